@@ -365,21 +365,21 @@ void PhysicsCommandComponentResource::create_commands_for_component(portal_core:
         angular_impulse_cmd.command_id = cpp_component.next_command_id++;
         
         if (execution_delay > 0.0f) {
-            cpp_component.add_delayed_command(angular_impulse_cmd, execution_delay);
+            cpp_component.add_delayed_command(std::move(angular_impulse_cmd), execution_delay);
         } else {
             // 直接添加到相應的命令隊列
             switch (timing) {
                 case portal_core::PhysicsCommandTiming::IMMEDIATE:
-                    cpp_component.immediate_commands.push_back(angular_impulse_cmd);
+                    cpp_component.immediate_commands.push_back(std::move(angular_impulse_cmd));
                     break;
                 case portal_core::PhysicsCommandTiming::BEFORE_PHYSICS_STEP:
-                    cpp_component.before_physics_commands.push_back(angular_impulse_cmd);
+                    cpp_component.before_physics_commands.push_back(std::move(angular_impulse_cmd));
                     break;
                 case portal_core::PhysicsCommandTiming::AFTER_PHYSICS_STEP:
-                    cpp_component.after_physics_commands.push_back(angular_impulse_cmd);
+                    cpp_component.after_physics_commands.push_back(std::move(angular_impulse_cmd));
                     break;
                 default:
-                    cpp_component.before_physics_commands.push_back(angular_impulse_cmd);
+                    cpp_component.before_physics_commands.push_back(std::move(angular_impulse_cmd));
                     break;
             }
         }
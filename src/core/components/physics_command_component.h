@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../math_types.h"
+#include "../inline_function.h"
+#include <algorithm>
 #include <vector>
 #include <queue>
 #include <variant>
@@ -82,8 +84,17 @@ namespace portal_core
     CRITICAL = 3
   };
 
+  /**
+   * 自定義命令的可調用對象
+   * 捕獲不超過 PHYSICS_COMMAND_CALLABLE_CAPACITY 字節時存放在命令內部，不產生堆分配；
+   * 超出時退回堆分配，並計入 PhysicsCommandComponent::allocation_count
+   */
+  static constexpr size_t PHYSICS_COMMAND_CALLABLE_CAPACITY = 48;
+  using PhysicsCommandCallable = InlineFunction<void(), PHYSICS_COMMAND_CALLABLE_CAPACITY>;
+
   /**
    * 基礎物理命令結構
+   * 自定義命令持有只能移動的可調用對象，命令本身也只能移動
    */
   struct PhysicsCommand
   {
@@ -105,7 +116,7 @@ namespace portal_core
         float,                 // 浮點參數（重力縮放、阻尼等）
         std::pair<Vector3, Vector3>, // 向量對（位置+力、起點+終點等）
         std::pair<Vector3, Quaternion>, // 位置+旋轉
-        std::function<void()>  // 自定義函數
+        PhysicsCommandCallable // 自定義函數
         >
         data;
 
@@ -118,7 +129,7 @@ namespace portal_core
     PhysicsCommand(PhysicsCommandType cmd_type, T &&cmd_data)
         : type(cmd_type), data(std::forward<T>(cmd_data)) {}
 
-    // 輔助方法獲取參數
+    // 輔助方法獲取參數（自定義函數請使用 invoke_custom）
     template <typename T>
     T get_data() const
     {
@@ -129,6 +140,20 @@ namespace portal_core
     {
       return !std::holds_alternative<std::monostate>(data);
     }
+
+    /**
+     * 調用自定義函數，重複命令可多次調用；沒有可調用對象時返回 false
+     */
+    bool invoke_custom() const
+    {
+      const auto *callable = std::get_if<PhysicsCommandCallable>(&data);
+      if (!callable || !*callable)
+      {
+        return false;
+      }
+      (*callable)();
+      return true;
+    }
   };
 
   /**
@@ -149,6 +174,10 @@ namespace portal_core
     // 命令ID計數器
     uint64_t next_command_id = 1;
 
+    // 添加命令引起的堆分配次數（列表擴容、超出內聯容量的自定義命令），由 PhysicsCommandSystem 每幀匯總並清零
+    // 列表在清空和執行後保留容量，穩定後每幀不再分配
+    uint32_t allocation_count = 0;
+
     // 執行狀態
     bool enabled = true;
     bool clear_after_execution = false; // 執行後是否清空所有命令
@@ -294,10 +323,12 @@ namespace portal_core
 
     /**
      * 添加自定義命令
+     * 任意可調用對象直接構造到命令內部，無需先轉換為 std::function
      */
-    void add_custom_command(std::function<void()> func, PhysicsCommandTiming timing = PhysicsCommandTiming::BEFORE_PHYSICS_STEP)
+    template <typename F>
+    void add_custom_command(F &&func, PhysicsCommandTiming timing = PhysicsCommandTiming::BEFORE_PHYSICS_STEP)
     {
-      PhysicsCommand cmd(PhysicsCommandType::CUSTOM, std::move(func));
+      PhysicsCommand cmd(PhysicsCommandType::CUSTOM, PhysicsCommandCallable(std::forward<F>(func)));
       cmd.timing = timing;
       cmd.command_id = next_command_id++;
       add_command(std::move(cmd));
@@ -322,6 +353,7 @@ namespace portal_core
       cmd.frame_count = 0; // 0表示無限重複
       cmd.auto_remove = false;
       cmd.command_id = next_command_id++;
+      count_allocations(recurring_commands, cmd);
       recurring_commands.push_back(std::move(cmd));
     }
 
@@ -430,24 +462,40 @@ namespace portal_core
     }
 
     /**
-     * 獲取準備執行的延遲命令
+     * 把準備執行的延遲命令按優先級順序移到 ready（調用方提供，可重用容量或使用幀內存）
+     * @return 移出的命令數
      */
-    std::vector<PhysicsCommand> get_ready_delayed_commands()
+    template <typename Container>
+    size_t take_ready_delayed_commands(Container &ready)
     {
-      std::vector<PhysicsCommand> ready_commands;
-      auto it = delayed_commands.begin();
-      while (it != delayed_commands.end())
+      const size_t previous_size = ready.size();
+      auto kept = delayed_commands.begin();
+      for (auto it = delayed_commands.begin(); it != delayed_commands.end(); ++it)
       {
         if (it->delay <= 0.0f)
         {
-          ready_commands.push_back(std::move(*it));
-          it = delayed_commands.erase(it);
+          ready.push_back(std::move(*it));
         }
         else
         {
-          ++it;
+          if (kept != it)
+          {
+            *kept = std::move(*it);
+          }
+          ++kept;
         }
       }
+      delayed_commands.erase(kept, delayed_commands.end());
+      return ready.size() - previous_size;
+    }
+
+    /**
+     * 獲取準備執行的延遲命令
+     */
+    std::vector<PhysicsCommand> get_ready_delayed_commands()
+    {
+      std::vector<PhysicsCommand> ready_commands;
+      take_ready_delayed_commands(ready_commands);
       return ready_commands;
     }
 
@@ -463,43 +511,44 @@ namespace portal_core
       switch (cmd.timing)
       {
       case PhysicsCommandTiming::IMMEDIATE:
-        immediate_commands.push_back(std::move(cmd));
+        insert_by_priority(immediate_commands, std::move(cmd));
         break;
       case PhysicsCommandTiming::BEFORE_PHYSICS_STEP:
-        before_physics_commands.push_back(std::move(cmd));
+        insert_by_priority(before_physics_commands, std::move(cmd));
         break;
       case PhysicsCommandTiming::AFTER_PHYSICS_STEP:
-        after_physics_commands.push_back(std::move(cmd));
+        insert_by_priority(after_physics_commands, std::move(cmd));
         break;
       case PhysicsCommandTiming::DELAYED:
-        delayed_commands.push_back(std::move(cmd));
+        insert_by_priority(delayed_commands, std::move(cmd));
         break;
       }
+    }
 
-      // 按優先級排序
-      auto sort_by_priority = [](std::vector<PhysicsCommand> &commands)
-      {
-        std::sort(commands.begin(), commands.end(),
-                  [](const PhysicsCommand &a, const PhysicsCommand &b)
-                  {
-                    return static_cast<int>(a.priority) > static_cast<int>(b.priority);
-                  });
-      };
+    /**
+     * 按優先級插入（高優先級在前，同優先級保持添加順序），列表始終有序，無需每次重新排序
+     */
+    void insert_by_priority(std::vector<PhysicsCommand> &commands, PhysicsCommand &&cmd)
+    {
+      count_allocations(commands, cmd);
+      auto position = std::upper_bound(commands.begin(), commands.end(), cmd.priority,
+                                       [](PhysicsCommandPriority priority, const PhysicsCommand &existing)
+                                       {
+                                         return static_cast<int>(priority) > static_cast<int>(existing.priority);
+                                       });
+      commands.insert(position, std::move(cmd));
+    }
 
-      switch (cmd.timing)
+    void count_allocations(const std::vector<PhysicsCommand> &commands, const PhysicsCommand &cmd)
+    {
+      if (commands.size() == commands.capacity())
       {
-      case PhysicsCommandTiming::IMMEDIATE:
-        sort_by_priority(immediate_commands);
-        break;
-      case PhysicsCommandTiming::BEFORE_PHYSICS_STEP:
-        sort_by_priority(before_physics_commands);
-        break;
-      case PhysicsCommandTiming::AFTER_PHYSICS_STEP:
-        sort_by_priority(after_physics_commands);
-        break;
-      case PhysicsCommandTiming::DELAYED:
-        sort_by_priority(delayed_commands);
-        break;
+        ++allocation_count;
+      }
+      const auto *callable = std::get_if<PhysicsCommandCallable>(&cmd.data);
+      if (callable && *callable && !callable->is_inline())
+      {
+        ++allocation_count;
       }
     }
   };
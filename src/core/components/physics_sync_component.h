@@ -25,9 +25,9 @@ struct PhysicsSyncComponent {
     Vec3 position_offset = Vec3(0.0f, 0.0f, 0.0f);
     Quat rotation_offset = Quat(0.0f, 0.0f, 0.0f, 1.0f);
     
-    // 插值設定（用於平滑同步）
+    // 插值設定：記錄最近兩個物理步的姿態，渲染時按固定步累積器的插值係數混合，
+    // 物理可以用較低的頻率步進而畫面不抖動（僅對 PHYSICS_TO_TRANSFORM 方向生效）
     bool enable_interpolation = false;
-    float interpolation_speed = 10.0f;
     
     // 同步閾值（避免微小變化的同步）
     float position_threshold = 0.001f;
@@ -37,6 +37,13 @@ struct PhysicsSyncComponent {
     Vec3 last_synced_position = Vec3(0.0f, 0.0f, 0.0f);
     Quat last_synced_rotation = Quat(0.0f, 0.0f, 0.0f, 1.0f);
     
+    // 插值姿態雙緩衝（已包含同步偏移）
+    Vec3 previous_position = Vec3(0.0f, 0.0f, 0.0f);
+    Quat previous_rotation = Quat(0.0f, 0.0f, 0.0f, 1.0f);
+    Vec3 current_position = Vec3(0.0f, 0.0f, 0.0f);
+    Quat current_rotation = Quat(0.0f, 0.0f, 0.0f, 1.0f);
+    bool has_pose_history = false;
+    
     PhysicsSyncComponent() = default;
     
     /**
@@ -69,6 +76,41 @@ struct PhysicsSyncComponent {
         last_synced_position = position;
         last_synced_rotation = rotation;
     }
+    
+    /**
+     * 記錄一個物理步後的姿態，當前姿態成為上一姿態
+     * 第一次記錄時兩者相同，避免從原點插值過來
+     */
+    void push_physics_pose(const Vec3& position, const Quat& rotation) {
+        if (has_pose_history) {
+            previous_position = current_position;
+            previous_rotation = current_rotation;
+        } else {
+            previous_position = position;
+            previous_rotation = rotation;
+            has_pose_history = true;
+        }
+        current_position = position;
+        current_rotation = rotation;
+    }
+    
+    /**
+     * 清除姿態歷史（傳送等不連續移動後調用，避免跨越兩地插值）
+     */
+    void reset_pose_history() {
+        has_pose_history = false;
+    }
+    
+    /**
+     * 按插值係數 alpha（0 為上一物理步，1 為當前物理步）混合姿態
+     */
+    Vec3 get_interpolated_position(float alpha) const {
+        return previous_position + (current_position - previous_position) * alpha;
+    }
+    
+    Quat get_interpolated_rotation(float alpha) const {
+        return previous_rotation.SLERP(current_rotation, alpha).Normalized();
+    }
 };
 
 } // namespace portal_core
@@ -5,6 +5,8 @@
 #include "../render/unified_render_manager.h"
 #include "../render/unified_debug_draw.h"
 #include "../render/unified_render_types.h"
+#include "../portal_game_world.h"
+#include "../frame_tracer.h"
 #include <iostream>
 #include <chrono>
 #include <sstream>
@@ -826,6 +828,103 @@ void RenderStatsWindow::update_render_stats() {
     render_stats_.gpu_time_ms = stats.frame_time_ms;
 }
 
+SystemProfilerWindow::SystemProfilerWindow()
+    : DebugWindow("system_profiler", "系统性能分析"),
+      frame_time_chart_("系统帧时间 (ms)", SystemProfiler::HISTORY_SIZE),
+      critical_path_chart_("关键路径 (ms)", SystemProfiler::HISTORY_SIZE) {
+    set_size(Vector2(520, 480));
+}
+
+void SystemProfilerWindow::render() {
+    begin_window();
+
+    auto* world = PortalGameWorld::get_instance();
+    if (!world) {
+        ImGui::Text("PortalGameWorld 未创建");
+        end_window();
+        return;
+    }
+
+    const auto& manager = world->get_system_manager();
+    if (!manager.is_profiling_enabled()) {
+        ImGui::Text("性能分析已禁用");
+        end_window();
+        return;
+    }
+
+    const SystemProfiler& profiler = manager.get_profiler();
+    const auto* frame = profiler.get_last_frame();
+    if (!frame) {
+        ImGui::Text("暂无数据");
+        end_window();
+        return;
+    }
+
+    // 每帧只向图表追加一次
+    if (frame->frame_index != last_charted_frame_) {
+        frame_time_chart_.add_value(frame->frame_ms);
+        critical_path_chart_.add_value(frame->critical_path_ms);
+        last_charted_frame_ = frame->frame_index;
+    }
+
+    ImGui::Text("帧 #%llu  固定步数: %u", static_cast<unsigned long long>(frame->frame_index), frame->fixed_steps);
+    ImGui::Text("帧耗时: %.3f ms  系统耗时总和: %.3f ms  关键路径: %.3f ms",
+                frame->frame_ms, frame->system_time_ms, frame->critical_path_ms);
+    if (frame->frame_ms > 0.0f) {
+        ImGui::Text("并行加速比: %.2fx", frame->system_time_ms / frame->frame_ms);
+    }
+    ImGui::Text("工作线程 忙碌: %.3f ms  空闲: %.3f ms  窃取任务: %llu",
+                frame->worker_busy_ms, frame->worker_idle_ms,
+                static_cast<unsigned long long>(frame->tasks_stolen));
+
+    frame_time_chart_.render();
+    critical_path_chart_.render();
+
+    ImGui::Separator();
+    ImGui::Text("%-28s %-13s %8s %8s %8s %8s %10s", "系统", "阶段", "当前", "平均", "最大", "帮助", "实体");
+    for (const auto& stats : profiler.get_system_stats()) {
+        ImGui::Text("%-28s %-13s %8.3f %8.3f %8.3f %8.3f %10llu",
+                    stats.name.c_str(), get_phase_name(stats.phase),
+                    stats.last_ms, stats.avg_ms, stats.max_ms, stats.avg_help_ms,
+                    static_cast<unsigned long long>(stats.last_entities));
+    }
+
+    ImGui::Separator();
+    ImGui::Checkbox("显示层详情", &show_layers_);
+    if (show_layers_) {
+        for (const auto& layer : frame->layers) {
+            ImGui::Text("%s 层 %u (%u 个系统): 耗时 %.3f ms, 关键路径 %.3f ms",
+                        get_phase_name(layer.phase), layer.layer_index, layer.system_count,
+                        layer.wall_ms, layer.critical_path_ms);
+        }
+    }
+
+    // 时间线追踪：导出后可在 chrome://tracing 或 ui.perfetto.dev 中查看
+    ImGui::Separator();
+    bool tracing = FrameTracer::is_enabled();
+    if (ImGui::Checkbox("记录时间线", &tracing)) {
+        FrameTracer::set_enabled(tracing);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("导出 Chrome Trace")) {
+        const std::string path = "portal_frame_trace.json";
+        const size_t event_count = FrameTracer::get_event_count();
+        trace_status_ = FrameTracer::write_chrome_trace(path)
+                            ? "已导出 " + std::to_string(event_count) + " 个事件到 " + path
+                            : "导出失败: " + path;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("清空时间线")) {
+        FrameTracer::clear();
+        trace_status_.clear();
+    }
+    if (!trace_status_.empty()) {
+        ImGui::Text("%s", trace_status_.c_str());
+    }
+
+    end_window();
+}
+
 ImGuiDemoWindow::ImGuiDemoWindow() 
     : DebugWindow("imgui_demo", "ImGui 演示") {
     set_size(Vector2(600, 500));
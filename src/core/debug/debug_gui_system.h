@@ -349,6 +349,23 @@ private:
     } render_stats_;
 };
 
+/**
+ * 系统性能分析窗口
+ * 显示 SystemManager 中每个系统的耗时、处理实体数、每层关键路径和工作线程空闲时间
+ */
+class SystemProfilerWindow : public DebugWindow {
+public:
+    SystemProfilerWindow();
+    void render() override;
+
+private:
+    DebugChart frame_time_chart_;
+    DebugChart critical_path_chart_;
+    uint64_t last_charted_frame_ = 0;
+    bool show_layers_ = false;
+    std::string trace_status_;
+};
+
 /**
  * ImGui演示窗口封装
  */
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace portal_core {
+
+/**
+ * 帧事件存储的类型擦除接口，EventManager 按类型索引保存
+ */
+class FrameEventStorageBase {
+public:
+    virtual ~FrameEventStorageBase() = default;
+
+    /**
+     * 丢弃在 frame 到期的全部事件
+     * @return 丢弃的事件数
+     */
+    virtual size_t expire(uint64_t frame) = 0;
+    virtual size_t size() const = 0;
+    virtual void clear() = 0;
+};
+
+/**
+ * 单一事件类型的帧事件存储 - 不为事件创建实体
+ *
+ * 事件按到期帧分桶：桶数组是一个按帧号取模的环，每个桶内事件与目标实体分别连续存放（SoA）。
+ * - 写入: 追加到 (当前帧 + 存活帧数) 对应的桶，O(1)
+ * - 过期: 每帧清空一个桶，事件类型可平凡析构时为 O(1)，桶保留容量，稳定后不再分配
+ * - 遍历: 按到期帧从近到远依次遍历各桶，桶内保持写入顺序
+ * 存活帧数上限为 MAX_LIFETIME_FRAMES（超出时截断）。
+ */
+template<typename TEvent>
+class FrameEventStorage : public FrameEventStorageBase {
+public:
+    static constexpr uint32_t BUCKET_BITS = 9;
+    static constexpr uint32_t BUCKET_COUNT = 1u << BUCKET_BITS;
+    static constexpr uint32_t MAX_LIFETIME_FRAMES = BUCKET_COUNT - 1;
+
+    void push(const TEvent& event, entt::entity target, uint64_t current_frame, uint32_t lifetime_frames) {
+        if (lifetime_frames == 0) {
+            lifetime_frames = 1;
+        } else if (lifetime_frames > MAX_LIFETIME_FRAMES) {
+            lifetime_frames = MAX_LIFETIME_FRAMES;
+        }
+        Bucket& bucket = buckets_[(current_frame + lifetime_frames) & (BUCKET_COUNT - 1)];
+        bucket.events.push_back(event);
+        bucket.targets.push_back(target);
+        ++size_;
+        // 记录最近写入的帧，遍历时从该帧的下一桶开始即可覆盖全部存活事件
+        current_frame_ = current_frame;
+    }
+
+    size_t expire(uint64_t frame) override {
+        Bucket& bucket = buckets_[frame & (BUCKET_COUNT - 1)];
+        const size_t expired = bucket.events.size();
+        bucket.events.clear();
+        bucket.targets.clear();
+        size_ -= expired;
+        current_frame_ = frame;
+        return expired;
+    }
+
+    /**
+     * 遍历存活事件
+     * func 以 (const TEvent&) 或 (entt::entity target, const TEvent&) 调用
+     */
+    template<typename Func>
+    void each(Func&& func) const {
+        if (size_ == 0) {
+            return;
+        }
+        for (uint32_t offset = 1; offset <= BUCKET_COUNT; ++offset) {
+            const Bucket& bucket = buckets_[(current_frame_ + offset) & (BUCKET_COUNT - 1)];
+            const size_t count = bucket.events.size();
+            for (size_t i = 0; i < count; ++i) {
+                if constexpr (std::is_invocable<Func&, entt::entity, const TEvent&>::value) {
+                    func(bucket.targets[i], bucket.events[i]);
+                } else {
+                    func(bucket.events[i]);
+                }
+            }
+        }
+    }
+
+    /**
+     * 遍历以指定实体为目标的存活事件
+     */
+    template<typename Func>
+    void each(entt::entity target, Func&& func) const {
+        each([&](entt::entity event_target, const TEvent& event) {
+            if (event_target == target) {
+                func(event);
+            }
+        });
+    }
+
+    size_t size() const override { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void clear() override {
+        for (Bucket& bucket : buckets_) {
+            bucket.events.clear();
+            bucket.targets.clear();
+        }
+        size_ = 0;
+    }
+
+private:
+    struct Bucket {
+        std::vector<TEvent> events;
+        std::vector<entt::entity> targets;
+    };
+
+    std::vector<Bucket> buckets_ = std::vector<Bucket>(BUCKET_COUNT);
+    size_t size_ = 0;
+    uint64_t current_frame_ = 0;
+};
+
+/**
+ * 帧事件只读视图，供系统遍历
+ * 类型从未写入过事件时为空视图
+ */
+template<typename TEvent>
+class FrameEventView {
+public:
+    explicit FrameEventView(const FrameEventStorage<TEvent>* storage = nullptr) : storage_(storage) {}
+
+    template<typename Func>
+    void each(Func&& func) const {
+        if (storage_) {
+            storage_->each(std::forward<Func>(func));
+        }
+    }
+
+    template<typename Func>
+    void each(entt::entity target, Func&& func) const {
+        if (storage_) {
+            storage_->each(target, std::forward<Func>(func));
+        }
+    }
+
+    size_t size() const { return storage_ ? storage_->size() : 0; }
+    bool empty() const { return size() == 0; }
+
+private:
+    const FrameEventStorage<TEvent>* storage_;
+};
+
+} // namespace portal_core
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 事件统计的编译期级别：
+//   PORTAL_EVENT_INSTRUMENTATION_NONE    不记录统计，相关代码在编译期移除
+//   PORTAL_EVENT_INSTRUMENTATION_SAMPLED 计数器精确记录；分类统计与处理耗时每 N 次采样一次并按比例累加
+//   PORTAL_EVENT_INSTRUMENTATION_FULL    全部记录，包括内存跟踪与性能分析
+// 未定义时调试构建 (PORTAL_TEMPLATE_DEBUG) 为 FULL，发布构建为 NONE；
+// 所有翻译单元必须使用同一级别，请在构建脚本中统一定义
+#define PORTAL_EVENT_INSTRUMENTATION_NONE 0
+#define PORTAL_EVENT_INSTRUMENTATION_SAMPLED 1
+#define PORTAL_EVENT_INSTRUMENTATION_FULL 2
+
+#ifndef PORTAL_EVENT_INSTRUMENTATION
+#ifdef PORTAL_TEMPLATE_DEBUG
+#define PORTAL_EVENT_INSTRUMENTATION PORTAL_EVENT_INSTRUMENTATION_FULL
+#else
+#define PORTAL_EVENT_INSTRUMENTATION PORTAL_EVENT_INSTRUMENTATION_NONE
+#endif
+#endif
+
+namespace portal_core {
+
+enum class EventInstrumentationLevel : uint8_t {
+    NONE = PORTAL_EVENT_INSTRUMENTATION_NONE,
+    SAMPLED = PORTAL_EVENT_INSTRUMENTATION_SAMPLED,
+    FULL = PORTAL_EVENT_INSTRUMENTATION_FULL
+};
+
+/**
+ * 事件统计策略：EventManager 在热路径上通过 if constexpr 查询，关闭的统计不生成任何代码
+ */
+template<EventInstrumentationLevel Level>
+struct EventInstrumentationPolicy {
+    static constexpr EventInstrumentationLevel level = Level;
+
+    // 各类计数器与按类型索引的计数（平坦数组，O(1)）
+    static constexpr bool counters = Level != EventInstrumentationLevel::NONE;
+    // 按分类字符串的统计与处理耗时：SAMPLED 时每 sample_interval 次记录一次
+    static constexpr bool sampled_details = Level != EventInstrumentationLevel::NONE;
+    // 内存跟踪与性能分析
+    static constexpr bool memory_tracking = Level == EventInstrumentationLevel::FULL;
+    static constexpr bool profiling = Level == EventInstrumentationLevel::FULL;
+
+    static constexpr uint32_t sample_interval = Level == EventInstrumentationLevel::SAMPLED ? 64 : 1;
+};
+
+using EventInstrumentation =
+    EventInstrumentationPolicy<static_cast<EventInstrumentationLevel>(PORTAL_EVENT_INSTRUMENTATION)>;
+
+/**
+ * 单一事件类型的统计，按 event_queue_type_index 保存在数组中
+ */
+struct EventTypeStatistics {
+    const char* type_name = nullptr;   // typeid(TEvent).name()，静态存储
+    uint32_t events_count = 0;         // 各种方式发布的事件总数
+    uint32_t sample_tick = 0;          // SAMPLED 级别的采样计数
+    size_t memory_bytes = 0;           // 内存跟踪（仅 FULL）
+};
+
+} // namespace portal_core
@@ -1,7 +1,9 @@
 #include "event_manager.h"
+#include "frame_tracer.h"
 #include <iostream>
 #include <algorithm>
 #include <chrono>
+#include <limits>
 
 namespace portal_core {
 
@@ -28,11 +30,27 @@ EventManager::EventManager(entt::registry& registry)
 }
 
 void EventManager::process_queued_events(float delta_time) {
-    auto start_time = std::chrono::high_resolution_clock::now();
+    PORTAL_TRACE_SCOPE("EventManager::process_queued_events");
+
+    // 录制帧边界：此前录制的事件在本帧处理；本帧内产生的事件不录制
+    if (event_recorder_ && recording_suppressed_ == 0) {
+        event_recorder_->record_frame(current_frame_ + 1, delta_time);
+    }
+    RecordingSuppression suppress(recording_suppressed_);
 
     // 更新当前帧数
     ++current_frame_;
 
+    // 处理耗时：SAMPLED 级别每 sample_interval 帧计时一次
+    bool timed = false;
+    std::chrono::high_resolution_clock::time_point start_time;
+    if constexpr (EventInstrumentation::sampled_details) {
+        timed = current_frame_ % EventInstrumentation::sample_interval == 0;
+        if (timed) {
+            start_time = std::chrono::high_resolution_clock::now();
+        }
+    }
+
     // 处理延迟事件
     update_delayed_events(delta_time);
 
@@ -40,15 +58,17 @@ void EventManager::process_queued_events(float delta_time) {
     update_temporary_markers();
 
     // 处理队列中的事件
-    dispatcher_.update();
+    dispatch_queued_events();
 
     // 清理过期事件
     cleanup_expired_events();
 
     // 计算处理时间
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-    statistics_.last_process_time_ms = duration.count() / 1000.0f;
+    if (timed) {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        statistics_.last_process_time_ms = duration.count() / 1000.0f;
+    }
 
     if (debug_mode_) {
         std::cout << "EventManager: Processed queued events in " 
@@ -57,13 +77,10 @@ void EventManager::process_queued_events(float delta_time) {
 }
 
 void EventManager::cleanup_expired_events() {
-    // 清理带有 EventMetadataComponent 的过期事件实体
-    struct EventMetadataComponent {
-        using is_event_component = void;
-        EventMetadata metadata;
-        uint32_t creation_frame;
-    };
+    // 帧事件按到期帧成桶丢弃
+    expire_frame_events();
 
+    // 清理带有 EventMetadataComponent 的过期事件实体
     auto view = registry_.view<EventMetadataComponent>();
     std::vector<entt::entity> to_destroy;
 
@@ -79,9 +96,7 @@ void EventManager::cleanup_expired_events() {
 
     for (auto entity : to_destroy) {
         registry_.destroy(entity);
-        if (statistics_.entity_events_count > 0) {
-            --statistics_.entity_events_count;
-        }
+        remove_statistic(statistics_.entity_events_count);
     }
 
     if (debug_mode_ && !to_destroy.empty()) {
@@ -90,28 +105,34 @@ void EventManager::cleanup_expired_events() {
     }
 }
 
+void EventManager::expire_frame_events() {
+    size_t expired = 0;
+    for (auto& storage : frame_event_storages_) {
+        if (storage) {
+            expired += storage->expire(current_frame_);
+        }
+    }
+    remove_statistic(statistics_.frame_events_count, static_cast<uint32_t>(expired));
+
+    if (debug_mode_ && expired > 0) {
+        std::cout << "EventManager: Expired " << expired << " frame events" << std::endl;
+    }
+}
+
 void EventManager::update_delayed_events(float delta_time) {
-    auto it = delayed_events_.begin();
-    while (it != delayed_events_.end()) {
-        it->remaining_time -= delta_time;
-        
-        if (it->remaining_time <= 0.0f) {
-            // 执行延迟事件
-            try {
-                it->executor();
-                if (debug_mode_) {
-                    std::cout << "EventManager: Executed delayed event in category: " 
-                              << it->category << std::endl;
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "EventManager: Error executing delayed event: " 
-                          << e.what() << std::endl;
-            }
-            
-            it = delayed_events_.erase(it);
-        } else {
-            ++it;
+    const size_t executed = delayed_events_.advance(delta_time, [this](DelayedExecutor& executor) {
+        // 执行延迟事件
+        try {
+            executor();
+        } catch (const std::exception& e) {
+            std::cerr << "EventManager: Error executing delayed event: " 
+                      << e.what() << std::endl;
         }
+    });
+
+    if (debug_mode_ && executed > 0) {
+        std::cout << "EventManager: Executed " << executed << " delayed events ("
+                  << delayed_events_.size() << " pending)" << std::endl;
     }
 }
 
@@ -133,9 +154,7 @@ void EventManager::update_temporary_markers() {
                           << e.what() << std::endl;
             }
             
-            if (statistics_.temporary_markers_count > 0) {
-                --statistics_.temporary_markers_count;
-            }
+            remove_statistic(statistics_.temporary_markers_count);
             
             it = temporary_markers_.erase(it);
         } else {
@@ -144,6 +163,279 @@ void EventManager::update_temporary_markers() {
     }
 }
 
+void EventManager::dispatch_queued_events() {
+    const bool budgeted = queued_event_budget_us_ > 0;
+    const DispatchClock::time_point deadline = budgeted
+        ? DispatchClock::now() + std::chrono::microseconds(queued_event_budget_us_)
+        : DispatchClock::time_point::max();
+    if constexpr (EventInstrumentation::counters) {
+        statistics_.budget_deferred_events_count = 0;
+    }
+
+    size_t dispatched = 0;
+    if (parallel_dispatch_enabled_ && worker_pool_) {
+        dispatch_queued_events_parallel(deadline);
+    } else {
+        // 按优先级依次分发；组内按索引遍历，处理器中首次入队的新类型会追加到 order，本帧同样会被处理
+        for (size_t lane_index = 0; lane_index < EVENT_PRIORITY_COUNT; ++lane_index) {
+            const auto& order = queued_lanes_[lane_index].order;
+            for (size_t i = 0; i < order.size(); ++i) {
+                dispatched += dispatch_lane_queue(lane_index, order[i], deadline);
+            }
+        }
+    }
+
+    if (budgeted && DispatchClock::now() >= deadline) {
+        add_statistic(statistics_.budget_exhausted_frames_count);
+    }
+
+    if (debug_mode_ && dispatched > 0) {
+        std::cout << "EventManager: Dispatched " << dispatched << " queued events" << std::endl;
+    }
+}
+
+size_t EventManager::dispatch_lane_queue(size_t lane_index, uint32_t type_index, DispatchClock::time_point deadline) {
+    QueuedEventLane& lane = queued_lanes_[lane_index];
+    TypedEventQueueBase& queue = *lane.queues[type_index];
+    if (!queue.has_pending()) {
+        lane.deferred_frames[type_index] = 0;
+        return 0;
+    }
+    const uint32_t deferred_frames = lane.deferred_frames[type_index];
+
+    // CRITICAL 与饥饿的队列不受预算限制
+    const bool starving = queued_event_budget_us_ > 0 && deferred_frames >= max_deferral_frames_;
+    const bool limited = lane_index != static_cast<size_t>(EventPriority::CRITICAL) &&
+                         deadline != DispatchClock::time_point::max() && !starving;
+    if (starving) {
+        add_statistic(statistics_.starvation_dispatches_count);
+    }
+
+    bool started_batch = false;
+    const size_t dispatched = dispatch_queue_until(queue, limited, deadline, started_batch);
+
+    // 本批未分发完，或预算用尽前没能换入已排队的事件：记为延后
+    // 处理器可能新增事件类型使数组扩容，按索引重新访问
+    if (queue.is_dispatching() || (!started_batch && queue.has_pending())) {
+        lane.deferred_frames[type_index] = deferred_frames + 1;
+        add_statistic(statistics_.budget_deferred_events_count, static_cast<uint32_t>(queue.size()));
+    } else {
+        lane.deferred_frames[type_index] = 0;
+    }
+    return dispatched;
+}
+
+size_t EventManager::dispatch_queue_until(TypedEventQueueBase& queue, bool limited, DispatchClock::time_point deadline,
+                                          bool& started_batch) {
+    const size_t chunk = limited ? BUDGET_CHECK_INTERVAL : std::numeric_limits<size_t>::max();
+    size_t dispatched = 0;
+    while (!limited || DispatchClock::now() < deadline) {
+        if (!queue.is_dispatching()) {
+            // 每帧最多换入一次新批次，处理器中入队的事件留到下一帧
+            if (started_batch || !queue.has_pending()) {
+                break;
+            }
+            started_batch = true;
+        }
+        dispatched += queue.dispatch(dispatcher_, chunk);
+    }
+    return dispatched;
+}
+
+void EventManager::dispatch_queued_events_parallel(DispatchClock::time_point deadline) {
+    for (const auto& lane : queued_lanes_) {
+        if (dispatch_policies_.size() < lane.queues.size()) {
+            dispatch_policies_.resize(lane.queues.size());
+        }
+    }
+
+    uint32_t parallel_types = 0;
+    size_t total_batches = 0;
+    size_t main_thread_types = 0;
+    for (size_t lane_index = 0; lane_index < EVENT_PRIORITY_COUNT; ++lane_index) {
+        QueuedEventLane& lane = queued_lanes_[lane_index];
+        if (lane.order.empty()) {
+            continue;
+        }
+
+        // 预算用尽：本优先级不再开始并行批次，只有 CRITICAL 与饥饿的队列在调用线程分发
+        if (lane_index != static_cast<size_t>(EventPriority::CRITICAL) && DispatchClock::now() >= deadline) {
+            for (size_t i = 0; i < lane.order.size(); ++i) {
+                dispatch_lane_queue(lane_index, lane.order[i], deadline);
+            }
+            continue;
+        }
+
+        // 分组：ANY_THREAD 类型放入第一个没有组件访问冲突的批次，其余留在调用线程
+        size_t batch_count = 0;
+        for (auto& batch : dispatch_batches_) {
+            batch.clear();
+        }
+
+        for (const uint32_t index : lane.order) {
+            const EventDispatchPolicy& policy = dispatch_policies_[index];
+            if (!policy.any_thread || !lane.queues[index]->has_pending()) {
+                continue;
+            }
+
+            size_t target = 0;
+            for (; target < batch_count; ++target) {
+                const auto& batch = dispatch_batches_[target];
+                const bool conflict = std::any_of(batch.begin(), batch.end(), [&](uint32_t other) {
+                    return policy.access.conflicts_with(dispatch_policies_[other].access);
+                });
+                if (!conflict) {
+                    break;
+                }
+            }
+            if (target == batch_count) {
+                if (dispatch_batches_.size() <= batch_count) {
+                    dispatch_batches_.emplace_back();
+                }
+                ++batch_count;
+            }
+            dispatch_batches_[target].push_back(index);
+        }
+
+        // 批次之间依次执行；同一类型的事件在同一任务内按顺序分发
+        for (size_t b = 0; b < batch_count; ++b) {
+            const auto& batch = dispatch_batches_[b];
+            parallel_types += static_cast<uint32_t>(batch.size());
+
+            TaskGroup group;
+            for (size_t i = 1; i < batch.size(); ++i) {
+                const uint32_t index = batch[i];
+                worker_pool_->submit(group, [this, lane_index, index]() { dispatch_queue_in_worker(lane_index, index); });
+            }
+            // 调用线程执行第一个类型，然后在 wait 中帮助执行其余任务
+            dispatch_queue_in_worker(lane_index, batch[0]);
+            worker_pool_->wait(group);
+
+            for (const uint32_t index : batch) {
+                lane.deferred_frames[index] = 0;
+            }
+        }
+        total_batches += batch_count;
+
+        // 延后的操作可能新增事件类型，之后再分发 MAIN_THREAD 类型
+        run_deferred_operations();
+
+        for (size_t i = 0; i < lane.order.size(); ++i) {
+            const uint32_t index = lane.order[i];
+            if (index < dispatch_policies_.size() && !dispatch_policies_[index].any_thread &&
+                lane.queues[index]->has_pending()) {
+                dispatch_lane_queue(lane_index, index, deadline);
+                ++main_thread_types;
+            }
+        }
+    }
+    if constexpr (EventInstrumentation::counters) {
+        statistics_.parallel_dispatched_types = parallel_types;
+        statistics_.parallel_dispatch_batches = static_cast<uint32_t>(total_batches);
+    }
+
+    if (debug_mode_) {
+        std::cout << "EventManager: Dispatched " << parallel_types << " event types in " << total_batches
+                  << " parallel batches, " << main_thread_types << " on main thread" << std::endl;
+    }
+}
+
+void EventManager::dispatch_queue_in_worker(size_t lane_index, uint32_t type_index) {
+    const EventManager* previous_owner = parallel_dispatch_owner_;
+    parallel_dispatch_owner_ = this;
+    try {
+        bool started_batch = false;
+        dispatch_queue_until(*queued_lanes_[lane_index].queues[type_index], false, DispatchClock::time_point::max(),
+                             started_batch);
+    } catch (const std::exception& e) {
+        std::cerr << "EventManager: Error in parallel event handler: " << e.what() << std::endl;
+    }
+    parallel_dispatch_owner_ = previous_owner;
+}
+
+void EventManager::defer_operation(DelayedExecutor operation) {
+    std::lock_guard<std::mutex> lock(deferred_mutex_);
+    deferred_operations_.push_back(std::move(operation));
+}
+
+void EventManager::run_deferred_operations() {
+    std::vector<DelayedExecutor> operations;
+    {
+        std::lock_guard<std::mutex> lock(deferred_mutex_);
+        operations.swap(deferred_operations_);
+    }
+    if (operations.empty()) {
+        return;
+    }
+
+    for (auto& operation : operations) {
+        operation();
+    }
+    add_statistic(statistics_.deferred_operations_count, static_cast<uint32_t>(operations.size()));
+
+    // 归还数组容量，下一帧不再分配
+    operations.clear();
+    std::lock_guard<std::mutex> lock(deferred_mutex_);
+    if (deferred_operations_.empty()) {
+        deferred_operations_.swap(operations);
+    }
+}
+
+void EventManager::declare_event_handler(uint32_t type_index, const EventHandlerDeclaration& declaration) {
+    if (type_index >= dispatch_policies_.size()) {
+        dispatch_policies_.resize(type_index + 1);
+    }
+    EventDispatchPolicy& policy = dispatch_policies_[type_index];
+    if (declaration.affinity == EventThreadAffinity::MAIN_THREAD) {
+        policy.any_thread = false;
+    }
+    policy.access.merge(declaration.access);
+}
+
+bool EventManager::cancel_queued_event(const QueuedEventHandle& handle) {
+    if (in_parallel_dispatch()) {
+        defer_operation(DelayedExecutor([this, handle]() { cancel_queued_event(handle); }));
+        return false;
+    }
+    if (!handle.is_valid() || handle.lane >= EVENT_PRIORITY_COUNT) {
+        return false;
+    }
+    const QueuedEventLane& lane = queued_lanes_[handle.lane];
+    if (handle.type_index >= lane.queues.size() || !lane.queues[handle.type_index]) {
+        return false;
+    }
+    if (!lane.queues[handle.type_index]->cancel(handle)) {
+        return false;
+    }
+    add_statistic(statistics_.cancelled_events_count);
+    return true;
+}
+
+size_t EventManager::cancel_queued_events_for_entity(entt::entity entity) {
+    if (in_parallel_dispatch()) {
+        defer_operation(DelayedExecutor([this, entity]() { cancel_queued_events_for_entity(entity); }));
+        return 0;
+    }
+    size_t cancelled = 0;
+    for (const auto& lane : queued_lanes_) {
+        for (const uint32_t index : lane.order) {
+            cancelled += lane.queues[index]->cancel_for_entity(entity);
+        }
+    }
+    add_statistic(statistics_.cancelled_events_count, static_cast<uint32_t>(cancelled));
+    return cancelled;
+}
+
+size_t EventManager::get_queued_event_count() const {
+    size_t count = 0;
+    for (const auto& lane : queued_lanes_) {
+        for (const uint32_t index : lane.order) {
+            count += lane.queues[index]->size();
+        }
+    }
+    return count;
+}
+
 void EventManager::log_event_if_debug(const std::string& event_type, const std::string& action) {
     if (debug_mode_) {
         std::cout << "EventManager: " << action << " - " << event_type 
@@ -169,11 +461,13 @@ EventManager::ObjectPoolStatistics EventManager::get_pool_statistics() const {
         return stats; // 返回空统计
     }
     
-    // 这里需要从 EventPoolManager 收集统计信息
-    // 由于我们使用了静态池，实际实现可能需要注册机制
-    // 简化实现，返回模拟数据
-    stats.total_pools_active = 4; // 假设有4个活跃池
-    stats.average_reuse_ratio = 0.75f; // 假设75%重用率
+    // 从 EventPoolManager 汇总各类型池（含线程缓存）的统计信息
+    const auto global_stats = pool_manager_.get_global_statistics();
+    stats.total_pools_active = global_stats.total_pools;
+    stats.total_objects_created = global_stats.total_created;
+    stats.total_objects_reused = global_stats.total_reused;
+    stats.average_reuse_ratio = global_stats.average_reuse_ratio;
+    stats.pool_sizes = global_stats.pool_sizes;
     
     return stats;
 }
@@ -245,6 +539,9 @@ void EventManager::apply_configuration(const Configuration& config) {
     set_object_pooling_enabled(config.object_pooling_enabled);
     set_concurrent_mode(config.concurrent_mode_enabled);
     set_debug_mode(config.debug_mode_enabled);
+    set_parallel_dispatch_enabled(config.parallel_dispatch_enabled);
+    set_queued_event_budget(config.queued_event_budget_us);
+    set_max_deferral_frames(config.max_deferral_frames);
     
     if (config.performance_profiling_enabled) {
         start_performance_profiling();
@@ -280,9 +577,20 @@ void EventManager::export_statistics_to_console() const {
     std::cout << "Events:" << std::endl;
     std::cout << "  Immediate: " << statistics_.immediate_events_count << std::endl;
     std::cout << "  Queued: " << statistics_.queued_events_count << std::endl;
+    std::cout << "  Cancelled: " << statistics_.cancelled_events_count << std::endl;
+    std::cout << "  Coalesced: " << statistics_.coalesced_events_count << std::endl;
+    std::cout << "  Deferred By Budget (last frame): " << statistics_.budget_deferred_events_count << std::endl;
+    std::cout << "  Budget Exhausted Frames: " << statistics_.budget_exhausted_frames_count << std::endl;
+    std::cout << "  Starvation Dispatches: " << statistics_.starvation_dispatches_count << std::endl;
     std::cout << "  Entity Events: " << statistics_.entity_events_count << std::endl;
     std::cout << "  Temporary Markers: " << statistics_.temporary_markers_count << std::endl;
+    std::cout << "  Frame Events: " << statistics_.frame_events_count << std::endl;
     std::cout << "  Last Process Time: " << statistics_.last_process_time_ms << "ms" << std::endl;
+    for (const auto& type_statistics : statistics_.events_by_type) {
+        if (type_statistics.type_name) {
+            std::cout << "  [" << type_statistics.type_name << "]: " << type_statistics.events_count << std::endl;
+        }
+    }
     
     std::cout << "\nPools:" << std::endl;
     std::cout << "  Active Pools: " << pool_statistics_.total_pools_active << std::endl;
@@ -317,8 +625,10 @@ void EventManager::export_pool_diagnostics() const {
         std::cout << "Pool [" << type_name << "]: " << size << " objects" << std::endl;
     }
     
-    for (const auto& [type_name, memory] : memory_usage_by_type_) {
-        std::cout << "Memory [" << type_name << "]: " << memory << " bytes" << std::endl;
+    for (const auto& type_statistics : statistics_.events_by_type) {
+        if (type_statistics.type_name && type_statistics.memory_bytes > 0) {
+            std::cout << "Memory [" << type_statistics.type_name << "]: " << type_statistics.memory_bytes << " bytes" << std::endl;
+        }
     }
     
     std::cout << "========================\n" << std::endl;
@@ -369,6 +679,13 @@ EventManager::PerformanceProfile EventManager::get_performance_profile() const {
 }
 
 void EventManager::start_performance_profiling() {
+    if constexpr (!EventInstrumentation::profiling) {
+        // 当前统计级别不包含性能分析，保持关闭
+        if (debug_mode_) {
+            std::cout << "EventManager: Performance profiling unavailable at this instrumentation level" << std::endl;
+        }
+        return;
+    }
     performance_profiling_enabled_ = true;
     last_profiling_time_ = std::chrono::high_resolution_clock::now();
     performance_profile_ = PerformanceProfile{};
@@ -409,21 +726,6 @@ void EventManager::update_performance_metrics() const {
     last_profiling_time_ = current_time;
 }
 
-void EventManager::track_memory_allocation(const std::string& type, size_t bytes) const {
-    total_allocated_memory_ += bytes;
-    memory_usage_by_type_[type] += bytes;
-}
-
-void EventManager::track_memory_deallocation(const std::string& type, size_t bytes) const {
-    if (total_allocated_memory_ >= bytes) {
-        total_allocated_memory_ -= bytes;
-    }
-    
-    if (memory_usage_by_type_[type] >= bytes) {
-        memory_usage_by_type_[type] -= bytes;
-    }
-}
-
 void EventManager::schedule_cleanup_if_needed(float current_time) {
     const float cleanup_interval = current_config_.pool_cleanup_interval;
     
@@ -10,7 +10,20 @@
 #include <thread>
 #include <chrono>
 #include <iostream>
+#include <mutex>
+#include <array>
+#include <algorithm>
+#include <typeinfo>
+#include <vector>
 #include "event_pool_and_concurrency.h"
+#include "event_timing_wheel.h"
+#include "event_typed_queue.h"
+#include "event_frame_storage.h"
+#include "event_instrumentation.h"
+#include "event_recorder.h"
+#include "system_base.h"
+#include "worker_pool.h"
+#include "inline_function.h"
 
 namespace portal_core {
 
@@ -40,6 +53,8 @@ enum class EventPriority {
     LOW = 3         // 低优先级 (日志、统计等)
 };
 
+static constexpr size_t EVENT_PRIORITY_COUNT = 4;
+
 // 事件元数据
 struct EventMetadata {
     EventPriority priority = EventPriority::NORMAL;
@@ -49,6 +64,32 @@ struct EventMetadata {
     uint32_t frame_lifetime = 1;           // 事件存活帧数
 };
 
+// 事件处理器的线程亲和性
+enum class EventThreadAffinity {
+    MAIN_THREAD,    // 只能在调用 process_queued_events 的线程执行 (UI、脚本、未声明访问的处理器)
+    ANY_THREAD      // 可在工作线程执行，需声明访问的组件
+};
+
+/**
+ * 事件处理器声明
+ * 同一事件类型的所有处理器都声明为 ANY_THREAD 时，该类型才会在并行分发中交给工作线程；
+ * 组件访问沿用系统调度的 ComponentAccess，访问冲突的事件类型不会同时分发。
+ * ANY_THREAD 处理器未声明组件访问时视为不访问注册表。
+ */
+struct EventHandlerDeclaration {
+    EventThreadAffinity affinity = EventThreadAffinity::MAIN_THREAD;
+    ComponentAccess access;
+};
+
+/**
+ * 构建处理器声明
+ * 使用方式：make_event_handler_declaration<const TransformComponent, PhysicsBodyComponent>(EventThreadAffinity::ANY_THREAD)
+ */
+template<typename... Components>
+EventHandlerDeclaration make_event_handler_declaration(EventThreadAffinity affinity) {
+    return EventHandlerDeclaration{affinity, make_component_access<Components...>()};
+}
+
 /**
  * 统一事件管理器
  * 
@@ -80,22 +121,46 @@ public:
     /**
      * 将事件加入队列，在帧末或指定时机统一处理
      * 适用于: 状态同步、批量更新、需要排序的事件等
+     * 按 metadata.priority 进入对应优先级的队列，高优先级先分发（见 set_queued_event_budget）
+     * @return 取消用的句柄；延迟事件返回无效句柄（请使用 schedule_event 的句柄）
      */
     template<typename TEvent>
-    void enqueue(const TEvent& event, const EventMetadata& metadata = {});
+    QueuedEventHandle enqueue(const TEvent& event, const EventMetadata& metadata = {});
 
     /**
      * 订阅 Dispatcher 事件
      * 返回 sink 用于连接/断开监听函数
+     * 未声明的处理器视为 MAIN_THREAD，该事件类型不会在工作线程上分发
      */
     template<typename TEvent>
     auto subscribe() -> decltype(auto);
 
+    /**
+     * 带声明的订阅：每次调用对应连接一个处理器
+     * 例: subscribe<CollisionStartEvent>(make_event_handler_declaration<DamageComponent>(EventThreadAffinity::ANY_THREAD))
+     *         .connect<&DamageSystem::on_collision>(damage_system);
+     */
+    template<typename TEvent>
+    auto subscribe(const EventHandlerDeclaration& declaration) -> decltype(auto);
+
+    /**
+     * 订阅批量事件：处理器签名为 void(EventSpan<TEvent>)，一次调用收到一段连续事件
+     * 队列事件在逐个通知 TEvent 处理器之后按未取消的连续区段分发；publish_batch(IMMEDIATE) 整批分发一次
+     * 例: subscribe_batch<RaycastResultEvent>().connect<&AiSystem::on_raycast_results>(ai_system);
+     */
+    template<typename TEvent>
+    auto subscribe_batch() -> decltype(auto);
+
+    template<typename TEvent>
+    auto subscribe_batch(const EventHandlerDeclaration& declaration) -> decltype(auto);
+
     // === 模式二: 实体事件 (数据驱动状态) ===
 
     /**
      * 创建事件实体，将事件作为组件附加
      * 适用于: 复杂状态、可查询的事件、需要持久化的状态等
+     * 在并行分发的 ANY_THREAD 处理器中调用时，实体在并行批次结束后于主线程创建，
+     * 此时返回 entt::null（工作线程不能修改注册表，也无法预先取得实体 ID）
      */
     template<typename TEventComponent, 
              typename = std::enable_if_t<is_event_component_v<TEventComponent>>>
@@ -105,6 +170,7 @@ public:
     /**
      * 向已有实体添加事件组件
      * 适用于: 实体状态变化、属性修改、状态标记等
+     * 在并行分发的 ANY_THREAD 处理器中调用时延后到并行批次结束后执行
      */
     template<typename TEventComponent,
              typename = std::enable_if_t<is_event_component_v<TEventComponent>>>
@@ -117,6 +183,7 @@ public:
     /**
      * 添加临时标记组件，自动在指定帧数后清理
      * 适用于: 一次性触发器、临时状态、帧级别的标记等
+     * 在并行分发的 ANY_THREAD 处理器中调用时延后到并行批次结束后执行
      */
     template<typename TEventComponent,
              typename = std::enable_if_t<is_event_component_v<TEventComponent>>>
@@ -124,27 +191,127 @@ public:
                             TEventComponent&& event_component,
                             uint32_t lifetime_frames = 1);
 
+    // === 模式四: 帧事件存储 (不创建实体) ===
+
+    /**
+     * 写入短生命周期事件，存活 lifetime_frames 帧后批量过期
+     * 事件按类型存放在按到期帧分桶的连续数组中，不创建实体、不修改注册表
+     * 适用于: 大量短生命周期的状态通知、命中/接触记录等原本使用 create_entity_event 的场景
+     */
+    template<typename TEvent>
+    void emit_frame_event(const TEvent& event, entt::entity target = entt::null,
+                          uint32_t lifetime_frames = 1, const EventMetadata& metadata = {});
+
+    /**
+     * 获取帧事件视图，供系统遍历
+     * 例: event_manager.view_frame_events<HitEvent>().each([](entt::entity target, const HitEvent& hit) { ... });
+     */
+    template<typename TEvent>
+    FrameEventView<TEvent> view_frame_events() const;
+
     // === 高级功能 ===
 
+    /**
+     * 延迟事件句柄，可用于取消尚未触发的延迟事件
+     */
+    using DelayedEventHandle = TimerHandle;
+
     /**
      * 延迟执行事件
+     * 事件按值保存在不分配的小缓冲执行器中（超出 DELAYED_EXECUTOR_CAPACITY 时退回堆分配）
+     * @return 取消用的句柄
      */
     template<typename TEvent>
-    void schedule_event(const TEvent& event, float delay_seconds, 
-                       EventHandlingStrategy strategy = EventHandlingStrategy::QUEUED);
+    DelayedEventHandle schedule_event(const TEvent& event, float delay_seconds, 
+                                      EventHandlingStrategy strategy = EventHandlingStrategy::QUEUED);
+
+    /**
+     * 取消尚未触发的延迟事件，O(1)
+     * @return true 成功取消，false 句柄无效或事件已触发
+     */
+    bool cancel_scheduled_event(DelayedEventHandle handle) { return delayed_events_.cancel(handle); }
+    bool is_scheduled_event_pending(DelayedEventHandle handle) const { return delayed_events_.is_pending(handle); }
+    size_t get_scheduled_event_count() const { return delayed_events_.size(); }
 
     /**
      * 批量发布事件
+     * - IMMEDIATE: 逐个通知 TEvent 处理器后，把整批交给 EventSpan<TEvent> 处理器一次
+     * - 其余策略: 一次扩容整段入队（启用合并或带延迟时退回逐个处理）
+     * 调试日志与统计每批只更新一次
      */
     template<typename TEvent>
+    void publish_batch(EventSpan<TEvent> events,
+                      EventHandlingStrategy strategy = EventHandlingStrategy::QUEUED,
+                      const EventMetadata& metadata = {});
+
+    template<typename TEvent>
     void publish_batch(const std::vector<TEvent>& events, 
-                      EventHandlingStrategy strategy = EventHandlingStrategy::QUEUED);
+                      EventHandlingStrategy strategy = EventHandlingStrategy::QUEUED,
+                      const EventMetadata& metadata = {}) {
+        publish_batch(EventSpan<TEvent>(events), strategy, metadata);
+    }
+
+    /**
+     * 取消单个尚未分发的队列事件
+     * 处理器中也可以取消本批中尚未轮到的事件
+     * @return true 成功取消，false 句柄无效或事件已分发
+     */
+    bool cancel_queued_event(const QueuedEventHandle& handle);
 
     /**
      * 取消指定类型的所有队列事件
+     * @return 取消的事件数
+     */
+    template<typename TEvent>
+    size_t cancel_queued_events();
+
+    /**
+     * 按条件取消指定类型的队列事件，predicate 以 const TEvent& 调用
+     */
+    template<typename TEvent, typename Predicate>
+    size_t cancel_queued_events_if(Predicate&& predicate);
+
+    /**
+     * 取消所有以该实体为目标的队列事件（事件的 entity 或 target 成员）
+     * 适用于: 实体销毁时丢弃发给它的事件
+     */
+    size_t cancel_queued_events_for_entity(entt::entity entity);
+
+    /**
+     * 启用队列事件合并：同一帧内合并键相同的事件只分发一次
+     * 合并后的事件保留最早的排队位置；未提供 merge_function 时后到的事件覆盖先到的事件
+     * 不同优先级的事件分别排队，互不合并
+     * 例: set_event_coalescing<BodyActivationEvent>(coalesce_by_target_entity<BodyActivationEvent>)
      */
     template<typename TEvent>
-    void cancel_queued_events();
+    void set_event_coalescing(typename TypedEventQueue<TEvent>::KeyFunction key_function,
+                              typename TypedEventQueue<TEvent>::MergeFunction merge_function = nullptr);
+
+    template<typename TEvent>
+    void disable_event_coalescing() { set_event_coalescing<TEvent>(nullptr); }
+
+    /**
+     * 等待分发的队列事件数（不含已取消和已合并的事件）
+     */
+    template<typename TEvent>
+    size_t get_queued_event_count() const;
+    size_t get_queued_event_count() const;
+
+    /**
+     * 队列事件的每帧时间预算（微秒），0 表示不限制（默认）
+     * 启用后 process_queued_events 按 CRITICAL → HIGH → NORMAL → LOW 分发：
+     * - CRITICAL 事件总是全部分发
+     * - 其余事件每分发 BUDGET_CHECK_INTERVAL 个检查一次时间，预算用尽后剩余事件延后到下一帧，
+     *   延后的事件保持顺序，仍可用原句柄取消
+     * - 饥饿保护：某类型的队列连续延后 max_deferral_frames 帧后，下一帧不受预算限制全部分发
+     * 并行分发时在每个优先级开始前检查预算，已开始的并行批次完整执行
+     */
+    void set_queued_event_budget(uint32_t budget_us) { queued_event_budget_us_ = budget_us; }
+    uint32_t get_queued_event_budget() const { return queued_event_budget_us_; }
+    void set_max_deferral_frames(uint32_t frames) { max_deferral_frames_ = frames; }
+    uint32_t get_max_deferral_frames() const { return max_deferral_frames_; }
+
+    static constexpr size_t BUDGET_CHECK_INTERVAL = 32;
 
     // === 对象池管理 (新增) ===
 
@@ -192,6 +359,32 @@ public:
     void set_worker_thread_count(size_t count);
     size_t get_worker_thread_count() const { return worker_thread_count_; }
 
+    /**
+     * 并行分发队列事件 (默认关闭)
+     * 开启后 process_queued_events 把处理器均为 ANY_THREAD 的事件类型分组交给工作线程：
+     * - 同一类型的事件仍在同一任务内按顺序分发
+     * - 组件访问冲突的类型分到不同的批次，批次之间依次执行
+     * - MAIN_THREAD 类型在所有并行批次结束后于调用线程分发
+     * 工作线程上的处理器调用 enqueue / publish_immediate / schedule_event / cancel_* 时，
+     * 操作会延后到并行批次结束后在调用线程按顺序执行（返回无效句柄 / 0）
+     */
+    void set_parallel_dispatch_enabled(bool enabled) { parallel_dispatch_enabled_ = enabled; }
+    bool is_parallel_dispatch_enabled() const { return parallel_dispatch_enabled_; }
+
+    /**
+     * 设置并行分发使用的线程池（通常为 SystemManager::get_worker_pool()），为 nullptr 时退回顺序分发
+     */
+    void set_worker_pool(WorkerPool* pool) { worker_pool_ = pool; }
+    WorkerPool* get_worker_pool() const { return worker_pool_; }
+
+    /**
+     * 设置事件录制器（nullptr 停止录制），录制器由调用方持有
+     * 录制外部调用 enqueue / publish_immediate / publish_batch / schedule_event 发布的事件与每帧的 delta_time；
+     * process_queued_events 期间与即时处理器中发布的事件由回放时的处理器重新产生，不录制
+     */
+    void set_event_recorder(EventRecorder* recorder) { event_recorder_ = recorder; }
+    EventRecorder* get_event_recorder() const { return event_recorder_; }
+
     /**
      * 获取并发统计信息
      */
@@ -220,14 +413,26 @@ public:
 
     /**
      * 获取事件统计信息
+     * 记录范围由编译期级别 PORTAL_EVENT_INSTRUMENTATION 决定（见 event_instrumentation.h）：
+     * NONE 时全部保持为 0；SAMPLED 时 events_by_category 与 last_process_time_ms 为采样估计值
      */
     struct EventStatistics {
         uint32_t immediate_events_count = 0;
         uint32_t queued_events_count = 0;
         uint32_t entity_events_count = 0;
         uint32_t temporary_markers_count = 0;
+        uint32_t frame_events_count = 0;       // 存活的帧事件
+        uint32_t cancelled_events_count = 0;   // 分发前被取消的队列事件
+        uint32_t coalesced_events_count = 0;   // 被合并到已排队事件中的队列事件
+        uint32_t parallel_dispatched_types = 0; // 上一帧在工作线程上分发的事件类型数
+        uint32_t parallel_dispatch_batches = 0; // 上一帧的并行批次数
+        uint32_t deferred_operations_count = 0; // 工作线程处理器中延后执行的操作
+        uint32_t budget_deferred_events_count = 0; // 上一帧因预算延后到下一帧的队列事件
+        uint32_t budget_exhausted_frames_count = 0; // 预算用尽的帧数（累计）
+        uint32_t starvation_dispatches_count = 0;   // 饥饿保护越过预算分发的次数（累计）
         float last_process_time_ms = 0.0f;
         std::unordered_map<std::string, uint32_t> events_by_category;
+        std::vector<EventTypeStatistics> events_by_type;   // 按 event_queue_type_index 索引
     };
 
     const EventStatistics& get_statistics() const { return statistics_; }
@@ -253,6 +458,9 @@ public:
         bool object_pooling_enabled = true;
         bool concurrent_mode_enabled = false;
         bool debug_mode_enabled = false;
+        bool parallel_dispatch_enabled = false;
+        uint32_t queued_event_budget_us = 0;   // 0 = 不限制
+        uint32_t max_deferral_frames = 8;
         size_t concurrent_queue_size = 10000;
         size_t pool_initial_size = 100;
         size_t pool_max_size = 1000;
@@ -299,6 +507,45 @@ public:
 private:
     entt::registry& registry_;
     entt::dispatcher dispatcher_;
+
+    // 队列事件：每个优先级一组队列，组内按事件类型索引保存，分发时通过 dispatcher_.trigger 通知订阅者
+    struct QueuedEventLane {
+        std::vector<std::unique_ptr<TypedEventQueueBase>> queues;
+        std::vector<uint32_t> order;             // 按首次入队顺序分发
+        std::vector<uint32_t> deferred_frames;   // 连续因预算延后的帧数，按类型索引
+    };
+    std::array<QueuedEventLane, EVENT_PRIORITY_COUNT> queued_lanes_;
+    // 合并等队列设置按类型保存，之后创建的其他优先级队列同样应用
+    std::vector<std::function<void(TypedEventQueueBase&)>> queue_initializers_;
+    uint32_t queued_event_budget_us_ = 0;
+    uint32_t max_deferral_frames_ = 8;
+
+    // 并行分发：按类型索引保存处理器声明的汇总
+    struct EventDispatchPolicy {
+        bool any_thread = true;                  // 所有处理器都声明为 ANY_THREAD
+        ComponentAccess access;
+    };
+    std::vector<EventDispatchPolicy> dispatch_policies_;
+    bool parallel_dispatch_enabled_ = false;
+    WorkerPool* worker_pool_ = nullptr;
+    std::vector<std::vector<uint32_t>> dispatch_batches_;   // 每帧复用
+
+    // 事件录制：recording_suppressed_ 非零时（帧处理期间、即时处理器内）不录制
+    EventRecorder* event_recorder_ = nullptr;
+    uint32_t recording_suppressed_ = 0;
+    struct RecordingSuppression {
+        explicit RecordingSuppression(uint32_t& depth) : depth_(depth) { ++depth_; }
+        ~RecordingSuppression() { --depth_; }
+        uint32_t& depth_;
+    };
+
+    template<typename TEvent>
+    void record_to_log(EventLogRecordKind kind, const TEvent* events, size_t count,
+                       EventPriority priority, float delay = 0.0f) {
+        if (event_recorder_ && recording_suppressed_ == 0) {
+            event_recorder_->record(current_frame_, kind, static_cast<uint8_t>(priority), delay, events, count);
+        }
+    }
     
     // 高级功能开关
     bool use_object_pooling_ = true;           // 默认启用对象池
@@ -311,14 +558,25 @@ private:
     // 并发事件调度器
     std::unique_ptr<ConcurrentEventDispatcher> concurrent_dispatcher_;
     
-    // 延迟事件队列
-    struct DelayedEvent {
-        std::function<void()> executor;
-        float remaining_time;
-        EventPriority priority;
-        std::string category;
+    // 延迟事件：分层时间轮（1ms 精度），插入/取消 O(1)，每帧只访问到期的槽
+    static constexpr size_t DELAYED_EXECUTOR_CAPACITY = 96;
+    using DelayedExecutor = InlineFunction<void(), DELAYED_EXECUTOR_CAPACITY>;
+    TimingWheel<DelayedExecutor> delayed_events_;
+
+    // 并行批次中工作线程处理器发起的操作，批次结束后在调用线程执行
+    std::mutex deferred_mutex_;
+    std::vector<DelayedExecutor> deferred_operations_;
+    inline static thread_local const EventManager* parallel_dispatch_owner_ = nullptr;
+
+    // 帧事件存储：按事件类型索引保存
+    std::vector<std::unique_ptr<FrameEventStorageBase>> frame_event_storages_;
+
+    // 实体事件的元数据组件，用于按存活帧数清理
+    struct EventMetadataComponent {
+        using is_event_component = void;
+        EventMetadata metadata;
+        uint32_t creation_frame;
     };
-    std::vector<DelayedEvent> delayed_events_;
 
     // 临时标记管理
     struct TemporaryMarker {
@@ -345,8 +603,8 @@ private:
     mutable size_t peak_memory_usage_ = 0;
     
     // === 内存使用跟踪 (新增) ===
+    // 按类型的内存用量记录在 statistics_.events_by_type 中
     mutable size_t total_allocated_memory_ = 0;
-    mutable std::unordered_map<std::string, size_t> memory_usage_by_type_;
     
     // === 清理管理 (新增) ===
     float last_cleanup_time_ = 0.0f;
@@ -354,52 +612,148 @@ private:
 
     // 内部辅助方法
     void update_delayed_events(float delta_time);
+    void expire_frame_events();
+    using DispatchClock = std::chrono::steady_clock;
+    void dispatch_queued_events();
+    void dispatch_queued_events_parallel(DispatchClock::time_point deadline);
+    size_t dispatch_lane_queue(size_t lane_index, uint32_t type_index, DispatchClock::time_point deadline);
+    size_t dispatch_queue_until(TypedEventQueueBase& queue, bool limited, DispatchClock::time_point deadline,
+                                bool& started_batch);
+    void dispatch_queue_in_worker(size_t lane_index, uint32_t type_index);
+    void run_deferred_operations();
+
+    /**
+     * 当前线程是否正在执行本管理器的并行分发任务
+     */
+    bool in_parallel_dispatch() const { return parallel_dispatch_owner_ == this; }
+    void defer_operation(DelayedExecutor operation);
     void update_temporary_markers();
     void log_event_if_debug(const std::string& event_type, const std::string& action);
     
     // === 新增内部方法 ===
     void update_performance_metrics() const;
-    void track_memory_allocation(const std::string& type, size_t bytes) const;
-    void track_memory_deallocation(const std::string& type, size_t bytes) const;
+    template<typename TEvent>
+    void track_memory_allocation(size_t bytes) const;
+    template<typename TEvent>
+    void track_memory_deallocation(size_t bytes) const;
     void schedule_cleanup_if_needed(float current_time);
+
+    template<typename TEvent>
+    TypedEventQueue<TEvent>& assure_event_queue(EventPriority priority = EventPriority::NORMAL);
+    void declare_event_handler(uint32_t type_index, const EventHandlerDeclaration& declaration);
+    template<typename TEvent>
+    TypedEventQueue<TEvent>* find_event_queue(size_t lane_index) const;
+
+    // === 统计记录：按编译期级别展开，关闭时为空函数 ===
+
+    /**
+     * 记录 count 个 TEvent 事件：累加 counter、按类型计数与分类统计
+     */
+    template<typename TEvent>
+    void record_events(uint32_t& counter, uint32_t count, const EventMetadata& metadata);
+    template<typename TEvent>
+    EventTypeStatistics& assure_type_statistics() const;
+
+    static void add_statistic(uint32_t& counter, uint32_t amount = 1) {
+        if constexpr (EventInstrumentation::counters) {
+            counter += amount;
+        }
+    }
+
+    static void remove_statistic(uint32_t& counter, uint32_t amount = 1) {
+        if constexpr (EventInstrumentation::counters) {
+            counter -= amount < counter ? amount : counter;
+        }
+    }
 };
 
 // === 模板实现 ===
 
 template<typename TEvent>
 void EventManager::publish_immediate(const TEvent& event, const EventMetadata& metadata) {
+    if (in_parallel_dispatch()) {
+        defer_operation(DelayedExecutor([this, event, metadata]() { publish_immediate(event, metadata); }));
+        return;
+    }
     if (debug_mode_) {
         log_event_if_debug(typeid(TEvent).name(), "publish_immediate");
     }
-    
-    dispatcher_.trigger(event);
-    ++statistics_.immediate_events_count;
-    ++statistics_.events_by_category[metadata.category];
+    record_to_log(EventLogRecordKind::IMMEDIATE, &event, 1, metadata.priority);
+
+    {
+        RecordingSuppression suppress(recording_suppressed_);
+        dispatcher_.trigger(event);
+    }
+    record_events<TEvent>(statistics_.immediate_events_count, 1, metadata);
 }
 
 template<typename TEvent>
-void EventManager::enqueue(const TEvent& event, const EventMetadata& metadata) {
+QueuedEventHandle EventManager::enqueue(const TEvent& event, const EventMetadata& metadata) {
+    if (in_parallel_dispatch()) {
+        defer_operation(DelayedExecutor([this, event, metadata]() { enqueue(event, metadata); }));
+        return QueuedEventHandle{};
+    }
     if (debug_mode_) {
         log_event_if_debug(typeid(TEvent).name(), "enqueue");
     }
+    record_to_log(EventLogRecordKind::QUEUED, &event, 1, metadata.priority, metadata.delay);
 
     if (metadata.delay > 0.0f) {
-        schedule_event(event, metadata.delay, EventHandlingStrategy::QUEUED);
+        // 到期后沿用原元数据（优先级、分类等）入队，只清除延迟
+        EventMetadata delayed_metadata = metadata;
+        delayed_metadata.delay = 0.0f;
+        delayed_events_.schedule(metadata.delay, DelayedExecutor([this, event, delayed_metadata = std::move(delayed_metadata)]() {
+            enqueue(event, delayed_metadata);
+        }));
+        return QueuedEventHandle{};
+    }
+
+    auto& queue = assure_event_queue<TEvent>(metadata.priority);
+    const size_t previous_size = queue.size();
+    const QueuedEventHandle handle = queue.push(event);
+    if (queue.size() == previous_size) {
+        record_events<TEvent>(statistics_.coalesced_events_count, 1, metadata);
     } else {
-        dispatcher_.enqueue(event);
-        ++statistics_.queued_events_count;
-        ++statistics_.events_by_category[metadata.category];
+        record_events<TEvent>(statistics_.queued_events_count, 1, metadata);
     }
+    return handle;
 }
 
 template<typename TEvent>
 auto EventManager::subscribe() -> decltype(auto) {
+    declare_event_handler(event_queue_type_index<TEvent>(), EventHandlerDeclaration{});
+    return dispatcher_.sink<TEvent>();
+}
+
+template<typename TEvent>
+auto EventManager::subscribe(const EventHandlerDeclaration& declaration) -> decltype(auto) {
+    declare_event_handler(event_queue_type_index<TEvent>(), declaration);
     return dispatcher_.sink<TEvent>();
 }
 
+template<typename TEvent>
+auto EventManager::subscribe_batch() -> decltype(auto) {
+    // 批量处理器与 TEvent 处理器在同一任务中分发，声明计入 TEvent
+    declare_event_handler(event_queue_type_index<TEvent>(), EventHandlerDeclaration{});
+    return dispatcher_.sink<EventSpan<TEvent>>();
+}
+
+template<typename TEvent>
+auto EventManager::subscribe_batch(const EventHandlerDeclaration& declaration) -> decltype(auto) {
+    declare_event_handler(event_queue_type_index<TEvent>(), declaration);
+    return dispatcher_.sink<EventSpan<TEvent>>();
+}
+
 template<typename TEventComponent, typename>
 entt::entity EventManager::create_entity_event(TEventComponent&& event_component, 
                                               const EventMetadata& metadata) {
+    if (in_parallel_dispatch()) {
+        defer_operation(DelayedExecutor([this, component = std::decay_t<TEventComponent>(std::forward<TEventComponent>(event_component)),
+                                         metadata]() mutable {
+            create_entity_event(std::move(component), metadata);
+        }));
+        return entt::null;
+    }
     if (debug_mode_) {
         log_event_if_debug(typeid(TEventComponent).name(), "create_entity_event");
     }
@@ -421,25 +775,58 @@ entt::entity EventManager::create_entity_event(TEventComponent&& event_component
     }
     
     // 添加元数据组件
-    struct EventMetadataComponent {
-        using is_event_component = void;
-        EventMetadata metadata;
-        uint32_t creation_frame;
-    };
-    
     registry_.emplace<EventMetadataComponent>(event_entity, 
         EventMetadataComponent{metadata, current_frame_});
 
-    ++statistics_.entity_events_count;
-    ++statistics_.events_by_category[metadata.category];
+    record_events<TEventComponent>(statistics_.entity_events_count, 1, metadata);
     
     return event_entity;
 }
 
+template<typename TEvent>
+void EventManager::emit_frame_event(const TEvent& event, entt::entity target,
+                                    uint32_t lifetime_frames, const EventMetadata& metadata) {
+    if (in_parallel_dispatch()) {
+        defer_operation(DelayedExecutor([this, event, target, lifetime_frames, metadata]() {
+            emit_frame_event(event, target, lifetime_frames, metadata);
+        }));
+        return;
+    }
+
+    const uint32_t index = event_queue_type_index<TEvent>();
+    if (index >= frame_event_storages_.size()) {
+        frame_event_storages_.resize(index + 1);
+    }
+    if (!frame_event_storages_[index]) {
+        frame_event_storages_[index] = std::make_unique<FrameEventStorage<TEvent>>();
+    }
+    static_cast<FrameEventStorage<TEvent>&>(*frame_event_storages_[index])
+        .push(event, target, current_frame_, lifetime_frames);
+
+    record_events<TEvent>(statistics_.frame_events_count, 1, metadata);
+}
+
+template<typename TEvent>
+FrameEventView<TEvent> EventManager::view_frame_events() const {
+    const uint32_t index = event_queue_type_index<TEvent>();
+    if (index >= frame_event_storages_.size() || !frame_event_storages_[index]) {
+        return FrameEventView<TEvent>();
+    }
+    return FrameEventView<TEvent>(static_cast<const FrameEventStorage<TEvent>*>(frame_event_storages_[index].get()));
+}
+
 template<typename TEventComponent, typename>
 void EventManager::add_component_event(entt::entity target_entity, 
                                       TEventComponent&& event_component,
                                       const EventMetadata& metadata) {
+    if (in_parallel_dispatch()) {
+        defer_operation(DelayedExecutor([this, target_entity,
+                                         component = std::decay_t<TEventComponent>(std::forward<TEventComponent>(event_component)),
+                                         metadata]() mutable {
+            add_component_event(target_entity, std::move(component), metadata);
+        }));
+        return;
+    }
     if (debug_mode_) {
         log_event_if_debug(typeid(TEventComponent).name(), "add_component_event");
     }
@@ -455,14 +842,21 @@ void EventManager::add_component_event(entt::entity target_entity,
             std::forward<TEventComponent>(event_component));
     }
     
-    ++statistics_.entity_events_count;
-    ++statistics_.events_by_category[metadata.category];
+    record_events<TEventComponent>(statistics_.entity_events_count, 1, metadata);
 }
 
 template<typename TEventComponent, typename>
 void EventManager::add_temporary_marker(entt::entity target_entity,
                                        TEventComponent&& event_component,
                                        uint32_t lifetime_frames) {
+    if (in_parallel_dispatch()) {
+        defer_operation(DelayedExecutor([this, target_entity,
+                                         component = std::decay_t<TEventComponent>(std::forward<TEventComponent>(event_component)),
+                                         lifetime_frames]() mutable {
+            add_temporary_marker(target_entity, std::move(component), lifetime_frames);
+        }));
+        return;
+    }
     if (debug_mode_) {
         log_event_if_debug(typeid(TEventComponent).name(), "add_temporary_marker");
     }
@@ -486,7 +880,7 @@ void EventManager::add_temporary_marker(entt::entity target_entity,
         lifetime_frames
     });
 
-    ++statistics_.temporary_markers_count;
+    add_statistic(statistics_.temporary_markers_count);
 }
 
 template<typename TEvent>
@@ -513,57 +907,225 @@ bool EventManager::enqueue_concurrent(const TEvent& event) {
 }
 
 template<typename TEvent>
-void EventManager::schedule_event(const TEvent& event, float delay_seconds, 
-                                 EventHandlingStrategy strategy) {
+EventManager::DelayedEventHandle EventManager::schedule_event(const TEvent& event, float delay_seconds, 
+                                                              EventHandlingStrategy strategy) {
+    if (in_parallel_dispatch()) {
+        defer_operation(DelayedExecutor([this, event, delay_seconds, strategy]() {
+            schedule_event(event, delay_seconds, strategy);
+        }));
+        return DelayedEventHandle{};
+    }
     if (debug_mode_) {
         log_event_if_debug(typeid(TEvent).name(), "schedule_event");
     }
-
-    DelayedEvent delayed;
-    delayed.remaining_time = delay_seconds;
-    delayed.priority = EventPriority::NORMAL;
-    delayed.category = "scheduled";
+    record_to_log(strategy == EventHandlingStrategy::IMMEDIATE ? EventLogRecordKind::IMMEDIATE : EventLogRecordKind::QUEUED,
+                  &event, 1, EventPriority::NORMAL, delay_seconds);
 
     switch (strategy) {
         case EventHandlingStrategy::IMMEDIATE:
-            delayed.executor = [this, event]() { publish_immediate(event); };
-            break;
+            return delayed_events_.schedule(delay_seconds, DelayedExecutor([this, event]() { publish_immediate(event); }));
         case EventHandlingStrategy::QUEUED:
-            delayed.executor = [this, event]() { enqueue(event); };
-            break;
         default:
-            delayed.executor = [this, event]() { enqueue(event); };
-            break;
+            return delayed_events_.schedule(delay_seconds, DelayedExecutor([this, event]() { enqueue(event); }));
     }
-
-    delayed_events_.push_back(std::move(delayed));
 }
 
 template<typename TEvent>
-void EventManager::publish_batch(const std::vector<TEvent>& events, 
-                                EventHandlingStrategy strategy) {
-    for (const auto& event : events) {
-        switch (strategy) {
-            case EventHandlingStrategy::IMMEDIATE:
-                publish_immediate(event);
-                break;
-            case EventHandlingStrategy::QUEUED:
-                enqueue(event);
-                break;
-            default:
-                enqueue(event);
-                break;
+void EventManager::publish_batch(EventSpan<TEvent> events,
+                                EventHandlingStrategy strategy,
+                                const EventMetadata& metadata) {
+    if (events.empty()) {
+        return;
+    }
+    if (in_parallel_dispatch()) {
+        // 视图只在调用期间有效，延后执行时拷贝一份
+        defer_operation(DelayedExecutor([this, copy = std::vector<TEvent>(events.begin(), events.end()), strategy, metadata]() {
+            publish_batch(EventSpan<TEvent>(copy), strategy, metadata);
+        }));
+        return;
+    }
+    if (debug_mode_) {
+        log_event_if_debug(typeid(TEvent).name(), "publish_batch (" + std::to_string(events.size()) + ")");
+    }
+    // 整批记录为一条，延迟路径中逐个 enqueue 与即时处理器中发布的事件不再录制
+    if (strategy == EventHandlingStrategy::IMMEDIATE) {
+        record_to_log(EventLogRecordKind::BATCH_IMMEDIATE, events.data, events.size(), metadata.priority);
+    } else {
+        record_to_log(EventLogRecordKind::BATCH_QUEUED, events.data, events.size(), metadata.priority, metadata.delay);
+    }
+    RecordingSuppression suppress(recording_suppressed_);
+
+    if (strategy == EventHandlingStrategy::IMMEDIATE) {
+        if (!dispatcher_.sink<TEvent>().empty()) {
+            for (const TEvent& event : events) {
+                dispatcher_.trigger(event);
+            }
+        }
+        dispatcher_.trigger(events);
+        record_events<TEvent>(statistics_.immediate_events_count, static_cast<uint32_t>(events.size()), metadata);
+    } else if (metadata.delay > 0.0f) {
+        for (const TEvent& event : events) {
+            enqueue(event, metadata);
         }
+        return;
+    } else {
+        auto& queue = assure_event_queue<TEvent>(metadata.priority);
+        const size_t previous_size = queue.size();
+        queue.push_batch(events);
+        const size_t added = queue.size() - previous_size;
+        record_events<TEvent>(statistics_.queued_events_count, static_cast<uint32_t>(added), metadata);
+        record_events<TEvent>(statistics_.coalesced_events_count, static_cast<uint32_t>(events.size() - added), metadata);
     }
 }
 
 template<typename TEvent>
-void EventManager::cancel_queued_events() {
-    // EnTT dispatcher 没有直接的取消接口，这里可以实现自定义逻辑
-    // 或者通过标记方式在处理时跳过
+size_t EventManager::cancel_queued_events() {
+    return cancel_queued_events_if<TEvent>([](const TEvent&) { return true; });
+}
+
+template<typename TEvent, typename Predicate>
+size_t EventManager::cancel_queued_events_if(Predicate&& predicate) {
+    if (in_parallel_dispatch()) {
+        defer_operation(DelayedExecutor([this, predicate = std::forward<Predicate>(predicate)]() mutable {
+            cancel_queued_events_if<TEvent>(predicate);
+        }));
+        return 0;
+    }
     if (debug_mode_) {
         log_event_if_debug(typeid(TEvent).name(), "cancel_queued_events");
     }
+
+    size_t cancelled = 0;
+    for (size_t lane_index = 0; lane_index < EVENT_PRIORITY_COUNT; ++lane_index) {
+        if (auto* queue = find_event_queue<TEvent>(lane_index)) {
+            cancelled += queue->cancel_if(predicate);
+        }
+    }
+    add_statistic(statistics_.cancelled_events_count, static_cast<uint32_t>(cancelled));
+    return cancelled;
+}
+
+template<typename TEvent>
+void EventManager::set_event_coalescing(typename TypedEventQueue<TEvent>::KeyFunction key_function,
+                                        typename TypedEventQueue<TEvent>::MergeFunction merge_function) {
+    const uint32_t index = event_queue_type_index<TEvent>();
+    if (index >= queue_initializers_.size()) {
+        queue_initializers_.resize(index + 1);
+    }
+    if (key_function) {
+        queue_initializers_[index] = [key_function, merge_function](TypedEventQueueBase& queue) {
+            static_cast<TypedEventQueue<TEvent>&>(queue).set_coalescing(key_function, merge_function);
+        };
+    } else {
+        queue_initializers_[index] = nullptr;
+    }
+    for (size_t lane_index = 0; lane_index < EVENT_PRIORITY_COUNT; ++lane_index) {
+        if (auto* queue = find_event_queue<TEvent>(lane_index)) {
+            queue->set_coalescing(key_function, merge_function);
+        }
+    }
+}
+
+template<typename TEvent>
+size_t EventManager::get_queued_event_count() const {
+    size_t count = 0;
+    for (size_t lane_index = 0; lane_index < EVENT_PRIORITY_COUNT; ++lane_index) {
+        if (const auto* queue = find_event_queue<TEvent>(lane_index)) {
+            count += queue->size();
+        }
+    }
+    return count;
+}
+
+template<typename TEvent>
+TypedEventQueue<TEvent>& EventManager::assure_event_queue(EventPriority priority) {
+    const uint32_t index = event_queue_type_index<TEvent>();
+    const auto lane_index = static_cast<uint8_t>(priority);
+    QueuedEventLane& lane = queued_lanes_[lane_index];
+    if (index >= lane.queues.size()) {
+        lane.queues.resize(index + 1);
+        lane.deferred_frames.resize(index + 1, 0);
+    }
+    if (!lane.queues[index]) {
+        lane.queues[index] = std::make_unique<TypedEventQueue<TEvent>>(index, lane_index);
+        lane.order.push_back(index);
+        if (index < queue_initializers_.size() && queue_initializers_[index]) {
+            queue_initializers_[index](*lane.queues[index]);
+        }
+        // 预先创建 dispatcher 中的处理器表，并行分发时 trigger 只做查找
+        dispatcher_.sink<TEvent>();
+        dispatcher_.sink<EventSpan<TEvent>>();
+    }
+    return static_cast<TypedEventQueue<TEvent>&>(*lane.queues[index]);
+}
+
+template<typename TEvent>
+TypedEventQueue<TEvent>* EventManager::find_event_queue(size_t lane_index) const {
+    const uint32_t index = event_queue_type_index<TEvent>();
+    const QueuedEventLane& lane = queued_lanes_[lane_index];
+    if (index >= lane.queues.size() || !lane.queues[index]) {
+        return nullptr;
+    }
+    return static_cast<TypedEventQueue<TEvent>*>(lane.queues[index].get());
+}
+
+template<typename TEvent>
+void EventManager::record_events(uint32_t& counter, uint32_t count, const EventMetadata& metadata) {
+    if constexpr (EventInstrumentation::counters) {
+        if (count == 0) {
+            return;
+        }
+        counter += count;
+        EventTypeStatistics& type_statistics = assure_type_statistics<TEvent>();
+        type_statistics.events_count += count;
+
+        // 分类统计需要按字符串查找，SAMPLED 级别每 sample_interval 次记录一次并按比例累加
+        if constexpr (EventInstrumentation::sample_interval > 1) {
+            if (++type_statistics.sample_tick % EventInstrumentation::sample_interval != 0) {
+                return;
+            }
+        }
+        statistics_.events_by_category[metadata.category] += count * EventInstrumentation::sample_interval;
+    } else {
+        (void)counter;
+        (void)count;
+        (void)metadata;
+    }
+}
+
+template<typename TEvent>
+EventTypeStatistics& EventManager::assure_type_statistics() const {
+    const uint32_t index = event_queue_type_index<TEvent>();
+    auto& by_type = statistics_.events_by_type;
+    if (index >= by_type.size()) {
+        by_type.resize(index + 1);
+    }
+    EventTypeStatistics& type_statistics = by_type[index];
+    if (!type_statistics.type_name) {
+        type_statistics.type_name = typeid(TEvent).name();
+    }
+    return type_statistics;
+}
+
+template<typename TEvent>
+void EventManager::track_memory_allocation(size_t bytes) const {
+    if constexpr (EventInstrumentation::memory_tracking) {
+        total_allocated_memory_ += bytes;
+        assure_type_statistics<TEvent>().memory_bytes += bytes;
+    } else {
+        (void)bytes;
+    }
+}
+
+template<typename TEvent>
+void EventManager::track_memory_deallocation(size_t bytes) const {
+    if constexpr (EventInstrumentation::memory_tracking) {
+        total_allocated_memory_ -= std::min(bytes, total_allocated_memory_);
+        size_t& type_bytes = assure_type_statistics<TEvent>().memory_bytes;
+        type_bytes -= std::min(bytes, type_bytes);
+    } else {
+        (void)bytes;
+    }
 }
 
 } // namespace portal_core
@@ -8,10 +8,29 @@
 #include <type_traits>
 #include <functional>
 #include <unordered_set>
+#include <unordered_map>
+#include <string>
+#include <typeinfo>
 #include <algorithm>
+#include <deque>
+#include <thread>
+#include <cstdint>
+#include <iostream>
 
 namespace portal_core {
 
+/**
+ * 对象池统计信息（与元素类型无关，便于 EventPoolManager 汇总）
+ */
+struct EventPoolStatistics {
+    size_t created_count = 0;    // 创建的对象总数（历史累计，只增不减）
+    size_t reused_count = 0;     // 重用的对象总数
+    size_t active_count = 0;     // 当前被借出的对象数
+    size_t available_count = 0;  // 当前可用对象数（共享池 + 各线程缓存）
+    size_t total_objects = 0;    // 池中对象总数（active + available）
+    float reuse_ratio = 0.0f;    // 重用率
+};
+
 /**
  * 模板化对象池 - 用于高效管理事件对象的内存分配
  * 
@@ -21,6 +40,15 @@ namespace portal_core {
  * - all_objects_ 拥有所有对象的唯一所有权
  * - available_ 只存储裸指针作为可借用对象的索引
  * - 使用 RAII 自动管理对象归还
+ * 
+ * 线程缓存：
+ * - 每个线程持有本池的一个小型空闲列表，acquire/release 优先在其中完成，不需要加锁
+ * - 线程缓存为空时从共享池批量补充，超过上限时批量归还共享池，只有这两步需要加锁
+ * - 线程退出时缓存中的对象归还共享池
+ * - clear() 使所有线程缓存失效（按代数惰性丢弃），不能与 acquire/release 并发调用
+ * 
+ * 调试构建（未定义 NDEBUG）记录借出中的对象，归还时加锁校验，
+ * 忽略不属于本池或已归还过的指针；发布构建不做校验，保持归还路径无锁
  */
 template<typename T>
 class EventPool {
@@ -29,15 +57,29 @@ public:
     
     // 定义智能指针类型
     using unique_obj_ptr = std::unique_ptr<T, std::function<void(T*)>>;
+    using PoolStatistics = EventPoolStatistics;
+    
+    // 每个线程缓存的对象上限，以及与共享池之间每次搬运的数量
+    static constexpr size_t LOCAL_CACHE_CAPACITY = 64;
+    static constexpr size_t LOCAL_TRANSFER_BATCH = 32;
     
     EventPool(size_t initial_capacity = 0, size_t max_capacity = 1024)
-        : max_capacity_(max_capacity) {
+        : max_capacity_(max_capacity), id_(next_pool_id()) {
+        {
+            std::lock_guard<std::mutex> lock(live_pools_mutex());
+            live_pools()[id_] = this;
+        }
         if (initial_capacity > 0) {
             reserve(initial_capacity);
         }
     }
     
     ~EventPool() {
+        {
+            // 之后退出的线程不再把缓存归还给本池
+            std::lock_guard<std::mutex> lock(live_pools_mutex());
+            live_pools().erase(id_);
+        }
         clear();
     }
     
@@ -53,29 +95,26 @@ public:
      */
     template<typename... Args>
     unique_obj_ptr acquire(Args&&... args) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        LocalCache* cache = get_local_cache();
+        const uint64_t generation = generation_.load(std::memory_order_acquire);
+        sync_generation(cache, generation);
 
         T* obj = nullptr;
         
-        if (!available_.empty()) {
-            // 从池中重用对象
-            obj = available_.back();
-            available_.pop_back();
-            ++stats_.reused_count;
+        if (!cache->objects.empty() || refill(cache)) {
+            // 从线程缓存中重用对象（无锁）
+            obj = cache->objects.back();
+            cache->objects.pop_back();
+            bump(cache->reused);
         } else {
             // 需要创建新对象
-            if (all_objects_.size() >= max_capacity_) {
+            obj = create_object();
+            if (!obj) {
                 // 已达到最大容量，返回空指针
                 return nullptr;
             }
-            
-            // 创建新对象并获取所有权
-            auto new_obj = std::make_unique<T>();
-            obj = new_obj.get();
-            owned_pointers_.insert(obj);  // O(1) 插入到指针集合
-            all_objects_.push_back(std::move(new_obj));
-            ++stats_.created_count;
         }
+        cache->cached.store(cache->objects.size(), std::memory_order_relaxed);
 
         // 使用完美转发重新初始化对象
         if constexpr (sizeof...(args) > 0) {
@@ -85,10 +124,17 @@ public:
             *obj = T{};
         }
 
-        ++stats_.active_count;
+        bump(cache->acquired);
 
-        // 返回带自定义删除器的智能指针
-        return unique_obj_ptr(obj, [this](T* ptr) { this->release(ptr); });
+#ifndef NDEBUG
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lent_pointers_.insert(obj);
+        }
+#endif
+
+        // 返回带自定义删除器的智能指针，记录借出时的代数以识别 clear() 之后的归还
+        return unique_obj_ptr(obj, [this, generation](T* ptr) { this->release(ptr, generation); });
     }
     
     /**
@@ -109,7 +155,6 @@ public:
         for (size_t i = 0; i < can_create; ++i) {
             auto new_obj = std::make_unique<T>();
             T* obj_ptr = new_obj.get();
-            owned_pointers_.insert(obj_ptr);  // O(1) 插入到指针集合
             all_objects_.push_back(std::move(new_obj));
             available_.push_back(obj_ptr);
             ++stats_.created_count;
@@ -118,43 +163,50 @@ public:
     
     /**
      * 清空池中所有对象
+     * 线程缓存中的指针随代数递增失效，由各线程在下次访问时丢弃
      */
     void clear() {
         std::lock_guard<std::mutex> lock(mutex_);
         
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        
         // 清空所有容器 - unique_ptr 会自动释放内存
         all_objects_.clear();
         available_.clear();
-        owned_pointers_.clear();  // 清空指针集合
+#ifndef NDEBUG
+        lent_pointers_.clear();
+#endif
         
-        // 重置统计信息
+        // 重置统计信息：线程缓存的计数器只由所属线程写入，这里记录基线而不是清零
         stats_.created_count = 0;
-        stats_.reused_count = 0;
-        stats_.active_count = 0;
+        baseline_ = collect_counters();
     }
     
     /**
      * 获取池的统计信息
      */
-    struct PoolStatistics {
-        size_t created_count = 0;    // 创建的对象总数（历史累计，只增不减）
-        size_t reused_count = 0;     // 重用的对象总数
-        size_t active_count = 0;     // 当前被借出的对象数
-        size_t available_count = 0;  // 当前可用对象数
-        size_t total_objects = 0;    // 池中对象总数（active + available）
-        float reuse_ratio = 0.0f;    // 重用率
-    };
-    
     PoolStatistics get_statistics() const {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        PoolStatistics result = stats_;
+        // 惰性汇总各线程缓存的计数器
+        const Counters counters = collect_counters();
+        const uint64_t generation = generation_.load(std::memory_order_relaxed);
+        
+        PoolStatistics result;
+        result.created_count = stats_.created_count;
+        result.reused_count = counters.reused - baseline_.reused;
+        result.active_count = (counters.acquired - baseline_.acquired) - (counters.released - baseline_.released);
         result.available_count = available_.size();
+        for (const auto& cache : caches_) {
+            if (cache->generation.load(std::memory_order_relaxed) == generation) {
+                result.available_count += cache->cached.load(std::memory_order_relaxed);
+            }
+        }
         result.total_objects = all_objects_.size();
         
-        size_t total_acquisitions = stats_.created_count + stats_.reused_count;
+        size_t total_acquisitions = result.created_count + result.reused_count;
         if (total_acquisitions > 0) {
-            result.reuse_ratio = static_cast<float>(stats_.reused_count) / total_acquisitions;
+            result.reuse_ratio = static_cast<float>(result.reused_count) / total_acquisitions;
         }
         
         return result;
@@ -163,6 +215,7 @@ public:
     /**
      * 收缩池大小，释放多余的对象
      * 优化版本：使用批量删除，避免 O(N*M) 复杂度
+     * 只收缩共享池，线程缓存中的对象不受影响
      */
     void shrink_to_fit(size_t target_available = 32) {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -187,18 +240,50 @@ public:
             });
         all_objects_.erase(new_end, all_objects_.end());
 
-        // 3. 从 owned_pointers_ 中清理待删除的指针
-        for (T* ptr : pointers_to_remove) {
-            owned_pointers_.erase(ptr);
-        }
-
-        // 4. 调整 available_ 大小
+        // 3. 调整 available_ 大小
         available_.resize(target_available);
         
         // 注意：created_count 保持不变（历史累计）
     }
 
 private:
+    /**
+     * 线程缓存：objects 只由所属线程访问；计数器由所属线程写入、统计时由其他线程读取
+     */
+    struct LocalCache {
+        std::vector<T*> objects;
+        std::atomic<uint64_t> generation{0};
+        std::atomic<size_t> acquired{0};
+        std::atomic<size_t> reused{0};
+        std::atomic<size_t> released{0};
+        std::atomic<size_t> cached{0};   // objects.size() 的副本，供统计读取
+    };
+    
+    struct Counters {
+        size_t acquired = 0;
+        size_t reused = 0;
+        size_t released = 0;
+    };
+    
+    /**
+     * 每个线程持有的 (池 id, 缓存) 表，线程退出时把缓存归还给仍然存活的池
+     */
+    struct ThreadCacheTable {
+        uint64_t last_id = 0;
+        LocalCache* last_cache = nullptr;
+        std::vector<std::pair<uint64_t, LocalCache*>> entries;
+        
+        ~ThreadCacheTable() {
+            std::lock_guard<std::mutex> lock(live_pools_mutex());
+            for (const auto& entry : entries) {
+                auto it = live_pools().find(entry.first);
+                if (it != live_pools().end()) {
+                    it->second->retire_cache(entry.second);
+                }
+            }
+        }
+    };
+    
     mutable std::mutex mutex_;
     
     // 所有对象的唯一所有者
@@ -207,38 +292,191 @@ private:
     // 可借用对象的索引（裸指针，不拥有所有权）
     std::vector<T*> available_;
     
-    // O(1) 指针合法性检查用的集合
-    std::unordered_set<T*> owned_pointers_;
+#ifndef NDEBUG
+    // 借出中的对象，调试构建中用于校验归还的指针
+    std::unordered_set<T*> lent_pointers_;
+#endif
     
     size_t max_capacity_;
     PoolStatistics stats_;
     
+    // 各线程缓存（由 mutex_ 保护列表本身），以及已退出线程留下的计数
+    std::vector<std::unique_ptr<LocalCache>> caches_;
+    Counters retired_;
+    Counters baseline_;
+    
+    uint64_t id_;
+    std::atomic<uint64_t> generation_{0};
+    
     /**
      * 释放对象回池中
-     * 优化版本：使用 O(1) 指针合法性检查
+     * 借出后池被 clear() 过的对象已被销毁，按代数识别并忽略
      */
-    void release(T* obj) {
+    void release(T* obj, uint64_t generation) {
         if (!obj) return;
         
+        if (generation != generation_.load(std::memory_order_acquire)) {
+            return;
+        }
+        
+#ifndef NDEBUG
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (lent_pointers_.erase(obj) == 0) {
+                std::cerr << "EventPool: Ignoring release of a pointer that is not lent out by this pool" << std::endl;
+                return;
+            }
+        }
+#endif
+        
+        // 重置对象到默认状态
+        *obj = T{};
+        
+        // 放回线程缓存（无锁），超过上限时批量归还共享池
+        LocalCache* cache = get_local_cache();
+        sync_generation(cache, generation);
+        cache->objects.push_back(obj);
+        bump(cache->released);
+        if (cache->objects.size() > LOCAL_CACHE_CAPACITY) {
+            drain(cache);
+        }
+        cache->cached.store(cache->objects.size(), std::memory_order_relaxed);
+    }
+    
+    /**
+     * 从共享池批量补充线程缓存
+     * @return false 共享池也为空
+     */
+    bool refill(LocalCache* cache) {
         std::lock_guard<std::mutex> lock(mutex_);
+        const size_t count = std::min(LOCAL_TRANSFER_BATCH, available_.size());
+        cache->objects.insert(cache->objects.end(), available_.end() - count, available_.end());
+        available_.resize(available_.size() - count);
+        return count > 0;
+    }
+    
+    /**
+     * 把线程缓存中较早放入的对象归还共享池，保留 LOCAL_TRANSFER_BATCH 个
+     */
+    void drain(LocalCache* cache) {
+        const size_t count = cache->objects.size() - LOCAL_TRANSFER_BATCH;
+        std::lock_guard<std::mutex> lock(mutex_);
+        available_.insert(available_.end(), cache->objects.begin(), cache->objects.begin() + count);
+        cache->objects.erase(cache->objects.begin(), cache->objects.begin() + count);
+    }
+    
+    T* create_object() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (all_objects_.size() >= max_capacity_) {
+            return nullptr;
+        }
         
-        // 使用 O(1) 平均复杂度的查找，而非 O(N) 线性搜索
-        if (owned_pointers_.count(obj) > 0) {
-            // 重置对象到默认状态
-            *obj = T{};
+        // 创建新对象并获取所有权
+        auto new_obj = std::make_unique<T>();
+        T* obj = new_obj.get();
+        all_objects_.push_back(std::move(new_obj));
+        ++stats_.created_count;
+        return obj;
+    }
+    
+    /**
+     * clear() 之后首次访问时丢弃缓存中已被销毁的对象指针
+     */
+    static void sync_generation(LocalCache* cache, uint64_t generation) {
+        if (cache->generation.load(std::memory_order_relaxed) != generation) {
+            cache->objects.clear();
+            cache->cached.store(0, std::memory_order_relaxed);
+            cache->generation.store(generation, std::memory_order_relaxed);
+        }
+    }
+    
+    // 计数器只由所属线程写入，不需要原子读-改-写
+    static void bump(std::atomic<size_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    
+    LocalCache* get_local_cache() {
+        thread_local ThreadCacheTable table;
+        if (table.last_id == id_) {
+            return table.last_cache;
+        }
+        
+        LocalCache* cache = nullptr;
+        for (const auto& entry : table.entries) {
+            if (entry.first == id_) {
+                cache = entry.second;
+                break;
+            }
+        }
+        
+        if (!cache) {
+            // 首次在本线程使用该池：注册新缓存，并顺带清理已销毁池的表项
+            {
+                std::lock_guard<std::mutex> lock(live_pools_mutex());
+                auto& pools = live_pools();
+                table.entries.erase(std::remove_if(table.entries.begin(), table.entries.end(),
+                    [&pools](const std::pair<uint64_t, LocalCache*>& entry) {
+                        return pools.count(entry.first) == 0;
+                    }), table.entries.end());
+            }
             
-            // 将对象放回可用池
-            available_.push_back(obj);
-            --stats_.active_count;
+            auto new_cache = std::make_unique<LocalCache>();
+            new_cache->objects.reserve(LOCAL_CACHE_CAPACITY + 1);
+            new_cache->generation.store(generation_.load(std::memory_order_acquire), std::memory_order_relaxed);
+            cache = new_cache.get();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                caches_.push_back(std::move(new_cache));
+            }
+            table.entries.emplace_back(id_, cache);
         }
-        // 如果指针不属于池，则静默忽略
-        // 在Debug模式下可以添加断言或日志
-#ifdef _DEBUG
-        else {
-            // 可选：在调试模式下记录非法指针访问
-            // std::cerr << "Warning: Attempting to release invalid pointer to EventPool" << std::endl;
+        
+        table.last_id = id_;
+        table.last_cache = cache;
+        return cache;
+    }
+    
+    /**
+     * 线程退出：缓存中的对象归还共享池，计数并入 retired_
+     * 调用方持有 live_pools_mutex()，保证本池在此期间不会被析构
+     */
+    void retire_cache(LocalCache* cache) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cache->generation.load(std::memory_order_relaxed) == generation_.load(std::memory_order_relaxed)) {
+            available_.insert(available_.end(), cache->objects.begin(), cache->objects.end());
         }
-#endif
+        retired_.acquired += cache->acquired.load(std::memory_order_relaxed);
+        retired_.reused += cache->reused.load(std::memory_order_relaxed);
+        retired_.released += cache->released.load(std::memory_order_relaxed);
+        caches_.erase(std::remove_if(caches_.begin(), caches_.end(),
+            [cache](const std::unique_ptr<LocalCache>& p) { return p.get() == cache; }), caches_.end());
+    }
+    
+    // 调用方持有 mutex_
+    Counters collect_counters() const {
+        Counters counters = retired_;
+        for (const auto& cache : caches_) {
+            counters.acquired += cache->acquired.load(std::memory_order_relaxed);
+            counters.reused += cache->reused.load(std::memory_order_relaxed);
+            counters.released += cache->released.load(std::memory_order_relaxed);
+        }
+        return counters;
+    }
+    
+    // 存活池的注册表（池 id 永不复用），用于线程退出时判断缓存能否归还
+    static std::mutex& live_pools_mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    
+    static std::unordered_map<uint64_t, EventPool*>& live_pools() {
+        static std::unordered_map<uint64_t, EventPool*> pools;
+        return pools;
+    }
+    
+    static uint64_t next_pool_id() {
+        static std::atomic<uint64_t> next_id{1};
+        return next_id.fetch_add(1, std::memory_order_relaxed);
     }
 };
 
@@ -254,10 +492,13 @@ public:
     
     /**
      * 获取指定类型的对象池
+     * 首次获取时注册到管理器，供全局统计汇总
      */
     template<typename T>
     EventPool<T>& get_pool() {
         static EventPool<T> pool;
+        static const bool registered = register_pool(typeid(T).name(), []() { return pool.get_statistics(); });
+        (void)registered;
         return pool;
     }
     
@@ -288,53 +529,185 @@ public:
         size_t total_pools = 0;
         size_t total_created = 0;
         size_t total_reused = 0;
-        float average_reuse_ratio = 0.0f;
+        size_t total_active = 0;
+        size_t total_available = 0;
+        float average_reuse_ratio = 0.0f;                    // 有借出记录的池的平均重用率
+        std::unordered_map<std::string, size_t> pool_sizes;  // 类型名 -> 池中对象总数
     };
     
-    // 注意：实际实现需要维护池的注册表来支持全局统计
-    // 这里简化处理
+    /**
+     * 汇总所有已注册池的统计信息
+     * 各池的线程缓存计数只在这里按需合并，acquire/release 路径上不维护全局计数
+     */
+    GlobalPoolStatistics get_global_statistics() const {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        
+        GlobalPoolStatistics result;
+        size_t pools_with_acquisitions = 0;
+        for (const auto& entry : pools_) {
+            const EventPoolStatistics stats = entry.second();
+            ++result.total_pools;
+            result.total_created += stats.created_count;
+            result.total_reused += stats.reused_count;
+            result.total_active += stats.active_count;
+            result.total_available += stats.available_count;
+            result.pool_sizes[entry.first] = stats.total_objects;
+            if (stats.created_count + stats.reused_count > 0) {
+                result.average_reuse_ratio += stats.reuse_ratio;
+                ++pools_with_acquisitions;
+            }
+        }
+        if (pools_with_acquisitions > 0) {
+            result.average_reuse_ratio /= pools_with_acquisitions;
+        }
+        
+        return result;
+    }
     
 private:
     EventPoolManager() = default;
+    
+    bool register_pool(const char* type_name, std::function<EventPoolStatistics()> collect) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        pools_.emplace_back(type_name, std::move(collect));
+        return true;
+    }
+    
+    mutable std::mutex registry_mutex_;
+    std::vector<std::pair<std::string, std::function<EventPoolStatistics()>>> pools_;
+};
+
+/**
+ * 队列写满时的处理策略
+ */
+enum class QueueFullPolicy {
+    Drop,      // 直接返回 false，事件被丢弃并计入统计
+    Spin,      // 自旋等待消费者腾出空间（生产者可能被阻塞）
+    Overflow   // 写入加锁的溢出链表，保证不丢事件，消费者在环形缓冲取空后再取溢出部分
 };
 
 /**
  * 无锁事件队列 - 用于多线程环境下的事件处理
  * 
- * 使用无锁队列避免线程同步开销，特别适用于高频事件场景
+ * 有界多生产者多消费者 (MPMC) 环形缓冲，采用 Vyukov 的每槽位序号算法：
+ * - 每个槽位带一个序号，生产者只有在 sequence == pos 时才能写入，写完后发布 pos + 1
+ * - 消费者只有在 sequence == pos + 1 时才能读取，读完后发布 pos + 槽位数，交还给下一轮生产者
+ * 因此竞争同一位置的线程不会覆盖或读到写了一半的事件。
+ * 
+ * 批量操作先检查一段连续槽位是否就绪，再用一次 CAS 认领整段位置。
  */
 template<typename T>
 class LockFreeEventQueue {
 public:
-    LockFreeEventQueue(size_t capacity = 4096) : capacity_(capacity) {
-        buffer_ = std::make_unique<Event[]>(capacity_);
+    /**
+     * @param capacity 与旧实现保持一致：实际可用容量是 capacity-1
+     */
+    LockFreeEventQueue(size_t capacity = 4096, QueueFullPolicy policy = QueueFullPolicy::Drop)
+        : slot_count_(capacity > 1 ? capacity - 1 : 1), policy_(policy) {
+        buffer_ = std::make_unique<Slot[]>(slot_count_);
+        for (size_t i = 0; i < slot_count_; ++i) {
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+        }
     }
     
+    LockFreeEventQueue(const LockFreeEventQueue&) = delete;
+    LockFreeEventQueue& operator=(const LockFreeEventQueue&) = delete;
+    
     /**
-     * 非阻塞入队操作
-     * @return true 成功入队，false 队列已满
+     * 入队操作，队列满时按 QueueFullPolicy 处理
+     * @return true 成功入队（含写入溢出链表），false 事件被丢弃
      */
     bool enqueue(const T& event) {
-        size_t write_pos = write_pos_.load(std::memory_order_relaxed);
+        if (ring_accepts_new_events() && try_enqueue(event)) {
+            return true;
+        }
+        return handle_full(&event, 1) == 1;
+    }
+    
+    /**
+     * 非阻塞入队，忽略写满策略
+     * @return true 成功入队，false 环形缓冲已满
+     */
+    bool try_enqueue(const T& event) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
         
         while (true) {
-            const size_t next_write_pos = (write_pos + 1) % capacity_;
+            Slot& slot = buffer_[pos % slot_count_];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
             
-            if (next_write_pos == read_pos_.load(std::memory_order_acquire)) {
-                // 队列已满
+            if (diff == 0) {
+                // 槽位空闲，尝试认领该位置
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.data = event;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // CAS 失败时 pos 已被更新为当前值，继续重试
+            } else if (diff < 0) {
+                // 槽位仍被上一轮的事件占用：队列已满
                 return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    /**
+     * 批量入队，队列满时剩余部分按 QueueFullPolicy 处理
+     * @return 成功入队的数量（Drop 策略下可能小于 count）
+     */
+    size_t enqueue_batch(const T* events, size_t count) {
+        size_t done = 0;
+        if (ring_accepts_new_events()) {
+            done = try_enqueue_batch(events, count);
+        }
+        if (done < count) {
+            done += handle_full(events + done, count - done);
+        }
+        return done;
+    }
+    
+    size_t enqueue_batch(const std::vector<T>& events) {
+        return enqueue_batch(events.data(), events.size());
+    }
+    
+    /**
+     * 非阻塞批量入队，忽略写满策略
+     * @return 写入环形缓冲的数量
+     */
+    size_t try_enqueue_batch(const T* events, size_t count) {
+        size_t done = 0;
+        while (done < count) {
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            
+            // 统计从 pos 开始连续空闲的槽位
+            size_t ready = 0;
+            const size_t wanted = std::min(count - done, slot_count_);
+            while (ready < wanted &&
+                   buffer_[(pos + ready) % slot_count_].sequence.load(std::memory_order_acquire) == pos + ready) {
+                ++ready;
             }
             
-            // 尝试原子性地更新写位置
-            if (write_pos_.compare_exchange_weak(write_pos, next_write_pos, 
-                                               std::memory_order_acq_rel, 
-                                               std::memory_order_relaxed)) {
-                // 成功获取写位置，现在可以安全写入
-                buffer_[write_pos].data = event;
-                return true;
+            if (ready == 0) {
+                if (buffer_[pos % slot_count_].sequence.load(std::memory_order_acquire) < pos) {
+                    break; // 队列已满
+                }
+                continue; // 其他生产者已推进 pos
             }
-            // 如果CAS失败，write_pos已经被更新为当前值，继续重试
+            
+            // 一次 CAS 认领整段位置；成功后这些槽位只属于当前线程
+            if (!enqueue_pos_.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+                continue;
+            }
+            for (size_t i = 0; i < ready; ++i) {
+                Slot& slot = buffer_[(pos + i) % slot_count_];
+                slot.data = events[done + i];
+                slot.sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            done += ready;
         }
+        return done;
     }
     
     /**
@@ -342,26 +715,10 @@ public:
      * @return true 成功出队，false 队列为空
      */
     bool dequeue(T& event) {
-        size_t read_pos = read_pos_.load(std::memory_order_relaxed);
-        
-        while (true) {
-            if (read_pos == write_pos_.load(std::memory_order_acquire)) {
-                // 队列为空
-                return false;
-            }
-            
-            const size_t next_read_pos = (read_pos + 1) % capacity_;
-            
-            // 尝试原子性地更新读位置
-            if (read_pos_.compare_exchange_weak(read_pos, next_read_pos,
-                                              std::memory_order_acq_rel,
-                                              std::memory_order_relaxed)) {
-                // 成功获取读位置，现在可以安全读取
-                event = buffer_[read_pos].data;
-                return true;
-            }
-            // 如果CAS失败，read_pos已经被更新为当前值，继续重试
+        if (try_dequeue_ring(event)) {
+            return true;
         }
+        return overflow_size_.load(std::memory_order_acquire) != 0 && dequeue_overflow(&event, 1, nullptr) == 1;
     }
     
     /**
@@ -374,54 +731,183 @@ public:
         events.clear();
         events.reserve(max_count);
         
-        T event;
-        size_t count = 0;
+        while (events.size() < max_count) {
+            size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            
+            // 统计从 pos 开始连续已写入的槽位
+            size_t ready = 0;
+            const size_t wanted = std::min(max_count - events.size(), slot_count_);
+            while (ready < wanted &&
+                   buffer_[(pos + ready) % slot_count_].sequence.load(std::memory_order_acquire) == pos + ready + 1) {
+                ++ready;
+            }
+            
+            if (ready == 0) {
+                if (buffer_[pos % slot_count_].sequence.load(std::memory_order_acquire) <= pos) {
+                    break; // 环形缓冲为空（或生产者尚未写完）
+                }
+                continue; // 其他消费者已推进 pos
+            }
+            
+            if (!dequeue_pos_.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+                continue;
+            }
+            for (size_t i = 0; i < ready; ++i) {
+                Slot& slot = buffer_[(pos + i) % slot_count_];
+                events.push_back(std::move(slot.data));
+                slot.sequence.store(pos + i + slot_count_, std::memory_order_release);
+            }
+        }
         
-        while (count < max_count && dequeue(event)) {
-            events.push_back(std::move(event));
-            ++count;
+        if (events.size() < max_count && overflow_size_.load(std::memory_order_acquire) != 0) {
+            dequeue_overflow(nullptr, max_count - events.size(), &events);
         }
         
-        return count;
+        return events.size();
     }
     
     /**
-     * 检查队列是否为空
+     * 检查队列是否为空 (近似值)
      */
     bool empty() const {
-        return read_pos_.load(std::memory_order_acquire) == 
-               write_pos_.load(std::memory_order_acquire);
+        return size() == 0;
     }
     
     /**
-     * 获取队列当前大小 (近似值)
+     * 获取队列当前大小 (近似值，含溢出链表)
      */
     size_t size() const {
-        const size_t write_pos = write_pos_.load(std::memory_order_acquire);
-        const size_t read_pos = read_pos_.load(std::memory_order_acquire);
-        
-        if (write_pos >= read_pos) {
-            return write_pos - read_pos;
-        } else {
-            return capacity_ - read_pos + write_pos;
-        }
+        const size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+        const size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+        const size_t ring_size = enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+        return ring_size + overflow_size_.load(std::memory_order_acquire);
     }
+    
+    /**
+     * 环形缓冲可容纳的事件数
+     */
+    size_t capacity() const { return slot_count_; }
+    
+    void set_full_policy(QueueFullPolicy policy) { policy_.store(policy, std::memory_order_relaxed); }
+    QueueFullPolicy get_full_policy() const { return policy_.load(std::memory_order_relaxed); }
+    
+    /**
+     * 因队列满被丢弃的事件总数 (Drop 策略)
+     */
+    size_t get_dropped_count() const { return dropped_count_.load(std::memory_order_relaxed); }
+    
+    /**
+     * 写入过溢出链表的事件总数 (Overflow 策略)
+     */
+    size_t get_overflow_count() const { return overflow_count_.load(std::memory_order_relaxed); }
 
 private:
-    struct alignas(64) Event {  // 缓存行对齐
-        T data;
-        Event() = default;
-        Event(const T& t) : data(t) {}
-        Event& operator=(const T& t) { data = t; return *this; }
-        operator T() const { return data; }
+    /**
+     * Overflow 策略下溢出链表非空时新事件直接进入溢出链表，避免越过更早的溢出事件
+     */
+    bool ring_accepts_new_events() const {
+        return overflow_size_.load(std::memory_order_acquire) == 0 ||
+               policy_.load(std::memory_order_relaxed) != QueueFullPolicy::Overflow;
+    }
+    
+    bool try_dequeue_ring(T& event) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        
+        while (true) {
+            Slot& slot = buffer_[pos % slot_count_];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    event = std::move(slot.data);
+                    // 交还给下一轮的生产者
+                    slot.sequence.store(pos + slot_count_, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // 槽位尚未写入：队列为空
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    /**
+     * 环形缓冲写满后按策略处理剩余事件
+     * @return 被接收的数量
+     */
+    size_t handle_full(const T* events, size_t count) {
+        switch (policy_.load(std::memory_order_relaxed)) {
+            case QueueFullPolicy::Spin: {
+                size_t done = 0;
+                int attempts = 0;
+                while (done < count) {
+                    const size_t written = try_enqueue_batch(events + done, count - done);
+                    done += written;
+                    if (written == 0 && ++attempts > 64) {
+                        std::this_thread::yield();
+                    }
+                }
+                return count;
+            }
+            case QueueFullPolicy::Overflow: {
+                std::lock_guard<std::mutex> lock(overflow_mutex_);
+                overflow_.insert(overflow_.end(), events, events + count);
+                overflow_size_.fetch_add(count, std::memory_order_release);
+                overflow_count_.fetch_add(count, std::memory_order_relaxed);
+                return count;
+            }
+            case QueueFullPolicy::Drop:
+            default:
+                dropped_count_.fetch_add(count, std::memory_order_relaxed);
+                return 0;
+        }
+    }
+    
+    /**
+     * 溢出链表只在环形缓冲的位置全部被认领后才出队：
+     * 若环形缓冲中还有因生产者未写完而暂不可读的事件，它们比溢出事件更早。
+     * 检查必须在持锁后进行，链表中每个事件的生产者在加入链表前完成的环形缓冲写入才对本线程可见
+     */
+    size_t dequeue_overflow(T* single, size_t max_count, std::vector<T>* out) {
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        const size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+        if (dequeue_pos_.load(std::memory_order_acquire) < enqueue_pos) {
+            return 0;
+        }
+        const size_t count = std::min(max_count, overflow_.size());
+        for (size_t i = 0; i < count; ++i) {
+            if (single) {
+                *single = std::move(overflow_.front());
+            } else {
+                out->push_back(std::move(overflow_.front()));
+            }
+            overflow_.pop_front();
+        }
+        overflow_size_.fetch_sub(count, std::memory_order_release);
+        return count;
+    }
+    
+    struct alignas(64) Slot {  // 缓存行对齐
+        std::atomic<size_t> sequence{0};
+        T data{};
     };
     
-    std::unique_ptr<Event[]> buffer_;
-    size_t capacity_;
+    std::unique_ptr<Slot[]> buffer_;
+    const size_t slot_count_;
+    std::atomic<QueueFullPolicy> policy_;
     
     // 使用不同的缓存行避免 false sharing
-    alignas(64) std::atomic<size_t> write_pos_{0};
-    alignas(64) std::atomic<size_t> read_pos_{0};
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    
+    alignas(64) std::atomic<size_t> overflow_size_{0};
+    std::atomic<size_t> dropped_count_{0};
+    std::atomic<size_t> overflow_count_{0};
+    std::mutex overflow_mutex_;
+    std::deque<T> overflow_;
 };
 
 /**
@@ -438,7 +924,31 @@ public:
     template<typename T>
     bool enqueue_concurrent(const T& event) {
         auto& queue = get_queue<T>();
-        return queue.enqueue(event);
+        if (!queue.enqueue(event)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+    
+    /**
+     * 线程安全的批量入队
+     * @return 成功入队的数量
+     */
+    template<typename T>
+    size_t enqueue_batch_concurrent(const T* events, size_t count) {
+        auto& queue = get_queue<T>();
+        const size_t accepted = queue.enqueue_batch(events, count);
+        dropped_.fetch_add(count - accepted, std::memory_order_relaxed);
+        return accepted;
+    }
+    
+    /**
+     * 设置某类事件队列写满时的处理策略
+     */
+    template<typename T>
+    void set_full_policy(QueueFullPolicy policy) {
+        get_queue<T>().set_full_policy(policy);
     }
     
     /**
@@ -468,7 +978,11 @@ public:
         float average_queue_usage = 0.0f;
     };
     
-    const ConcurrentStats& get_statistics() const { return stats_; }
+    ConcurrentStats get_statistics() const {
+        ConcurrentStats stats = stats_;
+        stats.total_dropped = dropped_.load(std::memory_order_relaxed);
+        return stats;
+    }
 
 private:
     template<typename T>
@@ -478,6 +992,7 @@ private:
     }
     
     ConcurrentStats stats_;
+    std::atomic<size_t> dropped_{0};  // 生产者线程并发写入
 };
 
 } // namespace portal_core
@@ -0,0 +1,331 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "event_typed_queue.h"
+
+namespace portal_core {
+
+/**
+ * 事件日志格式（本机字节序）：
+ *   文件头   EventLogFileHeader
+ *   记录     EventLogRecordHeader + payload_size 字节负载
+ * 事件记录的负载为 count 个事件对象的原始字节；帧记录的负载为一个 float delta_time。
+ * 类型 id 由注册名的 FNV-1a 哈希得到，录制与回放进程只需用相同的名字注册类型。
+ */
+enum class EventLogRecordKind : uint8_t {
+    FRAME = 0,              // 帧边界：此前的事件在该帧处理，回放时在此推进一帧
+    IMMEDIATE = 1,          // publish_immediate / schedule_event(IMMEDIATE)
+    QUEUED = 2,             // enqueue / schedule_event(QUEUED)
+    BATCH_IMMEDIATE = 3,    // publish_batch(IMMEDIATE)
+    BATCH_QUEUED = 4        // publish_batch(QUEUED)
+};
+
+struct EventLogFileHeader {
+    char magic[4] = {'P', 'E', 'V', 'L'};
+    uint32_t version = 1;
+};
+
+struct EventLogRecordHeader {
+    uint32_t frame = 0;
+    uint32_t type_id = 0;         // FRAME 记录为 0
+    uint32_t payload_size = 0;
+    uint32_t count = 0;           // 事件个数，publish_batch 整批记录为一条
+    float delay = 0.0f;           // 延迟事件的延迟秒数
+    EventLogRecordKind kind = EventLogRecordKind::FRAME;
+    uint8_t priority = 0;
+    uint16_t reserved = 0;
+};
+
+static_assert(std::is_trivially_copyable<EventLogRecordHeader>::value, "record header must be POD");
+
+inline uint32_t event_log_type_id(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const char* c = name; *c; ++c) {
+        hash ^= static_cast<uint8_t>(*c);
+        hash *= 16777619u;
+    }
+    // 0 保留给帧记录
+    return hash == 0 ? 1 : hash;
+}
+
+/**
+ * 事件录制器
+ *
+ * EventManager::set_event_recorder 后，外部发布的 enqueue / publish_immediate / publish_batch 事件
+ * 以紧凑二进制写入日志；处理器中派生的事件不录制，回放时由处理器重新产生。
+ * - 只录制已注册的可平凡拷贝类型，未注册的类型跳过并计数
+ * - 调用线程只把记录追加到内存缓冲；缓冲满 BUFFER_FLUSH_BYTES 后交给后台写线程，缓冲循环复用
+ */
+class EventRecorder {
+public:
+    static constexpr size_t BUFFER_FLUSH_BYTES = 64 * 1024;
+
+    struct Statistics {
+        uint64_t records_written = 0;
+        uint64_t events_written = 0;
+        uint64_t bytes_written = 0;
+        uint64_t skipped_unregistered = 0;
+    };
+
+    EventRecorder() = default;
+    ~EventRecorder() { close(); }
+
+    EventRecorder(const EventRecorder&) = delete;
+    EventRecorder& operator=(const EventRecorder&) = delete;
+
+    /**
+     * 注册可录制的事件类型，name 在录制与回放两端必须一致
+     */
+    template<typename TEvent>
+    void register_type(const char* name) {
+        static_assert(std::is_trivially_copyable<TEvent>::value, "only trivially copyable events can be recorded");
+        const uint32_t index = event_queue_type_index<TEvent>();
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        if (index >= type_ids_.size()) {
+            type_ids_.resize(index + 1, 0);
+        }
+        type_ids_[index] = event_log_type_id(name);
+    }
+
+    bool open(const std::string& path) {
+        close();
+        file_.open(path, std::ios::binary | std::ios::trunc);
+        if (!file_) {
+            std::cerr << "EventRecorder: Failed to open " << path << std::endl;
+            return false;
+        }
+        const EventLogFileHeader header;
+        file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        statistics_ = Statistics{};
+        statistics_.bytes_written = sizeof(header);
+        stop_ = false;
+        writer_ = std::thread([this]() { writer_loop(); });
+        return true;
+    }
+
+    /**
+     * 写出剩余记录并停止写线程
+     */
+    void close() {
+        if (!writer_.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(buffer_mutex_);
+            submit_current_locked();
+            stop_ = true;
+        }
+        writer_cv_.notify_one();
+        writer_.join();
+        file_.close();
+    }
+
+    bool is_open() const { return writer_.joinable(); }
+
+    /**
+     * 录制 count 个连续事件；未打开或类型未注册时直接返回
+     */
+    template<typename TEvent>
+    void record(uint32_t frame, EventLogRecordKind kind, uint8_t priority, float delay,
+                const TEvent* events, size_t count) {
+        if constexpr (std::is_trivially_copyable<TEvent>::value) {
+            if (!is_open() || count == 0) {
+                return;
+            }
+            const uint32_t index = event_queue_type_index<TEvent>();
+            std::lock_guard<std::mutex> lock(buffer_mutex_);
+            const uint32_t type_id = index < type_ids_.size() ? type_ids_[index] : 0;
+            if (type_id == 0) {
+                statistics_.skipped_unregistered += count;
+                return;
+            }
+            EventLogRecordHeader header;
+            header.frame = frame;
+            header.type_id = type_id;
+            header.payload_size = static_cast<uint32_t>(sizeof(TEvent) * count);
+            header.count = static_cast<uint32_t>(count);
+            header.delay = delay;
+            header.kind = kind;
+            header.priority = priority;
+            append_locked(header, events);
+            statistics_.events_written += count;
+        } else {
+            (void)frame;
+            (void)kind;
+            (void)priority;
+            (void)delay;
+            (void)events;
+            std::lock_guard<std::mutex> lock(buffer_mutex_);
+            statistics_.skipped_unregistered += count;
+        }
+    }
+
+    void record_frame(uint32_t frame, float delta_time) {
+        if (!is_open()) {
+            return;
+        }
+        EventLogRecordHeader header;
+        header.frame = frame;
+        header.payload_size = sizeof(float);
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        append_locked(header, &delta_time);
+    }
+
+    /**
+     * 把当前缓冲交给写线程（不等待写完）
+     */
+    void flush() {
+        {
+            std::lock_guard<std::mutex> lock(buffer_mutex_);
+            submit_current_locked();
+        }
+        writer_cv_.notify_one();
+    }
+
+    Statistics get_statistics() const {
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        return statistics_;
+    }
+
+private:
+    void append_locked(const EventLogRecordHeader& header, const void* payload) {
+        const size_t offset = current_.size();
+        current_.resize(offset + sizeof(header) + header.payload_size);
+        std::memcpy(current_.data() + offset, &header, sizeof(header));
+        std::memcpy(current_.data() + offset + sizeof(header), payload, header.payload_size);
+        ++statistics_.records_written;
+        statistics_.bytes_written += sizeof(header) + header.payload_size;
+
+        if (current_.size() >= BUFFER_FLUSH_BYTES) {
+            submit_current_locked();
+            writer_cv_.notify_one();
+        }
+    }
+
+    void submit_current_locked() {
+        if (current_.empty()) {
+            return;
+        }
+        filled_.push_back(std::move(current_));
+        current_.clear();
+        if (!free_.empty()) {
+            current_ = std::move(free_.back());
+            free_.pop_back();
+        }
+        current_.reserve(BUFFER_FLUSH_BYTES + 1024);
+    }
+
+    void writer_loop() {
+        std::vector<std::vector<uint8_t>> batch;
+        std::unique_lock<std::mutex> lock(buffer_mutex_);
+        while (true) {
+            writer_cv_.wait(lock, [this]() { return stop_ || !filled_.empty(); });
+            batch.swap(filled_);
+            const bool stopping = stop_;
+            lock.unlock();
+
+            for (auto& buffer : batch) {
+                file_.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+            file_.flush();
+
+            lock.lock();
+            // 写完的缓冲归还给调用线程复用
+            for (auto& buffer : batch) {
+                free_.push_back(std::move(buffer));
+            }
+            batch.clear();
+            if (stopping && filled_.empty()) {
+                return;
+            }
+        }
+    }
+
+    mutable std::mutex buffer_mutex_;
+    std::condition_variable writer_cv_;
+    std::thread writer_;
+    bool stop_ = false;
+    std::ofstream file_;
+
+    std::vector<uint8_t> current_;
+    std::vector<std::vector<uint8_t>> filled_;
+    std::vector<std::vector<uint8_t>> free_;
+    std::vector<uint32_t> type_ids_;     // 按 event_queue_type_index 索引，0 = 未注册
+    Statistics statistics_;
+};
+
+/**
+ * 事件日志读取：整个文件读入内存后顺序遍历记录
+ */
+class EventLogReader {
+public:
+    struct Record {
+        EventLogRecordHeader header;
+        const uint8_t* payload = nullptr;
+    };
+
+    bool open(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            std::cerr << "EventLogReader: Failed to open " << path << std::endl;
+            return false;
+        }
+        const std::streamsize size = file.tellg();
+        file.seekg(0);
+        data_.resize(static_cast<size_t>(size));
+        if (size > 0 && !file.read(reinterpret_cast<char*>(data_.data()), size)) {
+            std::cerr << "EventLogReader: Failed to read " << path << std::endl;
+            return false;
+        }
+
+        const EventLogFileHeader expected;
+        EventLogFileHeader header;
+        if (data_.size() < sizeof(header)) {
+            std::cerr << "EventLogReader: " << path << " is not an event log" << std::endl;
+            return false;
+        }
+        std::memcpy(&header, data_.data(), sizeof(header));
+        if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version) {
+            std::cerr << "EventLogReader: " << path << " has an unsupported format" << std::endl;
+            return false;
+        }
+        position_ = sizeof(header);
+        return true;
+    }
+
+    /**
+     * 读取下一条记录；文件结束或记录不完整时返回 false
+     * record.payload 指向内部缓冲，未对齐，按字节拷贝使用
+     */
+    bool next(Record& record) {
+        if (position_ + sizeof(EventLogRecordHeader) > data_.size()) {
+            return false;
+        }
+        std::memcpy(&record.header, data_.data() + position_, sizeof(EventLogRecordHeader));
+        const size_t payload_begin = position_ + sizeof(EventLogRecordHeader);
+        if (payload_begin + record.header.payload_size > data_.size()) {
+            return false;
+        }
+        record.payload = data_.data() + payload_begin;
+        position_ = payload_begin + record.header.payload_size;
+        return true;
+    }
+
+    void rewind() { position_ = sizeof(EventLogFileHeader); }
+
+private:
+    std::vector<uint8_t> data_;
+    size_t position_ = 0;
+};
+
+} // namespace portal_core
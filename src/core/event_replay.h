@@ -0,0 +1,130 @@
+#pragma once
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "event_manager.h"
+#include "event_recorder.h"
+
+namespace portal_core {
+
+/**
+ * 事件日志回放
+ *
+ * 按录制顺序重新发布日志中的事件，每遇到帧记录调用一次 step(delta_time) 推进一帧，不做任何等待，
+ * 用于确定性复现与负载测试。类型需以录制时相同的名字注册，未注册类型的记录跳过并计数。
+ *
+ * 无头回放整个游戏世界：
+ *   PortalGameWorld world;            // 不连接 Godot，按需初始化系统
+ *   EventReplayer replayer;
+ *   replayer.register_type<PortalEnterEvent>("PortalEnterEvent");
+ *   replayer.open("session.pevl");
+ *   auto result = replayer.replay_world(world);
+ */
+class EventReplayer {
+public:
+    struct Result {
+        uint32_t frames = 0;
+        uint64_t events = 0;
+        uint64_t skipped_records = 0;   // 未注册类型或负载大小不符
+        double elapsed_ms = 0.0;
+    };
+
+    template<typename TEvent>
+    void register_type(const char* name) {
+        static_assert(std::is_trivially_copyable<TEvent>::value, "only trivially copyable events can be replayed");
+        // 负载在日志中未对齐，先拷贝到类型数组再发布；数组随发布函数保存，逐帧复用
+        publishers_[event_log_type_id(name)] =
+            [events = std::vector<TEvent>()](EventManager& manager, const EventLogRecordHeader& header,
+                                             const uint8_t* payload) mutable {
+                if (header.count == 0 || header.payload_size != header.count * sizeof(TEvent)) {
+                    return false;
+                }
+                events.resize(header.count);
+                std::memcpy(static_cast<void*>(events.data()), payload, header.payload_size);
+
+                EventMetadata metadata;
+                metadata.priority = static_cast<EventPriority>(header.priority);
+                metadata.delay = header.delay;
+                switch (header.kind) {
+                    case EventLogRecordKind::IMMEDIATE:
+                        if (header.delay > 0.0f) {
+                            manager.schedule_event(events[0], header.delay, EventHandlingStrategy::IMMEDIATE);
+                        } else {
+                            manager.publish_immediate(events[0], metadata);
+                        }
+                        return true;
+                    case EventLogRecordKind::QUEUED:
+                        manager.enqueue(events[0], metadata);
+                        return true;
+                    case EventLogRecordKind::BATCH_IMMEDIATE:
+                        manager.publish_batch(EventSpan<TEvent>(events), EventHandlingStrategy::IMMEDIATE, metadata);
+                        return true;
+                    case EventLogRecordKind::BATCH_QUEUED:
+                        manager.publish_batch(EventSpan<TEvent>(events), EventHandlingStrategy::QUEUED, metadata);
+                        return true;
+                    default:
+                        return false;
+                }
+            };
+    }
+
+    bool open(const std::string& path) { return reader_.open(path); }
+
+    /**
+     * 回放到 manager，每帧调用 step(delta_time)
+     * 最后一个帧记录之后录制的事件会被发布，但录制时尚未处理，因此不再推进帧
+     */
+    template<typename Step>
+    Result replay(EventManager& manager, Step&& step) {
+        Result result;
+        const auto start = std::chrono::steady_clock::now();
+
+        reader_.rewind();
+        EventLogReader::Record record;
+        while (reader_.next(record)) {
+            if (record.header.kind == EventLogRecordKind::FRAME) {
+                float delta_time = 0.0f;
+                std::memcpy(&delta_time, record.payload, sizeof(delta_time));
+                step(delta_time);
+                ++result.frames;
+                continue;
+            }
+            auto it = publishers_.find(record.header.type_id);
+            if (it == publishers_.end() || !it->second(manager, record.header, record.payload)) {
+                ++result.skipped_records;
+                continue;
+            }
+            result.events += record.header.count;
+        }
+
+        result.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    /**
+     * 只回放事件系统：每帧调用 manager.process_queued_events
+     */
+    Result replay(EventManager& manager) {
+        return replay(manager, [&manager](float delta_time) { manager.process_queued_events(delta_time); });
+    }
+
+    /**
+     * 回放到游戏世界（PortalGameWorld 等提供 get_event_manager / update_systems 的类型）
+     */
+    template<typename World>
+    Result replay_world(World& world) {
+        return replay(world.get_event_manager(), [&world](float delta_time) { world.update_systems(delta_time); });
+    }
+
+private:
+    using Publisher = std::function<bool(EventManager&, const EventLogRecordHeader&, const uint8_t*)>;
+    std::unordered_map<uint32_t, Publisher> publishers_;
+    EventLogReader reader_;
+};
+
+} // namespace portal_core
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace portal_core {
+
+/**
+ * 定时器句柄，用于取消尚未触发的任务
+ * 节点复用时代数递增，旧句柄自动失效
+ */
+struct TimerHandle {
+    uint32_t index = std::numeric_limits<uint32_t>::max();
+    uint32_t generation = 0;
+
+    bool is_valid() const { return index != std::numeric_limits<uint32_t>::max(); }
+};
+
+/**
+ * 分层时间轮 - 管理大量延迟任务
+ *
+ * 时间按固定 tick 量化，共 LEVELS 层、每层 SLOTS 个槽：
+ * - 第 0 层每槽对应 1 个 tick，第 n 层每槽对应 SLOTS^n 个 tick
+ * - 插入时按剩余 tick 数选择层级，低层转完一圈时把上一层对应槽的任务下放（cascade）
+ * - 插入、取消均为 O(1)；每个 tick 只访问一个槽，不再逐个遍历全部任务
+ *
+ * 任务存放在节点数组中（空闲链表复用），槽内为双向链表，按插入顺序触发。
+ * Task 需可移动且可调用，推荐使用 InlineFunction 以避免每个任务一次堆分配。
+ */
+template<typename Task>
+class TimingWheel {
+public:
+    static constexpr uint32_t SLOT_BITS = 8;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t LEVELS = 4;
+    // 超出范围的任务先放在最高层，下放时重新计算
+    static constexpr uint64_t MAX_SPAN = (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+
+    explicit TimingWheel(float tick_seconds = 0.001f)
+        : tick_seconds_(tick_seconds > 0.0f ? tick_seconds : 0.001f) {
+        heads_.fill(NIL);
+        tails_.fill(NIL);
+    }
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+    TimingWheel(TimingWheel&&) = default;
+    TimingWheel& operator=(TimingWheel&&) = default;
+
+    /**
+     * 预分配节点，之后 reserve 范围内的调度不再分配内存
+     */
+    void reserve(size_t count) {
+        nodes_.reserve(count);
+    }
+
+    /**
+     * 延迟 delay_seconds 后执行任务
+     * 延迟向上取整到 tick，至少在下一个 tick 触发
+     */
+    TimerHandle schedule(float delay_seconds, Task task) {
+        const double ticks = std::ceil(static_cast<double>(delay_seconds) / tick_seconds_ - 1e-6);
+        return schedule_ticks(ticks > 1.0 ? static_cast<uint64_t>(ticks) : 1, std::move(task));
+    }
+
+    TimerHandle schedule_ticks(uint64_t delay_ticks, Task task) {
+        const uint32_t index = allocate_node();
+        Node& node = nodes_[index];
+        node.task = std::move(task);
+        node.expire_tick = current_tick_ + (delay_ticks > 0 ? delay_ticks : 1);
+        node.pending = true;
+        link(index);
+        ++size_;
+        return TimerHandle{index, node.generation};
+    }
+
+    /**
+     * 取消尚未触发的任务
+     * @return true 成功取消，false 句柄无效或任务已触发
+     */
+    bool cancel(TimerHandle handle) {
+        if (!is_pending(handle)) {
+            return false;
+        }
+        unlink(handle.index);
+        release_node(handle.index);
+        --size_;
+        return true;
+    }
+
+    bool is_pending(TimerHandle handle) const {
+        return handle.index < nodes_.size() &&
+               nodes_[handle.index].generation == handle.generation &&
+               nodes_[handle.index].pending;
+    }
+
+    /**
+     * 推进时间并执行到期任务
+     * @param on_expire 以 Task& 调用，由调用方负责执行（便于统一处理异常和日志）
+     * @return 本次触发的任务数
+     */
+    template<typename OnExpire>
+    size_t advance(float delta_seconds, OnExpire&& on_expire) {
+        accumulated_seconds_ += delta_seconds;
+        const double whole_ticks = std::floor(accumulated_seconds_ / tick_seconds_ + 1e-6);
+        if (whole_ticks < 1.0) {
+            return 0;
+        }
+        accumulated_seconds_ -= whole_ticks * tick_seconds_;
+        if (accumulated_seconds_ < 0.0) {
+            accumulated_seconds_ = 0.0;
+        }
+        return advance_ticks(static_cast<uint64_t>(whole_ticks), std::forward<OnExpire>(on_expire));
+    }
+
+    template<typename OnExpire>
+    size_t advance_ticks(uint64_t ticks, OnExpire&& on_expire) {
+        size_t fired = 0;
+        const uint64_t target = current_tick_ + ticks;
+        while (current_tick_ < target) {
+            if (size_ == 0) {
+                // 时间轮为空时直接跳到目标 tick
+                current_tick_ = target;
+                break;
+            }
+            ++current_tick_;
+            cascade();
+            fired += expire_slot(static_cast<uint32_t>(current_tick_ & (SLOTS - 1)), on_expire);
+        }
+        return fired;
+    }
+
+    /**
+     * 丢弃所有未触发的任务
+     */
+    void clear() {
+        for (uint32_t i = 0; i < nodes_.size(); ++i) {
+            if (nodes_[i].pending) {
+                release_node(i);
+            }
+        }
+        heads_.fill(NIL);
+        tails_.fill(NIL);
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    uint64_t current_tick() const { return current_tick_; }
+    float tick_seconds() const { return tick_seconds_; }
+
+private:
+    static constexpr uint32_t NIL = std::numeric_limits<uint32_t>::max();
+
+    struct Node {
+        Task task;
+        uint64_t expire_tick = 0;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;       // 空闲时作为空闲链表指针
+        uint32_t slot = NIL;       // level * SLOTS + index
+        uint32_t generation = 0;
+        bool pending = false;
+    };
+
+    uint32_t allocate_node() {
+        if (free_head_ != NIL) {
+            const uint32_t index = free_head_;
+            free_head_ = nodes_[index].next;
+            return index;
+        }
+        nodes_.emplace_back();
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+    void release_node(uint32_t index) {
+        Node& node = nodes_[index];
+        node.task = Task();
+        node.pending = false;
+        node.slot = NIL;
+        node.prev = NIL;
+        ++node.generation;
+        node.next = free_head_;
+        free_head_ = index;
+    }
+
+    /**
+     * 按剩余 tick 数把节点挂到对应层的槽尾
+     */
+    void link(uint32_t index) {
+        Node& node = nodes_[index];
+        uint64_t expire = node.expire_tick;
+        if (expire - current_tick_ > MAX_SPAN) {
+            expire = current_tick_ + MAX_SPAN;
+        }
+        const uint64_t delta = expire - current_tick_;
+
+        uint32_t level = 0;
+        while (level + 1 < LEVELS && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+            ++level;
+        }
+        const uint32_t slot = level * SLOTS + static_cast<uint32_t>((expire >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+        node.slot = slot;
+        node.next = NIL;
+        node.prev = tails_[slot];
+        if (tails_[slot] != NIL) {
+            nodes_[tails_[slot]].next = index;
+        } else {
+            heads_[slot] = index;
+        }
+        tails_[slot] = index;
+    }
+
+    void unlink(uint32_t index) {
+        Node& node = nodes_[index];
+        if (node.prev != NIL) {
+            nodes_[node.prev].next = node.next;
+        } else {
+            heads_[node.slot] = node.next;
+        }
+        if (node.next != NIL) {
+            nodes_[node.next].prev = node.prev;
+        } else {
+            tails_[node.slot] = node.prev;
+        }
+        node.prev = NIL;
+        node.next = NIL;
+        node.slot = NIL;
+    }
+
+    /**
+     * 低层转完一圈时，把上一层当前槽的任务重新按剩余时间挂到低层
+     */
+    void cascade() {
+        for (uint32_t level = 1; level < LEVELS; ++level) {
+            if ((current_tick_ & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) {
+                break;
+            }
+            const uint32_t slot = level * SLOTS + static_cast<uint32_t>((current_tick_ >> (SLOT_BITS * level)) & (SLOTS - 1));
+            uint32_t index = heads_[slot];
+            heads_[slot] = NIL;
+            tails_[slot] = NIL;
+            while (index != NIL) {
+                const uint32_t next = nodes_[index].next;
+                link(index);
+                index = next;
+            }
+        }
+    }
+
+    template<typename OnExpire>
+    size_t expire_slot(uint32_t slot, OnExpire& on_expire) {
+        size_t fired = 0;
+        // 逐个摘下槽头：任务执行期间新调度或取消的任务不会破坏遍历
+        while (heads_[slot] != NIL) {
+            const uint32_t index = heads_[slot];
+            unlink(index);
+
+            if (nodes_[index].expire_tick > current_tick_) {
+                // 超出时间轮范围的任务尚未到期，重新挂回（会落到更高层，不会回到本槽）
+                link(index);
+                continue;
+            }
+
+            // 先把任务移出节点并回收节点，任务中可以安全地调度新任务（节点数组可能扩容）
+            Task task = std::move(nodes_[index].task);
+            release_node(index);
+            --size_;
+            on_expire(task);
+            ++fired;
+        }
+        return fired;
+    }
+
+    float tick_seconds_;
+    double accumulated_seconds_ = 0.0;
+    uint64_t current_tick_ = 0;
+    size_t size_ = 0;
+
+    std::vector<Node> nodes_;
+    uint32_t free_head_ = NIL;
+    std::array<uint32_t, LEVELS * SLOTS> heads_;
+    std::array<uint32_t, LEVELS * SLOTS> tails_;
+};
+
+} // namespace portal_core
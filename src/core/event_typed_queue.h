@@ -0,0 +1,406 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace portal_core {
+
+/**
+ * 队列事件句柄，用于在分发前取消单个事件
+ * 队列每次分发后代数递增，旧句柄自动失效
+ */
+struct QueuedEventHandle {
+    uint32_t type_index = std::numeric_limits<uint32_t>::max();
+    uint32_t slot = 0;
+    uint32_t generation = 0;
+    uint8_t lane = 0;          // 所在的优先级队列
+
+    bool is_valid() const { return type_index != std::numeric_limits<uint32_t>::max(); }
+};
+
+// 事件目标实体检测 (C++17 兼容)：依次查找 entity / target 成员
+template<typename T, typename = void>
+struct has_entity_member : std::false_type {};
+
+template<typename T>
+struct has_entity_member<T, std::enable_if_t<std::is_convertible<decltype(std::declval<const T&>().entity), entt::entity>::value>>
+    : std::true_type {};
+
+template<typename T, typename = void>
+struct has_target_member : std::false_type {};
+
+template<typename T>
+struct has_target_member<T, std::enable_if_t<std::is_convertible<decltype(std::declval<const T&>().target), entt::entity>::value>>
+    : std::true_type {};
+
+/**
+ * 取事件的目标实体，用于按实体取消
+ * 没有 entity / target 成员的事件返回 entt::null，不参与按实体取消
+ */
+template<typename TEvent>
+entt::entity get_event_target_entity(const TEvent& event) {
+    if constexpr (has_entity_member<TEvent>::value) {
+        return event.entity;
+    } else if constexpr (has_target_member<TEvent>::value) {
+        return event.target;
+    } else {
+        (void)event;
+        return entt::null;
+    }
+}
+
+/**
+ * 按目标实体合并的键函数，例如同一帧内同一物体的多次 BodyActivationEvent
+ */
+template<typename TEvent>
+uint64_t coalesce_by_target_entity(const TEvent& event) {
+    return static_cast<uint64_t>(entt::to_integral(get_event_target_entity(event)));
+}
+
+/**
+ * 类型擦除的队列接口，EventManager 按类型索引保存
+ */
+class TypedEventQueueBase {
+public:
+    virtual ~TypedEventQueueBase() = default;
+
+    /**
+     * 分发本批事件，最多处理 max_entries 个数组项（含已取消的项）
+     * 本批未处理完时余下的事件保留到下一次调用，之前不会换入新入队的事件
+     * @return 通知处理器的事件数
+     */
+    virtual size_t dispatch(entt::dispatcher& dispatcher, size_t max_entries) = 0;
+    size_t dispatch(entt::dispatcher& dispatcher) {
+        return dispatch(dispatcher, std::numeric_limits<size_t>::max());
+    }
+
+    /**
+     * 本批是否还有未分发的事件（预算用尽而延后的事件）
+     */
+    virtual bool is_dispatching() const = 0;
+    virtual bool cancel(const QueuedEventHandle& handle) = 0;
+    virtual size_t cancel_for_entity(entt::entity entity) = 0;
+    virtual size_t cancel_all() = 0;
+    virtual size_t size() const = 0;
+    virtual bool has_pending() const = 0;
+    virtual void clear() = 0;
+};
+
+inline uint32_t next_event_queue_type_index() {
+    static std::atomic<uint32_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * 事件类型的队列索引，进程内唯一且连续，用于 O(1) 查找对应队列
+ */
+template<typename TEvent>
+uint32_t event_queue_type_index() {
+    static const uint32_t index = next_event_queue_type_index();
+    return index;
+}
+
+/**
+ * 连续事件视图 (C++17 下 std::span<const TEvent> 的替代)
+ * 批量处理器以 EventSpan<TEvent> 订阅，一次调用收到整批事件；视图只在处理器调用期间有效
+ */
+template<typename TEvent>
+struct EventSpan {
+    const TEvent* data = nullptr;
+    size_t count = 0;
+
+    EventSpan() = default;
+    EventSpan(const TEvent* first, size_t size) : data(first), count(size) {}
+    EventSpan(const std::vector<TEvent>& events) : data(events.data()), count(events.size()) {}
+
+    const TEvent* begin() const { return data; }
+    const TEvent* end() const { return data + count; }
+    const TEvent& operator[](size_t index) const { return data[index]; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+/**
+ * 单一事件类型的队列
+ *
+ * - 事件按入队顺序保存在连续数组中，取消只打标记，分发时跳过
+ * - 可选合并：同一合并键在一帧内只保留一个事件（保留最早的位置，内容由合并函数决定）
+ * - 分发时先把待处理数组换出，处理器中新入队的事件留到下一次分发，
+ *   与 entt::dispatcher::update() 的语义一致；处理器仍可取消本批中尚未分发的事件
+ * - 可分段分发：预算用尽时本批余下的事件留到下一次调用，期间仍可取消
+ * - 每段先逐个通知 TEvent 处理器，再把未取消的连续区段整段交给 EventSpan<TEvent> 处理器
+ */
+template<typename TEvent>
+class TypedEventQueue : public TypedEventQueueBase {
+public:
+    using KeyFunction = std::function<uint64_t(const TEvent&)>;
+    using MergeFunction = std::function<void(TEvent& existing, const TEvent& incoming)>;
+
+    explicit TypedEventQueue(uint32_t type_index, uint8_t lane = 0) : type_index_(type_index), lane_(lane) {}
+
+    using TypedEventQueueBase::dispatch;
+
+    QueuedEventHandle push(const TEvent& event) {
+        if (key_function_) {
+            const uint64_t key = key_function_(event);
+            auto it = coalesce_index_.find(key);
+            if (it != coalesce_index_.end()) {
+                TEvent& existing = pending_.events[it->second];
+                if (merge_function_) {
+                    merge_function_(existing, event);
+                } else {
+                    existing = event;
+                }
+                return QueuedEventHandle{type_index_, it->second, generation_, lane_};
+            }
+            coalesce_index_.emplace(key, static_cast<uint32_t>(pending_.size()));
+        }
+
+        pending_.events.push_back(event);
+        pending_.cancelled.push_back(0);
+        ++live_count_;
+        return QueuedEventHandle{type_index_, static_cast<uint32_t>(pending_.size() - 1), generation_, lane_};
+    }
+
+    /**
+     * 批量入队：一次扩容后整段拷贝
+     * 启用合并时退回逐个入队
+     * @return 第一个事件的句柄，其余事件的 slot 依次递增（合并时不保证）
+     */
+    QueuedEventHandle push_batch(EventSpan<TEvent> events) {
+        if (events.empty()) {
+            return QueuedEventHandle{};
+        }
+        if (key_function_) {
+            const QueuedEventHandle first = push(events[0]);
+            for (size_t i = 1; i < events.size(); ++i) {
+                push(events[i]);
+            }
+            return first;
+        }
+
+        const size_t first = pending_.size();
+        pending_.events.insert(pending_.events.end(), events.begin(), events.end());
+        pending_.cancelled.resize(pending_.events.size(), 0);
+        live_count_ += events.size();
+        return QueuedEventHandle{type_index_, static_cast<uint32_t>(first), generation_, lane_};
+    }
+
+    size_t dispatch(entt::dispatcher& dispatcher, size_t max_entries) override {
+        if (!is_dispatching()) {
+            if (pending_.empty()) {
+                return 0;
+            }
+            // 换出本批事件；dispatching_ 保留上次的容量，稳定后不再分配
+            dispatching_.swap(pending_);
+            pending_.clear();
+            coalesce_index_.clear();
+            dispatching_generation_ = generation_++;
+            dispatching_live_count_ = live_count_;
+            live_count_ = 0;
+            next_position_ = 0;
+        }
+
+        const size_t begin = next_position_;
+        const size_t end = dispatching_.size() - begin > max_entries ? begin + max_entries : dispatching_.size();
+        size_t dispatched = 0;
+        if (!dispatcher.sink<TEvent>().empty()) {
+            for (size_t i = begin; i < end; ++i) {
+                // 先推进位置：处理器只能取消之后的事件
+                next_position_ = i + 1;
+                if (dispatching_.cancelled[i]) {
+                    continue;
+                }
+                --dispatching_live_count_;
+                // 分发期间 dispatching_ 不会增长，引用保持有效
+                dispatcher.trigger(dispatching_.events[i]);
+                ++dispatched;
+            }
+        } else {
+            for (size_t i = begin; i < end; ++i) {
+                dispatched += dispatching_.cancelled[i] ? 0 : 1;
+            }
+            dispatching_live_count_ -= dispatched;
+        }
+        next_position_ = end;
+
+        // 逐个分发结束后本段不能再取消，批量处理器按未取消的连续区段接收
+        if (!dispatcher.sink<EventSpan<TEvent>>().empty()) {
+            size_t run_begin = begin;
+            while (run_begin < end) {
+                while (run_begin < end && dispatching_.cancelled[run_begin]) {
+                    ++run_begin;
+                }
+                size_t run_end = run_begin;
+                while (run_end < end && !dispatching_.cancelled[run_end]) {
+                    ++run_end;
+                }
+                if (run_end > run_begin) {
+                    dispatcher.trigger(EventSpan<TEvent>(dispatching_.events.data() + run_begin, run_end - run_begin));
+                }
+                run_begin = run_end;
+            }
+        }
+
+        if (next_position_ >= dispatching_.size()) {
+            dispatching_.clear();
+            next_position_ = 0;
+            dispatching_live_count_ = 0;
+        }
+        return dispatched;
+    }
+
+    bool is_dispatching() const override { return next_position_ < dispatching_.size(); }
+
+    bool cancel(const QueuedEventHandle& handle) override {
+        if (handle.type_index != type_index_ || handle.lane != lane_) {
+            return false;
+        }
+        if (handle.generation == generation_) {
+            if (handle.slot >= pending_.size() || pending_.cancelled[handle.slot]) {
+                return false;
+            }
+            cancel_pending(handle.slot);
+            return true;
+        }
+        // 正在分发（或延后到下一帧）的批次中尚未轮到的事件
+        if (is_dispatching() && handle.generation == dispatching_generation_ &&
+            handle.slot >= next_position_ && handle.slot < dispatching_.size() &&
+            !dispatching_.cancelled[handle.slot]) {
+            dispatching_.cancelled[handle.slot] = 1;
+            --dispatching_live_count_;
+            return true;
+        }
+        return false;
+    }
+
+    template<typename Predicate>
+    size_t cancel_if(Predicate&& predicate) {
+        size_t cancelled = 0;
+        for (uint32_t i = 0; i < pending_.size(); ++i) {
+            if (!pending_.cancelled[i] && predicate(static_cast<const TEvent&>(pending_.events[i]))) {
+                cancel_pending(i);
+                ++cancelled;
+            }
+        }
+        for (size_t i = next_position_; i < dispatching_.size(); ++i) {
+            if (!dispatching_.cancelled[i] && predicate(static_cast<const TEvent&>(dispatching_.events[i]))) {
+                dispatching_.cancelled[i] = 1;
+                --dispatching_live_count_;
+                ++cancelled;
+            }
+        }
+        return cancelled;
+    }
+
+    size_t cancel_for_entity(entt::entity entity) override {
+        if constexpr (has_entity_member<TEvent>::value || has_target_member<TEvent>::value) {
+            return cancel_if([entity](const TEvent& event) { return get_event_target_entity(event) == entity; });
+        } else {
+            (void)entity;
+            return 0;
+        }
+    }
+
+    size_t cancel_all() override {
+        return cancel_if([](const TEvent&) { return true; });
+    }
+
+    /**
+     * 设置合并键：同一帧内键相同的事件只分发一次
+     * 未提供合并函数时后到的事件覆盖先到的事件
+     */
+    void set_coalescing(KeyFunction key_function, MergeFunction merge_function = nullptr) {
+        key_function_ = std::move(key_function);
+        merge_function_ = std::move(merge_function);
+        // 已排队的重复事件不回溯合并，之后入队的事件合并到已排队的同键事件
+        coalesce_index_.clear();
+        if (key_function_) {
+            for (uint32_t i = 0; i < pending_.size(); ++i) {
+                if (!pending_.cancelled[i]) {
+                    coalesce_index_.emplace(key_function_(pending_.events[i]), i);
+                }
+            }
+        }
+    }
+
+    bool is_coalescing() const { return static_cast<bool>(key_function_); }
+
+    /**
+     * 等待分发的有效事件数（不含已取消和已合并的事件，含延后到下一帧的事件）
+     */
+    size_t size() const override { return live_count_ + dispatching_live_count_; }
+
+    /**
+     * 是否有待分发的数组项（含已取消的项，需要分发一次以清空）
+     */
+    bool has_pending() const override { return !pending_.empty() || is_dispatching(); }
+
+    void clear() override {
+        pending_.clear();
+        coalesce_index_.clear();
+        live_count_ = 0;
+        ++generation_;
+        if (is_dispatching()) {
+            // 丢弃延后的事件；正在分发时只丢弃尚未轮到的部分
+            for (size_t i = next_position_; i < dispatching_.size(); ++i) {
+                dispatching_.cancelled[i] = 1;
+            }
+            dispatching_live_count_ = 0;
+        }
+    }
+
+private:
+    // 事件与取消标记分开存放，事件数组可直接作为 EventSpan 交给批量处理器
+    struct Batch {
+        std::vector<TEvent> events;
+        std::vector<uint8_t> cancelled;
+
+        size_t size() const { return events.size(); }
+        bool empty() const { return events.empty(); }
+        void clear() {
+            events.clear();
+            cancelled.clear();
+        }
+        void swap(Batch& other) {
+            events.swap(other.events);
+            cancelled.swap(other.cancelled);
+        }
+    };
+
+    void cancel_pending(uint32_t slot) {
+        pending_.cancelled[slot] = 1;
+        --live_count_;
+        if (key_function_) {
+            // 取消后同键的新事件重新入队，而不是合并进已取消的事件
+            auto it = coalesce_index_.find(key_function_(pending_.events[slot]));
+            if (it != coalesce_index_.end() && it->second == slot) {
+                coalesce_index_.erase(it);
+            }
+        }
+    }
+
+    uint32_t type_index_;
+    uint8_t lane_;
+    uint32_t generation_ = 0;
+    uint32_t dispatching_generation_ = 0;
+    size_t live_count_ = 0;
+    size_t dispatching_live_count_ = 0;
+    size_t next_position_ = 0;             // dispatching_ 中下一个待分发的位置
+
+    Batch pending_;
+    Batch dispatching_;
+
+    KeyFunction key_function_;
+    MergeFunction merge_function_;
+    std::unordered_map<uint64_t, uint32_t> coalesce_index_;
+};
+
+} // namespace portal_core
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace portal_core
+{
+
+  /**
+   * 幀內存競技場（bump allocator）
+   * 分配只移動指針，釋放是空操作；每幀開始時 reset() 一次性回收全部內存。
+   * 內存塊在 reset() 後保留並重用，穩定後每幀不再向系統申請內存；
+   * 單次請求超過塊大小時分配一個專用的大塊，同樣保留重用。
+   *
+   * 只適合生命週期不超過一幀的數據；不會調用析構函數，非平凡類型請用
+   * FrameArenaAllocator 配合標準容器，由容器負責析構。非線程安全。
+   */
+  class FrameArena
+  {
+  public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit FrameArena(size_t block_size = DEFAULT_BLOCK_SIZE) : block_size_(block_size) {}
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    void *allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+    {
+      if (size == 0)
+      {
+        size = 1;
+      }
+      while (current_ < blocks_.size())
+      {
+        Block &block = blocks_[current_];
+        const size_t offset = align_up(block.used, alignment);
+        if (offset + size <= block.size)
+        {
+          block.used = offset + size;
+          bytes_used_ += size;
+          return block.data.get() + offset;
+        }
+        ++current_;
+      }
+
+      // 沒有可用的塊：申請新塊（計入堆分配次數）
+      const size_t block_size = std::max(block_size_, size + alignment);
+      Block block;
+      block.data.reset(new unsigned char[block_size]);
+      block.size = block_size;
+      blocks_.push_back(std::move(block));
+      ++heap_allocations_;
+      current_ = blocks_.size() - 1;
+      return allocate(size, alignment);
+    }
+
+    template <typename T>
+    T *allocate_array(size_t count)
+    {
+      return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * 回收本幀的全部分配，保留內存塊
+     */
+    void reset()
+    {
+      for (Block &block : blocks_)
+      {
+        block.used = 0;
+      }
+      current_ = 0;
+      peak_bytes_ = std::max(peak_bytes_, bytes_used_);
+      bytes_used_ = 0;
+      heap_allocations_ = 0;
+    }
+
+    // 自上次 reset() 以來的分配字節數與向系統申請內存塊的次數
+    size_t get_bytes_used() const { return bytes_used_; }
+    uint32_t get_heap_allocations() const { return heap_allocations_; }
+    size_t get_peak_bytes() const { return std::max(peak_bytes_, bytes_used_); }
+
+    size_t get_reserved_bytes() const
+    {
+      size_t total = 0;
+      for (const Block &block : blocks_)
+      {
+        total += block.size;
+      }
+      return total;
+    }
+
+  private:
+    struct Block
+    {
+      std::unique_ptr<unsigned char[]> data;
+      size_t size = 0;
+      size_t used = 0;
+    };
+
+    static size_t align_up(size_t value, size_t alignment)
+    {
+      return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    size_t block_size_;
+    std::vector<Block> blocks_;
+    size_t current_ = 0;
+    size_t bytes_used_ = 0;
+    size_t peak_bytes_ = 0;
+    uint32_t heap_allocations_ = 0;
+  };
+
+  /**
+   * 從 FrameArena 分配的標準分配器，deallocate 為空操作
+   * 容器必須在 arena reset() 之前銷毀或清空
+   */
+  template <typename T>
+  class FrameArenaAllocator
+  {
+  public:
+    using value_type = T;
+
+    explicit FrameArenaAllocator(FrameArena &arena) : arena_(&arena) {}
+
+    template <typename U>
+    FrameArenaAllocator(const FrameArenaAllocator<U> &other) : arena_(other.arena()) {}
+
+    T *allocate(size_t count) { return arena_->allocate_array<T>(count); }
+    void deallocate(T *, size_t) {}
+
+    FrameArena *arena() const { return arena_; }
+
+    template <typename U>
+    bool operator==(const FrameArenaAllocator<U> &other) const { return arena_ == other.arena(); }
+    template <typename U>
+    bool operator!=(const FrameArenaAllocator<U> &other) const { return arena_ != other.arena(); }
+
+  private:
+    FrameArena *arena_;
+  };
+
+  template <typename T>
+  using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
+
+} // namespace portal_core
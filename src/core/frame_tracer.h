@@ -0,0 +1,311 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "portal_core/lib/include/core/portal_trace_hooks.h"
+
+// 編譯期總開關：定義為 0 時 PORTAL_TRACE_SCOPE 展開為空，不產生任何開銷
+#ifndef PORTAL_ENABLE_TRACING
+#define PORTAL_ENABLE_TRACING 1
+#endif
+
+namespace portal_core
+{
+
+  /**
+   * 幀時間線追蹤器
+   * 記錄帶作用域的開始/結束事件，按需導出為 Chrome trace-event JSON，
+   * 可直接在 chrome://tracing 或 ui.perfetto.dev 中以火焰圖查看一幀內各線程的執行情況。
+   *
+   * 每個線程寫入自己的環形緩衝（單生產者，無鎖）；只有線程首次記錄事件時
+   * 註冊緩衝需要加鎖。運行期默認關閉，關閉時每個作用域只有一次原子讀取的開銷。
+   */
+  class FrameTracer
+  {
+  public:
+    // 每個線程保留的事件數，寫滿後覆蓋最舊的事件
+    static constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+    struct Event
+    {
+      const char *name = nullptr;     // 必須指向靜態存儲或 intern() 返回的字符串
+      const char *category = nullptr;
+      uint64_t start_ns = 0;
+      uint64_t duration_ns = 0;
+    };
+
+    /**
+     * RAII 作用域：構造時記下開始時間，析構時寫入一個完整事件
+     */
+    class Scope
+    {
+    public:
+      explicit Scope(const char *name, const char *category = "portal")
+          : name_(name), category_(category), start_ns_(is_enabled() ? now_ns() : 0) {}
+
+      ~Scope()
+      {
+        if (start_ns_ != 0)
+        {
+          record(name_, category_, start_ns_, now_ns());
+        }
+      }
+
+      Scope(const Scope &) = delete;
+      Scope &operator=(const Scope &) = delete;
+
+    private:
+      const char *name_;
+      const char *category_;
+      uint64_t start_ns_;
+    };
+
+    static bool is_enabled() { return enabled_.load(std::memory_order_relaxed); }
+    /**
+     * 開關追蹤；同時為 portal_core 庫安裝/移除追蹤回調，使庫內的作用域（如 TeleportManager::update）
+     * 寫入同一條時間線，關閉時庫內每個作用域只剩一次原子讀取
+     */
+    static void set_enabled(bool enabled)
+    {
+      enabled_.store(enabled, std::memory_order_relaxed);
+      Portal::set_trace_callback(enabled ? &FrameTracer::record : nullptr);
+    }
+
+    static uint64_t now_ns()
+    {
+      return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::steady_clock::now().time_since_epoch())
+                                       .count());
+    }
+
+    /**
+     * 寫入一個完整事件（時間戳為 steady_clock 納秒）
+     * 簽名保持為普通函數指針形式，便於不依賴本頭文件的庫（如 portal_core/lib）通過回調接入
+     */
+    static void record(const char *name, const char *category, uint64_t start_ns, uint64_t end_ns)
+    {
+      if (!is_enabled())
+      {
+        return;
+      }
+
+      ThreadBuffer *buffer = get_thread_buffer();
+      if (!buffer->events)
+      {
+        // 首次記錄時才分配，只命名過的線程不佔用事件內存
+        buffer->events.reset(new Event[EVENTS_PER_THREAD]);
+      }
+      const uint64_t index = buffer->written.load(std::memory_order_relaxed);
+      buffer->events[index % EVENTS_PER_THREAD] = Event{name, category, start_ns, end_ns - start_ns};
+      buffer->written.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * 把動態字符串轉為進程內長期有效的指針（用於系統名等運行時名稱）
+     * 會加鎖，應在初始化或調度表重建時調用，而不是每幀調用
+     */
+    static const char *intern(const std::string &name)
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex_);
+      return names_.insert(name).first->c_str();
+    }
+
+    /**
+     * 設置當前線程在時間線中顯示的名稱
+     */
+    static void set_thread_name(const std::string &name)
+    {
+      ThreadBuffer *buffer = get_thread_buffer();
+      std::lock_guard<std::mutex> lock(registry_mutex_);
+      buffer->thread_name = name;
+    }
+
+    /**
+     * 丟棄已記錄的事件
+     * 只移動每個緩衝的讀取起點，不會與正在寫入的線程衝突
+     */
+    static void clear()
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex_);
+      for (auto &buffer : buffers_)
+      {
+        buffer->cleared_at.store(buffer->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+      }
+    }
+
+    /**
+     * 當前可導出的事件總數
+     */
+    static size_t get_event_count()
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex_);
+      size_t count = 0;
+      for (const auto &buffer : buffers_)
+      {
+        uint64_t first = 0;
+        uint64_t last = 0;
+        buffer->readable_range(first, last);
+        count += static_cast<size_t>(last - first);
+      }
+      return count;
+    }
+
+    /**
+     * 導出為 Chrome trace-event JSON 字符串
+     * 建議在幀之間（或先 set_enabled(false)）調用，否則正在寫入的線程可能覆蓋最舊的事件
+     */
+    static std::string export_chrome_trace()
+    {
+      std::string json;
+      json.reserve(4096);
+      json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+      bool first_event = true;
+      auto begin_event = [&json, &first_event]()
+      {
+        json += first_event ? "\n" : ",\n";
+        first_event = false;
+      };
+
+      std::lock_guard<std::mutex> lock(registry_mutex_);
+      for (size_t thread_index = 0; thread_index < buffers_.size(); ++thread_index)
+      {
+        const ThreadBuffer &buffer = *buffers_[thread_index];
+        const unsigned tid = static_cast<unsigned>(thread_index + 1);
+
+        uint64_t first = 0;
+        uint64_t last = 0;
+        buffer.readable_range(first, last);
+        if (first == last && buffer.thread_name.empty())
+        {
+          continue;
+        }
+
+        // 線程名元數據
+        begin_event();
+        json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(tid) + ",\"args\":{\"name\":\"";
+        append_escaped(json, buffer.thread_name.empty() ? ("Thread " + std::to_string(tid)).c_str() : buffer.thread_name.c_str());
+        json += "\"}}";
+
+        for (uint64_t i = first; i < last; ++i)
+        {
+          const Event &event = buffer.events[i % EVENTS_PER_THREAD];
+          begin_event();
+          json += "{\"name\":\"";
+          append_escaped(json, event.name ? event.name : "?");
+          json += "\",\"cat\":\"";
+          append_escaped(json, event.category ? event.category : "portal");
+          json += "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(tid);
+          json += ",\"ts\":" + format_microseconds(event.start_ns);
+          json += ",\"dur\":" + format_microseconds(event.duration_ns) + "}";
+        }
+      }
+
+      json += "\n]}\n";
+      return json;
+    }
+
+    /**
+     * 導出到文件，成功返回 true
+     */
+    static bool write_chrome_trace(const std::string &path)
+    {
+      std::ofstream file(path, std::ios::out | std::ios::trunc);
+      if (!file.is_open())
+      {
+        return false;
+      }
+      file << export_chrome_trace();
+      return file.good();
+    }
+
+  private:
+    struct ThreadBuffer
+    {
+      std::unique_ptr<Event[]> events;
+      std::atomic<uint64_t> written{0};    // 只由所屬線程寫入
+      std::atomic<uint64_t> cleared_at{0}; // clear() 時的寫入位置
+      std::string thread_name;             // 由 registry_mutex_ 保護
+
+      void readable_range(uint64_t &first, uint64_t &last) const
+      {
+        last = written.load(std::memory_order_acquire);
+        first = cleared_at.load(std::memory_order_relaxed);
+        if (last - first > EVENTS_PER_THREAD)
+        {
+          first = last - EVENTS_PER_THREAD;
+        }
+      }
+    };
+
+    static ThreadBuffer *get_thread_buffer()
+    {
+      if (!tls_buffer_)
+      {
+        // 緩衝由全局列表持有，線程退出後其事件仍可導出
+        auto buffer = std::make_unique<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        tls_buffer_ = buffer.get();
+        buffers_.push_back(std::move(buffer));
+      }
+      return tls_buffer_;
+    }
+
+    static std::string format_microseconds(uint64_t ns)
+    {
+      char text[32];
+      std::snprintf(text, sizeof(text), "%llu.%03llu",
+                    static_cast<unsigned long long>(ns / 1000),
+                    static_cast<unsigned long long>(ns % 1000));
+      return text;
+    }
+
+    static void append_escaped(std::string &out, const char *text)
+    {
+      for (; *text; ++text)
+      {
+        const char c = *text;
+        if (c == '"' || c == '\\')
+        {
+          out += '\\';
+          out += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+          out += ' ';
+        }
+        else
+        {
+          out += c;
+        }
+      }
+    }
+
+    inline static std::atomic<bool> enabled_{false};
+    inline static std::mutex registry_mutex_;
+    inline static std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    inline static std::unordered_set<std::string> names_;
+    inline static thread_local ThreadBuffer *tls_buffer_ = nullptr;
+  };
+
+} // namespace portal_core
+
+#define PORTAL_TRACE_CONCAT_INNER(a, b) a##b
+#define PORTAL_TRACE_CONCAT(a, b) PORTAL_TRACE_CONCAT_INNER(a, b)
+
+#if PORTAL_ENABLE_TRACING
+#define PORTAL_TRACE_SCOPE(name) ::portal_core::FrameTracer::Scope PORTAL_TRACE_CONCAT(portal_trace_scope_, __LINE__)(name)
+#define PORTAL_TRACE_SCOPE_CATEGORY(name, category) ::portal_core::FrameTracer::Scope PORTAL_TRACE_CONCAT(portal_trace_scope_, __LINE__)(name, category)
+#else
+#define PORTAL_TRACE_SCOPE(name) ((void)0)
+#define PORTAL_TRACE_SCOPE_CATEGORY(name, category) ((void)0)
+#endif
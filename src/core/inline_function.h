@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace portal_core {
+
+template<typename Signature, size_t Capacity = 64>
+class InlineFunction;
+
+/**
+ * 小缓冲区可调用对象 - std::function 的不分配替代
+ *
+ * 捕获体不超过 Capacity 字节（且可无异常移动）时直接存放在对象内部，
+ * 构造、移动、调用都不触发堆分配；超出时退回堆分配，可用 is_inline() 检查。
+ * 只支持移动，不支持拷贝，适合一次性执行的延迟任务和命令。
+ */
+template<typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+public:
+    static constexpr size_t capacity = Capacity;
+
+    /**
+     * 编译期判断可调用对象能否内联存放
+     */
+    template<typename F>
+    static constexpr bool fits_inline = sizeof(F) <= Capacity &&
+                                        alignof(F) <= alignof(std::max_align_t) &&
+                                        std::is_nothrow_move_constructible<F>::value;
+
+    InlineFunction() = default;
+    InlineFunction(std::nullptr_t) {}
+
+    template<typename F,
+             typename Fn = std::decay_t<F>,
+             typename = std::enable_if_t<!std::is_same<Fn, InlineFunction>::value &&
+                                         std::is_invocable_r<R, Fn&, Args...>::value>>
+    InlineFunction(F&& f) {
+        if constexpr (fits_inline<Fn>) {
+            new (&storage_) Fn(std::forward<F>(f));
+            ops_ = &inline_ops<Fn>;
+        } else {
+            *reinterpret_cast<Fn**>(&storage_) = new Fn(std::forward<F>(f));
+            ops_ = &heap_ops<Fn>;
+        }
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept {
+        move_from(other);
+    }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    InlineFunction& operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction() {
+        reset();
+    }
+
+    // 与 std::function 相同，const 调用不要求可调用对象本身为 const
+    R operator()(Args... args) const {
+        return ops_->invoke(&storage_, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const { return ops_ != nullptr; }
+
+    /**
+     * 当前保存的可调用对象是否存放在内部缓冲区
+     */
+    bool is_inline() const { return ops_ != nullptr && ops_->is_inline; }
+
+    void reset() {
+        if (ops_) {
+            ops_->destroy(&storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*move)(void* dst, void* src);  // 移动到 dst 并销毁 src
+        void (*destroy)(void* storage);
+        bool is_inline;
+    };
+
+    template<typename Fn>
+    static constexpr Ops inline_ops = {
+        [](void* storage, Args&&... args) -> R {
+            return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...);
+        },
+        [](void* dst, void* src) {
+            Fn* from = static_cast<Fn*>(src);
+            new (dst) Fn(std::move(*from));
+            from->~Fn();
+        },
+        [](void* storage) { static_cast<Fn*>(storage)->~Fn(); },
+        true
+    };
+
+    template<typename Fn>
+    static constexpr Ops heap_ops = {
+        [](void* storage, Args&&... args) -> R {
+            return (**static_cast<Fn**>(storage))(std::forward<Args>(args)...);
+        },
+        [](void* dst, void* src) {
+            *static_cast<Fn**>(dst) = *static_cast<Fn**>(src);
+        },
+        [](void* storage) { delete *static_cast<Fn**>(storage); },
+        false
+    };
+
+    void move_from(InlineFunction& other) {
+        if (other.ops_) {
+            other.ops_->move(&storage_, &other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    static_assert(Capacity >= sizeof(void*), "Capacity must hold at least a pointer");
+
+    mutable std::aligned_storage_t<Capacity, alignof(std::max_align_t)> storage_;
+    const Ops* ops_ = nullptr;
+};
+
+} // namespace portal_core
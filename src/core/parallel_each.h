@@ -0,0 +1,211 @@
+#pragma once
+
+#include "worker_pool.h"
+#include "system_profiler.h"
+#include <entt/entt.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace portal_core
+{
+
+  /**
+   * 延遲結構變更緩衝
+   * 並行遍歷期間不能對註冊表做結構性修改（emplace/erase/destroy 會使 view 迭代器失效），
+   * 先記錄到緩衝中，遍歷結束後在單線程中統一執行
+   */
+  class DeferredCommands
+  {
+  public:
+    using Command = std::function<void(entt::registry &)>;
+
+    template <typename Component, typename... Args>
+    void emplace_or_replace(entt::entity entity, Args &&...args)
+    {
+      commands_.emplace_back(
+          [entity, captured = std::make_tuple(std::forward<Args>(args)...)](entt::registry &registry) mutable
+          {
+            std::apply([&registry, entity](auto &&...values)
+                       { registry.emplace_or_replace<Component>(entity, std::move(values)...); },
+                       std::move(captured));
+          });
+    }
+
+    template <typename... Components>
+    void remove(entt::entity entity)
+    {
+      commands_.emplace_back([entity](entt::registry &registry)
+                             { registry.remove<Components...>(entity); });
+    }
+
+    void destroy(entt::entity entity)
+    {
+      commands_.emplace_back([entity](entt::registry &registry)
+                             {
+                               if (registry.valid(entity))
+                               {
+                                 registry.destroy(entity);
+                               } });
+    }
+
+    /**
+     * 記錄任意延遲操作
+     */
+    void push(Command command) { commands_.push_back(std::move(command)); }
+
+    /**
+     * 按記錄順序執行所有延遲操作並清空緩衝
+     */
+    void flush(entt::registry &registry)
+    {
+      for (auto &command : commands_)
+      {
+        command(registry);
+      }
+      commands_.clear();
+    }
+
+    size_t size() const { return commands_.size(); }
+    bool empty() const { return commands_.empty(); }
+
+  private:
+    std::vector<Command> commands_;
+  };
+
+  // 每個任務塊的最小實體數：約等於組件數據佔滿 L1 緩存的量級，避免任務過碎
+  constexpr size_t DEFAULT_PARALLEL_CHUNK_SIZE = 1024;
+
+  namespace detail
+  {
+    template <typename View, typename Func>
+    void invoke_each(const View &view, entt::entity entity, const Func &func)
+    {
+      std::apply(func, std::tuple_cat(std::make_tuple(entity), view.get(entity)));
+    }
+
+    /**
+     * 把 [0, count) 切分成塊，每塊調用 run_chunk(chunk_index, begin, end)
+     */
+    template <typename RunChunk>
+    size_t dispatch_chunks(WorkerPool *pool, size_t count, size_t min_chunk_size, RunChunk &&run_chunk)
+    {
+      // 計入當前系統處理的實體數（性能分析用）
+      SystemProfiler::report_entities(count);
+
+      if (count == 0)
+      {
+        return 0;
+      }
+
+      min_chunk_size = std::max<size_t>(min_chunk_size, 1);
+      if (!pool || count <= min_chunk_size)
+      {
+        run_chunk(0, 0, count);
+        return 1;
+      }
+
+      // 每個線程約 4 個塊，便於負載不均時相互竊取
+      const size_t target_chunks = (pool->get_worker_count() + 1) * 4;
+      const size_t chunk_size = std::max(min_chunk_size, (count + target_chunks - 1) / target_chunks);
+      const size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+
+      TaskGroup group;
+      for (size_t chunk = 1; chunk < chunk_count; ++chunk)
+      {
+        size_t begin = chunk * chunk_size;
+        size_t end = std::min(count, begin + chunk_size);
+        pool->submit(group, [&run_chunk, chunk, begin, end]()
+                     { run_chunk(chunk, begin, end); });
+      }
+
+      // 第一塊由當前線程執行，隨後幫忙處理剩餘任務
+      pool->run_and_wait(group, [&]()
+                         { run_chunk(0, 0, std::min(count, chunk_size)); });
+      return chunk_count;
+    }
+
+    template <typename View, typename RunRange>
+    void for_each_range(WorkerPool *pool, const View &view, size_t min_chunk_size, RunRange &&run_range)
+    {
+      using Iterator = decltype(view.begin());
+      using Category = typename std::iterator_traits<Iterator>::iterator_category;
+
+      if constexpr (std::is_base_of_v<std::random_access_iterator_tag, Category>)
+      {
+        // 單組件 view 和 group 可以直接按下標切分
+        const Iterator first = view.begin();
+        const size_t count = static_cast<size_t>(std::distance(first, view.end()));
+        dispatch_chunks(pool, count, min_chunk_size, [&](size_t chunk, size_t begin, size_t end)
+                        { run_range(chunk, first + begin, first + end); });
+      }
+      else
+      {
+        // 多組件 view 的迭代器只能前向遍歷，先拍下實體快照再切分
+        std::vector<entt::entity> entities;
+        entities.reserve(view.size_hint());
+        for (const entt::entity entity : view)
+        {
+          entities.push_back(entity);
+        }
+
+        dispatch_chunks(pool, entities.size(), min_chunk_size, [&](size_t chunk, size_t begin, size_t end)
+                        { run_range(chunk, entities.begin() + begin, entities.begin() + end); });
+      }
+    }
+  } // namespace detail
+
+  /**
+   * 分塊並行遍歷 entt view / group
+   * func 的簽名與 view.each() 相同：func(entity, components&...)
+   * pool 為 nullptr 或實體數量不足一塊時在當前線程順序執行。
+   * 回調內只允許修改組件數據，不允許增刪組件或實體（請使用 parallel_each_deferred）
+   *
+   * @param pool 工作線程池，通常為 ISystem::get_worker_pool()
+   * @param min_chunk_size 每個任務塊的最小實體數
+   */
+  template <typename View, typename Func>
+  void parallel_each(WorkerPool *pool, const View &view, Func func,
+                     size_t min_chunk_size = DEFAULT_PARALLEL_CHUNK_SIZE)
+  {
+    detail::for_each_range(pool, view, min_chunk_size, [&view, &func](size_t, auto first, auto last)
+                           {
+                             for (; first != last; ++first)
+                             {
+                               detail::invoke_each(view, *first, func);
+                             } });
+  }
+
+  /**
+   * 帶延遲結構變更的分塊並行遍歷
+   * func 的簽名為 func(DeferredCommands &, entity, components&...)，
+   * 遍歷結束後按塊順序在當前線程執行所有記錄的操作，結果與順序遍歷一致
+   */
+  template <typename View, typename Func>
+  void parallel_each_deferred(WorkerPool *pool, entt::registry &registry, const View &view, Func func,
+                              size_t min_chunk_size = DEFAULT_PARALLEL_CHUNK_SIZE)
+  {
+    std::vector<DeferredCommands> chunk_commands;
+    const size_t max_chunks = pool ? (pool->get_worker_count() + 1) * 4 : 1;
+    chunk_commands.resize(max_chunks);
+
+    detail::for_each_range(pool, view, min_chunk_size, [&view, &func, &chunk_commands](size_t chunk, auto first, auto last)
+                           {
+                             DeferredCommands &commands = chunk_commands[chunk];
+                             for (; first != last; ++first)
+                             {
+                               const entt::entity entity = *first;
+                               std::apply(func, std::tuple_cat(std::forward_as_tuple(commands, entity), view.get(entity)));
+                             } });
+
+    for (DeferredCommands &commands : chunk_commands)
+    {
+      commands.flush(registry);
+    }
+  }
+
+} // namespace portal_core
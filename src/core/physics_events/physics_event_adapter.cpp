@@ -48,6 +48,9 @@ bool PhysicsEventAdapter::initialize() {
         }
     });
 
+    // 同一帧内同一物体的多次激活/休眠只分发最后的状态
+    event_manager_.set_event_coalescing<BodyActivationEvent>(coalesce_by_target_entity<BodyActivationEvent>);
+
     // 初始化BodyID到实体的映射
     update_body_entity_mapping();
 
@@ -323,7 +326,12 @@ bool PhysicsEventAdapter::is_plane_intersection(const Vec3& contact_normal, floa
 
 void PhysicsEventAdapter::process_pending_queries() {
     auto pending_view = registry_.view<PendingQueryTag, PhysicsEventQueryComponent>();
-    
+
+    raycast_query_batch_.clear();
+    raycast_query_targets_.clear();
+    overlap_query_batch_.clear();
+    overlap_query_targets_.clear();
+
     for (auto [entity, pending_tag, query_component] : pending_view.each()) {
         process_entity_queries(entity);
         
@@ -331,6 +339,10 @@ void PhysicsEventAdapter::process_pending_queries() {
         registry_.remove<PendingQueryTag>(entity);
         ++processed_queries_count_;
     }
+
+    // 所有实体的查询合并为每帧一次射线批量和一次重叠批量，批量足够大时由 Jolt 分给工作线程执行
+    execute_raycast_queries();
+    execute_overlap_queries();
 }
 
 void PhysicsEventAdapter::process_entity_queries(entt::entity entity) {
@@ -340,84 +352,100 @@ void PhysicsEventAdapter::process_entity_queries(entt::entity entity) {
         return;
     }
 
-    // 执行射线查询
-    if (!query_comp.raycast_queries.empty()) {
-        execute_raycast_queries(entity, query_comp);
+    // 收集射线查询
+    for (uint32_t i = 0; i < query_comp.raycast_queries.size(); ++i) {
+        const auto& raycast = query_comp.raycast_queries[i];
+        raycast_query_batch_.push_back({RVec3(raycast.origin.GetX(), raycast.origin.GetY(), raycast.origin.GetZ()),
+                                        raycast.direction, raycast.max_distance});
+        raycast_query_targets_.push_back({entity, i});
     }
 
-    // 执行重叠查询
-    if (!query_comp.overlap_queries.empty()) {
-        execute_overlap_queries(entity, query_comp);
+    // 收集重叠查询：只有球体与盒体进入批量，其他形状不查询，结果为空
+    for (uint32_t i = 0; i < query_comp.overlap_queries.size(); ++i) {
+        auto& overlap = query_comp.overlap_queries[i];
+        RVec3 center(overlap.center.GetX(), overlap.center.GetY(), overlap.center.GetZ());
+        if (overlap.shape == PhysicsQueryComponent::OverlapQuery::SPHERE) {
+            // 使用x分量作为半径
+            overlap_query_batch_.push_back(PhysicsWorldManager::OverlapQuery::sphere(center, overlap.size.GetX()));
+        } else if (overlap.shape == PhysicsQueryComponent::OverlapQuery::BOX) {
+            overlap_query_batch_.push_back(PhysicsWorldManager::OverlapQuery::box(center, overlap.size, overlap.rotation));
+        } else {
+            overlap.overlapping_entities.clear();
+            overlap_result_batch_.emplace_back(entity, overlap.center, overlap.size.GetX());
+            continue;
+        }
+        overlap_query_targets_.push_back({entity, i});
     }
 
     // 标记查询已处理
     query_comp.has_pending_queries = false;
 }
 
-void PhysicsEventAdapter::execute_raycast_queries(entt::entity entity, PhysicsEventQueryComponent& query_comp) {
-    for (auto& raycast : query_comp.raycast_queries) {
-        // 执行射线检测
-        auto result = physics_world_.raycast(RVec3(raycast.origin.GetX(), raycast.origin.GetY(), raycast.origin.GetZ()),
-                                           raycast.direction, raycast.max_distance);
-        
+void PhysicsEventAdapter::execute_raycast_queries() {
+    if (!raycast_query_batch_.empty()) {
+        physics_world_.raycast_batch(raycast_query_batch_, raycast_query_results_);
+    }
+
+    // 按批量槽位把结果写回各实体的查询
+    for (size_t i = 0; i < raycast_query_targets_.size(); ++i) {
+        const QueryTarget& target = raycast_query_targets_[i];
+        auto& raycast = registry_.get<PhysicsEventQueryComponent>(target.entity).raycast_queries[target.index];
+
         // 更新查询结果
-        raycast.hit = result.hit;
-        raycast.hit_point = result.hit_point;
-        raycast.hit_normal = result.hit_normal;
-        raycast.hit_distance = result.distance;
-        raycast.hit_entity = body_id_to_entity(result.body_id);
+        raycast.hit = raycast_query_results_.hit[i] != 0;
+        raycast.hit_point = raycast_query_results_.hit_points[i];
+        raycast.hit_normal = raycast_query_results_.hit_normals[i];
+        raycast.hit_distance = raycast_query_results_.distances[i];
+        raycast.hit_entity = body_id_to_entity(raycast_query_results_.body_ids[i]);
 
         // 检测相交维度
         auto dimension = detect_intersection_dimension(raycast.hit_point, raycast.hit_normal);
 
-        // 发送结果事件
-        auto result_event = RaycastResultEvent(entity, raycast.hit, raycast.hit_point, raycast.hit_normal,
-                                             raycast.hit_distance, raycast.hit_entity, dimension);
-        
-        // 队列事件 - 批量处理
-        event_manager_.enqueue(result_event, EventMetadata{EventPriority::NORMAL, 0.0f, true, "raycast"});
+        // 收集结果事件
+        raycast_result_batch_.emplace_back(target.entity, raycast.hit, raycast.hit_point, raycast.hit_normal,
+                                           raycast.hit_distance, raycast.hit_entity, dimension);
+    }
+
+    // 队列事件 - 整段入队
+    if (!raycast_result_batch_.empty()) {
+        event_manager_.publish_batch(raycast_result_batch_, EventHandlingStrategy::QUEUED,
+                                     EventMetadata{EventPriority::NORMAL, 0.0f, true, "raycast"});
+        raycast_result_batch_.clear();
     }
 }
 
-void PhysicsEventAdapter::execute_overlap_queries(entt::entity entity, PhysicsEventQueryComponent& query_comp) {
-    for (auto& overlap : query_comp.overlap_queries) {
+void PhysicsEventAdapter::execute_overlap_queries() {
+    if (!overlap_query_batch_.empty()) {
+        physics_world_.overlap_batch(overlap_query_batch_, overlap_query_results_);
+    }
+
+    // 按批量槽位把结果写回各实体的查询
+    for (size_t i = 0; i < overlap_query_targets_.size(); ++i) {
+        const QueryTarget& target = overlap_query_targets_[i];
+        auto& overlap = registry_.get<PhysicsEventQueryComponent>(target.entity).overlap_queries[target.index];
         std::vector<entt::entity> overlapping_entities;
 
-        if (overlap.shape == PhysicsQueryComponent::OverlapQuery::SPHERE) {
-            // 球体重叠查询
-            auto bodies = physics_world_.overlap_sphere(
-                RVec3(overlap.center.GetX(), overlap.center.GetY(), overlap.center.GetZ()), 
-                overlap.size.GetX());  // 使用x分量作为半径
-                
-            for (auto body_id : bodies) {
-                auto overlapped_entity = body_id_to_entity(body_id);
-                if (overlapped_entity != entt::null && overlapped_entity != entity) {
-                    overlapping_entities.push_back(overlapped_entity);
-                }
-            }
-        } else if (overlap.shape == PhysicsQueryComponent::OverlapQuery::BOX) {
-            // 盒体重叠查询
-            auto bodies = physics_world_.overlap_box(
-                RVec3(overlap.center.GetX(), overlap.center.GetY(), overlap.center.GetZ()), 
-                overlap.size, overlap.rotation);
-                
-            for (auto body_id : bodies) {
-                auto overlapped_entity = body_id_to_entity(body_id);
-                if (overlapped_entity != entt::null && overlapped_entity != entity) {
-                    overlapping_entities.push_back(overlapped_entity);
-                }
+        const uint32_t first = overlap_query_results_.first[i];
+        for (uint32_t j = first; j < first + overlap_query_results_.count[i]; ++j) {
+            auto overlapped_entity = body_id_to_entity(overlap_query_results_.body_ids[j]);
+            if (overlapped_entity != entt::null && overlapped_entity != target.entity) {
+                overlapping_entities.push_back(overlapped_entity);
             }
         }
 
         // 更新查询结果
         overlap.overlapping_entities = overlapping_entities;
 
-        // 发送重叠查询结果事件
-        auto result_event = OverlapQueryResultEvent(entity, overlap.center, overlap.size.GetX());
-        result_event.overlapping_entities = std::move(overlapping_entities);
-        
-        // 队列事件 - 批量处理
-        event_manager_.enqueue(result_event, EventMetadata{EventPriority::NORMAL, 0.0f, true, "overlap"});
+        // 收集重叠查询结果事件
+        overlap_result_batch_.emplace_back(target.entity, overlap.center, overlap.size.GetX());
+        overlap_result_batch_.back().overlapping_entities = std::move(overlapping_entities);
+    }
+
+    // 队列事件 - 整段入队（包含不支持形状的空结果）
+    if (!overlap_result_batch_.empty()) {
+        event_manager_.publish_batch(overlap_result_batch_, EventHandlingStrategy::QUEUED,
+                                     EventMetadata{EventPriority::NORMAL, 0.0f, true, "overlap"});
+        overlap_result_batch_.clear();
     }
 }
 
@@ -578,15 +606,17 @@ void PhysicsEventAdapter::process_persistent_contacts(float delta_time) {
                                                       contact_comp.contact_point, contact_comp.contact_normal,
                                                       contact_comp.contact_force);
             persistent_event.collision_type = "persistent_contact";
-            
-            // 队列事件 - 持续接触不需要立即处理
-            event_manager_.enqueue(persistent_event, 
-                EventMetadata{EventPriority::LOW, 0.0f, true, "persistent_contact"});
+            persistent_contact_batch_.push_back(std::move(persistent_event));
             
             // 避免重复触发
             contact_comp.notify_on_threshold = false;
         }
     }
+
+    // 队列事件 - 持续接触不需要立即处理，整段入队
+    event_manager_.publish_batch(persistent_contact_batch_, EventHandlingStrategy::QUEUED,
+                                 EventMetadata{EventPriority::LOW, 0.0f, true, "persistent_contact"});
+    persistent_contact_batch_.clear();
 }
 
 void PhysicsEventAdapter::debug_log(const std::string& message) {
@@ -99,6 +99,25 @@ private:
      */
     std::unordered_map<uint32_t, entt::entity> body_to_entity_map_;
 
+    // 批量结果事件缓冲：收集后整段入队，清空时保留容量
+    std::vector<RaycastResultEvent> raycast_result_batch_;
+    std::vector<OverlapQueryResultEvent> overlap_result_batch_;
+
+    // 批量射线/重叠查询的输入与结构数组结果，清空时保留容量
+    std::vector<PhysicsWorldManager::RaycastQuery> raycast_query_batch_;
+    PhysicsWorldManager::RaycastBatchResults raycast_query_results_;
+    std::vector<PhysicsWorldManager::OverlapQuery> overlap_query_batch_;
+    PhysicsWorldManager::OverlapBatchResults overlap_query_results_;
+
+    // 批量槽位对应的实体与查询序号，用于把结果写回各实体
+    struct QueryTarget {
+        entt::entity entity;
+        uint32_t index;
+    };
+    std::vector<QueryTarget> raycast_query_targets_;
+    std::vector<QueryTarget> overlap_query_targets_;
+    std::vector<CollisionStartEvent> persistent_contact_batch_;
+
     /**
      * 更新BodyID到实体的映射缓存
      */
@@ -158,19 +177,19 @@ private:
     void process_pending_queries();
 
     /**
-     * 处理单个实体的查询
+     * 收集单个实体的查询到本帧的批量中
      */
     void process_entity_queries(entt::entity entity);
 
     /**
-     * 执行射线查询并发送结果事件
+     * 批量执行本帧收集的射线查询并发送结果事件
      */
-    void execute_raycast_queries(entt::entity entity, PhysicsEventQueryComponent& query_comp);
+    void execute_raycast_queries();
 
     /**
-     * 执行重叠查询并发送结果事件
+     * 批量执行本帧收集的重叠查询并发送结果事件
      */
-    void execute_overlap_queries(entt::entity entity, PhysicsEventQueryComponent& query_comp);
+    void execute_overlap_queries();
 
     // === 事件分发辅助方法 ===
 
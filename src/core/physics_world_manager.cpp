@@ -1,5 +1,10 @@
 #include "physics_world_manager.h"
+#include "frame_tracer.h"
 #include <Jolt/Physics/Collision/Shape/Shape.h>
+#include <Jolt/Physics/Body/BodyLockMulti.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <cstdarg>
 #include <cstdint>
@@ -258,6 +263,9 @@ namespace portal_core
 
         std::cout << "PhysicsWorldManager: Cleaning up..." << std::endl;
 
+        // 形狀必須在 Jolt 清理之前釋放
+        shape_cache_.clear();
+
         // 清理物理系統
         physics_system_.reset();
         job_system_.reset();
@@ -272,6 +280,10 @@ namespace portal_core
 
         cleanup_jolt();
 
+        // 重新初始化時不沿用上一個世界的積壓時間
+        accumulated_time_ = 0.0f;
+        step_stats_ = StepStats();
+
         initialized_ = false;
         std::cout << "PhysicsWorldManager: Cleanup complete." << std::endl;
     }
@@ -314,62 +326,188 @@ namespace portal_core
             return;
         }
 
+        PORTAL_TRACE_SCOPE_CATEGORY("PhysicsWorldManager::update", "physics");
+
         accumulated_time_ += delta_time;
+        begin_step_frame();
+
+        const uint32_t pending = static_cast<uint32_t>(std::min(std::floor(accumulated_time_ / fixed_timestep_), 1.0e6f));
+        if (pending == 0)
+        {
+            return;
+        }
+
+        // 積壓超過每幀上限時先合併相鄰固定步，合併後仍超出的部分丟棄
+        const uint32_t step_limit = get_step_limit(max_steps_per_frame_);
+        uint32_t merge = 1;
+        if (pending > step_limit)
+        {
+            merge = std::min(max_merged_steps_, (pending + step_limit - 1) / step_limit);
+            step_stats_.dropped_steps = pending - std::min(pending, step_limit * merge);
+        }
+        accumulated_time_ -= static_cast<float>(pending) * fixed_timestep_;
+
+        // 測一次活動物體的最大速度，供本幀選擇碰撞子步數
+        if (adaptive_collision_steps_)
+        {
+            measure_max_body_speed();
+        }
 
         // 固定時間步進
-        while (accumulated_time_ >= fixed_timestep_)
+        uint32_t remaining = pending - step_stats_.dropped_steps;
+        const uint32_t steps_this_frame = (remaining + merge - 1) / merge;
+        while (remaining > 0)
+        {
+            const uint32_t covered = std::min(merge, remaining);
+            run_physics_step(fixed_timestep_ * static_cast<float>(covered), steps_this_frame);
+            remaining -= covered;
+            step_stats_.steps++;
+            step_stats_.merged_steps += covered - 1;
+        }
+
+        if (step_stats_.dropped_steps > 0 && delta_time > 0.0f)
         {
-            physics_system_->Update(fixed_timestep_, collision_steps_, temp_allocator_.get(), job_system_.get());
-            accumulated_time_ -= fixed_timestep_;
+            const float dropped_time = static_cast<float>(step_stats_.dropped_steps) * fixed_timestep_;
+            step_stats_.time_scale = std::max(0.0f, 1.0f - dropped_time / delta_time);
         }
+        step_stats_.total_merged_steps += step_stats_.merged_steps;
+        step_stats_.total_dropped_steps += step_stats_.dropped_steps;
     }
 
-    BodyID PhysicsWorldManager::create_body(const PhysicsBodyDesc &desc)
+    bool PhysicsWorldManager::step(float timestep, uint32_t step_index, uint32_t steps_this_frame)
     {
-        if (!initialized_)
+        if (!initialized_ || timestep <= 0.0f)
         {
-            return BodyID();
+            return false;
         }
 
-        // 創建形狀
-        RefConst<Shape> shape = create_shape(desc.shape);
-        if (!shape)
+        PORTAL_TRACE_SCOPE_CATEGORY("PhysicsWorldManager::step", "physics");
+
+        // 每幀第一步按耗時預算確定本幀執行的步數，之後超出的步直接丟棄
+        if (step_index == 0)
         {
-            std::cerr << "PhysicsWorldManager: Failed to create shape for body." << std::endl;
-            return BodyID();
+            begin_step_frame();
+            steps_this_frame = std::max<uint32_t>(steps_this_frame, 1);
+            frame_step_limit_ = get_step_limit(steps_this_frame);
+            step_stats_.time_scale = static_cast<float>(frame_step_limit_) / static_cast<float>(steps_this_frame);
+            if (adaptive_collision_steps_)
+            {
+                measure_max_body_speed();
+            }
         }
 
-        // 創建物理材質（直接在BodyCreationSettings中設置）
-        // Jolt中摩擦力和彈性係數是直接在BodyCreationSettings中設置的
+        if (step_index >= frame_step_limit_)
+        {
+            step_stats_.dropped_steps++;
+            step_stats_.total_dropped_steps++;
+            return false;
+        }
 
-        // 創建body設定
-        BodyCreationSettings body_settings(shape, desc.position, desc.rotation,
-                                           get_motion_type(desc.body_type), get_object_layer(desc.body_type));
+        run_physics_step(timestep, frame_step_limit_);
+        step_stats_.steps++;
+        return true;
+    }
 
-        body_settings.mLinearVelocity = desc.linear_velocity;
-        body_settings.mAngularVelocity = desc.angular_velocity;
-        body_settings.mAllowSleeping = desc.allow_sleeping;
-        body_settings.mUserData = desc.user_data;
-        body_settings.mFriction = desc.material.friction;
-        body_settings.mRestitution = desc.material.restitution;
+    void PhysicsWorldManager::begin_step_frame()
+    {
+        step_stats_.steps = 0;
+        step_stats_.merged_steps = 0;
+        step_stats_.dropped_steps = 0;
+        step_stats_.time_scale = 1.0f;
+    }
 
-        // 只對動態和運動學物體設置質量屬性，靜態物體不需要
-        if (desc.body_type != PhysicsBodyType::STATIC && desc.body_type != PhysicsBodyType::TRIGGER)
+    void PhysicsWorldManager::run_physics_step(float timestep, uint32_t steps_this_frame)
+    {
+        const int collision_steps = select_collision_steps(timestep, steps_this_frame);
+
+        auto start = std::chrono::steady_clock::now();
+        physics_system_->Update(timestep, collision_steps, temp_allocator_.get(), job_system_.get());
+        const float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+        // 每個碰撞子步耗時的滑動平均
+        const float sample = elapsed / static_cast<float>(collision_steps);
+        float &cost = step_stats_.collision_step_cost;
+        cost = cost > 0.0f ? cost + 0.1f * (sample - cost) : sample;
+
+        step_stats_.collision_steps = collision_steps;
+        step_stats_.total_steps++;
+    }
+
+    int PhysicsWorldManager::select_collision_steps(float timestep, uint32_t steps_this_frame) const
+    {
+        if (!adaptive_collision_steps_)
         {
-            // 動態和運動學物體設置質量
-            body_settings.mOverrideMassProperties = EOverrideMassProperties::CalculateInertia;
-            body_settings.mMassPropertiesOverride.mMass = desc.material.density;
+            return collision_steps_;
+        }
+
+        // 步長越長子步越多；快速物體每個子步的位移不超過上限，避免穿透
+        int steps = static_cast<int>(std::ceil(timestep / COLLISION_STEP_INTERVAL - 0.001f));
+        if (max_travel_per_collision_step_ > 0.0f)
+        {
+            const float travel = step_stats_.max_body_speed * timestep;
+            steps = std::max(steps, static_cast<int>(std::ceil(travel / max_travel_per_collision_step_)));
+        }
+        steps = std::clamp(steps, min_collision_steps_, max_collision_steps_);
+
+        // 有耗時預算時，本幀所有步的子步總耗時不超過預算
+        if (step_time_budget_ > 0.0f && step_stats_.collision_step_cost > 0.0f)
+        {
+            const float per_step_budget = step_time_budget_ / static_cast<float>(std::max<uint32_t>(steps_this_frame, 1));
+            const int affordable = static_cast<int>(per_step_budget / step_stats_.collision_step_cost);
+            steps = std::min(steps, std::max(affordable, min_collision_steps_));
+        }
+        return steps;
+    }
+
+    uint32_t PhysicsWorldManager::get_step_limit(uint32_t max_steps) const
+    {
+        if (step_time_budget_ <= 0.0f || step_stats_.collision_step_cost <= 0.0f)
+        {
+            return max_steps;
         }
-        // 靜態物體不設置任何質量屬性，保持默認的 CalculateMassAndInertia
 
-        // 創建並添加body，靜態物體不需要激活
-        EActivation activation = (desc.body_type == PhysicsBodyType::STATIC || desc.body_type == PhysicsBodyType::TRIGGER)
-                                     ? EActivation::DontActivate
-                                     : EActivation::Activate;
+        // 按最少子步數估算單步耗時，預算內至少執行一步
+        const float step_cost = step_stats_.collision_step_cost * static_cast<float>(min_collision_steps_);
+        const uint32_t affordable = static_cast<uint32_t>(std::min(step_time_budget_ / step_cost, 1.0e6f));
+        return std::clamp<uint32_t>(affordable, 1, max_steps);
+    }
+
+    void PhysicsWorldManager::measure_max_body_speed()
+    {
+        active_bodies_.clear();
+        physics_system_->GetActiveBodies(EBodyType::RigidBody, active_bodies_);
+
+        float max_speed_sq = 0.0f;
+        if (!active_bodies_.empty())
+        {
+            BodyLockMultiRead lock(physics_system_->GetBodyLockInterface(), active_bodies_.data(), static_cast<int>(active_bodies_.size()));
+            for (int i = 0; i < static_cast<int>(active_bodies_.size()); ++i)
+            {
+                if (const Body *body = lock.GetBody(i))
+                {
+                    max_speed_sq = std::max(max_speed_sq, body->GetLinearVelocity().LengthSq());
+                }
+            }
+        }
+        step_stats_.max_body_speed = std::sqrt(max_speed_sq);
+    }
+
+    BodyID PhysicsWorldManager::create_body(const PhysicsBodyDesc &desc)
+    {
+        if (!initialized_)
+        {
+            return BodyID();
+        }
+
+        BodyCreationSettings body_settings;
+        if (!make_body_settings(desc, body_settings))
+        {
+            return BodyID();
+        }
 
         // 創建並添加body
         BodyInterface &body_interface = physics_system_->GetBodyInterface();
-        BodyID body_id = body_interface.CreateAndAddBody(body_settings, activation);
+        BodyID body_id = body_interface.CreateAndAddBody(body_settings, get_activation(desc.body_type));
 
         if (body_id.IsInvalid())
         {
@@ -379,6 +517,68 @@ namespace portal_core
         return body_id;
     }
 
+    std::vector<BodyID> PhysicsWorldManager::create_bodies(const PhysicsBodyDesc *descs, size_t count)
+    {
+        std::vector<BodyID> body_ids(count);
+        if (!initialized_ || count == 0)
+        {
+            return body_ids;
+        }
+
+        PORTAL_TRACE_SCOPE_CATEGORY("PhysicsWorldManager::create_bodies", "physics");
+
+        // 先逐個創建物理體（不加入寬相），再按激活方式分兩組整批加入
+        BodyInterface &body_interface = physics_system_->GetBodyInterface();
+        std::vector<BodyID> activated;
+        std::vector<BodyID> not_activated;
+        BodyCreationSettings body_settings;
+        size_t failed = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!make_body_settings(descs[i], body_settings))
+            {
+                ++failed;
+                continue;
+            }
+            Body *body = body_interface.CreateBody(body_settings);
+            if (body == nullptr)
+            {
+                // 超出物理體上限
+                ++failed;
+                continue;
+            }
+            body_ids[i] = body->GetID();
+            if (get_activation(descs[i].body_type) == EActivation::Activate)
+            {
+                activated.push_back(body_ids[i]);
+            }
+            else
+            {
+                not_activated.push_back(body_ids[i]);
+            }
+        }
+
+        // AddBodiesPrepare 會重排傳入的數組，因此使用分組副本，body_ids 保持與 descs 對應
+        auto add_group = [&body_interface](std::vector<BodyID> &group, EActivation activation)
+        {
+            if (group.empty())
+            {
+                return;
+            }
+            const int group_size = static_cast<int>(group.size());
+            BodyInterface::AddState state = body_interface.AddBodiesPrepare(group.data(), group_size);
+            body_interface.AddBodiesFinalize(group.data(), group_size, state, activation);
+        };
+        add_group(activated, EActivation::Activate);
+        add_group(not_activated, EActivation::DontActivate);
+
+        if (failed > 0)
+        {
+            std::cerr << "PhysicsWorldManager: Failed to create " << failed << " of " << count << " physics bodies." << std::endl;
+        }
+        return body_ids;
+    }
+
     void PhysicsWorldManager::destroy_body(BodyID body_id)
     {
         if (!initialized_ || body_id.IsInvalid())
@@ -391,6 +591,95 @@ namespace portal_core
         body_interface.DestroyBody(body_id);
     }
 
+    void PhysicsWorldManager::destroy_bodies(const BodyID *body_ids, size_t count)
+    {
+        if (!initialized_ || count == 0)
+        {
+            return;
+        }
+
+        PORTAL_TRACE_SCOPE_CATEGORY("PhysicsWorldManager::destroy_bodies", "physics");
+
+        // RemoveBodies 只接受已加入寬相的物理體，並會重排數組
+        BodyInterface &body_interface = physics_system_->GetBodyInterface();
+        std::vector<BodyID> added;
+        std::vector<BodyID> valid;
+        added.reserve(count);
+        valid.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (body_ids[i].IsInvalid())
+            {
+                continue;
+            }
+            valid.push_back(body_ids[i]);
+            if (body_interface.IsAdded(body_ids[i]))
+            {
+                added.push_back(body_ids[i]);
+            }
+        }
+
+        if (!added.empty())
+        {
+            body_interface.RemoveBodies(added.data(), static_cast<int>(added.size()));
+        }
+        if (!valid.empty())
+        {
+            body_interface.DestroyBodies(valid.data(), static_cast<int>(valid.size()));
+        }
+    }
+
+    bool PhysicsWorldManager::make_body_settings(const PhysicsBodyDesc &desc, BodyCreationSettings &body_settings)
+    {
+        // 創建形狀（相同描述的形狀從緩存共享）
+        RefConst<Shape> shape = shape_cache_.find(desc.shape);
+        if (!shape)
+        {
+            shape = create_shape(desc.shape);
+            if (shape)
+            {
+                shape_cache_.insert(desc.shape, shape);
+            }
+        }
+        if (!shape)
+        {
+            std::cerr << "PhysicsWorldManager: Failed to create shape for body." << std::endl;
+            return false;
+        }
+
+        // 創建物理材質（直接在BodyCreationSettings中設置）
+        // Jolt中摩擦力和彈性係數是直接在BodyCreationSettings中設置的
+
+        // 創建body設定
+        body_settings = BodyCreationSettings(shape, desc.position, desc.rotation,
+                                             get_motion_type(desc.body_type), get_object_layer(desc.body_type));
+
+        body_settings.mLinearVelocity = desc.linear_velocity;
+        body_settings.mAngularVelocity = desc.angular_velocity;
+        body_settings.mAllowSleeping = desc.allow_sleeping;
+        body_settings.mUserData = desc.user_data;
+        body_settings.mFriction = desc.material.friction;
+        body_settings.mRestitution = desc.material.restitution;
+
+        // 只對動態和運動學物體設置質量屬性，靜態物體不需要
+        if (desc.body_type != PhysicsBodyType::STATIC && desc.body_type != PhysicsBodyType::TRIGGER)
+        {
+            // 動態和運動學物體設置質量
+            body_settings.mOverrideMassProperties = EOverrideMassProperties::CalculateInertia;
+            body_settings.mMassPropertiesOverride.mMass = desc.material.density;
+        }
+        // 靜態物體不設置任何質量屬性，保持默認的 CalculateMassAndInertia
+        return true;
+    }
+
+    EActivation PhysicsWorldManager::get_activation(PhysicsBodyType type)
+    {
+        // 靜態物體不需要激活
+        return (type == PhysicsBodyType::STATIC || type == PhysicsBodyType::TRIGGER)
+                   ? EActivation::DontActivate
+                   : EActivation::Activate;
+    }
+
     bool PhysicsWorldManager::has_body(BodyID body_id) const
     {
         if (!initialized_ || body_id.IsInvalid())
@@ -481,6 +770,219 @@ namespace portal_core
         }
     }
 
+    // PhysicsShapeCache 實現
+
+    namespace
+    {
+        void hash_bytes(uint64_t &hash, const void *data, size_t size)
+        {
+            const unsigned char *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        }
+
+        void hash_float(uint64_t &hash, float value)
+        {
+            hash_bytes(hash, &value, sizeof(value));
+        }
+
+        void hash_vec3(uint64_t &hash, const Vec3 &value)
+        {
+            // 只取 XYZ，Jolt 的 Vec3 第四個分量未定義
+            hash_float(hash, value.GetX());
+            hash_float(hash, value.GetY());
+            hash_float(hash, value.GetZ());
+        }
+
+        bool same_vec3(const Vec3 &a, const Vec3 &b)
+        {
+            return a.GetX() == b.GetX() && a.GetY() == b.GetY() && a.GetZ() == b.GetZ();
+        }
+    }
+
+    uint64_t PhysicsShapeCache::hash_shape_desc(const PhysicsShapeDesc &desc)
+    {
+        // FNV-1a，只哈希該形狀類型實際使用的字段
+        uint64_t hash = 14695981039346656037ull;
+        const uint32_t type = static_cast<uint32_t>(desc.type);
+        hash_bytes(hash, &type, sizeof(type));
+
+        switch (desc.type)
+        {
+        case PhysicsShapeType::BOX:
+            hash_vec3(hash, desc.size);
+            break;
+        case PhysicsShapeType::SPHERE:
+            hash_float(hash, desc.radius);
+            break;
+        case PhysicsShapeType::CAPSULE:
+        case PhysicsShapeType::CYLINDER:
+            hash_float(hash, desc.radius);
+            hash_float(hash, desc.height);
+            break;
+        default:
+            for (const Vec3 &vertex : desc.vertices)
+            {
+                hash_vec3(hash, vertex);
+            }
+            if (!desc.indices.empty())
+            {
+                hash_bytes(hash, desc.indices.data(), desc.indices.size() * sizeof(uint32_t));
+            }
+            break;
+        }
+        return hash;
+    }
+
+    bool PhysicsShapeCache::is_same_shape(const PhysicsShapeDesc &a, const PhysicsShapeDesc &b)
+    {
+        if (a.type != b.type)
+        {
+            return false;
+        }
+
+        switch (a.type)
+        {
+        case PhysicsShapeType::BOX:
+            return same_vec3(a.size, b.size);
+        case PhysicsShapeType::SPHERE:
+            return a.radius == b.radius;
+        case PhysicsShapeType::CAPSULE:
+        case PhysicsShapeType::CYLINDER:
+            return a.radius == b.radius && a.height == b.height;
+        default:
+            return a.indices == b.indices &&
+                   std::equal(a.vertices.begin(), a.vertices.end(), b.vertices.begin(), b.vertices.end(), same_vec3);
+        }
+    }
+
+    RefConst<Shape> PhysicsShapeCache::find(const PhysicsShapeDesc &desc)
+    {
+        if (!enabled_)
+        {
+            return nullptr;
+        }
+
+        auto bucket = entries_.find(hash_shape_desc(desc));
+        if (bucket != entries_.end())
+        {
+            for (Entry &entry : bucket->second)
+            {
+                if (is_same_shape(entry.desc, desc))
+                {
+                    entry.idle_frames = 0;
+                    stats_.hits_this_frame++;
+                    stats_.total_hits++;
+                    stats_.bytes_saved_this_frame += entry.size_bytes;
+                    stats_.total_bytes_saved += entry.size_bytes;
+                    return entry.shape;
+                }
+            }
+        }
+
+        stats_.misses_this_frame++;
+        stats_.total_misses++;
+        return nullptr;
+    }
+
+    void PhysicsShapeCache::insert(const PhysicsShapeDesc &desc, const RefConst<Shape> &shape)
+    {
+        if (!enabled_ || !shape)
+        {
+            return;
+        }
+
+        Entry entry;
+        entry.desc = desc;
+        entry.shape = shape;
+        entry.size_bytes = shape->GetStats().mSizeBytes;
+        stats_.cached_shapes++;
+        stats_.cached_bytes += entry.size_bytes;
+        entries_[hash_shape_desc(desc)].push_back(std::move(entry));
+    }
+
+    void PhysicsShapeCache::end_frame()
+    {
+        stats_.last_frame_hits = stats_.hits_this_frame;
+        stats_.last_frame_misses = stats_.misses_this_frame;
+        stats_.last_frame_bytes_saved = stats_.bytes_saved_this_frame;
+        stats_.hits_this_frame = 0;
+        stats_.misses_this_frame = 0;
+        stats_.bytes_saved_this_frame = 0;
+
+        // 閒置計數：引用計數為 1 表示已沒有物理體使用該形狀
+        for (auto bucket = entries_.begin(); bucket != entries_.end();)
+        {
+            auto &bucket_entries = bucket->second;
+            bucket_entries.erase(std::remove_if(bucket_entries.begin(), bucket_entries.end(),
+                                                [this](Entry &entry)
+                                                {
+                                                    if (entry.shape->GetRefCount() > 1)
+                                                    {
+                                                        entry.idle_frames = 0;
+                                                        return false;
+                                                    }
+                                                    if (++entry.idle_frames < eviction_delay_)
+                                                    {
+                                                        return false;
+                                                    }
+                                                    remove_entry_stats(entry);
+                                                    return true;
+                                                }),
+                                 bucket_entries.end());
+            bucket = bucket_entries.empty() ? entries_.erase(bucket) : std::next(bucket);
+        }
+    }
+
+    size_t PhysicsShapeCache::evict_unused()
+    {
+        const uint64_t evicted_before = stats_.total_evicted;
+        for (auto bucket = entries_.begin(); bucket != entries_.end();)
+        {
+            auto &bucket_entries = bucket->second;
+            bucket_entries.erase(std::remove_if(bucket_entries.begin(), bucket_entries.end(),
+                                                [this](const Entry &entry)
+                                                {
+                                                    if (entry.shape->GetRefCount() > 1)
+                                                    {
+                                                        return false;
+                                                    }
+                                                    remove_entry_stats(entry);
+                                                    return true;
+                                                }),
+                                 bucket_entries.end());
+            bucket = bucket_entries.empty() ? entries_.erase(bucket) : std::next(bucket);
+        }
+        return static_cast<size_t>(stats_.total_evicted - evicted_before);
+    }
+
+    void PhysicsShapeCache::clear()
+    {
+        entries_.clear();
+        stats_.cached_shapes = 0;
+        stats_.cached_bytes = 0;
+    }
+
+    void PhysicsShapeCache::set_enabled(bool enabled)
+    {
+        enabled_ = enabled;
+        if (!enabled_)
+        {
+            // 已創建的物理體繼續持有各自的形狀
+            clear();
+        }
+    }
+
+    void PhysicsShapeCache::remove_entry_stats(const Entry &entry)
+    {
+        stats_.cached_shapes--;
+        stats_.cached_bytes -= entry.size_bytes;
+        stats_.total_evicted++;
+    }
+
     ObjectLayer PhysicsWorldManager::get_object_layer(PhysicsBodyType type)
     {
         switch (type)
@@ -564,6 +1066,22 @@ namespace portal_core
         body_interface.AddImpulse(body_id, impulse);
     }
 
+    void PhysicsWorldManager::add_force(BodyID body_id, const Vec3 &force, const RVec3 &position)
+    {
+        if (!initialized_ || body_id.IsInvalid())
+            return;
+        BodyInterface &body_interface = physics_system_->GetBodyInterface();
+        body_interface.AddForce(body_id, force, position);
+    }
+
+    void PhysicsWorldManager::add_impulse(BodyID body_id, const Vec3 &impulse, const RVec3 &position)
+    {
+        if (!initialized_ || body_id.IsInvalid())
+            return;
+        BodyInterface &body_interface = physics_system_->GetBodyInterface();
+        body_interface.AddImpulse(body_id, impulse, position);
+    }
+
     void PhysicsWorldManager::add_torque(BodyID body_id, const Vec3 &torque)
     {
         if (!initialized_ || body_id.IsInvalid())
@@ -628,17 +1146,117 @@ namespace portal_core
         if (!initialized_)
             return result;
 
+        cast_ray(RaycastQuery{origin, direction, max_distance}, result);
+        return result;
+    }
+
+    std::vector<BodyID> PhysicsWorldManager::overlap_sphere(const RVec3 &center, float radius)
+    {
+        std::vector<BodyID> results;
+        if (!initialized_)
+            return results;
+
+        collide_overlap_query(OverlapQuery::sphere(center, radius), results);
+        return results;
+    }
+
+    std::vector<BodyID> PhysicsWorldManager::overlap_box(const RVec3 &center, const Vec3 &half_extents, const Quat &rotation)
+    {
+        std::vector<BodyID> results;
+        if (!initialized_)
+            return results;
+
+        collide_overlap_query(OverlapQuery::box(center, half_extents, rotation), results);
+        return results;
+    }
+
+    void PhysicsWorldManager::raycast_batch(const RaycastQuery *queries, size_t query_count, RaycastBatchResults &results)
+    {
+        results.resize(query_count);
+        if (!initialized_ || query_count == 0)
+        {
+            std::fill(results.hit.begin(), results.hit.end(), uint8_t(0));
+            return;
+        }
+
+        PORTAL_TRACE_SCOPE_CATEGORY("PhysicsWorldManager::raycast_batch", "physics");
+
+        // 每個查詢只寫自己下標的結果，各塊之間無需同步
+        run_query_chunks(query_count, get_query_chunk_count(query_count),
+                         [this, queries, &results](size_t, size_t begin, size_t end)
+                         {
+                             for (size_t i = begin; i < end; ++i)
+                             {
+                                 RaycastResult hit;
+                                 cast_ray(queries[i], hit);
+                                 results.hit[i] = hit.hit ? 1 : 0;
+                                 results.body_ids[i] = hit.body_id;
+                                 results.distances[i] = hit.distance;
+                                 results.hit_points[i] = hit.hit_point;
+                                 results.hit_normals[i] = hit.hit_normal;
+                             }
+                         });
+    }
+
+    void PhysicsWorldManager::overlap_batch(const OverlapQuery *queries, size_t query_count, OverlapBatchResults &results)
+    {
+        results.first.resize(query_count);
+        results.count.resize(query_count);
+        results.body_ids.clear();
+        if (!initialized_ || query_count == 0)
+        {
+            std::fill(results.count.begin(), results.count.end(), 0u);
+            std::fill(results.first.begin(), results.first.end(), 0u);
+            return;
+        }
+
+        PORTAL_TRACE_SCOPE_CATEGORY("PhysicsWorldManager::overlap_batch", "physics");
+
+        // 每塊把命中寫入自己的暫存列表，結束後按塊順序拼接，結果保持查詢順序
+        const size_t chunk_count = get_query_chunk_count(query_count);
+        if (results.chunk_hits.size() < chunk_count)
+        {
+            results.chunk_hits.resize(chunk_count);
+        }
+        run_query_chunks(query_count, chunk_count,
+                         [this, queries, &results](size_t chunk, size_t begin, size_t end)
+                         {
+                             std::vector<BodyID> &hits = results.chunk_hits[chunk];
+                             hits.clear();
+                             for (size_t i = begin; i < end; ++i)
+                             {
+                                 const size_t before = hits.size();
+                                 collide_overlap_query(queries[i], hits);
+                                 results.count[i] = static_cast<uint32_t>(hits.size() - before);
+                             }
+                         });
+
+        uint32_t offset = 0;
+        for (size_t i = 0; i < query_count; ++i)
+        {
+            results.first[i] = offset;
+            offset += results.count[i];
+        }
+        results.body_ids.reserve(offset);
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+        {
+            results.body_ids.insert(results.body_ids.end(), results.chunk_hits[chunk].begin(), results.chunk_hits[chunk].end());
+        }
+    }
+
+    void PhysicsWorldManager::cast_ray(const RaycastQuery &query, RaycastResult &result)
+    {
         RRayCast ray;
-        ray.mOrigin = origin;
-        ray.mDirection = direction * max_distance;
+        ray.mOrigin = query.origin;
+        ray.mDirection = query.direction * query.max_distance;
         RayCastResult hit;
 
         if (physics_system_->GetNarrowPhaseQuery().CastRay(ray, hit))
         {
             result.hit = true;
             result.body_id = hit.mBodyID;
-            result.hit_point = Vec3(origin + direction * hit.mFraction * max_distance);
-            result.distance = hit.mFraction * max_distance;
+            result.hit_point = Vec3(query.origin + query.direction * hit.mFraction * query.max_distance);
+            result.distance = hit.mFraction * query.max_distance;
 
             // 獲取法線需要更詳細的查詢
             const BodyLockInterface &lock_interface = physics_system_->GetBodyLockInterface();
@@ -651,64 +1269,83 @@ namespace portal_core
                 result.hit_normal = body.GetWorldSpaceSurfaceNormal(hit.mSubShapeID2, RVec3(contact_point));
             }
         }
-
-        return result;
     }
 
-    std::vector<BodyID> PhysicsWorldManager::overlap_sphere(const RVec3 &center, float radius)
+    namespace
     {
-        std::vector<BodyID> results;
-        if (!initialized_)
-            return results;
+        // 直接把命中的物理體寫入輸出列表，避免 AllHitCollisionCollector 為每次查詢分配結果數組
+        class BodyIdCollector : public CollideShapeCollector
+        {
+        public:
+            explicit BodyIdCollector(std::vector<BodyID> &body_ids) : body_ids_(body_ids) {}
 
-        // 創建球體形狀進行重疊測試
-        Ref<SphereShape> sphere = new SphereShape(radius);
+            void AddHit(const CollideShapeResult &result) override
+            {
+                body_ids_.push_back(result.mBodyID2);
+            }
 
-        AllHitCollisionCollector<CollideShapeCollector> collector;
-        RMat44 transform = RMat44::sTranslation(center);
+        private:
+            std::vector<BodyID> &body_ids_;
+        };
+    }
 
+    void PhysicsWorldManager::collide_overlap_query(const OverlapQuery &query, std::vector<BodyID> &out_body_ids)
+    {
         // 創建CollideShapeSettings
         CollideShapeSettings settings;
         settings.mActiveEdgeMode = EActiveEdgeMode::CollideOnlyWithActive;
         settings.mCollectFacesMode = ECollectFacesMode::NoFaces;
 
-        physics_system_->GetNarrowPhaseQuery().CollideShape(sphere, Vec3::sReplicate(1.0f),
-                                                            transform, settings, RVec3::sZero(), collector);
+        BodyIdCollector collector(out_body_ids);
+        const NarrowPhaseQuery &query_interface = physics_system_->GetNarrowPhaseQuery();
 
-        for (const CollideShapeResult &hit : collector.mHits)
+        // 查詢形狀在棧上創建（嵌入式引用計數），不產生堆分配
+        if (query.type == OverlapQuery::Type::SPHERE)
         {
-            results.push_back(hit.mBodyID2);
+            SphereShape sphere(query.half_extents.GetX());
+            sphere.SetEmbedded();
+            query_interface.CollideShape(&sphere, Vec3::sReplicate(1.0f), RMat44::sTranslation(query.center),
+                                         settings, RVec3::sZero(), collector);
+        }
+        else
+        {
+            BoxShape box(query.half_extents);
+            box.SetEmbedded();
+            query_interface.CollideShape(&box, Vec3::sReplicate(1.0f), RMat44::sRotationTranslation(query.rotation, query.center),
+                                         settings, RVec3::sZero(), collector);
         }
-
-        return results;
     }
 
-    std::vector<BodyID> PhysicsWorldManager::overlap_box(const RVec3 &center, const Vec3 &half_extents, const Quat &rotation)
+    size_t PhysicsWorldManager::get_query_chunk_count(size_t query_count) const
     {
-        std::vector<BodyID> results;
-        if (!initialized_)
-            return results;
-
-        // 創建盒子形狀進行重疊測試
-        Ref<BoxShape> box = new BoxShape(half_extents);
-
-        AllHitCollisionCollector<CollideShapeCollector> collector;
-        RMat44 transform = RMat44::sRotationTranslation(rotation, center);
-
-        // 創建CollideShapeSettings
-        CollideShapeSettings settings;
-        settings.mActiveEdgeMode = EActiveEdgeMode::CollideOnlyWithActive;
-        settings.mCollectFacesMode = ECollectFacesMode::NoFaces;
-
-        physics_system_->GetNarrowPhaseQuery().CollideShape(box, Vec3::sReplicate(1.0f),
-                                                            transform, settings, RVec3::sZero(), collector);
+        const size_t max_chunks = job_system_ ? static_cast<size_t>(std::max(job_system_->GetMaxConcurrency(), 1)) : 1;
+        const size_t chunks = (query_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+        return std::max<size_t>(1, std::min(chunks, max_chunks));
+    }
 
-        for (const CollideShapeResult &hit : collector.mHits)
+    void PhysicsWorldManager::run_query_chunks(size_t query_count, size_t chunk_count,
+                                               const std::function<void(size_t, size_t, size_t)> &chunk_function)
+    {
+        if (chunk_count <= 1 || !job_system_)
         {
-            results.push_back(hit.mBodyID2);
+            chunk_function(0, 0, query_count);
+            return;
         }
 
-        return results;
+        // 查詢均分到各塊；等待屏障時調用線程也會參與執行任務
+        JobSystem::Barrier *barrier = job_system_->CreateBarrier();
+        const size_t per_chunk = (query_count + chunk_count - 1) / chunk_count;
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+        {
+            const size_t begin = std::min(chunk * per_chunk, query_count);
+            const size_t end = std::min(begin + per_chunk, query_count);
+            JobSystem::JobHandle job = job_system_->CreateJob("PhysicsQueryBatch", Color::sCyan,
+                                                              [&chunk_function, chunk, begin, end]()
+                                                              { chunk_function(chunk, begin, end); });
+            barrier->AddJob(job);
+        }
+        job_system_->WaitForJobs(barrier);
+        job_system_->DestroyBarrier(barrier);
     }
 
     // 事件回調設置
@@ -32,6 +32,7 @@
 #include <Jolt/Physics/Collision/PhysicsMaterial.h>
 #include <Jolt/Physics/Collision/CollideShape.h>
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -232,6 +233,80 @@ private:
     ActivationEventCallback body_deactivated_callback_;
 };
 
+// 物理形狀緩存
+// 以形狀類型、尺寸和頂點/索引內容為鍵共享 Jolt 形狀，描述相同的物理體使用同一個 Shape。
+// 只剩緩存持有（引用計數為 1）的形狀在閒置 eviction_delay 幀後淘汰。非線程安全。
+class PhysicsShapeCache {
+public:
+    struct Stats {
+        // 本幀，end_frame() 時歸檔為上一幀
+        uint32_t hits_this_frame = 0;
+        uint32_t misses_this_frame = 0;
+        size_t bytes_saved_this_frame = 0;
+
+        // 上一幀
+        uint32_t last_frame_hits = 0;
+        uint32_t last_frame_misses = 0;
+        size_t last_frame_bytes_saved = 0;
+
+        // 累計
+        uint64_t total_hits = 0;
+        uint64_t total_misses = 0;
+        uint64_t total_bytes_saved = 0;     // 命中時少創建的形狀內存
+        uint64_t total_evicted = 0;
+
+        // 當前緩存內容
+        uint32_t cached_shapes = 0;
+        size_t cached_bytes = 0;
+
+        float get_last_frame_hit_rate() const {
+            const uint32_t lookups = last_frame_hits + last_frame_misses;
+            return lookups > 0 ? static_cast<float>(last_frame_hits) / lookups : 0.0f;
+        }
+
+        float get_total_hit_rate() const {
+            const uint64_t lookups = total_hits + total_misses;
+            return lookups > 0 ? static_cast<float>(total_hits) / lookups : 0.0f;
+        }
+    };
+
+    // 查找與 desc 相同的已緩存形狀，未命中返回空
+    RefConst<Shape> find(const PhysicsShapeDesc& desc);
+    void insert(const PhysicsShapeDesc& desc, const RefConst<Shape>& shape);
+
+    // 歸檔本幀統計並淘汰閒置足夠久的形狀，每幀調用一次
+    void end_frame();
+    // 立即淘汰所有只被緩存持有的形狀，返回淘汰數量
+    size_t evict_unused();
+    void clear();
+
+    void set_enabled(bool enabled);
+    bool is_enabled() const { return enabled_; }
+    void set_eviction_delay(uint32_t frames) { eviction_delay_ = frames; }
+    uint32_t get_eviction_delay() const { return eviction_delay_; }
+
+    const Stats& get_stats() const { return stats_; }
+
+    static uint64_t hash_shape_desc(const PhysicsShapeDesc& desc);
+    static bool is_same_shape(const PhysicsShapeDesc& a, const PhysicsShapeDesc& b);
+
+private:
+    struct Entry {
+        PhysicsShapeDesc desc;
+        RefConst<Shape> shape;
+        size_t size_bytes = 0;
+        uint32_t idle_frames = 0;
+    };
+
+    void remove_entry_stats(const Entry& entry);
+
+    // 按內容哈希分桶，桶內逐項比較描述，哈希碰撞不會返回錯誤的形狀
+    std::unordered_map<uint64_t, std::vector<Entry>> entries_;
+    Stats stats_;
+    bool enabled_ = true;
+    uint32_t eviction_delay_ = 300;
+};
+
 // 物理世界管理器
 class PhysicsWorldManager {
 public:
@@ -247,14 +322,70 @@ public:
     bool is_initialized() const { return initialized_; }
     
     // 物理步進
-    void update(float delta_time);
+    void update(float delta_time);                 // 內部累積時間，按固定步長步進 0~N 次
+    // 由外部固定步長時鐘驅動時使用：step_index / steps_this_frame 為本幀第幾步及總步數，
+    // 每幀的步數上限由外部時鐘決定（SystemManager::set_max_fixed_steps_per_frame），這裡只按耗時預算
+    // 丟棄超出的步並據此選擇碰撞子步數。無法跨調用合併，單獨調用時按每幀一步處理；返回是否實際步進
+    bool step(float timestep, uint32_t step_index = 0, uint32_t steps_this_frame = 1);
     void set_fixed_timestep(float timestep) { fixed_timestep_ = timestep; }
+    float get_fixed_timestep() const { return fixed_timestep_; }
+    
+    // update 之後累積器中剩餘的時間 / 固定步長（0~1），用於在上一步與當前步的姿態間插值
+    float get_interpolation_alpha() const { return fixed_timestep_ > 0.0f ? accumulated_time_ / fixed_timestep_ : 0.0f; }
+    // 最近一次 update 執行的物理步數
+    uint32_t get_last_update_steps() const { return step_stats_.steps; }
+    
+    // 死亡螺旋保護（僅 update 使用自身累積器時生效）：每次 update 最多執行 max_steps_per_frame 個物理步。
+    // 積壓超過上限時可把相鄰固定步合併成較長的一步（每步最多 max_merged_steps 個固定步長，默認 1 即不合併），
+    // 仍不夠時丟棄剩餘積壓，遊戲時間相對變慢
+    void set_max_steps_per_frame(uint32_t max_steps) { max_steps_per_frame_ = std::max<uint32_t>(max_steps, 1); }
+    uint32_t get_max_steps_per_frame() const { return max_steps_per_frame_; }
+    void set_max_merged_steps(uint32_t max_merged) { max_merged_steps_ = std::max<uint32_t>(max_merged, 1); }
+    uint32_t get_max_merged_steps() const { return max_merged_steps_; }
+    
+    // 物理耗時預算（秒/幀，0 為不限制）：按測得的步進耗時進一步限制每幀步數和碰撞子步數，update 與 step 均生效
+    void set_step_time_budget(float seconds) { step_time_budget_ = std::max(seconds, 0.0f); }
+    float get_step_time_budget() const { return step_time_budget_; }
+    
+    // 碰撞子步數：關閉自適應時（默認）固定使用 collision_steps；開啟時按步長和最快活動物體的速度
+    // 在 [min, max] 內選擇，使物體每個子步移動不超過 max_travel_per_collision_step
+    void set_collision_steps(int steps) { collision_steps_ = std::max(steps, 1); }
+    int get_collision_steps() const { return collision_steps_; }
+    void set_adaptive_collision_steps(bool enable) { adaptive_collision_steps_ = enable; }
+    bool is_adaptive_collision_steps() const { return adaptive_collision_steps_; }
+    void set_collision_steps_range(int min_steps, int max_steps) {
+        min_collision_steps_ = std::max(min_steps, 1);
+        max_collision_steps_ = std::max(max_steps, min_collision_steps_);
+    }
+    void set_max_travel_per_collision_step(float distance) { max_travel_per_collision_step_ = distance; }
+    
+    struct StepStats {
+        uint32_t steps = 0;                  // 最近一幀執行的物理步數
+        uint32_t merged_steps = 0;           // 最近一幀被合併進較長步長的固定步數
+        uint32_t dropped_steps = 0;          // 最近一幀被丟棄的固定步數
+        float time_scale = 1.0f;             // 最近一幀的模擬時間 / 真實時間（丟步時小於 1）
+        int collision_steps = 1;             // 最近一步使用的碰撞子步數
+        float max_body_speed = 0.0f;         // 最近一次測得的活動物體最大線速度
+        float collision_step_cost = 0.0f;    // 每個碰撞子步的平均耗時（秒，滑動平均）
+        uint64_t total_steps = 0;
+        uint64_t total_merged_steps = 0;
+        uint64_t total_dropped_steps = 0;
+    };
+    
+    const StepStats& get_step_stats() const { return step_stats_; }
     
     // 物理體管理
     BodyID create_body(const PhysicsBodyDesc& desc);
     void destroy_body(BodyID body_id);
     bool has_body(BodyID body_id) const;
     
+    // 批量創建/銷毀：整批通過 AddBodiesPrepare/AddBodiesFinalize 加入寬相、RemoveBodies 移除，
+    // 一幀內加入大量物理體時避免逐個插入寬相樹。返回的 BodyID 與 descs 一一對應，失敗為無效 ID
+    std::vector<BodyID> create_bodies(const PhysicsBodyDesc* descs, size_t count);
+    std::vector<BodyID> create_bodies(const std::vector<PhysicsBodyDesc>& descs) { return create_bodies(descs.data(), descs.size()); }
+    void destroy_bodies(const BodyID* body_ids, size_t count);
+    void destroy_bodies(const std::vector<BodyID>& body_ids) { destroy_bodies(body_ids.data(), body_ids.size()); }
+    
     // 物理體控制
     void set_body_position(BodyID body_id, const RVec3& position);
     void set_body_rotation(BodyID body_id, const Quat& rotation);
@@ -262,6 +393,8 @@ public:
     void set_body_angular_velocity(BodyID body_id, const Vec3& velocity);
     void add_force(BodyID body_id, const Vec3& force);
     void add_impulse(BodyID body_id, const Vec3& impulse);
+    void add_force(BodyID body_id, const Vec3& force, const RVec3& position);     // 作用於世界座標 position，同時產生扭矩
+    void add_impulse(BodyID body_id, const Vec3& impulse, const RVec3& position); // 作用於世界座標 position，同時產生角衝量
     void add_torque(BodyID body_id, const Vec3& torque);
     void add_angular_impulse(BodyID body_id, const Vec3& impulse);
     
@@ -285,12 +418,74 @@ public:
     std::vector<BodyID> overlap_sphere(const RVec3& center, float radius);
     std::vector<BodyID> overlap_box(const RVec3& center, const Vec3& half_extents, const Quat& rotation = Quat::sIdentity());
     
+    // 批量查詢：查詢按塊分配到 Jolt 任務系統並行執行，結果寫入調用者持有的結構數組緩衝區。
+    // 緩衝區跨幀重用時不再分配內存；查詢期間不能同時步進物理世界
+    struct RaycastQuery {
+        RVec3 origin;
+        Vec3 direction;
+        float max_distance = 1000.0f;
+    };
+    
+    struct RaycastBatchResults {
+        std::vector<uint8_t> hit;
+        std::vector<BodyID> body_ids;
+        std::vector<float> distances;
+        std::vector<Vec3> hit_points;
+        std::vector<Vec3> hit_normals;
+        
+        size_t size() const { return hit.size(); }
+        void resize(size_t count) {
+            hit.resize(count);
+            body_ids.resize(count);
+            distances.resize(count);
+            hit_points.resize(count);
+            hit_normals.resize(count);
+        }
+    };
+    
+    struct OverlapQuery {
+        enum class Type : uint8_t { SPHERE, BOX };
+        Type type = Type::SPHERE;
+        RVec3 center;
+        Vec3 half_extents;   // 球體使用 x 分量作為半徑
+        Quat rotation = Quat::sIdentity();
+        
+        static OverlapQuery sphere(const RVec3& center, float radius) {
+            return {Type::SPHERE, center, Vec3::sReplicate(radius), Quat::sIdentity()};
+        }
+        static OverlapQuery box(const RVec3& center, const Vec3& half_extents, const Quat& rotation = Quat::sIdentity()) {
+            return {Type::BOX, center, half_extents, rotation};
+        }
+    };
+    
+    // 第 i 個查詢的結果為 body_ids[first[i], first[i] + count[i])
+    struct OverlapBatchResults {
+        std::vector<uint32_t> first;
+        std::vector<uint32_t> count;
+        std::vector<BodyID> body_ids;
+        std::vector<std::vector<BodyID>> chunk_hits;   // 每個任務塊的暫存結果
+        
+        size_t size() const { return count.size(); }
+    };
+    
+    void raycast_batch(const RaycastQuery* queries, size_t query_count, RaycastBatchResults& results);
+    void raycast_batch(const std::vector<RaycastQuery>& queries, RaycastBatchResults& results) { raycast_batch(queries.data(), queries.size(), results); }
+    void overlap_batch(const OverlapQuery* queries, size_t query_count, OverlapBatchResults& results);
+    void overlap_batch(const std::vector<OverlapQuery>& queries, OverlapBatchResults& results) { overlap_batch(queries.data(), queries.size(), results); }
+    
+    // 每個查詢任務最少處理的查詢數，查詢數不足兩塊時在調用線程直接執行
+    static constexpr size_t QUERY_BATCH_CHUNK_SIZE = 64;
+    
     // 事件回調設置
     void set_contact_added_callback(PhysicsContactListener::ContactEventCallback callback);
     void set_contact_removed_callback(PhysicsContactListener::ContactEventCallback callback);
     void set_body_activated_callback(PhysicsActivationListener::ActivationEventCallback callback);
     void set_body_deactivated_callback(PhysicsActivationListener::ActivationEventCallback callback);
     
+    // 形狀緩存：create_body 通過它共享相同描述的形狀
+    PhysicsShapeCache& get_shape_cache() { return shape_cache_; }
+    const PhysicsShapeCache& get_shape_cache() const { return shape_cache_; }
+    
     // 獲取底層系統訪問（高級用途）
     JPH::PhysicsSystem& get_physics_system() { return *physics_system_; }
     const JPH::PhysicsSystem& get_physics_system() const { return *physics_system_; }
@@ -321,8 +516,19 @@ private:
     
     // 形狀創建輔助函數
     RefConst<Shape> create_shape(const PhysicsShapeDesc& desc);
+    bool make_body_settings(const PhysicsBodyDesc& desc, BodyCreationSettings& body_settings);
+    void run_physics_step(float timestep, uint32_t steps_this_frame);
+    int select_collision_steps(float timestep, uint32_t steps_this_frame) const;
+    void begin_step_frame();
+    uint32_t get_step_limit(uint32_t max_steps) const;
+    void measure_max_body_speed();
+    void cast_ray(const RaycastQuery& query, RaycastResult& result);
+    void collide_overlap_query(const OverlapQuery& query, std::vector<BodyID>& out_body_ids);
+    size_t get_query_chunk_count(size_t query_count) const;
+    void run_query_chunks(size_t query_count, size_t chunk_count, const std::function<void(size_t, size_t, size_t)>& chunk_function);
     ObjectLayer get_object_layer(PhysicsBodyType type);
     EMotionType get_motion_type(PhysicsBodyType type);
+    EActivation get_activation(PhysicsBodyType type);
     
     // 初始化狀態
     bool initialized_ = false;
@@ -344,9 +550,27 @@ private:
     float accumulated_time_ = 0.0f;
     int collision_steps_ = 1;
     
+    // 步進保護與自適應碰撞子步
+    uint32_t max_steps_per_frame_ = 8;   // 與 SystemManager 每幀固定步數上限的默認值一致
+    uint32_t max_merged_steps_ = 1;
+    float step_time_budget_ = 0.0f;
+    bool adaptive_collision_steps_ = false;
+    uint32_t frame_step_limit_ = 1;      // step 驅動時本幀實際執行的步數
+    int min_collision_steps_ = 1;
+    int max_collision_steps_ = 4;
+    float max_travel_per_collision_step_ = 0.5f;
+    StepStats step_stats_;
+    Array<BodyID> active_bodies_;
+    
+    // Jolt 建議每 1/60 秒至少一個碰撞子步
+    static constexpr float COLLISION_STEP_INTERVAL = 1.0f / 60.0f;
+    
     // 調試設定
     bool debug_rendering_enabled_ = false;
     
+    // 形狀緩存
+    PhysicsShapeCache shape_cache_;
+    
     // 統計數據
     mutable PhysicsStats last_stats_;
     
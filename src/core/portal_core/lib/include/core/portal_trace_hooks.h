@@ -0,0 +1,72 @@
+#ifndef PORTAL_TRACE_HOOKS_H
+#define PORTAL_TRACE_HOOKS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Portal
+{
+
+  /**
+   * 追蹤回調：記錄一個完整的作用域事件
+   * 時間戳為 std::chrono::steady_clock 的納秒數，與宿主追蹤器的時鐘一致
+   *
+   * 本庫不依賴任何追蹤實現，由宿主在初始化時安裝回調，例如：
+   *   Portal::set_trace_callback(&portal_core::FrameTracer::record);
+   * 未安裝時每個作用域只有一次原子讀取的開銷
+   */
+  using TraceCallback = void (*)(const char *name, const char *category, uint64_t start_ns, uint64_t end_ns);
+
+  inline std::atomic<TraceCallback> &trace_callback_slot()
+  {
+    static std::atomic<TraceCallback> callback{nullptr};
+    return callback;
+  }
+
+  inline void set_trace_callback(TraceCallback callback)
+  {
+    trace_callback_slot().store(callback, std::memory_order_release);
+  }
+
+  /**
+   * RAII 追蹤作用域，name 必須指向靜態存儲的字符串
+   */
+  class TraceScope
+  {
+  public:
+    explicit TraceScope(const char *name, const char *category = "portal")
+        : name_(name), category_(category),
+          callback_(trace_callback_slot().load(std::memory_order_acquire)),
+          start_ns_(callback_ ? now_ns() : 0)
+    {
+    }
+
+    ~TraceScope()
+    {
+      if (callback_)
+      {
+        callback_(name_, category_, start_ns_, now_ns());
+      }
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+  private:
+    static uint64_t now_ns()
+    {
+      return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::steady_clock::now().time_since_epoch())
+                                       .count());
+    }
+
+    const char *name_;
+    const char *category_;
+    TraceCallback callback_;
+    uint64_t start_ns_;
+  };
+
+} // namespace Portal
+
+#endif // PORTAL_TRACE_HOOKS_H
@@ -73,6 +73,7 @@
 #include "core/portal_center_of_mass.h"
 #include "core/portal_teleport_manager.h"
 #include "core/portal_manager.h"
+#include "core/portal_trace_hooks.h"
 
 /**
  * 主要命名空間
@@ -1,5 +1,6 @@
 #include "../../include/core/portal_teleport_manager.h"
 #include "../../include/core/portal.h"
+#include "../../include/core/portal_trace_hooks.h"
 #include "../../include/math/portal_math.h"
 #include "../../include/rendering/multi_segment_clipping.h"
 #include <iostream>
@@ -49,6 +50,7 @@ namespace Portal
 
   void TeleportManager::update(float delta_time)
   {
+    TraceScope trace_scope("TeleportManager::update", "portal");
     std::cout << "DEBUG: TeleportManager::update() start" << std::endl;
     ghost_sync_timer_ += delta_time;
 
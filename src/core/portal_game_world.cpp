@@ -119,6 +119,8 @@ namespace portal_core
     system_manager_.update_systems(registry_, delta_time);
     
     // 2. 在所有系统更新后，处理队列中的事件
+    //    并行分发与系统共用常驻线程池（未启用并行执行时为 nullptr，退回顺序分发）
+    event_manager_.set_worker_pool(system_manager_.get_worker_pool());
     event_manager_.process_queued_events(delta_time);
   }
 
@@ -1,4 +1,5 @@
 #include "unified_render_manager.h"
+#include "../frame_tracer.h"
 #include <algorithm>
 #include <iostream>
 #include <cstring>
@@ -170,6 +171,7 @@ void UnifiedRenderManager::clear_expired_commands(float delta_time) {
 
 void UnifiedRenderManager::flush_commands() {
     if (!enabled_) return;
+    PORTAL_TRACE_SCOPE_CATEGORY("UnifiedRenderManager::flush_commands", "render");
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
@@ -1,14 +1,215 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <memory>
 
 namespace portal_core
 {
 
+  class WorkerPool;
+
+  /**
+   * 幀管線階段
+   * SystemManager 每幀按以下順序執行各階段，每個階段有獨立的分層任務圖
+   */
+  enum class SystemPhase
+  {
+    PreUpdate,     // 輸入、命令收集等幀開始前的準備
+    FixedUpdate,   // 固定時間步進（物理等），每幀可能執行 0~N 次
+    Update,        // 可變時間步的遊戲邏輯（默認階段）
+    PostUpdate,    // 依賴本幀邏輯結果的後處理
+    RenderExtract, // 為渲染提取數據
+    Count
+  };
+
+  constexpr size_t SYSTEM_PHASE_COUNT = static_cast<size_t>(SystemPhase::Count);
+
+  inline const char *get_phase_name(SystemPhase phase)
+  {
+    switch (phase)
+    {
+    case SystemPhase::PreUpdate:
+      return "PreUpdate";
+    case SystemPhase::FixedUpdate:
+      return "FixedUpdate";
+    case SystemPhase::Update:
+      return "Update";
+    case SystemPhase::PostUpdate:
+      return "PostUpdate";
+    case SystemPhase::RenderExtract:
+      return "RenderExtract";
+    default:
+      return "Unknown";
+    }
+  }
+
+  /**
+   * 當前幀的時間信息（由 SystemManager 維護並注入系統）
+   */
+  struct FrameTiming
+  {
+    uint64_t frame_index = 0;
+    float delta_time = 0.0f;            // 本幀可變時間步
+    float fixed_timestep = 1.0f / 60.0f; // 固定步長
+    uint32_t fixed_step_count = 0;       // 本幀執行的固定步數
+    uint32_t fixed_step_index = 0;       // 當前固定步序號（僅在 FixedUpdate 中有效）
+    uint32_t dropped_fixed_steps = 0;    // 因超過每幀上限而丟棄的固定步數
+    float interpolation_alpha = 0.0f;    // 剩餘累積時間 / 固定步長，用於渲染插值
+
+    bool is_first_fixed_step() const { return fixed_step_index == 0; }
+    bool is_last_fixed_step() const { return fixed_step_index + 1 >= fixed_step_count; }
+  };
+
+  /**
+   * 系統組件訪問聲明
+   * 描述系統讀取/寫入哪些組件類型，調度器據此推導數據衝突並決定能否並行。
+   * 沿用 entt::organizer 的約定：const T 表示只讀，T 表示讀寫；
+   * entt::registry 表示獨占整個註冊表（例如創建/銷毀實體），const entt::registry 表示只讀整個註冊表。
+   */
+  struct ComponentAccess
+  {
+    struct Entry
+    {
+      entt::id_type id;
+      std::string_view name;
+    };
+
+    std::vector<Entry> reads;
+    std::vector<Entry> writes;
+    bool reads_registry = false;
+    bool writes_registry = false;
+    bool declared = false; // 未聲明的系統不參與數據衝突推導
+
+    template <typename Component>
+    void add()
+    {
+      using RawType = std::remove_const_t<Component>;
+      declared = true;
+
+      if constexpr (std::is_same_v<RawType, entt::registry>)
+      {
+        (std::is_const_v<Component> ? reads_registry : writes_registry) = true;
+      }
+      else
+      {
+        Entry entry{entt::type_hash<RawType>::value(), entt::type_name<RawType>::value()};
+        auto &target = std::is_const_v<Component> ? reads : writes;
+        if (!contains(target, entry.id))
+        {
+          target.push_back(entry);
+        }
+      }
+    }
+
+    /**
+     * 合併另一份聲明（取並集）
+     */
+    void merge(const ComponentAccess &other)
+    {
+      if (!other.declared)
+      {
+        return;
+      }
+      declared = true;
+      reads_registry |= other.reads_registry;
+      writes_registry |= other.writes_registry;
+      for (const Entry &entry : other.reads)
+      {
+        if (!contains(reads, entry.id))
+        {
+          reads.push_back(entry);
+        }
+      }
+      for (const Entry &entry : other.writes)
+      {
+        if (!contains(writes, entry.id))
+        {
+          writes.push_back(entry);
+        }
+      }
+    }
+
+    bool has_any_access() const
+    {
+      return reads_registry || writes_registry || !reads.empty() || !writes.empty();
+    }
+
+    /**
+     * 兩個系統的訪問是否存在數據衝突（寫-寫 或 讀-寫）
+     * @param reason 可選，輸出第一個衝突的組件名稱
+     */
+    bool conflicts_with(const ComponentAccess &other, std::string_view *reason = nullptr) const
+    {
+      if (!declared || !other.declared)
+      {
+        return false;
+      }
+
+      if ((writes_registry && other.has_any_access()) || (other.writes_registry && has_any_access()))
+      {
+        if (reason)
+          *reason = "entt::registry";
+        return true;
+      }
+
+      if ((reads_registry && !other.writes.empty()) || (other.reads_registry && !writes.empty()))
+      {
+        if (reason)
+          *reason = "entt::registry";
+        return true;
+      }
+
+      for (const Entry &entry : writes)
+      {
+        if (contains(other.writes, entry.id) || contains(other.reads, entry.id))
+        {
+          if (reason)
+            *reason = entry.name;
+          return true;
+        }
+      }
+
+      for (const Entry &entry : reads)
+      {
+        if (contains(other.writes, entry.id))
+        {
+          if (reason)
+            *reason = entry.name;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+  private:
+    static bool contains(const std::vector<Entry> &entries, entt::id_type id)
+    {
+      return std::any_of(entries.begin(), entries.end(), [id](const Entry &entry)
+                         { return entry.id == id; });
+    }
+  };
+
+  /**
+   * 編譯期構建組件訪問聲明
+   * 使用方式：make_component_access<const TransformComponent, PhysicsBodyComponent>()
+   */
+  template <typename... Components>
+  ComponentAccess make_component_access()
+  {
+    ComponentAccess access;
+    access.declared = true;
+    (access.add<Components>(), ...);
+    return access;
+  }
+
   /**
    * 系統基礎介面
    * 所有系統都應該繼承這個類
@@ -42,6 +243,19 @@ namespace portal_core
      */
     virtual std::vector<std::string> get_conflicts() const { return {}; }
 
+    /**
+     * 獲取系統的組件訪問聲明
+     * 聲明後調度器會自動讓存在數據衝突的系統串行執行，無衝突的系統放入同一並行層；
+     * 默認未聲明，此時只按名稱依賴排序
+     */
+    virtual ComponentAccess get_component_access() const { return {}; }
+
+    /**
+     * 獲取系統所屬的幀管線階段，默認為 Update
+     * FixedUpdate 階段的系統每次以固定步長調用 update
+     */
+    virtual SystemPhase get_phase() const { return SystemPhase::Update; }
+
     /**
      * 系統初始化（可選）
      * @return true 如果初始化成功，false 否則
@@ -52,6 +266,30 @@ namespace portal_core
      * 系統清理（可選）
      */
     virtual void cleanup() {}
+
+    /**
+     * 設置系統內並行遍歷使用的工作線程池（由 SystemManager 注入）
+     */
+    void set_worker_pool(WorkerPool *pool) { worker_pool_ = pool; }
+
+    /**
+     * 獲取工作線程池，未啟用並行執行時為 nullptr（parallel_each 會退化為順序執行）
+     */
+    WorkerPool *get_worker_pool() const { return worker_pool_; }
+
+    /**
+     * 設置當前幀的時間信息（由 SystemManager 注入）
+     */
+    void set_frame_timing(const FrameTiming *timing) { frame_timing_ = timing; }
+
+    /**
+     * 獲取當前幀的時間信息，不經 SystemManager 直接調用 update 時為 nullptr
+     */
+    const FrameTiming *get_frame_timing() const { return frame_timing_; }
+
+  private:
+    WorkerPool *worker_pool_ = nullptr;
+    const FrameTiming *frame_timing_ = nullptr;
   };
 
   /**
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "system_base.h"
+#include "worker_pool.h"
+#include "system_profiler.h"
+#include "frame_tracer.h"
 #include <entt/entt.hpp>
 #include <memory>
 #include <unordered_map>
@@ -8,17 +11,31 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include <functional>
 #include <algorithm>
 #include <unordered_set>
 #include <thread>
-#include <future>
+#include <array>
+#include <atomic>
+#include <cmath>
 
 namespace portal_core
 {
 
+  /**
+   * 並行執行時的調度方式
+   */
+  enum class ParallelSchedulingMode
+  {
+    LayerBarrier,   // 按層執行，每層全部完成後才開始下一層
+    DependencyGraph // 按依賴圖執行，系統的前驅全部完成即可開始，就緒系統按關鍵路徑長度優先
+  };
+
   /**
    * 系統管理器
-   * 使用 entt::organizer 來管理系統的執行順序和依賴關係，支持並行執行
+   * 使用 entt::organizer 來管理系統的執行順序和依賴關係，支持並行執行。
+   * 每幀按 PreUpdate → FixedUpdate × N → Update → PostUpdate → RenderExtract 的管線執行，
+   * 固定步長的累積時間由此統一管理
    */
   class SystemManager
   {
@@ -42,6 +59,7 @@ namespace portal_core
 
       // 清空現有系統
       systems_.clear();
+      system_infos_.clear();
 
       // 從註冊表載入所有系統
       const auto &registered_systems = SystemRegistry::get_registered_systems();
@@ -57,9 +75,11 @@ namespace portal_core
         auto system = info.factory();
         if (system)
         {
+          system->set_frame_timing(&frame_timing_);
           if (system->initialize())
           {
             systems_[name] = std::move(system);
+            system_infos_[name] = info;
             std::cout << "SystemManager: Created system '" << name << "'" << std::endl;
           }
           else
@@ -74,16 +94,23 @@ namespace portal_core
       }
 
       // 第二步：構建任務圖
-      build_task_graph_manual(registered_systems);
+      build_task_graph_manual(collect_system_infos());
+      propagate_worker_pool();
 
       initialized_ = true;
       std::cout << "SystemManager: Initialization complete." << std::endl;
     }
 
     /**
-     * 手動添加系統（用於特殊情況）
+     * 手動添加系統（運行時熱加載）
+     * 已初始化時只增量更新受影響的子圖：插入新節點、連接其依賴/衝突邊並向後重新分層，
+     * 不再對整個任務圖重做循環檢測和佈局分析。未指定依賴信息時沿用 SystemRegistry 中同名系統的註冊信息。
+     * 同名系統已存在時先移除舊實例
      */
-    void add_system(const std::string &name, std::unique_ptr<ISystem> system)
+    void add_system(const std::string &name, std::unique_ptr<ISystem> system,
+                    const std::vector<std::string> &dependencies = {},
+                    const std::vector<std::string> &conflicts = {},
+                    int priority = 0)
     {
       if (!system)
       {
@@ -97,37 +124,96 @@ namespace portal_core
         return;
       }
 
+      if (systems_.count(name))
+      {
+        remove_system(name);
+      }
+
+      system->set_worker_pool(enable_parallel_execution_ ? worker_pool_.get() : nullptr);
+      system->set_frame_timing(&frame_timing_);
       systems_[name] = std::move(system);
+      system_infos_[name] = make_system_info(name, dependencies, conflicts, priority);
 
-      // 重新構建任務圖（如果已初始化）
       if (initialized_)
       {
-        rebuild_task_graph();
+        insert_graph_node(name);
+        finish_graph_update();
       }
     }
 
     /**
      * 移除系統
+     * 已初始化時只把該節點從任務圖中摘除，並重新計算其後繼的層次
      */
     void remove_system(const std::string &name)
     {
       auto it = systems_.find(name);
-      if (it != systems_.end())
+      if (it == systems_.end())
       {
-        it->second->cleanup();
-        systems_.erase(it);
+        return;
+      }
 
-        // 重新構建任務圖
-        if (initialized_)
-        {
-          rebuild_task_graph();
-        }
+      if (initialized_)
+      {
+        erase_graph_node(name);
+      }
+
+      it->second->cleanup();
+      systems_.erase(it);
+      system_infos_.erase(name);
+
+      if (initialized_)
+      {
+        finish_graph_update();
+      }
+    }
+
+    /**
+     * 開始批量增刪系統
+     * begin/end 之間的 add_system/remove_system 只維護圖結構，
+     * 層次列表和調度表在最外層 end_system_batch 時統一更新一次（可嵌套）。
+     * 不應在 update_systems 執行期間調用
+     */
+    void begin_system_batch() { ++batch_depth_; }
+
+    /**
+     * 結束批量增刪，提交所有變更
+     */
+    void end_system_batch()
+    {
+      if (batch_depth_ > 0 && --batch_depth_ == 0)
+      {
+        finish_graph_update();
       }
     }
 
     /**
-     * 更新所有系統
-     * 根據任務圖進行順序或並行執行
+     * 批量增刪的 RAII 作用域
+     */
+    class SystemBatch
+    {
+    public:
+      explicit SystemBatch(SystemManager &manager) : manager_(manager) { manager_.begin_system_batch(); }
+      ~SystemBatch() { manager_.end_system_batch(); }
+      SystemBatch(const SystemBatch &) = delete;
+      SystemBatch &operator=(const SystemBatch &) = delete;
+
+    private:
+      SystemManager &manager_;
+    };
+
+    /**
+     * 強制全量重建任務圖（完整的循環檢測和佈局輸出，用於調試）
+     */
+    void rebuild_task_graph()
+    {
+      build_task_graph_manual(collect_system_infos());
+    }
+
+    /**
+     * 更新所有系統（執行一幀完整管線）
+     * FixedUpdate 階段根據累積時間執行 0~N 次固定步進，其餘階段各執行一次；
+     * 每個階段內根據任務圖進行順序或並行執行
      */
     void update_systems(entt::registry &registry, float delta_time)
     {
@@ -137,26 +223,131 @@ namespace portal_core
         return;
       }
 
-      if (enable_parallel_execution_)
+      PORTAL_TRACE_SCOPE("SystemManager::update_systems");
+
+      frame_timing_.frame_index++;
+      frame_timing_.delta_time = delta_time;
+      frame_timing_.fixed_timestep = fixed_timestep_;
+
+      WorkerPool *active_pool = enable_parallel_execution_ ? worker_pool_.get() : nullptr;
+      if (profiling_enabled_)
       {
-        execute_systems_parallel(registry, delta_time);
+        profiler_.begin_frame(frame_timing_.frame_index, active_pool);
       }
-      else
+
+      execute_phase(SystemPhase::PreUpdate, registry, delta_time);
+
+      // 計算本幀固定步數，超過上限時丟棄積壓時間，避免幀率尖峰後的死亡螺旋
+      fixed_accumulator_ += delta_time;
+      uint32_t fixed_steps = static_cast<uint32_t>(fixed_accumulator_ / fixed_timestep_);
+      frame_timing_.dropped_fixed_steps = 0;
+      if (fixed_steps > max_fixed_steps_per_frame_)
+      {
+        frame_timing_.dropped_fixed_steps = fixed_steps - max_fixed_steps_per_frame_;
+        fixed_steps = max_fixed_steps_per_frame_;
+      }
+      frame_timing_.fixed_step_count = fixed_steps;
+
+      for (uint32_t step = 0; step < fixed_steps; ++step)
+      {
+        frame_timing_.fixed_step_index = step;
+        execute_phase(SystemPhase::FixedUpdate, registry, fixed_timestep_);
+      }
+
+      fixed_accumulator_ -= static_cast<float>(fixed_steps) * fixed_timestep_;
+      if (frame_timing_.dropped_fixed_steps > 0)
+      {
+        fixed_accumulator_ = std::fmod(fixed_accumulator_, fixed_timestep_);
+      }
+      frame_timing_.fixed_step_index = 0;
+      frame_timing_.interpolation_alpha = fixed_accumulator_ / fixed_timestep_;
+
+      execute_phase(SystemPhase::Update, registry, delta_time);
+      execute_phase(SystemPhase::PostUpdate, registry, delta_time);
+      execute_phase(SystemPhase::RenderExtract, registry, delta_time);
+
+      if (profiling_enabled_)
+      {
+        profiler_.end_frame(frame_timing_.fixed_step_count, active_pool);
+      }
+    }
+
+    /**
+     * 設置固定步長（秒）
+     */
+    void set_fixed_timestep(float timestep)
+    {
+      if (timestep > 0.0f)
       {
-        execute_systems_sequential(registry, delta_time);
+        fixed_timestep_ = timestep;
       }
     }
 
+    float get_fixed_timestep() const { return fixed_timestep_; }
+
+    /**
+     * 設置每幀最多執行的固定步數，超出部分的時間會被丟棄
+     */
+    void set_max_fixed_steps_per_frame(uint32_t max_steps) { max_fixed_steps_per_frame_ = std::max<uint32_t>(max_steps, 1); }
+    uint32_t get_max_fixed_steps_per_frame() const { return max_fixed_steps_per_frame_; }
+
+    /**
+     * 獲取最近一幀的時間信息（固定步數、插值係數等）
+     */
+    const FrameTiming &get_frame_timing() const { return frame_timing_; }
+
+    /**
+     * 啟用/禁用性能分析（默認啟用，每個系統每幀只增加兩次計時）
+     */
+    void set_profiling_enabled(bool enabled) { profiling_enabled_ = enabled; }
+    bool is_profiling_enabled() const { return profiling_enabled_; }
+
+    /**
+     * 獲取性能分析器（每系統耗時、層關鍵路徑、工作線程空閒時間）
+     */
+    const SystemProfiler &get_profiler() const { return profiler_; }
+
     /**
      * 啟用/禁用並行執行
      */
     void set_parallel_execution(bool enabled)
     {
       enable_parallel_execution_ = enabled;
+      if (enabled)
+      {
+        ensure_worker_pool();
+      }
+      propagate_worker_pool();
       std::cout << "SystemManager: Parallel execution "
                 << (enabled ? "enabled" : "disabled") << std::endl;
     }
 
+    /**
+     * 設置並行調度方式（默認按依賴圖調度）
+     */
+    void set_scheduling_mode(ParallelSchedulingMode mode) { scheduling_mode_ = mode; }
+    ParallelSchedulingMode get_scheduling_mode() const { return scheduling_mode_; }
+
+    /**
+     * 設置工作線程數量（0 表示硬件線程數 - 1）
+     * 會重建常駐線程池，不應在 update_systems 執行期間調用
+     */
+    void set_worker_thread_count(size_t count)
+    {
+      worker_thread_count_ = count;
+      worker_pool_.reset();
+      if (enable_parallel_execution_)
+      {
+        ensure_worker_pool();
+      }
+      propagate_worker_pool();
+    }
+
+    /**
+     * 獲取常駐工作線程池（未啟用並行執行時為 nullptr）
+     */
+    WorkerPool *get_worker_pool() { return worker_pool_.get(); }
+
     /**
      * 獲取系統
      */
@@ -176,7 +367,38 @@ namespace portal_core
         pair.second->cleanup();
       }
       systems_.clear();
+      system_infos_.clear();
+      graph_nodes_.clear();
+      dependents_by_name_.clear();
+      conflicted_by_name_.clear();
+      for (size_t phase_index = 0; phase_index < SYSTEM_PHASE_COUNT; ++phase_index)
+      {
+        phase_access_index_[phase_index].clear();
+        touched_layers_[phase_index].clear();
+      }
+      full_rebuild_pending_ = false;
       parallel_layers_.clear();
+      for (auto &layers : phase_layers_)
+      {
+        layers.clear();
+      }
+      for (auto &order : phase_order_)
+      {
+        order.clear();
+      }
+      for (auto &schedule : phase_schedule_)
+      {
+        schedule.clear();
+      }
+      for (auto &dag : phase_dag_)
+      {
+        dag.tasks.clear();
+        dag.roots.clear();
+        dag.dirty = true;
+      }
+      profiler_.clear();
+      fixed_accumulator_ = 0.0f;
+      frame_timing_ = FrameTiming{};
       initialized_ = false;
     }
 
@@ -212,161 +434,1130 @@ namespace portal_core
     }
 
     /**
-     * 獲取並行執行層次（用於調試）
+     * 獲取並行執行層次（用於調試，按階段順序拼接）
      */
     const std::vector<std::vector<std::string>> &get_parallel_layers() const
     {
       return parallel_layers_;
     }
 
+    /**
+     * 獲取指定階段的並行執行層次
+     */
+    const std::vector<std::vector<std::string>> &get_phase_layers(SystemPhase phase) const
+    {
+      return phase_layers_[static_cast<size_t>(phase)];
+    }
+
   private:
+    /**
+     * 已解析的調度項，執行時無需再按名稱查找系統
+     */
+    struct ScheduledSystem
+    {
+      ISystem *system = nullptr;
+      size_t profile_slot = 0;
+      const char *trace_name = nullptr; // 時間線中顯示的名稱（已 intern）
+    };
+
+    /**
+     * 任務圖節點，跨幀保留以支持增量增刪
+     */
+    struct GraphNode
+    {
+      const std::string *name = nullptr; // 指向 graph_nodes_ 中的鍵
+      ISystem *system = nullptr;
+      SystemPhase phase = SystemPhase::Update;
+      int priority = 0;
+      ComponentAccess access;
+      std::vector<std::string> dependencies;
+      std::unordered_set<std::string> conflicts; // 註冊信息和實例上聲明的衝突系統
+      std::unordered_set<GraphNode *> predecessors;
+      std::unordered_set<GraphNode *> successors;
+      size_t order_index = 0; // 在階段拓撲順序中的位置，決定衝突邊的方向
+      uint32_t layer = 0;     // 最長前驅鏈的長度，即所在的並行層
+      bool layered = false;   // 是否已放入 phase_layers_
+      size_t profile_slot = 0;
+      const char *trace_name = nullptr;
+    };
+
+    /**
+     * 按組件類型索引的訪問者，增量插入時只檢查可能衝突的系統而不是整個階段
+     */
+    struct PhaseAccessIndex
+    {
+      std::unordered_map<entt::id_type, std::unordered_set<GraphNode *>> readers;
+      std::unordered_map<entt::id_type, std::unordered_set<GraphNode *>> writers;
+      std::unordered_set<GraphNode *> any_access;        // 聲明了任意訪問
+      std::unordered_set<GraphNode *> component_writers; // 寫入至少一種組件
+      std::unordered_set<GraphNode *> registry_readers;
+      std::unordered_set<GraphNode *> registry_writers;
+
+      void clear()
+      {
+        readers.clear();
+        writers.clear();
+        any_access.clear();
+        component_writers.clear();
+        registry_readers.clear();
+        registry_writers.clear();
+      }
+    };
+
     std::unordered_map<std::string, std::unique_ptr<ISystem>> systems_;
-    std::vector<std::vector<std::string>> parallel_layers_; // 並行執行層次
+    std::unordered_map<std::string, SystemRegistry::SystemInfo> system_infos_; // 每個系統的依賴/衝突/優先級
+    std::vector<std::vector<std::string>> parallel_layers_;                        // 所有階段的層次（按階段順序拼接）
+    std::array<std::vector<std::vector<std::string>>, SYSTEM_PHASE_COUNT> phase_layers_; // 每個階段的並行執行層次
     bool initialized_ = false;
+
+    // 幀管線時間
+    FrameTiming frame_timing_;
+    float fixed_timestep_ = 1.0f / 60.0f;
+    float fixed_accumulator_ = 0.0f;
+    uint32_t max_fixed_steps_per_frame_ = 8;
+
+    // 增量任務圖
+    std::unordered_map<std::string, GraphNode> graph_nodes_;
+    std::array<std::vector<GraphNode *>, SYSTEM_PHASE_COUNT> phase_order_; // 每個階段的拓撲順序
+    std::array<PhaseAccessIndex, SYSTEM_PHASE_COUNT> phase_access_index_;
+    std::unordered_map<std::string, std::unordered_set<std::string>> dependents_by_name_; // 被依賴名 -> 依賴它的系統
+    std::unordered_map<std::string, std::unordered_set<std::string>> conflicted_by_name_; // 被聲明衝突的名稱 -> 聲明方
+    std::array<bool, SYSTEM_PHASE_COUNT> phase_graph_valid_{};                 // 存在循環時只能全量重建
+    std::array<std::unordered_set<uint32_t>, SYSTEM_PHASE_COUNT> touched_layers_; // 待提交的層
+    bool full_rebuild_pending_ = false;
+    int batch_depth_ = 0;
+    size_t relayered_system_count_ = 0;
+
+    // 每個階段的調度表（與 phase_layers_ 一一對應）
+    std::array<std::vector<std::vector<ScheduledSystem>>, SYSTEM_PHASE_COUNT> phase_schedule_;
+
+    /**
+     * 依賴圖調度的任務節點
+     */
+    struct DagTask
+    {
+      ScheduledSystem entry;
+      std::vector<uint32_t> predecessors;
+      std::vector<uint32_t> successors; // 按優先級降序排列
+      float estimated_ms = 1.0f;         // 耗時估計（滑動平均），無測量數據時每個系統記為 1
+      float priority = 0.0f;             // 從本系統到出口的最長估計耗時（關鍵路徑長度）
+      float last_ms = 0.0f;              // 本次執行的耗時，只由執行該任務的線程寫入
+      float path_ms = 0.0f;              // 本次執行中到達本系統結束時的最長路徑耗時
+    };
+
+    /**
+     * 單個階段的依賴圖調度表，由層次列表派生，任務按拓撲順序存放
+     */
+    struct DagSchedule
+    {
+      std::vector<DagTask> tasks;
+      std::vector<uint32_t> roots; // 無前驅的任務，按優先級降序排列
+      std::unique_ptr<std::atomic<uint32_t>[]> remaining; // 每個任務尚未完成的前驅數
+      uint32_t runs_since_refresh = 0;
+      bool dirty = true;
+    };
+
+    // 每執行多少次後按測量耗時重新計算關鍵路徑優先級
+    static constexpr uint32_t DAG_PRIORITY_REFRESH_INTERVAL = 30;
+    // 耗時估計的滑動平均係數
+    static constexpr float DAG_COST_SMOOTHING = 0.1f;
+    static constexpr uint32_t DAG_NO_TASK = ~0u;
+
+    std::array<DagSchedule, SYSTEM_PHASE_COUNT> phase_dag_;
+    ParallelSchedulingMode scheduling_mode_ = ParallelSchedulingMode::DependencyGraph;
+
+    // 性能分析
+    SystemProfiler profiler_;
+    bool profiling_enabled_ = true;
+    std::vector<float> layer_times_; // 並行層內各系統耗時的臨時緩衝
     bool enable_parallel_execution_ = false;
 
+    // 常駐工作線程池，首次啟用並行執行時創建
+    std::unique_ptr<WorkerPool> worker_pool_;
+    size_t worker_thread_count_ = 0;
+
+    void ensure_worker_pool()
+    {
+      if (!worker_pool_)
+      {
+        worker_pool_ = std::make_unique<WorkerPool>(worker_thread_count_);
+        std::cout << "SystemManager: Worker pool started with "
+                  << worker_pool_->get_worker_count() << " threads." << std::endl;
+      }
+    }
+
+    /**
+     * 把工作線程池注入所有系統，供系統內部的 parallel_each 使用
+     */
+    void propagate_worker_pool()
+    {
+      WorkerPool *pool = enable_parallel_execution_ ? worker_pool_.get() : nullptr;
+      for (auto &pair : systems_)
+      {
+        pair.second->set_worker_pool(pool);
+      }
+    }
+
     /**
      * 手動構建任務圖
+     * 每個階段獨立構建；依賴前一階段的系統由階段順序保證，無需連邊
      */
     void build_task_graph_manual(const std::vector<std::pair<std::string, SystemRegistry::SystemInfo>> &registered_systems)
     {
-      // 構建依賴關係
-      std::unordered_map<std::string, std::vector<std::string>> dependencies;
-      std::unordered_map<std::string, int> in_degree;
-      std::unordered_map<std::string, std::unordered_set<std::string>> dependents;
-
-      // 初始化
-      for (const auto &pair : registered_systems)
+      parallel_layers_.clear();
+      graph_nodes_.clear();
+      dependents_by_name_.clear();
+      conflicted_by_name_.clear();
+      for (size_t phase_index = 0; phase_index < SYSTEM_PHASE_COUNT; ++phase_index)
       {
-        const std::string &name = pair.first;
-        if (systems_.find(name) != systems_.end())
-        {
-          in_degree[name] = 0;
-          dependencies[name] = {};
-          dependents[name] = {};
-        }
+        phase_access_index_[phase_index].clear();
+        touched_layers_[phase_index].clear();
       }
+      full_rebuild_pending_ = false;
+      relayered_system_count_ = 0;
 
-      // 設置依賴關係
-      for (const auto &pair : registered_systems)
+      for (size_t phase_index = 0; phase_index < SYSTEM_PHASE_COUNT; ++phase_index)
       {
-        const std::string &name = pair.first;
-        const SystemRegistry::SystemInfo &info = pair.second;
+        const SystemPhase phase = static_cast<SystemPhase>(phase_index);
 
-        if (systems_.find(name) == systems_.end())
-          continue;
+        // 構建依賴關係
+        std::unordered_map<std::string, int> in_degree;
+        std::unordered_map<std::string, std::unordered_set<std::string>> dependents;
 
-        for (const std::string &dependency : info.dependencies)
+        // 初始化
+        for (const auto &pair : registered_systems)
         {
-          if (systems_.find(dependency) != systems_.end())
+          const std::string &name = pair.first;
+          auto it = systems_.find(name);
+          if (it != systems_.end() && it->second->get_phase() == phase)
           {
-            dependencies[name].push_back(dependency);
-            dependents[dependency].insert(name);
-            in_degree[name]++;
-            std::cout << "SystemManager: '" << dependency << "' -> '" << name << "' dependency added." << std::endl;
+            in_degree[name] = 0;
+            dependents[name] = {};
           }
-          else
+        }
+
+        if (in_degree.empty())
+        {
+          phase_layers_[phase_index].clear();
+          phase_order_[phase_index].clear();
+          phase_graph_valid_[phase_index] = true;
+          continue;
+        }
+
+        // 設置依賴關係
+        for (const auto &pair : registered_systems)
+        {
+          const std::string &name = pair.first;
+          const SystemRegistry::SystemInfo &info = pair.second;
+
+          if (in_degree.find(name) == in_degree.end())
+            continue;
+
+          for (const std::string &dependency : info.dependencies)
           {
-            std::cerr << "SystemManager: Warning - Dependency '" << dependency
-                      << "' for system '" << name << "' not found." << std::endl;
+            auto dependency_it = systems_.find(dependency);
+            if (dependency_it == systems_.end())
+            {
+              std::cerr << "SystemManager: Warning - Dependency '" << dependency
+                        << "' for system '" << name << "' not found." << std::endl;
+              continue;
+            }
+
+            SystemPhase dependency_phase = dependency_it->second->get_phase();
+            if (dependency_phase == phase)
+            {
+              dependents[dependency].insert(name);
+              in_degree[name]++;
+              std::cout << "SystemManager: '" << dependency << "' -> '" << name << "' dependency added." << std::endl;
+            }
+            else if (dependency_phase > phase)
+            {
+              std::cerr << "SystemManager: Warning - System '" << name << "' (" << get_phase_name(phase)
+                        << ") depends on '" << dependency << "' in later phase "
+                        << get_phase_name(dependency_phase) << ", dependency ignored." << std::endl;
+            }
           }
         }
+
+        // 根據組件訪問聲明和衝突列表補充排序邊
+        std::vector<std::string> order;
+        add_access_hazard_edges(registered_systems, in_degree, dependents, order);
+
+        // 檢測並報告循環依賴
+        if (!detect_circular_dependencies(in_degree, dependents))
+        {
+          std::cerr << "SystemManager: Circular dependencies detected in phase " << get_phase_name(phase)
+                    << "! System execution may be incorrect." << std::endl;
+        }
+
+        // 分析並行執行層次
+        std::cout << "SystemManager: Phase " << get_phase_name(phase) << ":" << std::endl;
+        analyze_parallel_layers(in_degree, dependents, phase_layers_[phase_index]);
+        parallel_layers_.insert(parallel_layers_.end(), phase_layers_[phase_index].begin(), phase_layers_[phase_index].end());
+
+        // 保留圖結構，之後的增刪只更新受影響的部分
+        store_phase_graph(phase_index, order, in_degree, dependents);
       }
 
-      // 檢測並報告循環依賴
-      if (!detect_circular_dependencies(in_degree, dependents))
+      for (size_t phase_index = 0; phase_index < SYSTEM_PHASE_COUNT; ++phase_index)
       {
-        std::cerr << "SystemManager: Circular dependencies detected! System execution may be incorrect." << std::endl;
+        resolve_schedule(phase_index);
       }
 
-      // 分析並行執行層次
-      analyze_parallel_layers(in_degree, dependents);
-
       std::cout << "SystemManager: Task graph analysis complete. "
                 << parallel_layers_.size() << " execution layers identified." << std::endl;
     }
 
     /**
-     * 檢測循環依賴
+     * 把一個階段的層次解析為系統指針和分析器槽位
      */
-    bool detect_circular_dependencies(
-        const std::unordered_map<std::string, int> &in_degree,
-        const std::unordered_map<std::string, std::unordered_set<std::string>> &dependents)
+    void resolve_schedule(size_t phase_index)
     {
-      std::unordered_map<std::string, int> temp_in_degree = in_degree;
-      std::queue<std::string> zero_in_degree_queue;
-      std::unordered_set<std::string> processed;
+      phase_dag_[phase_index].dirty = true;
+      phase_schedule_[phase_index].resize(phase_layers_[phase_index].size());
+      for (size_t layer = 0; layer < phase_layers_[phase_index].size(); ++layer)
+      {
+        resolve_schedule_layer(phase_index, layer);
+      }
+    }
 
-      // 找到所有入度為0的節點
-      for (const auto &pair : temp_in_degree)
+    void resolve_schedule_layer(size_t phase_index, size_t layer)
+    {
+      phase_dag_[phase_index].dirty = true;
+      std::vector<ScheduledSystem> &entries = phase_schedule_[phase_index][layer];
+      entries.clear();
+      for (const std::string &name : phase_layers_[phase_index][layer])
       {
-        if (pair.second == 0)
+        auto it = graph_nodes_.find(name);
+        if (it != graph_nodes_.end())
         {
-          zero_in_degree_queue.push(pair.first);
+          entries.push_back(ScheduledSystem{it->second.system, it->second.profile_slot, it->second.trace_name});
         }
       }
+    }
 
-      // 拓撲排序
-      while (!zero_in_degree_queue.empty())
-      {
-        std::string current = zero_in_degree_queue.front();
-        zero_in_degree_queue.pop();
-        processed.insert(current);
+    /**
+     * 收集當前所有系統的註冊信息
+     * 先按 SystemRegistry 的註冊順序，再按名稱追加手動添加的系統，保證全量構建結果穩定
+     */
+    std::vector<std::pair<std::string, SystemRegistry::SystemInfo>> collect_system_infos() const
+    {
+      std::vector<std::pair<std::string, SystemRegistry::SystemInfo>> result;
+      result.reserve(system_infos_.size());
 
-        // 減少所有依賴節點的入度
-        auto it = dependents.find(current);
-        if (it != dependents.end())
+      std::unordered_set<std::string> listed;
+      for (const auto &pair : SystemRegistry::get_registered_systems())
+      {
+        auto it = system_infos_.find(pair.first);
+        if (it != system_infos_.end())
         {
-          for (const std::string &dependent : it->second)
-          {
-            temp_in_degree[dependent]--;
-            if (temp_in_degree[dependent] == 0)
-            {
-              zero_in_degree_queue.push(dependent);
-            }
-          }
+          result.emplace_back(it->first, it->second);
+          listed.insert(it->first);
         }
       }
 
-      // 檢查是否有未處理的節點（說明存在循環）
-      std::vector<std::string> circular_systems;
-      for (const auto &pair : temp_in_degree)
+      std::vector<std::string> manual_names;
+      for (const auto &pair : system_infos_)
       {
-        if (processed.find(pair.first) == processed.end())
+        if (!listed.count(pair.first))
         {
-          circular_systems.push_back(pair.first);
+          manual_names.push_back(pair.first);
         }
       }
+      std::sort(manual_names.begin(), manual_names.end());
+      for (const std::string &name : manual_names)
+      {
+        result.emplace_back(name, system_infos_.at(name));
+      }
+      return result;
+    }
 
-      if (!circular_systems.empty())
+    /**
+     * 生成手動添加系統的註冊信息，未指定時沿用 SystemRegistry 中的同名註冊
+     */
+    static SystemRegistry::SystemInfo make_system_info(const std::string &name,
+                                                       const std::vector<std::string> &dependencies,
+                                                       const std::vector<std::string> &conflicts,
+                                                       int priority)
+    {
+      if (dependencies.empty() && conflicts.empty() && priority == 0)
       {
-        std::cerr << "SystemManager: Circular dependency detected among systems: ";
-        for (size_t i = 0; i < circular_systems.size(); ++i)
+        for (const auto &pair : SystemRegistry::get_registered_systems())
         {
-          std::cerr << circular_systems[i];
-          if (i < circular_systems.size() - 1)
-            std::cerr << ", ";
+          if (pair.first == name)
+          {
+            return pair.second;
+          }
         }
-        std::cerr << std::endl;
-        return false;
       }
 
-      return true;
+      SystemRegistry::SystemInfo info;
+      info.dependencies = dependencies;
+      info.conflicts = conflicts;
+      info.priority = priority;
+      return info;
     }
 
     /**
-     * 分析並行執行層次
+     * 節點 a 在拓撲排序中是否優先於 b（與全量構建的優先級隊列一致：優先級數字小者先，其次按名稱）
      */
-    void analyze_parallel_layers(
-        const std::unordered_map<std::string, int> &in_degree,
-        const std::unordered_map<std::string, std::unordered_set<std::string>> &dependents)
+    static bool precedes(const GraphNode &a, const GraphNode &b)
     {
-      parallel_layers_.clear();
-
-      std::unordered_map<std::string, int> current_in_degree = in_degree;
-      std::unordered_set<std::string> remaining_systems;
+      return a.priority != b.priority ? a.priority < b.priority : *a.name < *b.name;
+    }
 
-      for (const auto &pair : current_in_degree)
+    /**
+     * 創建（或重置）系統對應的圖節點，並登記到各索引中；不連邊
+     */
+    GraphNode &create_graph_node(const std::string &name, SystemPhase phase)
+    {
+      ISystem *system = systems_[name].get();
+      const SystemRegistry::SystemInfo &info = system_infos_[name];
+
+      auto it = graph_nodes_.try_emplace(name).first;
+      GraphNode &node = it->second;
+      node = GraphNode{};
+      node.name = &it->first;
+      node.system = system;
+      node.phase = phase;
+      node.priority = info.priority;
+      node.access = system->get_component_access();
+      node.dependencies = info.dependencies;
+      node.conflicts.insert(info.conflicts.begin(), info.conflicts.end());
+      for (const std::string &conflict : system->get_conflicts())
+      {
+        node.conflicts.insert(conflict);
+      }
+      node.profile_slot = profiler_.register_system(name, phase);
+      node.trace_name = FrameTracer::intern(name);
+
+      for (const std::string &dependency : node.dependencies)
+      {
+        dependents_by_name_[dependency].insert(name);
+      }
+      for (const std::string &conflict : node.conflicts)
+      {
+        conflicted_by_name_[conflict].insert(name);
+      }
+
+      PhaseAccessIndex &index = phase_access_index_[static_cast<size_t>(phase)];
+      const ComponentAccess &access = node.access;
+      if (access.declared)
+      {
+        for (const auto &entry : access.reads)
+          index.readers[entry.id].insert(&node);
+        for (const auto &entry : access.writes)
+          index.writers[entry.id].insert(&node);
+        if (access.has_any_access())
+          index.any_access.insert(&node);
+        if (!access.writes.empty())
+          index.component_writers.insert(&node);
+        if (access.reads_registry)
+          index.registry_readers.insert(&node);
+        if (access.writes_registry)
+          index.registry_writers.insert(&node);
+      }
+      return node;
+    }
+
+    /**
+     * 從各索引中註銷節點（不處理邊和層）
+     */
+    void unindex_graph_node(GraphNode &node)
+    {
+      const std::string &name = *node.name;
+      for (const std::string &dependency : node.dependencies)
+      {
+        auto it = dependents_by_name_.find(dependency);
+        if (it != dependents_by_name_.end() && it->second.erase(name) && it->second.empty())
+        {
+          dependents_by_name_.erase(it);
+        }
+      }
+      for (const std::string &conflict : node.conflicts)
+      {
+        auto it = conflicted_by_name_.find(conflict);
+        if (it != conflicted_by_name_.end() && it->second.erase(name) && it->second.empty())
+        {
+          conflicted_by_name_.erase(it);
+        }
+      }
+
+      PhaseAccessIndex &index = phase_access_index_[static_cast<size_t>(node.phase)];
+      // 集合清空後移除鍵，避免已註銷的組件類型在索引中殘留
+      auto erase_from = [&node](std::unordered_map<entt::id_type, std::unordered_set<GraphNode *>> &by_component, entt::id_type id)
+      {
+        auto it = by_component.find(id);
+        if (it != by_component.end() && it->second.erase(&node) && it->second.empty())
+        {
+          by_component.erase(it);
+        }
+      };
+      for (const auto &entry : node.access.reads)
+        erase_from(index.readers, entry.id);
+      for (const auto &entry : node.access.writes)
+        erase_from(index.writers, entry.id);
+      index.any_access.erase(&node);
+      index.component_writers.erase(&node);
+      index.registry_readers.erase(&node);
+      index.registry_writers.erase(&node);
+    }
+
+    /**
+     * 通過索引找出與節點存在數據衝突或聲明衝突的同階段系統
+     * 與 ComponentAccess::conflicts_with 的判定規則一致
+     */
+    std::unordered_set<GraphNode *> find_conflicting_nodes(const GraphNode &node) const
+    {
+      std::unordered_set<GraphNode *> result;
+      const PhaseAccessIndex &index = phase_access_index_[static_cast<size_t>(node.phase)];
+      const ComponentAccess &access = node.access;
+
+      auto merge = [&result](const std::unordered_set<GraphNode *> &nodes)
+      {
+        result.insert(nodes.begin(), nodes.end());
+      };
+      // 只查找不插入：沒有系統訪問的組件類型直接跳過
+      auto merge_component = [&merge](const std::unordered_map<entt::id_type, std::unordered_set<GraphNode *>> &by_component, entt::id_type id)
+      {
+        auto it = by_component.find(id);
+        if (it != by_component.end())
+        {
+          merge(it->second);
+        }
+      };
+
+      if (access.declared)
+      {
+        if (access.writes_registry)
+          merge(index.any_access);
+        if (access.reads_registry)
+          merge(index.component_writers);
+        if (access.has_any_access())
+          merge(index.registry_writers);
+        if (!access.writes.empty())
+          merge(index.registry_readers);
+
+        for (const auto &entry : access.writes)
+        {
+          merge_component(index.writers, entry.id);
+          merge_component(index.readers, entry.id);
+        }
+        for (const auto &entry : access.reads)
+        {
+          merge_component(index.writers, entry.id);
+        }
+      }
+
+      auto add_declared = [this, &result, &node](const std::string &other)
+      {
+        auto it = graph_nodes_.find(other);
+        if (it != graph_nodes_.end() && it->second.phase == node.phase)
+        {
+          result.insert(const_cast<GraphNode *>(&it->second));
+        }
+      };
+      for (const std::string &conflict : node.conflicts)
+      {
+        add_declared(conflict);
+      }
+      auto declared_it = conflicted_by_name_.find(*node.name);
+      if (declared_it != conflicted_by_name_.end())
+      {
+        for (const std::string &other : declared_it->second)
+        {
+          add_declared(other);
+        }
+      }
+
+      result.erase(const_cast<GraphNode *>(&node));
+      return result;
+    }
+
+    /**
+     * 全量構建後保存一個階段的圖結構
+     */
+    void store_phase_graph(size_t phase_index, const std::vector<std::string> &order,
+                           const std::unordered_map<std::string, int> &in_degree,
+                           const std::unordered_map<std::string, std::unordered_set<std::string>> &dependents)
+    {
+      const SystemPhase phase = static_cast<SystemPhase>(phase_index);
+
+      for (const auto &pair : in_degree)
+      {
+        create_graph_node(pair.first, phase).order_index = order.size();
+      }
+
+      for (const auto &pair : dependents)
+      {
+        for (const std::string &dependent : pair.second)
+        {
+          add_graph_edge(graph_nodes_[pair.first], graph_nodes_[dependent]);
+        }
+      }
+
+      auto &phase_order = phase_order_[phase_index];
+      phase_order.clear();
+      for (size_t i = 0; i < order.size(); ++i)
+      {
+        GraphNode &node = graph_nodes_[order[i]];
+        node.order_index = i;
+        phase_order.push_back(&node);
+      }
+
+      const auto &layers = phase_layers_[phase_index];
+      for (uint32_t layer = 0; layer < layers.size(); ++layer)
+      {
+        for (const std::string &name : layers[layer])
+        {
+          GraphNode &node = graph_nodes_[name];
+          node.layer = layer;
+          node.layered = true;
+        }
+      }
+
+      // 拓撲順序不完整說明存在循環，之後的增刪退回全量構建
+      phase_graph_valid_[phase_index] = order.size() == in_degree.size();
+    }
+
+    /**
+     * 把系統增量插入任務圖
+     * 新節點插入拓撲順序中位於所有前驅之後、所有後繼之前、並按優先級排序的位置，
+     * 衝突邊沿該順序連接，因此只要依賴本身不成環就不會引入循環；
+     * 無法找到這樣的位置時標記為全量重建（由全量構建報告循環）。
+     * 依賴、被依賴和衝突系統都通過索引查找，開銷與系統總數基本無關
+     */
+    void insert_graph_node(const std::string &name)
+    {
+      const SystemPhase phase = systems_[name]->get_phase();
+      const size_t phase_index = static_cast<size_t>(phase);
+
+      if (full_rebuild_pending_ || !phase_graph_valid_[phase_index])
+      {
+        full_rebuild_pending_ = true;
+        return;
+      }
+
+      // 顯式依賴：本系統依賴的（前驅）和依賴本系統的（後繼）
+      std::vector<GraphNode *> explicit_predecessors;
+      for (const std::string &dependency : system_infos_[name].dependencies)
+      {
+        if (dependency == name)
+        {
+          // 自依賴即循環，交給全量構建報告
+          full_rebuild_pending_ = true;
+          return;
+        }
+
+        auto dependency_it = graph_nodes_.find(dependency);
+        if (dependency_it == graph_nodes_.end())
+        {
+          // 批量操作中依賴可能稍後才添加，屆時由對方連邊
+          if (batch_depth_ == 0)
+          {
+            std::cerr << "SystemManager: Warning - Dependency '" << dependency
+                      << "' for system '" << name << "' not found." << std::endl;
+          }
+          continue;
+        }
+
+        if (dependency_it->second.phase == phase)
+        {
+          explicit_predecessors.push_back(&dependency_it->second);
+        }
+        else if (dependency_it->second.phase > phase)
+        {
+          std::cerr << "SystemManager: Warning - System '" << name << "' (" << get_phase_name(phase)
+                    << ") depends on '" << dependency << "' in later phase "
+                    << get_phase_name(dependency_it->second.phase) << ", dependency ignored." << std::endl;
+        }
+      }
+
+      std::vector<GraphNode *> explicit_successors;
+      auto dependents_it = dependents_by_name_.find(name);
+      if (dependents_it != dependents_by_name_.end())
+      {
+        for (const std::string &dependent : dependents_it->second)
+        {
+          auto it = graph_nodes_.find(dependent);
+          if (it != graph_nodes_.end() && it->second.phase == phase)
+          {
+            explicit_successors.push_back(&it->second);
+          }
+        }
+      }
+
+      std::vector<GraphNode *> &order = phase_order_[phase_index];
+      size_t lowest = 0;
+      size_t highest = order.size();
+      for (const GraphNode *predecessor : explicit_predecessors)
+      {
+        lowest = std::max(lowest, predecessor->order_index + 1);
+      }
+      for (const GraphNode *successor : explicit_successors)
+      {
+        highest = std::min(highest, successor->order_index);
+      }
+      if (lowest > highest)
+      {
+        full_rebuild_pending_ = true;
+        return;
+      }
+
+      GraphNode &node = create_graph_node(name, phase);
+
+      size_t position = lowest;
+      while (position < highest && precedes(*order[position], node))
+      {
+        ++position;
+      }
+      order.insert(order.begin() + position, &node);
+      for (size_t i = position; i < order.size(); ++i)
+      {
+        order[i]->order_index = i;
+      }
+
+      for (GraphNode *predecessor : explicit_predecessors)
+      {
+        add_graph_edge(*predecessor, node);
+      }
+      for (GraphNode *successor : explicit_successors)
+      {
+        add_graph_edge(node, *successor);
+      }
+
+      // 數據衝突和聲明衝突沿拓撲順序連邊
+      for (GraphNode *other : find_conflicting_nodes(node))
+      {
+        if (other->order_index < node.order_index)
+        {
+          add_graph_edge(*other, node);
+        }
+        else
+        {
+          add_graph_edge(node, *other);
+        }
+      }
+
+      uint32_t layer = 0;
+      for (const GraphNode *predecessor : node.predecessors)
+      {
+        layer = std::max(layer, predecessor->layer + 1);
+      }
+      move_to_layer(node, layer);
+      relayered_system_count_++;
+      propagate_layers(std::vector<GraphNode *>(node.successors.begin(), node.successors.end()));
+    }
+
+    /**
+     * 把系統從任務圖中摘除，並重新計算其後繼的層次
+     */
+    void erase_graph_node(const std::string &name)
+    {
+      auto it = graph_nodes_.find(name);
+      if (it == graph_nodes_.end())
+      {
+        return;
+      }
+
+      GraphNode &node = it->second;
+      const size_t phase_index = static_cast<size_t>(node.phase);
+      node.successors.erase(&node); // 自依賴（只在存在循環的階段出現）
+      node.predecessors.erase(&node);
+      std::vector<GraphNode *> successors(node.successors.begin(), node.successors.end());
+
+      for (GraphNode *predecessor : node.predecessors)
+      {
+        predecessor->successors.erase(&node);
+      }
+      for (GraphNode *successor : successors)
+      {
+        successor->predecessors.erase(&node);
+      }
+
+      std::vector<GraphNode *> &order = phase_order_[phase_index];
+      const size_t position = node.order_index;
+      if (position < order.size() && order[position] == &node)
+      {
+        order.erase(order.begin() + position);
+        for (size_t i = position; i < order.size(); ++i)
+        {
+          order[i]->order_index = i;
+        }
+      }
+      else
+      {
+        // 只有存在循環的階段會出現不在拓撲順序中的節點
+        full_rebuild_pending_ = true;
+      }
+
+      if (node.layered)
+      {
+        auto &layer = phase_layers_[phase_index][node.layer];
+        layer.erase(std::find(layer.begin(), layer.end(), name));
+        touched_layers_[phase_index].insert(node.layer);
+      }
+
+      unindex_graph_node(node);
+      graph_nodes_.erase(it);
+      propagate_layers(successors);
+    }
+
+    static void add_graph_edge(GraphNode &from, GraphNode &to)
+    {
+      from.successors.insert(&to);
+      to.predecessors.insert(&from);
+    }
+
+    /**
+     * 把節點移動到指定層（同時更新 phase_layers_，並記錄待提交的層）
+     */
+    void move_to_layer(GraphNode &node, uint32_t layer)
+    {
+      const size_t phase_index = static_cast<size_t>(node.phase);
+      auto &layers = phase_layers_[phase_index];
+
+      if (node.layered)
+      {
+        if (node.layer == layer)
+        {
+          return;
+        }
+        auto &old_layer = layers[node.layer];
+        old_layer.erase(std::find(old_layer.begin(), old_layer.end(), *node.name));
+        touched_layers_[phase_index].insert(node.layer);
+      }
+
+      if (layers.size() <= layer)
+      {
+        layers.resize(layer + 1);
+      }
+      layers[layer].push_back(*node.name);
+      touched_layers_[phase_index].insert(layer);
+      node.layer = layer;
+      node.layered = true;
+    }
+
+    /**
+     * 從給定節點開始向後重新計算層次
+     * 按拓撲順序處理，層次未變化的節點不再向後傳播，因此只觸及受影響的子圖
+     */
+    void propagate_layers(const std::vector<GraphNode *> &seeds)
+    {
+      using QueueEntry = std::pair<size_t, GraphNode *>;
+      std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> pending;
+      std::unordered_set<GraphNode *> queued;
+      for (GraphNode *seed : seeds)
+      {
+        if (queued.insert(seed).second)
+        {
+          pending.emplace(seed->order_index, seed);
+        }
+      }
+
+      while (!pending.empty())
+      {
+        GraphNode *node = pending.top().second;
+        pending.pop();
+        queued.erase(node);
+
+        uint32_t layer = 0;
+        for (const GraphNode *predecessor : node->predecessors)
+        {
+          layer = std::max(layer, predecessor->layer + 1);
+        }
+
+        if (node->layered && layer == node->layer)
+        {
+          continue;
+        }
+        move_to_layer(*node, layer);
+        relayered_system_count_++;
+
+        for (GraphNode *successor : node->successors)
+        {
+          if (queued.insert(successor).second)
+          {
+            pending.emplace(successor->order_index, successor);
+          }
+        }
+      }
+    }
+
+    /**
+     * 提交圖結構的變更：只重新解析被觸及的層的調度表
+     * 批量操作期間推遲到最外層 end_system_batch
+     */
+    void finish_graph_update()
+    {
+      if (batch_depth_ > 0)
+      {
+        return;
+      }
+
+      if (full_rebuild_pending_)
+      {
+        std::cout << "SystemManager: Incremental update not possible, rebuilding task graph." << std::endl;
+        rebuild_task_graph();
+        return;
+      }
+
+      bool any_touched = false;
+      bool layer_count_changed = false;
+      for (size_t phase_index = 0; phase_index < SYSTEM_PHASE_COUNT; ++phase_index)
+      {
+        auto &touched = touched_layers_[phase_index];
+        if (touched.empty())
+        {
+          continue;
+        }
+
+        // 層次由最長路徑決定，只有末尾的層可能被清空
+        auto &layers = phase_layers_[phase_index];
+        while (!layers.empty() && layers.back().empty())
+        {
+          layers.pop_back();
+        }
+
+        auto &schedule = phase_schedule_[phase_index];
+        layer_count_changed |= schedule.size() != layers.size();
+        phase_dag_[phase_index].dirty = true;
+        schedule.resize(layers.size());
+        for (uint32_t layer : touched)
+        {
+          if (layer < layers.size())
+          {
+            resolve_schedule_layer(phase_index, layer);
+          }
+        }
+        any_touched = true;
+      }
+
+      if (!any_touched)
+      {
+        return;
+      }
+
+      if (layer_count_changed)
+      {
+        parallel_layers_.clear();
+        for (const auto &layers : phase_layers_)
+        {
+          parallel_layers_.insert(parallel_layers_.end(), layers.begin(), layers.end());
+        }
+      }
+      else
+      {
+        size_t offset = 0;
+        for (size_t phase_index = 0; phase_index < SYSTEM_PHASE_COUNT; ++phase_index)
+        {
+          for (uint32_t layer : touched_layers_[phase_index])
+          {
+            if (layer < phase_layers_[phase_index].size())
+            {
+              parallel_layers_[offset + layer] = phase_layers_[phase_index][layer];
+            }
+          }
+          offset += phase_layers_[phase_index].size();
+        }
+      }
+
+      for (auto &touched : touched_layers_)
+      {
+        touched.clear();
+      }
+
+      std::cout << "SystemManager: Task graph updated incrementally (" << relayered_system_count_
+                << " systems re-layered, " << parallel_layers_.size() << " execution layers)." << std::endl;
+      relayered_system_count_ = 0;
+    }
+
+    /**
+     * 根據數據衝突補充排序邊
+     * 先按名稱依賴和優先級求出一個拓撲順序，再對存在組件讀寫衝突
+     * （或在衝突列表中互相排斥）的系統對，沿該順序添加邊；
+     * 邊只會從順序靠前的系統指向靠後的系統，因此不會引入新的循環
+     */
+    void add_access_hazard_edges(
+        const std::vector<std::pair<std::string, SystemRegistry::SystemInfo>> &registered_systems,
+        std::unordered_map<std::string, int> &in_degree,
+        std::unordered_map<std::string, std::unordered_set<std::string>> &dependents,
+        std::vector<std::string> &order)
+    {
+      std::unordered_map<std::string, int> priorities;
+      std::unordered_map<std::string, std::unordered_set<std::string>> declared_conflicts;
+      for (const auto &pair : registered_systems)
+      {
+        if (in_degree.count(pair.first))
+        {
+          priorities[pair.first] = pair.second.priority;
+          for (const std::string &conflict : pair.second.conflicts)
+          {
+            declared_conflicts[pair.first].insert(conflict);
+            declared_conflicts[conflict].insert(pair.first);
+          }
+        }
+      }
+
+      // 按優先級（相同時按名稱）進行拓撲排序
+      auto order_before = [&priorities](const std::string &a, const std::string &b)
+      {
+        int pa = priorities[a];
+        int pb = priorities[b];
+        return pa != pb ? pa > pb : a > b;
+      };
+      std::priority_queue<std::string, std::vector<std::string>, decltype(order_before)> ready(order_before);
+      std::unordered_map<std::string, int> temp_in_degree = in_degree;
+      for (const auto &pair : temp_in_degree)
+      {
+        if (pair.second == 0)
+        {
+          ready.push(pair.first);
+        }
+      }
+
+      order.clear();
+      while (!ready.empty())
+      {
+        std::string current = ready.top();
+        ready.pop();
+        order.push_back(current);
+
+        for (const std::string &dependent : dependents[current])
+        {
+          if (--temp_in_degree[dependent] == 0)
+          {
+            ready.push(dependent);
+          }
+        }
+      }
+
+      // 收集訪問聲明和實例上的衝突列表
+      std::vector<ComponentAccess> accesses;
+      accesses.reserve(order.size());
+      for (const std::string &name : order)
+      {
+        ISystem *system = systems_[name].get();
+        accesses.push_back(system->get_component_access());
+        for (const std::string &conflict : system->get_conflicts())
+        {
+          declared_conflicts[name].insert(conflict);
+          declared_conflicts[conflict].insert(name);
+        }
+      }
+
+      for (size_t later = 1; later < order.size(); ++later)
+      {
+        const std::string &later_name = order[later];
+        for (size_t earlier = 0; earlier < later; ++earlier)
+        {
+          const std::string &earlier_name = order[earlier];
+          if (dependents[earlier_name].count(later_name))
+          {
+            continue;
+          }
+
+          std::string_view reason;
+          bool hazard = accesses[earlier].conflicts_with(accesses[later], &reason);
+          if (!hazard && declared_conflicts[earlier_name].count(later_name))
+          {
+            hazard = true;
+            reason = "declared conflict";
+          }
+
+          if (hazard)
+          {
+            dependents[earlier_name].insert(later_name);
+            in_degree[later_name]++;
+            std::cout << "SystemManager: '" << earlier_name << "' -> '" << later_name
+                      << "' ordered by access hazard (" << reason << ")." << std::endl;
+          }
+        }
+      }
+    }
+
+    /**
+     * 檢測循環依賴
+     */
+    bool detect_circular_dependencies(
+        const std::unordered_map<std::string, int> &in_degree,
+        const std::unordered_map<std::string, std::unordered_set<std::string>> &dependents)
+    {
+      std::unordered_map<std::string, int> temp_in_degree = in_degree;
+      std::queue<std::string> zero_in_degree_queue;
+      std::unordered_set<std::string> processed;
+
+      // 找到所有入度為0的節點
+      for (const auto &pair : temp_in_degree)
+      {
+        if (pair.second == 0)
+        {
+          zero_in_degree_queue.push(pair.first);
+        }
+      }
+
+      // 拓撲排序
+      while (!zero_in_degree_queue.empty())
+      {
+        std::string current = zero_in_degree_queue.front();
+        zero_in_degree_queue.pop();
+        processed.insert(current);
+
+        // 減少所有依賴節點的入度
+        auto it = dependents.find(current);
+        if (it != dependents.end())
+        {
+          for (const std::string &dependent : it->second)
+          {
+            temp_in_degree[dependent]--;
+            if (temp_in_degree[dependent] == 0)
+            {
+              zero_in_degree_queue.push(dependent);
+            }
+          }
+        }
+      }
+
+      // 檢查是否有未處理的節點（說明存在循環）
+      std::vector<std::string> circular_systems;
+      for (const auto &pair : temp_in_degree)
+      {
+        if (processed.find(pair.first) == processed.end())
+        {
+          circular_systems.push_back(pair.first);
+        }
+      }
+
+      if (!circular_systems.empty())
+      {
+        std::cerr << "SystemManager: Circular dependency detected among systems: ";
+        for (size_t i = 0; i < circular_systems.size(); ++i)
+        {
+          std::cerr << circular_systems[i];
+          if (i < circular_systems.size() - 1)
+            std::cerr << ", ";
+        }
+        std::cerr << std::endl;
+        return false;
+      }
+
+      return true;
+    }
+
+    /**
+     * 分析並行執行層次
+     */
+    void analyze_parallel_layers(
+        const std::unordered_map<std::string, int> &in_degree,
+        const std::unordered_map<std::string, std::unordered_set<std::string>> &dependents,
+        std::vector<std::vector<std::string>> &layers)
+    {
+      layers.clear();
+
+      std::unordered_map<std::string, int> current_in_degree = in_degree;
+      std::unordered_set<std::string> remaining_systems;
+
+      for (const auto &pair : current_in_degree)
       {
         remaining_systems.insert(pair.first);
       }
@@ -393,7 +1584,7 @@ namespace portal_core
           break;
         }
 
-        parallel_layers_.push_back(current_layer);
+        layers.push_back(current_layer);
 
         // 移除當前層的系統並更新依賴
         for (const std::string &completed_system : current_layer)
@@ -425,91 +1616,313 @@ namespace portal_core
     }
 
     /**
-     * 重新構建任務圖（當動態添加/移除系統時）
+     * 執行單個階段
      */
-    void rebuild_task_graph()
+    void execute_phase(SystemPhase phase, entt::registry &registry, float delta_time)
     {
-      const auto &registered_systems = SystemRegistry::get_registered_systems();
-      build_task_graph_manual(registered_systems);
-    }
+      const auto &layers = phase_schedule_[static_cast<size_t>(phase)];
+      if (layers.empty())
+      {
+        return;
+      }
 
-    /**
-     * 順序執行系統
-     */
-    void execute_systems_sequential(entt::registry &registry, float delta_time)
-    {
-      // 按層次順序執行所有系統
-      for (const auto &layer : parallel_layers_)
+      PORTAL_TRACE_SCOPE_CATEGORY(get_phase_name(phase), "phase");
+
+      if (enable_parallel_execution_ && scheduling_mode_ == ParallelSchedulingMode::DependencyGraph)
       {
-        for (const std::string &system_name : layer)
+        DagSchedule &dag = phase_dag_[static_cast<size_t>(phase)];
+        if (dag.dirty)
+        {
+          build_phase_dag(static_cast<size_t>(phase));
+        }
+        if (dag.tasks.size() > 1)
+        {
+          execute_phase_dag(phase, dag, registry, delta_time);
+          return;
+        }
+      }
+
+      for (uint32_t layer_index = 0; layer_index < layers.size(); ++layer_index)
+      {
+        const auto &layer = layers[layer_index];
+        auto layer_start = SystemProfiler::Clock::now();
+        float critical_path_ms = 0.0f;
+
+        if (enable_parallel_execution_ && layer.size() > 1)
+        {
+          critical_path_ms = execute_layer_parallel(layer, registry, delta_time);
+        }
+        else
         {
-          auto it = systems_.find(system_name);
-          if (it != systems_.end())
+          // 單個系統或未啟用並行時直接在當前線程執行，避免調度開銷
+          for (const ScheduledSystem &entry : layer)
           {
-            // 直接調用系統更新，不使用異常處理
-            it->second->update(registry, delta_time);
+            critical_path_ms = std::max(critical_path_ms, run_system(entry, registry, delta_time));
           }
         }
+
+        if (profiling_enabled_)
+        {
+          profiler_.record_layer(phase, layer_index, static_cast<uint32_t>(layer.size()),
+                                 SystemProfiler::elapsed_ms(layer_start, SystemProfiler::Clock::now()),
+                                 critical_path_ms);
+        }
+      }
+    }
+
+    /**
+     * 並行執行一層系統
+     * 層內系統提交到常駐線程池，當前線程也參與執行，返回層內最慢系統的耗時
+     */
+    float execute_layer_parallel(const std::vector<ScheduledSystem> &layer, entt::registry &registry, float delta_time)
+    {
+      ensure_worker_pool();
+
+      layer_times_.assign(layer.size(), 0.0f);
+
+      TaskGroup layer_group;
+      for (size_t i = 0; i < layer.size(); ++i)
+      {
+        const ScheduledSystem *entry = &layer[i];
+        float *time_slot = &layer_times_[i];
+        worker_pool_->submit(layer_group, [this, entry, time_slot, &registry, delta_time]()
+                             { *time_slot = run_system(*entry, registry, delta_time); });
       }
+
+      // 等待當前層所有系統完成（當前線程也參與執行）
+      worker_pool_->wait(layer_group);
+
+      return *std::max_element(layer_times_.begin(), layer_times_.end());
     }
 
     /**
-     * 並行執行系統
-     * 每一層內的系統可以並行執行，層與層之間需要同步
+     * 由層次列表派生階段的依賴圖調度表
+     * 層次順序即拓撲順序；耗時估計取分析器中最近的測量值，因此重建後不會丟失
      */
-    void execute_systems_parallel(entt::registry &registry, float delta_time)
+    void build_phase_dag(size_t phase_index)
     {
-      const size_t PARALLEL_THRESHOLD = 4; // 小於此數量的系統仍然順序執行
+      DagSchedule &dag = phase_dag_[phase_index];
+      dag.tasks.clear();
+      dag.roots.clear();
+      dag.runs_since_refresh = 0;
+      dag.dirty = false;
 
-      for (size_t layer_idx = 0; layer_idx < parallel_layers_.size(); ++layer_idx)
+      std::unordered_map<const ISystem *, uint32_t> task_index;
+      for (const auto &layer : phase_schedule_[phase_index])
       {
-        const auto &layer = parallel_layers_[layer_idx];
+        for (const ScheduledSystem &entry : layer)
+        {
+          task_index[entry.system] = static_cast<uint32_t>(dag.tasks.size());
+          DagTask task;
+          task.entry = entry;
+          task.estimated_ms = measured_system_cost(entry.profile_slot);
+          dag.tasks.push_back(std::move(task));
+        }
+      }
 
-        if (layer.size() == 1 || layer.size() < PARALLEL_THRESHOLD)
+      for (const auto &layer : phase_layers_[phase_index])
+      {
+        for (const std::string &name : layer)
         {
-          // 單個系統或系統數量較少，直接順序執行避免線程開銷
-          for (const std::string &system_name : layer)
+          const GraphNode &node = graph_nodes_[name];
+          const uint32_t from = task_index[node.system];
+          for (const GraphNode *successor : node.successors)
           {
-            auto it = systems_.find(system_name);
-            if (it != systems_.end())
+            auto it = task_index.find(successor->system);
+            if (it != task_index.end())
             {
-              it->second->update(registry, delta_time);
+              dag.tasks[from].successors.push_back(it->second);
+              dag.tasks[it->second].predecessors.push_back(from);
             }
           }
         }
-        else
+      }
+
+      for (uint32_t i = 0; i < dag.tasks.size(); ++i)
+      {
+        if (dag.tasks[i].predecessors.empty())
+        {
+          dag.roots.push_back(i);
+        }
+      }
+
+      dag.remaining.reset(new std::atomic<uint32_t>[dag.tasks.size()]);
+      refresh_dag_priorities(dag);
+    }
+
+    /**
+     * 分析器中系統單次調用的平均耗時，沒有數據時返回 1（退化為按系統個數計算的路徑長度）
+     */
+    float measured_system_cost(size_t profile_slot) const
+    {
+      if (profile_slot >= profiler_.get_system_count())
+      {
+        return 1.0f;
+      }
+
+      const auto &history = profiler_.get_system_history(profile_slot);
+      float total_ms = 0.0f;
+      uint32_t calls = 0;
+      for (size_t i = history.size() > 16 ? history.size() - 16 : 0; i < history.size(); ++i)
+      {
+        total_ms += history[i].time_ms;
+        calls += history[i].calls;
+      }
+      return calls > 0 ? std::max(total_ms / static_cast<float>(calls), 0.001f) : 1.0f;
+    }
+
+    /**
+     * 按耗時估計重新計算每個任務的關鍵路徑長度，並據此排序後繼和入口任務
+     */
+    static void refresh_dag_priorities(DagSchedule &dag)
+    {
+      for (size_t i = dag.tasks.size(); i-- > 0;)
+      {
+        DagTask &task = dag.tasks[i];
+        float longest_successor = 0.0f;
+        for (uint32_t successor : task.successors)
+        {
+          longest_successor = std::max(longest_successor, dag.tasks[successor].priority);
+        }
+        task.priority = task.estimated_ms + longest_successor;
+      }
+
+      auto higher_priority = [&dag](uint32_t a, uint32_t b)
+      {
+        return dag.tasks[a].priority > dag.tasks[b].priority;
+      };
+      for (DagTask &task : dag.tasks)
+      {
+        std::sort(task.successors.begin(), task.successors.end(), higher_priority);
+      }
+      std::sort(dag.roots.begin(), dag.roots.end(), higher_priority);
+      dag.runs_since_refresh = 0;
+    }
+
+    /**
+     * 按依賴圖並行執行一個階段
+     * 每個系統在其前驅全部完成後立即開始，不等待同層的其他系統；
+     * 完成後優先在當前線程繼續執行關鍵路徑最長的就緒後繼，其餘就緒後繼提交到線程池
+     */
+    void execute_phase_dag(SystemPhase phase, DagSchedule &dag, entt::registry &registry, float delta_time)
+    {
+      ensure_worker_pool();
+      auto phase_start = SystemProfiler::Clock::now();
+
+      for (size_t i = 0; i < dag.tasks.size(); ++i)
+      {
+        dag.remaining[i].store(static_cast<uint32_t>(dag.tasks[i].predecessors.size()), std::memory_order_relaxed);
+      }
+
+      TaskGroup group;
+      // 入口任務不綁定具體系統：每個任務執行時按原子游標從 dag.roots（按優先級降序）領取下一個入口。
+      // 提交時輪詢分配到各工作線程的隊列、執行順序也不確定，但最先開始的總是剩餘入口中優先級最高的
+      std::atomic<size_t> next_root{0};
+      auto run_next_root = [this, &dag, &group, &registry, delta_time, &next_root]()
+      {
+        const size_t slot = next_root.fetch_add(1, std::memory_order_relaxed);
+        if (slot < dag.roots.size())
+        {
+          run_dag_chain(dag, group, dag.roots[slot], registry, delta_time);
+        }
+      };
+      for (size_t i = 1; i < dag.roots.size(); ++i)
+      {
+        worker_pool_->submit(group, run_next_root);
+      }
+      worker_pool_->run_and_wait(group, run_next_root);
+
+      // 根據本次實際耗時計算關鍵路徑，並更新耗時估計
+      float critical_path_ms = 0.0f;
+      for (DagTask &task : dag.tasks)
+      {
+        float start_ms = 0.0f;
+        for (uint32_t predecessor : task.predecessors)
+        {
+          start_ms = std::max(start_ms, dag.tasks[predecessor].path_ms);
+        }
+        task.path_ms = start_ms + task.last_ms;
+        critical_path_ms = std::max(critical_path_ms, task.path_ms);
+
+        if (profiling_enabled_)
         {
-          // 多個系統且數量足夠，並行執行
-          std::vector<std::future<void>> futures;
+          task.estimated_ms += (task.last_ms - task.estimated_ms) * DAG_COST_SMOOTHING;
+        }
+      }
+
+      if (++dag.runs_since_refresh >= DAG_PRIORITY_REFRESH_INTERVAL)
+      {
+        refresh_dag_priorities(dag);
+      }
+
+      if (profiling_enabled_)
+      {
+        // 依賴圖調度沒有層的概念，整個階段記為一層，關鍵路徑為依賴圖上的最長路徑
+        profiler_.record_layer(phase, 0, static_cast<uint32_t>(dag.tasks.size()),
+                               SystemProfiler::elapsed_ms(phase_start, SystemProfiler::Clock::now()),
+                               critical_path_ms);
+      }
+    }
+
+    /**
+     * 執行一個任務，並沿就緒的後繼繼續執行
+     */
+    void run_dag_chain(DagSchedule &dag, TaskGroup &group, uint32_t index, entt::registry &registry, float delta_time)
+    {
+      while (index != DAG_NO_TASK)
+      {
+        DagTask &task = dag.tasks[index];
+        task.last_ms = run_system(task.entry, registry, delta_time);
 
-          for (const std::string &system_name : layer)
+        uint32_t next = DAG_NO_TASK;
+        for (uint32_t successor : task.successors)
+        {
+          if (dag.remaining[successor].fetch_sub(1, std::memory_order_acq_rel) != 1)
           {
-            auto it = systems_.find(system_name);
-            if (it != systems_.end())
-            {
-              // 直接捕獲必要的變數，避免使用靜態成員
-              futures.emplace_back(std::async(std::launch::async,
-                                              [this, &registry, delta_time, system_name]()
-                                              {
-                                                auto sys_it = this->systems_.find(system_name);
-                                                if (sys_it != this->systems_.end())
-                                                {
-                                                  sys_it->second->update(registry, delta_time);
-                                                }
-                                              }));
-            }
+            continue;
           }
 
-          // 等待當前層所有系統完成
-          for (auto &future : futures)
+          if (next == DAG_NO_TASK)
           {
-            future.wait();
+            next = successor;
+          }
+          else
+          {
+            worker_pool_->submit(group, [this, &dag, &group, &registry, delta_time, successor]()
+                                 { run_dag_chain(dag, group, successor, registry, delta_time); });
           }
-
-          std::cout << "SystemManager: Layer " << layer_idx << " completed ("
-                    << layer.size() << " systems in parallel)" << std::endl;
         }
+        index = next;
+      }
+    }
+
+    /**
+     * 執行單個系統並記錄耗時和處理的實體數，返回耗時（毫秒）
+     * 系統在 wait 中替其他系統執行任務的時間單獨記錄，不計入它自己的耗時
+     */
+    float run_system(const ScheduledSystem &entry, entt::registry &registry, float delta_time)
+    {
+      PORTAL_TRACE_SCOPE_CATEGORY(entry.trace_name, "system");
+
+      if (!profiling_enabled_)
+      {
+        // 直接調用系統更新，不使用異常處理
+        entry.system->update(registry, delta_time);
+        return 0.0f;
       }
+
+      uint64_t entities = 0;
+      SystemProfiler::EntityCountScope entity_scope(entities);
+
+      const uint64_t help_before_ns = WorkerPool::get_thread_help_time_ns();
+      auto start = SystemProfiler::Clock::now();
+      entry.system->update(registry, delta_time);
+      const float wall_ms = SystemProfiler::elapsed_ms(start, SystemProfiler::Clock::now());
+      const float help_ms = static_cast<float>(WorkerPool::get_thread_help_time_ns() - help_before_ns) / 1.0e6f;
+      const float time_ms = std::max(0.0f, wall_ms - help_ms);
+
+      profiler_.record_system(entry.profile_slot, time_ms, entities, help_ms);
+      return time_ms;
     }
   };
 
@@ -0,0 +1,323 @@
+#pragma once
+
+#include "system_base.h"
+#include "worker_pool.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace portal_core
+{
+
+  /**
+   * 固定容量環形緩衝
+   * 寫滿後覆蓋最舊的數據；push 返回槽位引用以便複用其中容器的容量
+   */
+  template <typename T, size_t Capacity>
+  class RingBuffer
+  {
+  public:
+    T &push()
+    {
+      T &slot = data_[head_];
+      head_ = (head_ + 1) % Capacity;
+      count_ = std::min(count_ + 1, Capacity);
+      return slot;
+    }
+
+    void push(const T &value) { push() = value; }
+
+    /**
+     * 按時間順序訪問，0 為最舊的一項
+     */
+    const T &operator[](size_t index) const
+    {
+      return data_[(head_ + Capacity - count_ + index) % Capacity];
+    }
+
+    const T &back() const { return (*this)[count_ - 1]; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    void clear()
+    {
+      head_ = 0;
+      count_ = 0;
+    }
+
+  private:
+    std::array<T, Capacity> data_{};
+    size_t head_ = 0;
+    size_t count_ = 0;
+  };
+
+  /**
+   * 系統性能分析器
+   * 由 SystemManager 常駐開啟，記錄每個系統的耗時和處理實體數、每層的關鍵路徑、
+   * 以及工作線程的忙碌/空閒時間，最近 HISTORY_SIZE 幀保存在環形緩衝中
+   */
+  class SystemProfiler
+  {
+  public:
+    using Clock = std::chrono::high_resolution_clock;
+    static constexpr size_t HISTORY_SIZE = 120;
+
+    struct SystemSample
+    {
+      float time_ms = 0.0f;  // 本幀累計耗時（FixedUpdate 多次步進時為總和），不含幫助時間
+      float help_ms = 0.0f;  // 等待自己的任務時替其他系統執行任務的時間
+      uint32_t calls = 0;    // 本幀調用次數
+      uint64_t entities = 0; // 本幀處理的實體數
+    };
+
+    struct LayerSample
+    {
+      SystemPhase phase = SystemPhase::Update;
+      uint32_t layer_index = 0;
+      uint32_t system_count = 0;
+      float wall_ms = 0.0f;          // 層的實際耗時
+      float critical_path_ms = 0.0f; // 層內最慢系統的耗時（並行時的理論下限）
+    };
+
+    struct FrameSample
+    {
+      uint64_t frame_index = 0;
+      float frame_ms = 0.0f;          // update_systems 總耗時
+      float system_time_ms = 0.0f;    // 所有系統耗時之和（串行成本）
+      float critical_path_ms = 0.0f;  // 各層關鍵路徑之和
+      float worker_busy_ms = 0.0f;    // 工作線程執行任務的總時間
+      float worker_idle_ms = 0.0f;    // 工作線程在本幀內的空閒總時間
+      uint64_t tasks_stolen = 0;      // 本幀竊取的任務數（線程間負載不均的指標）
+      uint32_t fixed_steps = 0;
+      std::vector<LayerSample> layers;
+    };
+
+    struct SystemStats
+    {
+      std::string name;
+      SystemPhase phase = SystemPhase::Update;
+      float last_ms = 0.0f;
+      float avg_ms = 0.0f;
+      float max_ms = 0.0f;
+      float last_help_ms = 0.0f;
+      float avg_help_ms = 0.0f;
+      uint64_t last_entities = 0;
+      float avg_entities = 0.0f;
+    };
+
+    /**
+     * 在當前線程上統計實體數的作用域
+     * 作用域內調用 report_entities 的數量累加到 counter
+     */
+    class EntityCountScope
+    {
+    public:
+      explicit EntityCountScope(uint64_t &counter) : previous_(tls_entity_counter_) { tls_entity_counter_ = &counter; }
+      ~EntityCountScope() { tls_entity_counter_ = previous_; }
+      EntityCountScope(const EntityCountScope &) = delete;
+      EntityCountScope &operator=(const EntityCountScope &) = delete;
+
+    private:
+      uint64_t *previous_;
+    };
+
+    /**
+     * 報告當前系統處理的實體數（parallel_each 會自動調用）
+     */
+    static void report_entities(uint64_t count)
+    {
+      if (tls_entity_counter_)
+      {
+        *tls_entity_counter_ += count;
+      }
+    }
+
+    static float elapsed_ms(Clock::time_point start, Clock::time_point end)
+    {
+      return std::chrono::duration<float, std::milli>(end - start).count();
+    }
+
+    /**
+     * 註冊系統並返回槽位（同名系統返回已有槽位）
+     */
+    size_t register_system(const std::string &name, SystemPhase phase)
+    {
+      auto it = slot_by_name_.find(name);
+      if (it != slot_by_name_.end())
+      {
+        tracks_[it->second].phase = phase;
+        return it->second;
+      }
+      tracks_.push_back(SystemTrack{name, phase, {}, {}});
+      slot_by_name_.emplace(name, tracks_.size() - 1);
+      return tracks_.size() - 1;
+    }
+
+    void begin_frame(uint64_t frame_index, const WorkerPool *pool)
+    {
+      current_frame_.frame_index = frame_index;
+      current_frame_.layers.clear();
+      for (auto &track : tracks_)
+      {
+        track.current = SystemSample{};
+      }
+
+      frame_start_ = Clock::now();
+      busy_ns_at_frame_start_ = pool ? pool->get_busy_time_ns() : 0;
+      stolen_at_frame_start_ = pool ? pool->get_stolen_task_count() : 0;
+    }
+
+    /**
+     * 記錄一次系統調用（不同系統可在不同線程上同時調用）
+     * time_ms 為系統自身的耗時，help_ms 為其間替其他任務組執行任務的時間
+     */
+    void record_system(size_t slot, float time_ms, uint64_t entities, float help_ms = 0.0f)
+    {
+      SystemSample &sample = tracks_[slot].current;
+      sample.time_ms += time_ms;
+      sample.help_ms += help_ms;
+      sample.calls++;
+      sample.entities += entities;
+    }
+
+    /**
+     * 記錄一層的耗時；同一幀內重複執行的層（FixedUpdate）會累加
+     */
+    void record_layer(SystemPhase phase, uint32_t layer_index, uint32_t system_count, float wall_ms, float critical_path_ms)
+    {
+      for (auto &layer : current_frame_.layers)
+      {
+        if (layer.phase == phase && layer.layer_index == layer_index)
+        {
+          layer.wall_ms += wall_ms;
+          layer.critical_path_ms += critical_path_ms;
+          return;
+        }
+      }
+      current_frame_.layers.push_back(LayerSample{phase, layer_index, system_count, wall_ms, critical_path_ms});
+    }
+
+    void end_frame(uint32_t fixed_steps, const WorkerPool *pool)
+    {
+      current_frame_.frame_ms = elapsed_ms(frame_start_, Clock::now());
+      current_frame_.fixed_steps = fixed_steps;
+
+      current_frame_.system_time_ms = 0.0f;
+      for (auto &track : tracks_)
+      {
+        current_frame_.system_time_ms += track.current.time_ms;
+        track.history.push(track.current);
+      }
+
+      current_frame_.critical_path_ms = 0.0f;
+      for (const auto &layer : current_frame_.layers)
+      {
+        current_frame_.critical_path_ms += layer.critical_path_ms;
+      }
+
+      if (pool)
+      {
+        const float busy_ms = static_cast<float>(pool->get_busy_time_ns() - busy_ns_at_frame_start_) / 1.0e6f;
+        const float available_ms = current_frame_.frame_ms * static_cast<float>(pool->get_worker_count());
+        current_frame_.worker_busy_ms = busy_ms;
+        current_frame_.worker_idle_ms = std::max(0.0f, available_ms - busy_ms);
+        current_frame_.tasks_stolen = pool->get_stolen_task_count() - stolen_at_frame_start_;
+      }
+      else
+      {
+        current_frame_.worker_busy_ms = 0.0f;
+        current_frame_.worker_idle_ms = 0.0f;
+        current_frame_.tasks_stolen = 0;
+      }
+
+      // 交換而非拷貝，複用層數組的容量
+      FrameSample &slot = frames_.push();
+      std::swap(slot, current_frame_);
+    }
+
+    /**
+     * 按平均耗時降序排列的系統統計
+     */
+    std::vector<SystemStats> get_system_stats() const
+    {
+      std::vector<SystemStats> result;
+      result.reserve(tracks_.size());
+
+      for (const auto &track : tracks_)
+      {
+        SystemStats stats;
+        stats.name = track.name;
+        stats.phase = track.phase;
+
+        const size_t count = track.history.size();
+        if (count > 0)
+        {
+          double total_ms = 0.0;
+          double total_help_ms = 0.0;
+          double total_entities = 0.0;
+          for (size_t i = 0; i < count; ++i)
+          {
+            const SystemSample &sample = track.history[i];
+            total_ms += sample.time_ms;
+            total_help_ms += sample.help_ms;
+            total_entities += static_cast<double>(sample.entities);
+            stats.max_ms = std::max(stats.max_ms, sample.time_ms);
+          }
+          stats.last_ms = track.history.back().time_ms;
+          stats.last_help_ms = track.history.back().help_ms;
+          stats.last_entities = track.history.back().entities;
+          stats.avg_ms = static_cast<float>(total_ms / count);
+          stats.avg_help_ms = static_cast<float>(total_help_ms / count);
+          stats.avg_entities = static_cast<float>(total_entities / count);
+        }
+
+        result.push_back(std::move(stats));
+      }
+
+      std::sort(result.begin(), result.end(), [](const SystemStats &a, const SystemStats &b)
+                { return a.avg_ms > b.avg_ms; });
+      return result;
+    }
+
+    size_t get_system_count() const { return tracks_.size(); }
+    const std::string &get_system_name(size_t slot) const { return tracks_[slot].name; }
+    const RingBuffer<SystemSample, HISTORY_SIZE> &get_system_history(size_t slot) const { return tracks_[slot].history; }
+
+    const RingBuffer<FrameSample, HISTORY_SIZE> &get_frame_history() const { return frames_; }
+    const FrameSample *get_last_frame() const { return frames_.empty() ? nullptr : &frames_.back(); }
+
+    void clear()
+    {
+      tracks_.clear();
+      slot_by_name_.clear();
+      frames_.clear();
+      current_frame_ = FrameSample{};
+    }
+
+  private:
+    struct SystemTrack
+    {
+      std::string name;
+      SystemPhase phase;
+      RingBuffer<SystemSample, HISTORY_SIZE> history;
+      SystemSample current;
+    };
+
+    std::vector<SystemTrack> tracks_;
+    std::unordered_map<std::string, size_t> slot_by_name_;
+    RingBuffer<FrameSample, HISTORY_SIZE> frames_;
+    FrameSample current_frame_;
+
+    Clock::time_point frame_start_;
+    uint64_t busy_ns_at_frame_start_ = 0;
+    uint64_t stolen_at_frame_start_ = 0;
+
+    inline static thread_local uint64_t *tls_entity_counter_ = nullptr;
+  };
+
+} // namespace portal_core
@@ -2,6 +2,8 @@
 #include "../components/physics_body_component.h"
 #include "../components/transform_component.h"
 #include "../components/physics_command_component.h"
+#include "../components/physics_sync_component.h"
+#include <Jolt/Physics/Body/BodyLockMulti.h>
 #include <iostream>
 #include <chrono>
 #include <algorithm>
@@ -39,16 +41,23 @@ namespace portal_core
     // 重置每幀統計
     commands_executed_this_frame_ = 0;
     stats_.commands_executed_this_frame = 0;
-    entities_processed_this_frame_.clear();
+    stats_.commands_in_stream = 0;
+    stats_.locked_batches = 0;
+
+    // 上一幀的命令流指向即將回收的幀內存，先換成空的命令流再重置
+    stream_ = CommandStream(frame_arena_);
+    frame_arena_.reset();
+    list_allocations_this_frame_ = 0;
 
     // 更新延遲命令計時
     delta_time_accumulator_ += delta_time;
 
-    // 執行不同時機的命令
-    execute_immediate_commands(registry);
-    execute_delayed_commands(registry, delta_time);
-    execute_before_physics_commands(registry);
-    execute_recurring_commands(registry);
+    // 收集立即、到期延遲、物理步進前與重複命令為一條命令流，排序一次後按序執行
+    gather_commands(registry, delta_time);
+    last_stream_size_ = stream_.commands.size();
+    sort_command_stream();
+    execute_command_stream(registry);
+    restore_unfinished_commands(registry);
 
     // 清理已執行的命令
     cleanup_executed_commands(registry);
@@ -59,6 +68,7 @@ namespace portal_core
     // 更新統計數據
     auto command_view = registry.view<PhysicsCommandComponent>();
     stats_.entities_with_commands = 0;
+    uint32_t allocations = list_allocations_this_frame_ + frame_arena_.get_heap_allocations();
     for (auto entity : command_view)
     {
       auto &cmd_comp = command_view.get<PhysicsCommandComponent>(entity);
@@ -66,198 +76,456 @@ namespace portal_core
       {
         stats_.entities_with_commands++;
       }
+      allocations += cmd_comp.allocation_count;
+      cmd_comp.allocation_count = 0;
     }
+    stats_.allocations_this_frame = allocations;
+    stats_.frame_arena_bytes = frame_arena_.get_bytes_used();
   }
 
   void PhysicsCommandSystem::cleanup()
   {
     std::cout << "PhysicsCommandSystem: Cleaning up..." << std::endl;
 
-    entities_processed_this_frame_.clear();
+    stream_ = CommandStream(frame_arena_);
     physics_world_ = nullptr;
     initialized_ = false;
 
     std::cout << "PhysicsCommandSystem: Cleanup complete." << std::endl;
   }
 
-  void PhysicsCommandSystem::execute_immediate_commands(entt::registry &registry)
+  void PhysicsCommandSystem::execute_after_physics_commands(entt::registry &registry)
   {
+    stream_.clear();
     auto view = registry.view<PhysicsCommandComponent>();
+    for (auto entity : view)
+    {
+      auto &cmd_comp = view.get<PhysicsCommandComponent>(entity);
+      if (cmd_comp.enabled)
+      {
+        stage_command_list(cmd_comp.after_physics_commands, entity, CommandStage::AFTER_PHYSICS);
+      }
+    }
 
-    view.each([&](auto entity, auto &cmd_comp)
-              {
-        if (commands_executed_this_frame_ >= max_commands_per_frame_) {
-            return;
-        }
+    sort_command_stream();
+    execute_command_stream(registry);
+    restore_unfinished_commands(registry);
+  }
 
-        if (!cmd_comp.enabled || cmd_comp.immediate_commands.empty()) {
-            return;
-        }
+  void PhysicsCommandSystem::gather_commands(entt::registry &registry, float delta_time)
+  {
+    stream_.clear();
+    // 按上一幀的命令數預留，避免在幀內存中反復擴容
+    stream_.commands.reserve(last_stream_size_);
+    stream_.infos.reserve(last_stream_size_);
+    stream_.entries.reserve(last_stream_size_);
 
-        // 執行立即命令
-        auto& commands = cmd_comp.immediate_commands;
-        for (auto it = commands.begin(); it != commands.end() && commands_executed_this_frame_ < max_commands_per_frame_;) {
-            const PhysicsCommand& command = *it;
-            
-            if (execute_command(command, entity, registry)) {
-                stats_.total_commands_executed++;
-                stats_.commands_executed_this_frame++;
-                commands_executed_this_frame_++;
-            } else {
-                stats_.commands_failed++;
-            }
-
-            if (command.auto_remove) {
-                it = commands.erase(it);
-            } else {
-                ++it;
-            }
+    // 一次遍歷收集所有實體的命令；命令移出實體列表，執行期間自定義命令新增的命令留到下一幀
+    auto view = registry.view<PhysicsCommandComponent>();
+    for (auto entity : view)
+    {
+      auto &cmd_comp = view.get<PhysicsCommandComponent>(entity);
+      if (!cmd_comp.enabled)
+      {
+        continue;
+      }
+
+      stage_command_list(cmd_comp.immediate_commands, entity, CommandStage::IMMEDIATE);
+
+      if (!cmd_comp.delayed_commands.empty())
+      {
+        cmd_comp.update_delayed_commands(delta_time);
+        const size_t first = stream_.commands.size();
+        if (cmd_comp.take_ready_delayed_commands(stream_.commands) > 0)
+        {
+          add_stream_entries(first, entity, CommandStage::DELAYED);
         }
+      }
 
-        entities_processed_this_frame_.insert(entity); });
+      stage_command_list(cmd_comp.before_physics_commands, entity, CommandStage::BEFORE_PHYSICS);
+      stage_command_list(cmd_comp.recurring_commands, entity, CommandStage::RECURRING);
+    }
   }
 
-  void PhysicsCommandSystem::execute_before_physics_commands(entt::registry &registry)
+  void PhysicsCommandSystem::stage_command_list(std::vector<PhysicsCommand> &commands, entt::entity entity, CommandStage stage)
   {
-    auto view = registry.view<PhysicsCommandComponent>();
+    if (commands.empty())
+    {
+      return;
+    }
+    const size_t first = stream_.commands.size();
+    for (auto &command : commands)
+    {
+      stream_.commands.push_back(std::move(command));
+    }
+    commands.clear();
+    add_stream_entries(first, entity, stage);
+  }
 
-    view.each([&](auto entity, auto &cmd_comp)
-              {
-        if (commands_executed_this_frame_ >= max_commands_per_frame_) {
-            return;
-        }
+  void PhysicsCommandSystem::add_stream_entries(size_t first, entt::entity entity, CommandStage stage)
+  {
+    // 排序鍵（高位到低位）：階段 3 位 | 反轉優先級 2 位 | 輪次 27 位 | 輪轉後的實體 32 位
+    // 輪次是命令在該實體同一優先級中的序號：各實體輪流執行，每幀上限不會被單個實體耗盡
+    const uint64_t entity_bits = static_cast<uint32_t>(entt::to_integral(entity) - stream_rotation_);
+    uint32_t rounds[4] = {0, 0, 0, 0};
+    for (size_t i = first; i < stream_.commands.size(); ++i)
+    {
+      const int priority = static_cast<int>(stream_.commands[i].priority);
+      const uint64_t round = std::min<uint32_t>(rounds[priority]++, (1u << 27) - 1);
+      CommandStreamEntry entry;
+      entry.key = (static_cast<uint64_t>(stage) << 61) |
+                  (static_cast<uint64_t>(3 - priority) << 59) |
+                  (round << 32) |
+                  entity_bits;
+      entry.index = static_cast<uint32_t>(i);
+      stream_.entries.push_back(entry);
+      stream_.infos.push_back(StagedCommandInfo{entity, stage, false});
+    }
+  }
 
-        if (!cmd_comp.enabled || cmd_comp.before_physics_commands.empty()) {
-            return;
-        }
+  void PhysicsCommandSystem::sort_command_stream()
+  {
+    // LSD 基數排序，每輪 8 位；所有條目在某一字節相同時跳過該輪（高位輪次通常全為 0）
+    // 基數排序是穩定的，鍵相同的命令保持收集順序
+    const size_t count = stream_.entries.size();
+    if (count < 2)
+    {
+      return;
+    }
+    stream_.sort_buffer.resize(count);
+    CommandStreamEntry *source = stream_.entries.data();
+    CommandStreamEntry *target = stream_.sort_buffer.data();
 
-        // 執行物理步進前命令
-        auto& commands = cmd_comp.before_physics_commands;
-        for (auto it = commands.begin(); it != commands.end() && commands_executed_this_frame_ < max_commands_per_frame_;) {
-            const PhysicsCommand& command = *it;
-            
-            if (execute_command(command, entity, registry)) {
-                stats_.total_commands_executed++;
-                stats_.commands_executed_this_frame++;
-                commands_executed_this_frame_++;
-            } else {
-                stats_.commands_failed++;
-            }
-
-            if (command.auto_remove) {
-                it = commands.erase(it);
-            } else {
-                ++it;
-            }
-        }
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+      size_t offsets[256] = {};
+      for (size_t i = 0; i < count; ++i)
+      {
+        ++offsets[(source[i].key >> shift) & 0xFF];
+      }
+      if (offsets[(source[0].key >> shift) & 0xFF] == count)
+      {
+        continue;
+      }
+      size_t total = 0;
+      for (size_t &offset : offsets)
+      {
+        const size_t bucket = offset;
+        offset = total;
+        total += bucket;
+      }
+      for (size_t i = 0; i < count; ++i)
+      {
+        target[offsets[(source[i].key >> shift) & 0xFF]++] = source[i];
+      }
+      std::swap(source, target);
+    }
 
-        entities_processed_this_frame_.insert(entity); });
+    if (source != stream_.entries.data())
+    {
+      std::copy(source, source + count, stream_.entries.data());
+    }
   }
 
-  void PhysicsCommandSystem::execute_after_physics_commands(entt::registry &registry)
+  void PhysicsCommandSystem::execute_command_stream(entt::registry &registry)
   {
-    auto view = registry.view<PhysicsCommandComponent>();
+    stats_.commands_in_stream += static_cast<uint32_t>(stream_.entries.size());
 
-    view.each([&](auto entity, auto &cmd_comp)
-              {
-        if (commands_executed_this_frame_ >= max_commands_per_frame_) {
-            return;
-        }
-
-        if (!cmd_comp.enabled || cmd_comp.after_physics_commands.empty()) {
-            return;
-        }
+    const bool batching = physics_world_ && physics_world_->is_initialized();
+    size_t next = 0;
+    while (next < stream_.entries.size() && commands_executed_this_frame_ < max_commands_per_frame_)
+    {
+      const CommandStreamEntry &entry = stream_.entries[next];
+      if (!batching || !is_batchable(stream_.commands[entry.index]))
+      {
+        // 自定義命令等可能再次訪問物理世界，不能在鎖內執行
+        stream_.infos[entry.index].executed = true;
+        execute_and_count(stream_.commands[entry.index], stream_.infos[entry.index].entity, registry);
+        ++next;
+        continue;
+      }
 
-        // 執行物理步進後命令
-        auto& commands = cmd_comp.after_physics_commands;
-        for (auto it = commands.begin(); it != commands.end() && commands_executed_this_frame_ < max_commands_per_frame_;) {
-            const PhysicsCommand& command = *it;
-            
-            if (execute_command(command, entity, registry)) {
-                stats_.total_commands_executed++;
-                stats_.commands_executed_this_frame++;
-                commands_executed_this_frame_++;
-            } else {
-                stats_.commands_failed++;
-            }
-
-            if (command.auto_remove) {
-                it = commands.erase(it);
-            } else {
-                ++it;
-            }
-        }
+      // 連續的可批量命令組成一批，批大小不超過剩餘的每幀上限
+      const size_t budget = max_commands_per_frame_ - commands_executed_this_frame_;
+      size_t end = next + 1;
+      while (end < stream_.entries.size() && end - next < std::min(budget, COMMAND_BATCH_SIZE) &&
+             is_batchable(stream_.commands[stream_.entries[end].index]))
+      {
+        ++end;
+      }
+      execute_command_batch(next, end, registry);
+      next = end;
+    }
 
-        entities_processed_this_frame_.insert(entity); });
+    if (next < stream_.entries.size())
+    {
+      // 下一幀從第一個未執行命令的實體開始輪轉
+      stats_.commands_skipped += static_cast<uint32_t>(stream_.entries.size() - next);
+      stream_rotation_ = entt::to_integral(stream_.infos[stream_.entries[next].index].entity);
+    }
   }
 
-  void PhysicsCommandSystem::execute_delayed_commands(entt::registry &registry, float delta_time)
+  void PhysicsCommandSystem::restore_unfinished_commands(entt::registry &registry)
   {
-    auto view = registry.view<PhysicsCommandComponent>();
+    // 同一實體同一階段的命令在 commands 中連續存放，逐段放回
+    auto &commands = stream_.commands;
+    size_t first = 0;
+    while (first < commands.size())
+    {
+      const entt::entity entity = stream_.infos[first].entity;
+      const CommandStage stage = stream_.infos[first].stage;
+      size_t last = first + 1;
+      while (last < commands.size() && stream_.infos[last].entity == entity && stream_.infos[last].stage == stage)
+      {
+        ++last;
+      }
 
-    view.each([&](auto entity, auto &cmd_comp)
-              {
-        if (commands_executed_this_frame_ >= max_commands_per_frame_) {
-            return;
+      // 保留未執行與不自動移除的命令，保持原順序；延遲命令到期後只執行一次，執行過即丟棄
+      size_t kept_end = first;
+      for (size_t i = first; i < last; ++i)
+      {
+        const bool executed = stream_.infos[i].executed;
+        if (!executed || (stage != CommandStage::DELAYED && !commands[i].auto_remove))
+        {
+          if (kept_end != i)
+          {
+            commands[kept_end] = std::move(commands[i]);
+          }
+          ++kept_end;
         }
+      }
 
-        if (!cmd_comp.enabled || cmd_comp.delayed_commands.empty()) {
-            return;
+      // 執行期間實體可能被銷毀或移除組件，此時丟棄剩餘命令
+      auto *cmd_comp = registry.valid(entity) ? registry.try_get<PhysicsCommandComponent>(entity) : nullptr;
+      if (cmd_comp && kept_end != first)
+      {
+        auto &list = get_stage_list(*cmd_comp, stage);
+        const size_t added = list.size();
+        const size_t previous_capacity = list.capacity();
+        list.insert(list.begin(), std::make_move_iterator(commands.begin() + first), std::make_move_iterator(commands.begin() + kept_end));
+        if (list.capacity() != previous_capacity)
+        {
+          ++list_allocations_this_frame_;
         }
-
-        // 更新延遲命令計時
-        cmd_comp.update_delayed_commands(delta_time);
-
-        // 獲取準備執行的延遲命令
-        auto ready_commands = cmd_comp.get_ready_delayed_commands();
-        
-        for (const auto& command : ready_commands) {
-            if (commands_executed_this_frame_ >= max_commands_per_frame_) {
-                break;
-            }
-
-            if (execute_command(command, entity, registry)) {
-                stats_.total_commands_executed++;
-                stats_.commands_executed_this_frame++;
-                commands_executed_this_frame_++;
-            } else {
-                stats_.commands_failed++;
-            }
+        if (added > 0 && stage != CommandStage::DELAYED && stage != CommandStage::RECURRING)
+        {
+          // 執行期間新增的命令可能優先級更高，兩段各自有序，穩定合併
+          std::inplace_merge(list.begin(), list.end() - added, list.end(),
+                             [](const PhysicsCommand &a, const PhysicsCommand &b)
+                             { return static_cast<int>(a.priority) > static_cast<int>(b.priority); });
         }
+      }
+      first = last;
+    }
+    stream_.clear();
+  }
 
-        entities_processed_this_frame_.insert(entity); });
+  std::vector<PhysicsCommand> &PhysicsCommandSystem::get_stage_list(PhysicsCommandComponent &cmd_comp, CommandStage stage) const
+  {
+    switch (stage)
+    {
+    case CommandStage::IMMEDIATE:
+      return cmd_comp.immediate_commands;
+    case CommandStage::DELAYED:
+      return cmd_comp.delayed_commands;
+    case CommandStage::RECURRING:
+      return cmd_comp.recurring_commands;
+    case CommandStage::AFTER_PHYSICS:
+      return cmd_comp.after_physics_commands;
+    case CommandStage::BEFORE_PHYSICS:
+    default:
+      return cmd_comp.before_physics_commands;
+    }
   }
 
-  void PhysicsCommandSystem::execute_recurring_commands(entt::registry &registry)
+  bool PhysicsCommandSystem::is_batchable(const PhysicsCommand &command) const
   {
-    auto view = registry.view<PhysicsCommandComponent>();
+    switch (command.type)
+    {
+    case PhysicsCommandType::ADD_FORCE:
+    case PhysicsCommandType::ADD_IMPULSE:
+    case PhysicsCommandType::ADD_TORQUE:
+    case PhysicsCommandType::ADD_ANGULAR_IMPULSE:
+    case PhysicsCommandType::ADD_FORCE_AT_POSITION:
+    case PhysicsCommandType::ADD_IMPULSE_AT_POSITION:
+    case PhysicsCommandType::SET_LINEAR_VELOCITY:
+    case PhysicsCommandType::SET_ANGULAR_VELOCITY:
+    case PhysicsCommandType::ADD_LINEAR_VELOCITY:
+    case PhysicsCommandType::ADD_ANGULAR_VELOCITY:
+      return true;
+    default:
+      // 位置類命令需要更新寬相，經 BodyInterface 執行；自定義與查詢命令不能在鎖內執行
+      return false;
+    }
+  }
 
-    view.each([&](auto entity, auto &cmd_comp)
-              {
-        if (commands_executed_this_frame_ >= max_commands_per_frame_) {
-            return;
-        }
+  void PhysicsCommandSystem::execute_command_batch(size_t begin, size_t end, entt::registry &registry)
+  {
+    auto &body_ids = stream_.batch_body_ids;
+    auto &bodies_to_activate = stream_.bodies_to_activate;
+    body_ids.clear();
+    bodies_to_activate.clear();
 
-        if (!cmd_comp.enabled || cmd_comp.recurring_commands.empty()) {
-            return;
-        }
+    for (size_t i = begin; i < end; ++i)
+    {
+      const uint32_t index = stream_.entries[i].index;
+      const entt::entity entity = stream_.infos[index].entity;
+      stream_.infos[index].executed = true;
+
+      // 驗證失敗的命令用無效 ID 佔位，鎖內取不到物理體即視為失敗
+      auto *physics_body = validate_command(stream_.commands[index], entity, registry) ? get_physics_body(entity, registry) : nullptr;
+      body_ids.push_back(physics_body && physics_body->is_valid() ? physics_body->body_id : JPH::BodyID());
+    }
 
-        // 執行重複命令
-        for (const auto& command : cmd_comp.recurring_commands) {
-            if (commands_executed_this_frame_ >= max_commands_per_frame_) {
-                break;
-            }
-
-            if (execute_command(command, entity, registry)) {
-                stats_.total_commands_executed++;
-                stats_.commands_executed_this_frame++;
-                commands_executed_this_frame_++;
-            } else {
-                stats_.commands_failed++;
-            }
+    uint32_t succeeded = 0;
+    {
+      JPH::BodyLockMultiWrite lock(physics_world_->get_physics_system().GetBodyLockInterface(), body_ids.data(), static_cast<int>(body_ids.size()));
+      for (size_t i = begin; i < end; ++i)
+      {
+        const size_t slot = i - begin;
+        const uint32_t index = stream_.entries[i].index;
+        JPH::Body *body = body_ids[slot].IsInvalid() ? nullptr : lock.GetBody(static_cast<int>(slot));
+        auto *physics_body = body ? get_physics_body(stream_.infos[index].entity, registry) : nullptr;
+
+        bool needs_activation = false;
+        const bool success = physics_body && apply_locked_command(stream_.commands[index], *body, *physics_body, needs_activation);
+        if (success)
+        {
+          ++succeeded;
+          if (needs_activation)
+          {
+            bodies_to_activate.push_back(body_ids[slot]);
+          }
+        }
+        else
+        {
+          stats_.commands_failed++;
         }
+      }
+    }
+    stats_.locked_batches++;
 
-        entities_processed_this_frame_.insert(entity); });
+    // 激活需要物體管理器的鎖，在釋放物理體鎖之後進行
+    if (!bodies_to_activate.empty())
+    {
+      physics_world_->get_body_interface().ActivateBodies(bodies_to_activate.data(), static_cast<int>(bodies_to_activate.size()));
+    }
+
+    stats_.total_commands_executed += succeeded;
+    stats_.commands_executed_this_frame += succeeded;
+    commands_executed_this_frame_ += succeeded;
+  }
+
+  bool PhysicsCommandSystem::apply_locked_command(const PhysicsCommand &command, JPH::Body &body, PhysicsBodyComponent &physics_body, bool &needs_activation)
+  {
+    // 與 BodyInterface 的語義一致：力只作用於動態物體，速度不作用於靜態物體
+    switch (command.type)
+    {
+    case PhysicsCommandType::ADD_FORCE:
+    case PhysicsCommandType::ADD_IMPULSE:
+    case PhysicsCommandType::ADD_TORQUE:
+    case PhysicsCommandType::ADD_ANGULAR_IMPULSE:
+    {
+      if (!body.IsDynamic())
+      {
+        return true;
+      }
+      const Vec3 value = command.get_data<Vec3>();
+      switch (command.type)
+      {
+      case PhysicsCommandType::ADD_FORCE:
+        body.AddForce(value);
+        break;
+      case PhysicsCommandType::ADD_IMPULSE:
+        body.AddImpulse(value);
+        break;
+      case PhysicsCommandType::ADD_TORQUE:
+        body.AddTorque(value);
+        break;
+      default:
+        body.AddAngularImpulse(value);
+        break;
+      }
+      needs_activation = !body.IsActive();
+      return true;
+    }
+    case PhysicsCommandType::ADD_FORCE_AT_POSITION:
+    case PhysicsCommandType::ADD_IMPULSE_AT_POSITION:
+    {
+      if (!body.IsDynamic())
+      {
+        return true;
+      }
+      // Jolt 按相對質心的位置同時施加線性與角向分量
+      const auto value_position = command.get_data<std::pair<Vec3, Vec3>>();
+      const JPH::RVec3 position(value_position.second.GetX(), value_position.second.GetY(), value_position.second.GetZ());
+      if (command.type == PhysicsCommandType::ADD_FORCE_AT_POSITION)
+      {
+        body.AddForce(value_position.first, position);
+      }
+      else
+      {
+        body.AddImpulse(value_position.first, position);
+      }
+      needs_activation = !body.IsActive();
+      return true;
+    }
+    case PhysicsCommandType::SET_LINEAR_VELOCITY:
+    case PhysicsCommandType::ADD_LINEAR_VELOCITY:
+    {
+      if (body.IsStatic())
+      {
+        return true;
+      }
+      Vec3 velocity = command.get_data<Vec3>();
+      if (command.type == PhysicsCommandType::ADD_LINEAR_VELOCITY)
+      {
+        velocity = body.GetLinearVelocity() + velocity;
+      }
+      body.SetLinearVelocityClamped(velocity);
+      physics_body.linear_velocity = body.GetLinearVelocity();
+      needs_activation = !body.IsActive() && !velocity.IsNearZero();
+      return true;
+    }
+    case PhysicsCommandType::SET_ANGULAR_VELOCITY:
+    case PhysicsCommandType::ADD_ANGULAR_VELOCITY:
+    {
+      if (body.IsStatic())
+      {
+        return true;
+      }
+      Vec3 velocity = command.get_data<Vec3>();
+      if (command.type == PhysicsCommandType::ADD_ANGULAR_VELOCITY)
+      {
+        velocity = body.GetAngularVelocity() + velocity;
+      }
+      body.SetAngularVelocityClamped(velocity);
+      physics_body.angular_velocity = body.GetAngularVelocity();
+      needs_activation = !body.IsActive() && !velocity.IsNearZero();
+      return true;
+    }
+    default:
+      return false;
+    }
+  }
+
+  bool PhysicsCommandSystem::execute_and_count(const PhysicsCommand &command, entt::entity entity, entt::registry &registry)
+  {
+    const bool success = execute_command(command, entity, registry);
+    count_command_result(success);
+    return success;
+  }
+
+  void PhysicsCommandSystem::count_command_result(bool success)
+  {
+    if (success)
+    {
+      stats_.total_commands_executed++;
+      stats_.commands_executed_this_frame++;
+      commands_executed_this_frame_++;
+      return;
+    }
+    stats_.commands_failed++;
   }
 
   bool PhysicsCommandSystem::execute_command(const PhysicsCommand &command, entt::entity entity, entt::registry &registry)
@@ -349,35 +617,19 @@ namespace portal_core
       return true;
     }
     case PhysicsCommandType::ADD_FORCE_AT_POSITION:
-    {
-      auto force_pos = command.get_data<std::pair<Vec3, Vec3>>();
-      Vec3 force = force_pos.first;
-      Vec3 position = force_pos.second;
-
-      // 計算相對於質心的位置向量
-      JPH::RVec3 com_pos = physics_world_->get_body_position(body_id);
-      Vec3 relative_pos(position.GetX() - com_pos.GetX(), position.GetY() - com_pos.GetY(), position.GetZ() - com_pos.GetZ());
-
-      // 添加力和相應的扭矩
-      physics_world_->add_force(body_id, force);
-      Vec3 torque = relative_pos.Cross(force);
-      physics_world_->add_torque(body_id, torque);
-      return true;
-    }
     case PhysicsCommandType::ADD_IMPULSE_AT_POSITION:
     {
-      auto impulse_pos = command.get_data<std::pair<Vec3, Vec3>>();
-      Vec3 impulse = impulse_pos.first;
-      Vec3 position = impulse_pos.second;
-
-      // 計算相對於質心的位置向量
-      JPH::RVec3 com_pos = physics_world_->get_body_position(body_id);
-      Vec3 relative_pos(position.GetX() - com_pos.GetX(), position.GetY() - com_pos.GetY(), position.GetZ() - com_pos.GetZ());
-
-      // 添加衝量和相應的角衝量
-      physics_world_->add_impulse(body_id, impulse);
-      Vec3 angular_impulse = relative_pos.Cross(impulse);
-      physics_world_->add_angular_impulse(body_id, angular_impulse);
+      // 與批量路徑一致，由 Jolt 按相對質心的位置同時施加線性與角向分量
+      const auto value_position = command.get_data<std::pair<Vec3, Vec3>>();
+      const JPH::RVec3 position(value_position.second.GetX(), value_position.second.GetY(), value_position.second.GetZ());
+      if (command.type == PhysicsCommandType::ADD_FORCE_AT_POSITION)
+      {
+        physics_world_->add_force(body_id, value_position.first, position);
+      }
+      else
+      {
+        physics_world_->add_impulse(body_id, value_position.first, position);
+      }
       return true;
     }
     default:
@@ -446,6 +698,12 @@ namespace portal_core
 
     JPH::BodyID body_id = physics_body->body_id;
 
+    // 直接改寫姿態屬於不連續移動，清除插值歷史，避免渲染從舊位置混合過來
+    if (auto *sync_comp = registry.try_get<PhysicsSyncComponent>(entity))
+    {
+      sync_comp->reset_pose_history();
+    }
+
     switch (command.type)
     {
     case PhysicsCommandType::SET_POSITION:
@@ -578,11 +836,9 @@ namespace portal_core
   {
     if (command.has_data())
     {
-      // 替換 try-catch 為簡單的檢查
-      auto custom_func = command.get_data<std::function<void()>>();
-      if (custom_func)
+      // 直接調用命令內部存儲的可調用對象，不做拷貝
+      if (command.invoke_custom())
       {
-        custom_func();
         return true;
       }
       else
@@ -712,6 +968,10 @@ namespace portal_core
 
   void PhysicsQuerySystem::execute_raycast_queries(entt::registry &registry)
   {
+    // 收集本幀所有實體的射線查詢，一次批量執行
+    raycast_batch_.clear();
+    raycast_targets_.clear();
+
     auto view = registry.view<PhysicsQueryComponent>();
 
     for (auto entity : view)
@@ -730,23 +990,43 @@ namespace portal_core
           break;
         }
 
-        if (execute_raycast_query(query, entity, registry))
-        {
-          stats_.raycast_queries_executed++;
-          queries_executed_this_frame_++;
-        }
-        else
-        {
-          stats_.queries_failed++;
-        }
+        raycast_batch_.push_back({JPH::RVec3(query.origin.GetX(), query.origin.GetY(), query.origin.GetZ()),
+                                  query.direction, query.max_distance});
+        raycast_targets_.push_back(&query);
+        stats_.raycast_queries_executed++;
+        queries_executed_this_frame_++;
       }
 
       query_comp.raycast_results_valid = true;
     }
+
+    if (raycast_batch_.empty())
+    {
+      return;
+    }
+
+    physics_world_->raycast_batch(raycast_batch_, raycast_results_);
+
+    for (size_t i = 0; i < raycast_targets_.size(); ++i)
+    {
+      PhysicsQueryComponent::RaycastQuery &query = *raycast_targets_[i];
+      query.hit = raycast_results_.hit[i] != 0;
+      if (query.hit)
+      {
+        query.hit_point = raycast_results_.hit_points[i];
+        query.hit_normal = raycast_results_.hit_normals[i];
+        query.hit_distance = raycast_results_.distances[i];
+        query.hit_entity = body_id_to_entity(raycast_results_.body_ids[i], registry);
+      }
+    }
   }
 
   void PhysicsQuerySystem::execute_overlap_queries(entt::registry &registry)
   {
+    // 收集本幀所有實體的重疊查詢，一次批量執行
+    overlap_batch_.clear();
+    overlap_targets_.clear();
+
     auto view = registry.view<PhysicsQueryComponent>();
 
     for (auto entity : view)
@@ -765,19 +1045,50 @@ namespace portal_core
           break;
         }
 
-        if (execute_overlap_query(query, entity, registry))
-        {
-          stats_.overlap_queries_executed++;
-          queries_executed_this_frame_++;
-        }
-        else
+        JPH::RVec3 center(query.center.GetX(), query.center.GetY(), query.center.GetZ());
+        switch (query.shape)
         {
+        case PhysicsQueryComponent::OverlapQuery::SPHERE:
+          overlap_batch_.push_back(PhysicsWorldManager::OverlapQuery::sphere(center, query.size.GetX()));
+          break;
+        case PhysicsQueryComponent::OverlapQuery::BOX:
+          overlap_batch_.push_back(PhysicsWorldManager::OverlapQuery::box(center, query.size, query.rotation));
+          break;
+        default:
           stats_.queries_failed++;
+          continue;
         }
+
+        overlap_targets_.push_back(&query);
+        stats_.overlap_queries_executed++;
+        queries_executed_this_frame_++;
       }
 
       query_comp.overlap_results_valid = true;
     }
+
+    if (overlap_batch_.empty())
+    {
+      return;
+    }
+
+    physics_world_->overlap_batch(overlap_batch_, overlap_results_);
+
+    // 轉換BodyID到entity並應用層過濾
+    for (size_t i = 0; i < overlap_targets_.size(); ++i)
+    {
+      PhysicsQueryComponent::OverlapQuery &query = *overlap_targets_[i];
+      query.overlapping_entities.clear();
+      const uint32_t first = overlap_results_.first[i];
+      for (uint32_t j = first; j < first + overlap_results_.count[i]; ++j)
+      {
+        entt::entity overlapping_entity = body_id_to_entity(overlap_results_.body_ids[j], registry);
+        if (overlapping_entity != entt::null && passes_layer_filter(overlapping_entity, query.layer_mask, registry))
+        {
+          query.overlapping_entities.push_back(overlapping_entity);
+        }
+      }
+    }
   }
 
   void PhysicsQuerySystem::execute_distance_queries(entt::registry &registry)
@@ -815,64 +1126,6 @@ namespace portal_core
     }
   }
 
-  bool PhysicsQuerySystem::execute_raycast_query(PhysicsQueryComponent::RaycastQuery &query, entt::entity entity, entt::registry &registry)
-  {
-    auto result = physics_world_->raycast(
-        JPH::RVec3(query.origin.GetX(), query.origin.GetY(), query.origin.GetZ()),
-        query.direction,
-        query.max_distance);
-
-    query.hit = result.hit;
-    if (result.hit)
-    {
-      query.hit_point = result.hit_point;
-      query.hit_normal = result.hit_normal;
-      query.hit_distance = result.distance;
-      query.hit_entity = body_id_to_entity(result.body_id, registry);
-    }
-
-    return true;
-  }
-
-  bool PhysicsQuerySystem::execute_overlap_query(PhysicsQueryComponent::OverlapQuery &query, entt::entity entity, entt::registry &registry)
-  {
-    std::vector<JPH::BodyID> body_ids;
-
-    switch (query.shape)
-    {
-    case PhysicsQueryComponent::OverlapQuery::SPHERE:
-    {
-      body_ids = physics_world_->overlap_sphere(
-          JPH::RVec3(query.center.GetX(), query.center.GetY(), query.center.GetZ()),
-          query.size.GetX());
-      break;
-    }
-    case PhysicsQueryComponent::OverlapQuery::BOX:
-    {
-      body_ids = physics_world_->overlap_box(
-          JPH::RVec3(query.center.GetX(), query.center.GetY(), query.center.GetZ()),
-          query.size,
-          query.rotation);
-      break;
-    }
-    default:
-      return false;
-    }
-
-    // 轉換BodyID到entity並應用層過濾
-    query.overlapping_entities.clear();
-    for (JPH::BodyID body_id : body_ids)
-    {
-      entt::entity overlapping_entity = body_id_to_entity(body_id, registry);
-      if (overlapping_entity != entt::null && passes_layer_filter(overlapping_entity, query.layer_mask, registry))
-      {
-        query.overlapping_entities.push_back(overlapping_entity);
-      }
-    }
-
-    return true;
-  }
-
   bool PhysicsQuerySystem::execute_distance_query(PhysicsQueryComponent::DistanceQuery &query, entt::entity entity, entt::registry &registry)
   {
     // 使用球體重疊查詢來實現距離查詢
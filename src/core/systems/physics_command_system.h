@@ -5,6 +5,7 @@
 #include "../components/physics_command_component.h"
 #include "../components/physics_body_component.h"
 #include "../components/transform_component.h"
+#include "../frame_arena.h"
 #include <entt/entt.hpp>
 
 namespace portal_core
@@ -26,6 +27,12 @@ namespace portal_core
         virtual void update(entt::registry &registry, float delta_time) override;
         virtual void cleanup() override;
         virtual const char *get_name() const override { return "PhysicsCommandSystem"; }
+        // 自定義命令回調也應只訪問以下組件
+        virtual ComponentAccess get_component_access() const override
+        {
+            return make_component_access<PhysicsCommandComponent, PhysicsBodyComponent, TransformComponent>();
+        }
+        virtual SystemPhase get_phase() const override { return SystemPhase::FixedUpdate; }
 
         // 命令執行控制
         void set_enabled(bool enabled) { enabled_ = enabled; }
@@ -44,17 +51,37 @@ namespace portal_core
             uint32_t commands_failed = 0;
             float execution_time = 0.0f;
             uint32_t entities_with_commands = 0;
+
+            // 命令存儲的堆分配：上一幀以來添加命令引起的列表擴容與自定義命令溢出，加上幀內存塊的申請
+            uint32_t allocations_this_frame = 0;
+            size_t frame_arena_bytes = 0;        // 本幀暫存命令使用的幀內存
+
+            // 全局命令流
+            uint32_t commands_in_stream = 0;     // 本幀收集的命令數
+            uint32_t locked_batches = 0;         // 本幀獲取物理體鎖的次數（每批一次）
         };
 
         const CommandSystemStats &get_stats() const { return stats_; }
 
+        // 每批最多執行的可批量命令數（共用一次物理體鎖）
+        static constexpr size_t COMMAND_BATCH_SIZE = 64;
+
     protected:
+        /**
+         * 命令流階段，按執行順序排列
+         * 物理步進後命令單獨成流，由 execute_after_physics_commands 執行
+         */
+        enum class CommandStage : uint8_t
+        {
+            IMMEDIATE = 0,
+            DELAYED = 1,
+            BEFORE_PHYSICS = 2,
+            RECURRING = 3,
+            AFTER_PHYSICS = 4
+        };
+
         // 命令執行方法
-        void execute_immediate_commands(entt::registry &registry);
-        void execute_before_physics_commands(entt::registry &registry);
         void execute_after_physics_commands(entt::registry &registry);
-        void execute_delayed_commands(entt::registry &registry, float delta_time);
-        void execute_recurring_commands(entt::registry &registry);
 
         // 單個命令執行
         bool execute_command(const PhysicsCommand &command, entt::entity entity, entt::registry &registry);
@@ -74,6 +101,22 @@ namespace portal_core
         TransformComponent *get_transform(entt::entity entity, entt::registry &registry) const;
         PhysicsWorldManager *get_physics_world() const;
 
+        // 全局命令流：收集所有實體的命令，按 (階段, 優先級, 輪次, 實體) 排序一次後分批執行
+        void gather_commands(entt::registry &registry, float delta_time);
+        void stage_command_list(std::vector<PhysicsCommand> &commands, entt::entity entity, CommandStage stage);
+        void add_stream_entries(size_t first, entt::entity entity, CommandStage stage);
+        void sort_command_stream();
+        void execute_command_stream(entt::registry &registry);
+        void restore_unfinished_commands(entt::registry &registry);
+        std::vector<PhysicsCommand> &get_stage_list(PhysicsCommandComponent &cmd_comp, CommandStage stage) const;
+
+        // 可批量命令（力與速度）在一次物理體鎖內直接作用於 Jolt 物理體
+        bool is_batchable(const PhysicsCommand &command) const;
+        void execute_command_batch(size_t begin, size_t end, entt::registry &registry);
+        bool apply_locked_command(const PhysicsCommand &command, JPH::Body &body, PhysicsBodyComponent &physics_body, bool &needs_activation);
+        bool execute_and_count(const PhysicsCommand &command, entt::entity entity, entt::registry &registry);
+        void count_command_result(bool success);
+
         // 命令清理
         void cleanup_executed_commands(entt::registry &registry);
         void remove_command_from_vector(std::vector<PhysicsCommand> &commands, uint64_t command_id);
@@ -93,11 +136,59 @@ namespace portal_core
         // 統計數據
         mutable CommandSystemStats stats_;
 
-        // 執行狀態跟踪
-        std::unordered_set<entt::entity> entities_processed_this_frame_;
-
         // 延遲命令計時
         float delta_time_accumulator_ = 0.0f;
+
+        // 命令流中的一條命令：排序鍵與 CommandStream::commands 中的下標
+        struct CommandStreamEntry
+        {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        struct StagedCommandInfo
+        {
+            entt::entity entity;
+            CommandStage stage;
+            bool executed;
+        };
+
+        // 本幀命令流，全部分配自幀內存
+        struct CommandStream
+        {
+            explicit CommandStream(FrameArena &arena)
+                : commands(FrameArenaAllocator<PhysicsCommand>(arena)),
+                  infos(FrameArenaAllocator<StagedCommandInfo>(arena)),
+                  entries(FrameArenaAllocator<CommandStreamEntry>(arena)),
+                  sort_buffer(FrameArenaAllocator<CommandStreamEntry>(arena)),
+                  batch_body_ids(FrameArenaAllocator<JPH::BodyID>(arena)),
+                  bodies_to_activate(FrameArenaAllocator<JPH::BodyID>(arena))
+            {
+            }
+
+            void clear()
+            {
+                commands.clear();
+                infos.clear();
+                entries.clear();
+            }
+
+            FrameVector<PhysicsCommand> commands;       // 從各實體列表移出的命令，同一實體同一階段連續存放
+            FrameVector<StagedCommandInfo> infos;       // 與 commands 一一對應
+            FrameVector<CommandStreamEntry> entries;    // 排序後即執行順序
+            FrameVector<CommandStreamEntry> sort_buffer;
+            FrameVector<JPH::BodyID> batch_body_ids;
+            FrameVector<JPH::BodyID> bodies_to_activate;
+        };
+
+        // 幀內存：本幀的命令流暫存於此，下一幀開始時整體回收
+        FrameArena frame_arena_;
+        CommandStream stream_{frame_arena_};
+        size_t last_stream_size_ = 0;
+        uint32_t list_allocations_this_frame_ = 0;
+
+        // 公平輪轉：上一幀因上限未執行的第一個實體，本幀在同一輪次中排在最前
+        uint32_t stream_rotation_ = 0;
     };
 
     /**
@@ -116,6 +207,11 @@ namespace portal_core
         virtual void update(entt::registry &registry, float delta_time) override;
         virtual void cleanup() override;
         virtual const char *get_name() const override { return "PhysicsQuerySystem"; }
+        virtual ComponentAccess get_component_access() const override
+        {
+            return make_component_access<PhysicsQueryComponent, const PhysicsBodyComponent>();
+        }
+        virtual SystemPhase get_phase() const override { return SystemPhase::FixedUpdate; }
 
         // 查詢執行控制
         void set_enabled(bool enabled) { enabled_ = enabled; }
@@ -138,14 +234,12 @@ namespace portal_core
         const QuerySystemStats &get_stats() const { return stats_; }
 
     protected:
-        // 查詢執行方法
+        // 查詢執行方法（射線與重疊查詢收集所有實體後批量執行）
         void execute_raycast_queries(entt::registry &registry);
         void execute_overlap_queries(entt::registry &registry);
         void execute_distance_queries(entt::registry &registry);
 
         // 單個查詢執行
-        bool execute_raycast_query(PhysicsQueryComponent::RaycastQuery &query, entt::entity entity, entt::registry &registry);
-        bool execute_overlap_query(PhysicsQueryComponent::OverlapQuery &query, entt::entity entity, entt::registry &registry);
         bool execute_distance_query(PhysicsQueryComponent::DistanceQuery &query, entt::entity entity, entt::registry &registry);
 
         // 輔助方法
@@ -167,6 +261,14 @@ namespace portal_core
 
         // 統計數據
         mutable QuerySystemStats stats_;
+
+        // 批量查詢的輸入、結果寫回目標與結果緩衝區，跨幀重用
+        std::vector<PhysicsWorldManager::RaycastQuery> raycast_batch_;
+        std::vector<PhysicsQueryComponent::RaycastQuery *> raycast_targets_;
+        PhysicsWorldManager::RaycastBatchResults raycast_results_;
+        std::vector<PhysicsWorldManager::OverlapQuery> overlap_batch_;
+        std::vector<PhysicsQueryComponent::OverlapQuery *> overlap_targets_;
+        PhysicsWorldManager::OverlapBatchResults overlap_results_;
     };
 
     /**
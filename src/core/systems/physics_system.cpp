@@ -4,6 +4,7 @@
 #include "core/components/physics_sync_component.h"
 #include "core/components/physics_event_component.h"
 #include "core/component_safety_manager.h"
+#include "core/parallel_each.h"
 
 // 直接使用统一渲染接口进行调试绘制
 #ifdef GDEXTENSION_BUILD
@@ -12,6 +13,8 @@
 
 #include <iostream>
 #include <chrono>
+#include <atomic>
+#include <algorithm>
 
 namespace portal_core
 {
@@ -64,6 +67,12 @@ namespace portal_core
 
     auto start_time = std::chrono::high_resolution_clock::now();
 
+    // 由 SystemManager 的 FixedUpdate 階段驅動時，delta_time 即固定步長，且一幀內可能被調用多次；
+    // 直接調用 update 時（例如測試）沿用物理世界自身的累積器
+    const FrameTiming *timing = get_frame_timing();
+    const bool driven_by_fixed_step = timing != nullptr;
+    const bool last_fixed_step = !driven_by_fixed_step || timing->is_last_fixed_step();
+
     // 處理待創建和待銷毀的物理體
     process_pending_creations(registry);
     process_pending_destructions(registry);
@@ -76,16 +85,45 @@ namespace portal_core
 
     // 步進物理世界
     auto physics_start = std::chrono::high_resolution_clock::now();
-    physics_world_->update(delta_time);
+    bool stepped = false;
+    if (driven_by_fixed_step)
+    {
+      stepped = physics_world_->step(delta_time, timing->fixed_step_index, timing->fixed_step_count);
+    }
+    else
+    {
+      physics_world_->update(delta_time);
+      stepped = physics_world_->get_last_update_steps() > 0;
+    }
     auto physics_end = std::chrono::high_resolution_clock::now();
 
     stats_.physics_step_time = std::chrono::duration<float>(physics_end - physics_start).count();
 
+    // 插值物體在每個物理步後記錄姿態（耗時預算丟棄的步不記錄）
+    if (auto_sync_enabled_ && stepped)
+    {
+      capture_interpolation_poses(registry);
+    }
+
+    // 以下工作只依賴本幀最終的物理狀態，多個固定步時只在最後一步執行
+    if (!last_fixed_step)
+    {
+      return;
+    }
+
     // 同步物理結果到Transform
     if (auto_sync_enabled_)
     {
       auto sync_start = std::chrono::high_resolution_clock::now();
       sync_physics_to_transform(registry);
+
+      // 由 SystemManager 驅動時插值在 PostUpdate 階段由 PhysicsInterpolationSystem 完成（每個渲染幀都需要），
+      // 直接調用時使用物理世界自身累積器的插值係數
+      if (!driven_by_fixed_step)
+      {
+        stats_.interpolation_alpha = physics_world_->get_interpolation_alpha();
+        stats_.num_interpolated_bodies = apply_interpolated_poses(registry, stats_.interpolation_alpha, get_worker_pool());
+      }
       auto sync_end = std::chrono::high_resolution_clock::now();
 
       stats_.sync_time = std::chrono::duration<float>(sync_end - sync_start).count();
@@ -113,6 +151,8 @@ namespace portal_core
       std::cout << "PhysicsSystem: Bodies=" << stats_.num_physics_bodies
                 << " Active=" << stats_.num_active_bodies
                 << " PhysicsTime=" << stats_.physics_step_time * 1000.0f << "ms"
+                << " Steps=" << stats_.physics_steps << "(merged " << stats_.merged_physics_steps
+                << ", dropped " << stats_.dropped_physics_steps << ")"
                 << " SyncTime=" << stats_.sync_time * 1000.0f << "ms"
                 << " TotalTime=" << total_time * 1000.0f << "ms" << std::endl;
     }
@@ -143,22 +183,46 @@ namespace portal_core
   }
 
   void PhysicsSystem::create_physics_body(entt::entity entity, entt::registry &registry)
+  {
+    if (!prepare_physics_body(entity, registry))
+    {
+      return;
+    }
+
+    // 創建Jolt物理體
+    auto &physics_body = registry.get<PhysicsBodyComponent>(entity);
+    const auto &transform = registry.get<TransformComponent>(entity);
+    if (create_jolt_body(entity, physics_body, transform))
+    {
+      std::cout << "PhysicsSystem: Created physics body for entity " << static_cast<uint32_t>(entity) << std::endl;
+    }
+    else
+    {
+      std::cerr << "PhysicsSystem: Failed to create physics body for entity " << static_cast<uint32_t>(entity) << std::endl;
+    }
+  }
+
+  bool PhysicsSystem::prepare_physics_body(entt::entity entity, entt::registry &registry)
   {
     // 檢查是否已經有物理體
     if (entity_to_body_.count(entity))
     {
       std::cout << "PhysicsSystem: Entity already has physics body, skipping creation." << std::endl;
-      return;
+      return false;
     }
 
-    // 檢查必需的組件
+    // 檢查必需的組件（待創建的實體可能已在同一幀被銷毀）
+    if (!registry.valid(entity))
+    {
+      return false;
+    }
     auto *physics_body = registry.try_get<PhysicsBodyComponent>(entity);
     auto *transform = registry.try_get<TransformComponent>(entity);
 
     if (!physics_body || !transform)
     {
       std::cerr << "PhysicsSystem: Entity missing required components for physics body creation." << std::endl;
-      return;
+      return false;
     }
 
     // 使用安全管理器進行自動驗證和修正
@@ -175,7 +239,7 @@ namespace portal_core
     if (!ComponentSafetyManager::validate_component_dependencies(registry, entity))
     {
       std::cerr << "PhysicsSystem: Component dependency validation failed for entity " << entity_id << std::endl;
-      return;
+      return false;
     }
 
     // 驗證物理體組件（現在應該都是有效的）
@@ -183,18 +247,10 @@ namespace portal_core
     {
       std::cerr << "PhysicsSystem: Physics body component still invalid after auto-correction for entity "
                 << entity_id << std::endl;
-      return;
+      return false;
     }
 
-    // 創建Jolt物理體
-    if (create_jolt_body(entity, *physics_body, *transform))
-    {
-      std::cout << "PhysicsSystem: Created physics body for entity " << static_cast<uint32_t>(entity) << std::endl;
-    }
-    else
-    {
-      std::cerr << "PhysicsSystem: Failed to create physics body for entity " << static_cast<uint32_t>(entity) << std::endl;
-    }
+    return true;
   }
 
   void PhysicsSystem::destroy_physics_body(entt::entity entity, entt::registry &registry)
@@ -225,12 +281,13 @@ namespace portal_core
   void PhysicsSystem::sync_physics_to_transform(entt::registry &registry)
   {
     // 同步動態物體的位置和旋轉到Transform
+    // 每個實體只讀物理體狀態、只寫自己的組件，可以分塊並行
     auto view = registry.view<PhysicsBodyComponent, TransformComponent, PhysicsSyncComponent>();
 
-    stats_.num_sync_operations = 0;
+    std::atomic<uint32_t> sync_operations{0};
 
-    view.each([&](auto entity, auto &physics_body, auto &transform, auto &sync_comp)
-              {
+    parallel_each(get_worker_pool(), view, [&](auto entity, auto &physics_body, auto &transform, auto &sync_comp)
+                  {
         // 檢查同步方向和條件
         if (sync_comp.sync_direction == PhysicsSyncComponent::TRANSFORM_TO_PHYSICS) {
             return; // 這個方向在另一個函數處理
@@ -241,16 +298,63 @@ namespace portal_core
         }
         
         sync_single_entity_to_transform(entity, registry);
-        stats_.num_sync_operations++; });
+        sync_operations.fetch_add(1, std::memory_order_relaxed); });
 
     // 同步沒有PhysicsSyncComponent但有物理體的實體（使用默認同步）
     auto physics_view = registry.view<PhysicsBodyComponent, TransformComponent>(entt::exclude<PhysicsSyncComponent>);
-    physics_view.each([&](auto entity, auto &physics_body, auto &transform)
-                      {
+    parallel_each(get_worker_pool(), physics_view, [&](auto entity, auto &physics_body, auto &transform)
+                  {
         if (physics_body.is_valid() && physics_body.is_dynamic()) {
             sync_single_entity_to_transform(entity, registry);
-            stats_.num_sync_operations++;
+            sync_operations.fetch_add(1, std::memory_order_relaxed);
         } });
+
+    stats_.num_sync_operations = sync_operations.load(std::memory_order_relaxed);
+  }
+
+  void PhysicsSystem::capture_interpolation_poses(entt::registry &registry)
+  {
+    auto view = registry.view<PhysicsBodyComponent, PhysicsSyncComponent>();
+
+    parallel_each(get_worker_pool(), view, [&](auto, auto &physics_body, auto &sync_comp)
+                  {
+        if (!sync_comp.enable_interpolation || sync_comp.sync_direction != PhysicsSyncComponent::PHYSICS_TO_TRANSFORM ||
+            !physics_body.is_valid()) {
+            return;
+        }
+
+        JPH::RVec3 physics_pos = physics_world_->get_body_position(physics_body.body_id);
+        JPH::Quat physics_rot = physics_world_->get_body_rotation(physics_body.body_id);
+        Vec3 position = Vec3(physics_pos.GetX(), physics_pos.GetY(), physics_pos.GetZ()) + sync_comp.position_offset;
+        Quat rotation = Quat(physics_rot.GetX(), physics_rot.GetY(), physics_rot.GetZ(), physics_rot.GetW()) * sync_comp.rotation_offset;
+        sync_comp.push_physics_pose(position, rotation); });
+  }
+
+  uint32_t PhysicsSystem::apply_interpolated_poses(entt::registry &registry, float alpha, WorkerPool *pool)
+  {
+    alpha = std::clamp(alpha, 0.0f, 1.0f);
+    auto view = registry.view<TransformComponent, PhysicsSyncComponent>();
+
+    std::atomic<uint32_t> interpolated{0};
+    parallel_each(pool, view, [&](auto, auto &transform, auto &sync_comp)
+                  {
+        if (!sync_comp.enable_interpolation || !sync_comp.has_pose_history ||
+            sync_comp.sync_direction != PhysicsSyncComponent::PHYSICS_TO_TRANSFORM) {
+            return;
+        }
+
+        Vec3 position = sync_comp.get_interpolated_position(alpha);
+        Quat rotation = sync_comp.get_interpolated_rotation(alpha);
+        if (sync_comp.sync_position) {
+            transform.position = position;
+        }
+        if (sync_comp.sync_rotation) {
+            transform.rotation = rotation;
+        }
+        sync_comp.update_last_synced_state(position, rotation);
+        interpolated.fetch_add(1, std::memory_order_relaxed); });
+
+    return interpolated.load(std::memory_order_relaxed);
   }
 
   void PhysicsSystem::sync_transform_to_physics(entt::registry &registry)
@@ -371,20 +475,86 @@ namespace portal_core
             } });
     }
 
+    if (pending_creation_.empty())
+    {
+      return;
+    }
+
+    // 所有待創建的物理體整批加入物理世界，寬相只做一次批量插入
+    std::vector<entt::entity> entities;
+    std::vector<PhysicsBodyDesc> descs;
+    entities.reserve(pending_creation_.size());
+    descs.reserve(pending_creation_.size());
     for (auto entity : pending_creation_)
     {
-      create_physics_body(entity, registry);
+      if (!prepare_physics_body(entity, registry))
+      {
+        continue;
+      }
+      const auto &physics_body = registry.get<PhysicsBodyComponent>(entity);
+      const auto &transform = registry.get<TransformComponent>(entity);
+      PhysicsBodyDesc desc = physics_body.create_physics_body_desc(transform.position, transform.rotation);
+      desc.user_data = static_cast<uint64_t>(entity);
+      entities.push_back(entity);
+      descs.push_back(std::move(desc));
     }
     pending_creation_.clear();
+
+    if (entities.empty())
+    {
+      return;
+    }
+
+    std::vector<JPH::BodyID> body_ids = physics_world_->create_bodies(descs);
+    size_t created = 0;
+    for (size_t i = 0; i < entities.size(); ++i)
+    {
+      if (body_ids[i].IsInvalid())
+      {
+        std::cerr << "PhysicsSystem: Failed to create physics body for entity " << static_cast<uint32_t>(entities[i]) << std::endl;
+        continue;
+      }
+      register_physics_body(entities[i], body_ids[i], registry.get<PhysicsBodyComponent>(entities[i]));
+      ++created;
+    }
+
+    std::cout << "PhysicsSystem: Created " << created << " physics bodies." << std::endl;
   }
 
   void PhysicsSystem::process_pending_destructions(entt::registry &registry)
   {
+    if (pending_destruction_.empty())
+    {
+      return;
+    }
+
+    // 整批從物理世界移除並銷毀
+    std::vector<JPH::BodyID> body_ids;
+    body_ids.reserve(pending_destruction_.size());
     for (auto entity : pending_destruction_)
     {
-      destroy_physics_body(entity, registry);
+      auto it = entity_to_body_.find(entity);
+      if (it == entity_to_body_.end())
+      {
+        continue; // 沒有物理體
+      }
+      body_ids.push_back(it->second);
+
+      // 清理映射
+      cleanup_entity_mapping(entity);
+
+      // 重置組件中的body_id
+      if (registry.valid(entity))
+      {
+        if (auto *physics_body = registry.try_get<PhysicsBodyComponent>(entity))
+        {
+          physics_body->body_id = JPH::BodyID();
+        }
+      }
     }
     pending_destruction_.clear();
+
+    physics_world_->destroy_bodies(body_ids);
   }
 
   void PhysicsSystem::update_statistics(entt::registry &registry, float delta_time)
@@ -411,6 +581,23 @@ namespace portal_core
         }
       }
     }
+
+    // 形狀緩存每幀歸檔一次統計並淘汰閒置形狀
+    PhysicsShapeCache &shape_cache = physics_world_->get_shape_cache();
+    shape_cache.end_frame();
+    const PhysicsShapeCache::Stats &cache_stats = shape_cache.get_stats();
+    stats_.shape_cache_hits = cache_stats.last_frame_hits;
+    stats_.shape_cache_misses = cache_stats.last_frame_misses;
+    stats_.shape_bytes_saved = cache_stats.last_frame_bytes_saved;
+
+    // 步進統計
+    const PhysicsWorldManager::StepStats &step_stats = physics_world_->get_step_stats();
+    const FrameTiming *timing = get_frame_timing();
+    stats_.physics_steps = step_stats.steps;
+    stats_.merged_physics_steps = step_stats.merged_steps;
+    // 由 SystemManager 驅動時還要算上固定步時鐘因每幀上限丟棄的步
+    stats_.dropped_physics_steps = step_stats.dropped_steps + (timing ? timing->dropped_fixed_steps : 0);
+    stats_.collision_steps = step_stats.collision_steps;
   }
 
   bool PhysicsSystem::validate_physics_body_component(const PhysicsBodyComponent &component) const
@@ -474,6 +661,12 @@ namespace portal_core
       return false;
     }
 
+    register_physics_body(entity, body_id, physics_body);
+    return true;
+  }
+
+  void PhysicsSystem::register_physics_body(entt::entity entity, JPH::BodyID body_id, PhysicsBodyComponent &physics_body)
+  {
     // 更新組件
     physics_body.body_id = body_id;
 
@@ -483,8 +676,6 @@ namespace portal_core
 
     // 應用額外的物理設定
     apply_physics_settings(body_id, physics_body);
-
-    return true;
   }
 
   void PhysicsSystem::sync_single_entity_to_transform(entt::entity entity, entt::registry &registry)
@@ -511,27 +702,17 @@ namespace portal_core
       new_position += sync_comp->position_offset;
       new_rotation = new_rotation * sync_comp->rotation_offset;
 
-      // 檢查是否需要同步（閾值檢查）
-      if (!sync_comp->should_sync_position(new_position) && !sync_comp->should_sync_rotation(new_rotation))
-      {
-        return;
-      }
-
-      // 插值處理
-      if (sync_comp->enable_interpolation)
+      // 插值物體的Transform由 apply_interpolated_poses 寫入
+      const bool interpolated = sync_comp->enable_interpolation &&
+                                sync_comp->sync_direction == PhysicsSyncComponent::PHYSICS_TO_TRANSFORM;
+      if (!interpolated)
       {
-        float t = sync_comp->interpolation_speed * 0.016f; // 假設60fps
-        if (sync_comp->sync_position)
-        {
-          transform->position = transform->position + (new_position - transform->position) * t;
-        }
-        if (sync_comp->sync_rotation)
+        // 檢查是否需要同步（閾值檢查）
+        if (!sync_comp->should_sync_position(new_position) && !sync_comp->should_sync_rotation(new_rotation))
         {
-          transform->rotation = transform->rotation.SLERP(new_rotation, t);
+          return;
         }
-      }
-      else
-      {
+
         // 直接設置
         if (sync_comp->sync_position)
         {
@@ -541,10 +722,10 @@ namespace portal_core
         {
           transform->rotation = new_rotation;
         }
-      }
 
-      // 更新上次同步狀態
-      sync_comp->update_last_synced_state(new_position, new_rotation);
+        // 更新上次同步狀態
+        sync_comp->update_last_synced_state(new_position, new_rotation);
+      }
     }
     else
     {
@@ -590,6 +771,10 @@ namespace portal_core
     {
       JPH::RVec3 jolt_pos(physics_position.GetX(), physics_position.GetY(), physics_position.GetZ());
       physics_world_->set_body_position(physics_body->body_id, jolt_pos);
+      if (sync_comp)
+      {
+        sync_comp->reset_pose_history();
+      }
     }
 
     if (!sync_comp || sync_comp->sync_rotation)
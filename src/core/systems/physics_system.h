@@ -28,6 +28,11 @@ namespace portal_core
         virtual void update(entt::registry &registry, float delta_time) override;
         virtual void cleanup() override;
         virtual const char *get_name() const override { return "PhysicsSystem"; }
+        virtual ComponentAccess get_component_access() const override
+        {
+            return make_component_access<PhysicsBodyComponent, TransformComponent, PhysicsSyncComponent>();
+        }
+        virtual SystemPhase get_phase() const override { return SystemPhase::FixedUpdate; }
 
         // 擴展的初始化方法（設置組件監聽器）
         bool initialize(entt::registry &registry);
@@ -43,6 +48,9 @@ namespace portal_core
 
         // 物理體查詢
         entt::entity get_entity_by_body_id(JPH::BodyID body_id) const;
+
+        // 按插值係數把啟用插值的實體的上一/當前物理步姿態混合寫入Transform，返回處理的實體數
+        static uint32_t apply_interpolated_poses(entt::registry &registry, float alpha, WorkerPool *pool = nullptr);
         JPH::BodyID get_body_id_by_entity(entt::entity entity) const;
 
         // 統計信息
@@ -54,6 +62,21 @@ namespace portal_core
             uint32_t num_sync_operations = 0;
             float physics_step_time = 0.0f;
             float sync_time = 0.0f;
+
+            // 步進保護（本幀）：由 SystemManager 驅動時丟步來自其固定步時鐘
+            uint32_t physics_steps = 0;
+            uint32_t merged_physics_steps = 0;
+            uint32_t dropped_physics_steps = 0;
+            int collision_steps = 1;
+
+            // 姿態插值（僅直接調用 update 時由本系統統計）
+            float interpolation_alpha = 0.0f;
+            uint32_t num_interpolated_bodies = 0;
+
+            // 形狀緩存（上一幀）
+            uint32_t shape_cache_hits = 0;
+            uint32_t shape_cache_misses = 0;
+            size_t shape_bytes_saved = 0;
         };
 
         const PhysicsSystemStats &get_stats() const { return stats_; }
@@ -72,8 +95,11 @@ namespace portal_core
         // 物理體創建輔助
         bool create_jolt_body(entt::entity entity, PhysicsBodyComponent &physics_body,
                               const TransformComponent &transform);
+        bool prepare_physics_body(entt::entity entity, entt::registry &registry);
+        void register_physics_body(entt::entity entity, JPH::BodyID body_id, PhysicsBodyComponent &physics_body);
 
         // 同步輔助方法
+        void capture_interpolation_poses(entt::registry &registry);
         void sync_single_entity_to_transform(entt::entity entity, entt::registry &registry);
         void sync_single_entity_to_physics(entt::entity entity, entt::registry &registry);
 
@@ -123,12 +149,12 @@ namespace portal_core
         bool initialize_physics_world();
 
         /**
-         * 處理待創建的物理體
+         * 處理待創建的物理體（整批通過 PhysicsWorldManager::create_bodies 創建）
          */
         void process_pending_creations(entt::registry &registry);
 
         /**
-         * 處理待銷毀的物理體
+         * 處理待銷毀的物理體（整批通過 PhysicsWorldManager::destroy_bodies 銷毀）
          */
         void process_pending_destructions(entt::registry &registry);
 
@@ -179,6 +205,43 @@ namespace portal_core
         void update_debug_rendering(entt::registry &registry);
     };
 
+    /**
+     * 物理姿態插值系統
+     * 物理以固定步長步進，渲染幀之間可能沒有物理步；本系統每幀在 PostUpdate 階段
+     * 按 FrameTiming::interpolation_alpha 混合上一/當前物理步的姿態，消除高刷新率下的抖動
+     */
+    class PhysicsInterpolationSystem : public ISystem
+    {
+    public:
+        PhysicsInterpolationSystem() = default;
+        virtual ~PhysicsInterpolationSystem() = default;
+
+        // ISystem 接口實現
+        virtual bool initialize() override { return true; }
+        virtual void update(entt::registry &registry, float delta_time) override
+        {
+            // 不由 SystemManager 驅動時沒有幀時間信息，插值由 PhysicsSystem 自行完成
+            const FrameTiming *timing = get_frame_timing();
+            if (!timing)
+            {
+                return;
+            }
+            last_interpolated_bodies_ = PhysicsSystem::apply_interpolated_poses(registry, timing->interpolation_alpha, get_worker_pool());
+        }
+        virtual void cleanup() override {}
+        virtual const char *get_name() const override { return "PhysicsInterpolationSystem"; }
+        virtual ComponentAccess get_component_access() const override
+        {
+            return make_component_access<TransformComponent, PhysicsSyncComponent>();
+        }
+        virtual SystemPhase get_phase() const override { return SystemPhase::PostUpdate; }
+
+        uint32_t get_last_interpolated_bodies() const { return last_interpolated_bodies_; }
+
+    private:
+        uint32_t last_interpolated_bodies_ = 0;
+    };
+
     /**
      * 物理系統的工廠函數
      */
@@ -187,4 +250,7 @@ namespace portal_core
     // 自動註冊物理系統
     REGISTER_SYSTEM(PhysicsSystem, {"PhysicsCommandSystem"}, {}, 20);
 
+    // 自動註冊物理姿態插值系統
+    REGISTER_SYSTEM(PhysicsInterpolationSystem, {"PhysicsSystem"}, {}, 40);
+
 } // namespace portal_core
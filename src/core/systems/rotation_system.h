@@ -4,6 +4,7 @@
 #include <entt/entt.hpp>
 #include "../components/transform_component.h"
 #include "../system_base.h"
+#include "../parallel_each.h"
 
 namespace portal_core
 {
@@ -27,11 +28,11 @@ namespace portal_core
       // 更新所有具有 TransformComponent 和 RotationComponent 的實體
       auto view = registry.view<TransformComponent, RotationComponent>();
 
-      for (auto [entity, transform, rotation_comp] : view.each())
-      {
+      parallel_each(get_worker_pool(), view, [delta_time](auto, auto &transform, auto &rotation_comp)
+                    {
         if (!rotation_comp.enabled)
         {
-          continue;
+          return;
         }
 
         // 計算旋轉增量
@@ -47,8 +48,12 @@ namespace portal_core
           // 應用旋轉
           transform.rotation = delta_rotation * transform.rotation;
           transform.rotation = transform.rotation.Normalized();
-        }
-      }
+        } });
+    }
+
+    ComponentAccess get_component_access() const override
+    {
+      return make_component_access<TransformComponent, const RotationComponent>();
     }
 
     // 設置實體的角速度
@@ -4,6 +4,7 @@
 #include "entt/entt.hpp"
 #include "../components/x_rotation_component.h"
 #include "../system_base.h"
+#include "../parallel_each.h"
 #include "../math_constants.h"
 
 namespace portal_core
@@ -26,27 +27,20 @@ namespace portal_core
       // 🎯 新策略：只需要 XRotationComponent，不依賴 TransformComponent
       auto view = registry.view<XRotationComponent>();
 
-      // 調試：計算並打印找到的實體數量
-      size_t entity_count = 0;
-
-      // 為每個實體更新其 X 軸旋轉狀態
-      for (auto [entity, x_rotation] : view.each())
-      {
-        entity_count++;
-
+      // 為每個實體更新其 X 軸旋轉狀態（大量實體時分塊並行）
+      parallel_each(get_worker_pool(), view, [delta_time](auto, auto &x_rotation)
+                    {
         // 根據速度和時間差更新當前旋轉值
         x_rotation.current_rotation += x_rotation.speed * delta_time;
-        
+
         // 保持旋轉值在合理範圍內 (-2π 到 2π)
         while (x_rotation.current_rotation > 2.0f * M_PI)
           x_rotation.current_rotation -= 2.0f * M_PI;
         while (x_rotation.current_rotation < -2.0f * M_PI)
-          x_rotation.current_rotation += 2.0f * M_PI;
-
-        printf("XRotationSystem: Entity %u X-rotation: %f radians (speed: %f)\n",
-               static_cast<unsigned>(entity), x_rotation.current_rotation, x_rotation.speed);
-      }
+          x_rotation.current_rotation += 2.0f * M_PI; });
 
+      // 調試：打印處理的實體數量（逐實體輸出在並行遍歷中會交錯，已移除）
+      size_t entity_count = view.size();
       if (entity_count > 0)
       {
         printf("XRotationSystem: Updated %zu entities with X-axis rotation\n", entity_count);
@@ -62,6 +56,11 @@ namespace portal_core
     {
       return {}; // X軸旋轉系統沒有依賴
     }
+
+    ComponentAccess get_component_access() const override
+    {
+      return make_component_access<XRotationComponent>();
+    }
   };
 
   // 自動註冊系統
@@ -4,6 +4,7 @@
 #include "entt/entt.hpp"
 #include "../components/y_rotation_component.h"
 #include "../system_base.h"
+#include "../parallel_each.h"
 #include "../math_constants.h"
 
 namespace portal_core
@@ -26,27 +27,20 @@ namespace portal_core
       // 🎯 新策略：只需要 YRotationComponent，不依賴 TransformComponent
       auto view = registry.view<YRotationComponent>();
 
-      // 調試：計算並打印找到的實體數量
-      size_t entity_count = 0;
-
-      // 為每個實體更新其 Y 軸旋轉狀態
-      for (auto [entity, y_rotation] : view.each())
-      {
-        entity_count++;
-
+      // 為每個實體更新其 Y 軸旋轉狀態（大量實體時分塊並行）
+      parallel_each(get_worker_pool(), view, [delta_time](auto, auto &y_rotation)
+                    {
         // 根據速度和時間差更新當前旋轉值
         y_rotation.current_rotation += y_rotation.speed * delta_time;
-        
+
         // 保持旋轉值在合理範圍內 (-2π 到 2π)
         while (y_rotation.current_rotation > 2.0f * M_PI)
           y_rotation.current_rotation -= 2.0f * M_PI;
         while (y_rotation.current_rotation < -2.0f * M_PI)
-          y_rotation.current_rotation += 2.0f * M_PI;
-
-        printf("YRotationSystem: Entity %u Y-rotation: %f radians (speed: %f)\n",
-               static_cast<unsigned>(entity), y_rotation.current_rotation, y_rotation.speed);
-      }
+          y_rotation.current_rotation += 2.0f * M_PI; });
 
+      // 調試：打印處理的實體數量（逐實體輸出在並行遍歷中會交錯，已移除）
+      size_t entity_count = view.size();
       if (entity_count > 0)
       {
         printf("YRotationSystem: Updated %zu entities with Y-axis rotation\n", entity_count);
@@ -62,6 +56,11 @@ namespace portal_core
     {
       return {}; // Y軸旋轉系統沒有依賴
     }
+
+    ComponentAccess get_component_access() const override
+    {
+      return make_component_access<YRotationComponent>();
+    }
   };
 
   // 自動註冊系統
@@ -0,0 +1,45 @@
+#pragma once
+
+// SystemManager 相關測試共用的斷言宏與系統註冊輔助函數
+
+#include "core/system_manager.h"
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define TEST_ASSERT(condition, message)                          \
+    do                                                           \
+    {                                                            \
+        if (!(condition))                                        \
+        {                                                        \
+            std::cout << "❌ FAILED: " << message << std::endl; \
+            return false;                                        \
+        }                                                        \
+        std::cout << "✅ PASSED: " << message << std::endl;     \
+    } while (0)
+
+// 以默認構造的 System 註冊測試系統
+template <typename System>
+void register_test_system(const std::string &name, int priority = 0,
+                          const std::vector<std::string> &dependencies = {},
+                          const std::vector<std::string> &conflicts = {})
+{
+    portal_core::SystemRegistry::register_system(
+        name, []() -> std::unique_ptr<portal_core::ISystem>
+        { return std::make_unique<System>(); },
+        dependencies, conflicts, priority);
+}
+
+// 執行期間屏蔽 std::cout 輸出
+class ScopedSilence
+{
+public:
+    ScopedSilence() : previous_(std::cout.rdbuf(sink_.rdbuf())) {}
+    ~ScopedSilence() { std::cout.rdbuf(previous_); }
+
+private:
+    std::ostringstream sink_;
+    std::streambuf *previous_;
+};
@@ -0,0 +1,222 @@
+#include "core/event_manager.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+using namespace portal_core;
+
+// 简单的测试宏
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "FAILED: " << message << " at line " << __LINE__ << std::endl; \
+        return false; \
+    } else { \
+        std::cout << "PASSED: " << message << std::endl; \
+    }
+
+struct ContactEvent {
+    entt::entity entity = entt::null;
+    int sequence = 0;
+    float impulse = 0.0f;
+};
+
+struct BatchRecorder {
+    std::vector<size_t> batch_sizes;
+    std::vector<int> batch_sequences;
+    std::vector<int> single_sequences;
+    float impulse_sum = 0.0f;
+
+    void on_batch(EventSpan<ContactEvent> events) {
+        batch_sizes.push_back(events.size());
+        for (const auto& event : events) {
+            batch_sequences.push_back(event.sequence);
+        }
+    }
+    void on_single(const ContactEvent& event) { single_sequences.push_back(event.sequence); }
+    void on_batch_sum(EventSpan<ContactEvent> events) {
+        for (const auto& event : events) {
+            impulse_sum += event.impulse;
+        }
+    }
+    void on_single_sum(const ContactEvent& event) { impulse_sum += event.impulse; }
+};
+
+std::vector<ContactEvent> make_contacts(int count) {
+    std::vector<ContactEvent> events;
+    for (int i = 0; i < count; ++i) {
+        events.push_back(ContactEvent{entt::null, i, 1.0f});
+    }
+    return events;
+}
+
+// 队列批量入队：批量处理器一次收到整批
+bool test_queued_batch() {
+    std::cout << "\n=== Testing Queued Batch ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    BatchRecorder recorder;
+    manager.subscribe_batch<ContactEvent>().connect<&BatchRecorder::on_batch>(recorder);
+    manager.subscribe<ContactEvent>().connect<&BatchRecorder::on_single>(recorder);
+
+    const auto contacts = make_contacts(100);
+    manager.publish_batch(contacts, EventHandlingStrategy::QUEUED, EventMetadata{EventPriority::NORMAL, 0.0f, true, "contact"});
+    manager.enqueue(ContactEvent{entt::null, 100, 1.0f});
+
+    TEST_ASSERT(manager.get_queued_event_count<ContactEvent>() == 101, "Batch and single enqueue share one queue");
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(manager.get_statistics().queued_events_count == 101, "Queued statistics counted per event");
+    }
+    if constexpr (EventInstrumentation::level == EventInstrumentationLevel::FULL) {
+        TEST_ASSERT(manager.get_statistics().events_by_category.at("contact") == 100, "Category counted for the whole batch");
+    }
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(recorder.batch_sizes.size() == 1 && recorder.batch_sizes[0] == 101, "Batch handler called once with all events");
+    TEST_ASSERT(recorder.single_sequences.size() == 101, "Per-event handlers still receive every event");
+
+    bool ordered = recorder.batch_sequences.size() == 101;
+    for (int i = 0; ordered && i < 101; ++i) {
+        ordered = recorder.batch_sequences[i] == i && recorder.single_sequences[i] == i;
+    }
+    TEST_ASSERT(ordered, "Both handler kinds see enqueue order");
+    return true;
+}
+
+// 取消的事件把批次分成连续区段
+bool test_batch_with_cancellation() {
+    std::cout << "\n=== Testing Batch With Cancellation ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    BatchRecorder recorder;
+    manager.subscribe_batch<ContactEvent>().connect<&BatchRecorder::on_batch>(recorder);
+
+    manager.publish_batch(make_contacts(10));
+    manager.cancel_queued_events_if<ContactEvent>([](const ContactEvent& event) {
+        return event.sequence == 0 || event.sequence == 4 || event.sequence == 5;
+    });
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(recorder.batch_sizes.size() == 2, "Cancelled events split the batch into runs");
+    TEST_ASSERT(recorder.batch_sizes[0] == 3 && recorder.batch_sizes[1] == 4, "Runs skip cancelled events");
+    TEST_ASSERT(recorder.batch_sequences.front() == 1 && recorder.batch_sequences.back() == 9, "Run contents correct");
+    return true;
+}
+
+// 启用合并时逐个入队
+bool test_batch_with_coalescing() {
+    std::cout << "\n=== Testing Batch With Coalescing ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    BatchRecorder recorder;
+    manager.subscribe_batch<ContactEvent>().connect<&BatchRecorder::on_batch>(recorder);
+    manager.set_event_coalescing<ContactEvent>(coalesce_by_target_entity<ContactEvent>);
+
+    const auto a = registry.create();
+    const auto b = registry.create();
+    std::vector<ContactEvent> contacts = {
+        ContactEvent{a, 0, 1.0f}, ContactEvent{b, 1, 1.0f}, ContactEvent{a, 2, 1.0f}
+    };
+    manager.publish_batch(contacts);
+
+    TEST_ASSERT(manager.get_queued_event_count<ContactEvent>() == 2, "Batch entries coalesced by entity");
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(manager.get_statistics().coalesced_events_count == 1, "Coalesced batch entry counted");
+    }
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(recorder.batch_sizes.size() == 1 && recorder.batch_sizes[0] == 2, "Coalesced batch delivered as one span");
+    TEST_ASSERT(recorder.batch_sequences[0] == 2 && recorder.batch_sequences[1] == 1, "Latest event kept at first position");
+    return true;
+}
+
+// 立即批量发布：整批只通知一次批量处理器
+bool test_immediate_batch() {
+    std::cout << "\n=== Testing Immediate Batch ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    BatchRecorder recorder;
+    manager.subscribe_batch<ContactEvent>().connect<&BatchRecorder::on_batch>(recorder);
+    manager.subscribe<ContactEvent>().connect<&BatchRecorder::on_single>(recorder);
+
+    const auto contacts = make_contacts(50);
+    manager.publish_batch(EventSpan<ContactEvent>(contacts.data(), contacts.size()), EventHandlingStrategy::IMMEDIATE);
+
+    TEST_ASSERT(recorder.batch_sizes.size() == 1 && recorder.batch_sizes[0] == 50, "Immediate batch delivered as one span");
+    TEST_ASSERT(recorder.single_sequences.size() == 50, "Per-event handlers notified immediately");
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(manager.get_statistics().immediate_events_count == 50, "Immediate statistics counted per event");
+    }
+    TEST_ASSERT(manager.get_queued_event_count() == 0, "Nothing queued");
+    return true;
+}
+
+// 批量路径 vs 逐个入队
+bool test_batch_benchmark() {
+    std::cout << "\n=== Batch Publish Benchmark ===" << std::endl;
+
+    const int frames = 200;
+    const auto contacts = make_contacts(5000);
+
+    double single_ms = 0.0;
+    double batch_ms = 0.0;
+    float single_sum = 0.0f;
+    float batch_sum = 0.0f;
+    {
+        entt::registry registry;
+        EventManager manager(registry);
+        BatchRecorder recorder;
+        manager.subscribe<ContactEvent>().connect<&BatchRecorder::on_single_sum>(recorder);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            for (const auto& contact : contacts) {
+                manager.enqueue(contact);
+            }
+            manager.process_queued_events(0.016f);
+        }
+        single_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        single_sum = recorder.impulse_sum;
+    }
+    {
+        entt::registry registry;
+        EventManager manager(registry);
+        BatchRecorder recorder;
+        manager.subscribe_batch<ContactEvent>().connect<&BatchRecorder::on_batch_sum>(recorder);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            manager.publish_batch(contacts);
+            manager.process_queued_events(0.016f);
+        }
+        batch_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        batch_sum = recorder.impulse_sum;
+    }
+
+    std::cout << "Per-event enqueue + handler: " << single_ms / frames << " ms/frame" << std::endl;
+    std::cout << "publish_batch + span handler: " << batch_ms / frames << " ms/frame" << std::endl;
+    std::cout << "Speedup: " << single_ms / batch_ms << "x" << std::endl;
+
+    TEST_ASSERT(single_sum == batch_sum, "Both paths deliver the same events");
+    return true;
+}
+
+int main() {
+    std::cout << "Starting Batch Publish Tests..." << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_queued_batch();
+    all_passed &= test_batch_with_cancellation();
+    all_passed &= test_batch_with_coalescing();
+    all_passed &= test_immediate_batch();
+    all_passed &= test_batch_benchmark();
+
+    if (all_passed) {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,206 @@
+#include "core/event_frame_storage.h"
+#include "core/event_manager.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+using namespace portal_core;
+
+// 简单的测试宏
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "FAILED: " << message << " at line " << __LINE__ << std::endl; \
+        return false; \
+    } else { \
+        std::cout << "PASSED: " << message << std::endl; \
+    }
+
+struct HitEvent {
+    using is_event_component = void;
+    int sequence = 0;
+    float damage = 0.0f;
+};
+
+struct UnusedEvent {
+    int value = 0;
+};
+
+// 按存活帧数过期
+bool test_frame_expiry() {
+    std::cout << "\n=== Testing Frame Event Expiry ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+
+    manager.emit_frame_event(HitEvent{1, 1.0f});                  // 存活 1 帧
+    manager.emit_frame_event(HitEvent{2, 2.0f}, entt::null, 3);   // 存活 3 帧
+    manager.emit_frame_event(HitEvent{3, 3.0f}, entt::null, 3);
+
+    TEST_ASSERT(manager.view_frame_events<HitEvent>().size() == 3, "Events visible in the emitting frame");
+    TEST_ASSERT(manager.view_frame_events<UnusedEvent>().empty(), "Unused type yields an empty view");
+
+    manager.process_queued_events(0.016f);
+    std::vector<int> seen;
+    manager.view_frame_events<HitEvent>().each([&](const HitEvent& hit) { seen.push_back(hit.sequence); });
+    TEST_ASSERT(seen.size() == 2 && seen[0] == 2 && seen[1] == 3, "One-frame event expired, order kept within bucket");
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(manager.view_frame_events<HitEvent>().size() == 2, "Three-frame events still alive after two frames");
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(manager.view_frame_events<HitEvent>().empty(), "Three-frame events expired");
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(manager.get_statistics().frame_events_count == 0, "Statistics track live frame events");
+    }
+    TEST_ASSERT(registry.view<HitEvent>().size() == 0, "No components added to the registry");
+    return true;
+}
+
+// 按目标实体遍历
+bool test_target_view() {
+    std::cout << "\n=== Testing Frame Event Targets ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    const auto a = registry.create();
+    const auto b = registry.create();
+
+    manager.emit_frame_event(HitEvent{0, 5.0f}, a, 2);
+    manager.emit_frame_event(HitEvent{1, 7.0f}, b, 1);
+    manager.emit_frame_event(HitEvent{2, 9.0f}, a, 1);
+
+    float damage_to_a = 0.0f;
+    manager.view_frame_events<HitEvent>().each(a, [&](const HitEvent& hit) { damage_to_a += hit.damage; });
+    TEST_ASSERT(damage_to_a == 14.0f, "Per-entity iteration sums events for that target");
+
+    size_t with_target = 0;
+    manager.view_frame_events<HitEvent>().each([&](entt::entity target, const HitEvent&) {
+        with_target += (target == a || target == b) ? 1 : 0;
+    });
+    TEST_ASSERT(with_target == 3, "Iteration exposes event targets");
+
+    manager.process_queued_events(0.016f);
+    damage_to_a = 0.0f;
+    manager.view_frame_events<HitEvent>().each(a, [&](const HitEvent& hit) { damage_to_a += hit.damage; });
+    TEST_ASSERT(damage_to_a == 5.0f, "Only the longer-lived event remains");
+    return true;
+}
+
+// 存活帧数截断到环的范围内
+bool test_lifetime_clamp() {
+    std::cout << "\n=== Testing Lifetime Clamp ===" << std::endl;
+
+    FrameEventStorage<HitEvent> storage;
+    storage.push(HitEvent{0, 0.0f}, entt::null, 0, 100000);
+    storage.push(HitEvent{1, 0.0f}, entt::null, 0, 0);   // 0 视为 1 帧
+
+    TEST_ASSERT(storage.expire(1) == 1, "Zero lifetime treated as one frame");
+    size_t frame = 2;
+    for (; frame < FrameEventStorage<HitEvent>::MAX_LIFETIME_FRAMES; ++frame) {
+        storage.expire(frame);
+    }
+    TEST_ASSERT(storage.size() == 1, "Clamped event alive until the maximum lifetime");
+    TEST_ASSERT(storage.expire(frame) == 1, "Clamped event expires at the maximum lifetime");
+    return true;
+}
+
+// 实体事件路径：过期的事件实体会被销毁
+bool test_entity_event_cleanup() {
+    std::cout << "\n=== Testing Entity Event Cleanup ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    manager.set_object_pooling_enabled(false);
+
+    EventMetadata metadata;
+    metadata.frame_lifetime = 2;
+    const auto event_entity = manager.create_entity_event(HitEvent{0, 1.0f}, metadata);
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(registry.valid(event_entity), "Entity event alive before its lifetime ends");
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(!registry.valid(event_entity), "Entity event destroyed after its lifetime");
+    return true;
+}
+
+// 每秒 10 万个短生命周期事件：实体事件 vs 帧事件存储
+struct BenchmarkResult {
+    double total_ms = 0.0;
+    double sum = 0.0;
+};
+
+BenchmarkResult run_entity_path(int frames, int events_per_frame) {
+    entt::registry registry;
+    EventManager manager(registry);
+    manager.set_object_pooling_enabled(false);
+    EventMetadata metadata;
+    metadata.frame_lifetime = 2;
+
+    BenchmarkResult result;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < events_per_frame; ++i) {
+            manager.create_entity_event(HitEvent{i, 1.0f}, metadata);
+        }
+        // 消费系统遍历事件
+        auto view = registry.view<HitEvent>();
+        for (auto entity : view) {
+            result.sum += view.get<HitEvent>(entity).damage;
+        }
+        manager.process_queued_events(1.0f / 60.0f);
+    }
+    result.total_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return result;
+}
+
+BenchmarkResult run_frame_storage_path(int frames, int events_per_frame) {
+    entt::registry registry;
+    EventManager manager(registry);
+
+    BenchmarkResult result;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < events_per_frame; ++i) {
+            manager.emit_frame_event(HitEvent{i, 1.0f}, entt::null, 2);
+        }
+        manager.view_frame_events<HitEvent>().each([&](const HitEvent& hit) { result.sum += hit.damage; });
+        manager.process_queued_events(1.0f / 60.0f);
+    }
+    result.total_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return result;
+}
+
+bool test_short_lived_benchmark() {
+    std::cout << "\n=== Short-Lived Events Benchmark (100k/s) ===" << std::endl;
+
+    const int frames = 300;              // 5 秒 @ 60fps
+    const int events_per_frame = 1667;   // ~100k 事件/秒
+
+    const BenchmarkResult entity_result = run_entity_path(frames, events_per_frame);
+    const BenchmarkResult storage_result = run_frame_storage_path(frames, events_per_frame);
+
+    std::cout << "Entity events:      " << entity_result.total_ms / frames << " ms/frame" << std::endl;
+    std::cout << "Frame event storage: " << storage_result.total_ms / frames << " ms/frame" << std::endl;
+    std::cout << "Speedup: " << entity_result.total_ms / storage_result.total_ms << "x" << std::endl;
+
+    TEST_ASSERT(entity_result.sum == storage_result.sum, "Both paths observe the same events");
+    return true;
+}
+
+int main() {
+    std::cout << "Starting Frame Event Storage Tests..." << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_frame_expiry();
+    all_passed &= test_target_view();
+    all_passed &= test_lifetime_clamp();
+    all_passed &= test_entity_event_cleanup();
+    all_passed &= test_short_lived_benchmark();
+
+    if (all_passed) {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
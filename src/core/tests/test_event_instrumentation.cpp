@@ -0,0 +1,144 @@
+#include "core/event_manager.h"
+#include <iostream>
+#include <chrono>
+
+using namespace portal_core;
+
+// 简单的测试宏
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "FAILED: " << message << " at line " << __LINE__ << std::endl; \
+        return false; \
+    } else { \
+        std::cout << "PASSED: " << message << std::endl; \
+    }
+
+struct MoveEvent {
+    int sequence = 0;
+};
+
+struct SoundEvent {
+    int clip = 0;
+};
+
+struct Sink {
+    int received = 0;
+    void on_move(const MoveEvent&) { ++received; }
+};
+
+const char* level_name() {
+    switch (EventInstrumentation::level) {
+        case EventInstrumentationLevel::NONE: return "NONE";
+        case EventInstrumentationLevel::SAMPLED: return "SAMPLED";
+        case EventInstrumentationLevel::FULL: return "FULL";
+    }
+    return "?";
+}
+
+// 各级别策略的编译期取值
+bool test_policies() {
+    std::cout << "\n=== Testing Instrumentation Policies ===" << std::endl;
+
+    using None = EventInstrumentationPolicy<EventInstrumentationLevel::NONE>;
+    using Sampled = EventInstrumentationPolicy<EventInstrumentationLevel::SAMPLED>;
+    using Full = EventInstrumentationPolicy<EventInstrumentationLevel::FULL>;
+
+    static_assert(!None::counters && !None::sampled_details && !None::memory_tracking && !None::profiling,
+                  "NONE records nothing");
+    static_assert(Sampled::counters && Sampled::sampled_details && Sampled::sample_interval > 1 &&
+                  !Sampled::memory_tracking, "SAMPLED keeps exact counters and samples details");
+    static_assert(Full::counters && Full::memory_tracking && Full::profiling && Full::sample_interval == 1,
+                  "FULL records everything");
+
+    std::cout << "Active level: " << level_name() << std::endl;
+    TEST_ASSERT(true, "Policies resolved at compile time");
+    return true;
+}
+
+// 按类型索引的计数与分类统计
+bool test_counters() {
+    std::cout << "\n=== Testing Per-Type Counters ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    Sink sink;
+    manager.subscribe<MoveEvent>().connect<&Sink::on_move>(sink);
+
+    EventMetadata metadata;
+    metadata.category = "movement";
+    const int count = 1024;
+    for (int i = 0; i < count; ++i) {
+        manager.enqueue(MoveEvent{i}, metadata);
+    }
+    manager.publish_immediate(SoundEvent{1});
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(sink.received == count, "Events dispatched at every level");
+
+    const auto& stats = manager.get_statistics();
+    if constexpr (!EventInstrumentation::counters) {
+        TEST_ASSERT(stats.queued_events_count == 0 && stats.events_by_type.empty() && stats.events_by_category.empty(),
+                    "No statistics recorded");
+        return true;
+    }
+
+    const uint32_t move_index = event_queue_type_index<MoveEvent>();
+    const uint32_t sound_index = event_queue_type_index<SoundEvent>();
+    TEST_ASSERT(stats.queued_events_count == count, "Queued counter exact");
+    TEST_ASSERT(stats.events_by_type.size() > move_index && stats.events_by_type.size() > sound_index,
+                "Per-type array indexed by type id");
+    TEST_ASSERT(stats.events_by_type[move_index].events_count == count, "Per-type count exact");
+    TEST_ASSERT(stats.events_by_type[sound_index].events_count == 1, "Immediate events counted per type");
+    TEST_ASSERT(stats.events_by_type[move_index].type_name != nullptr, "Type name recorded once");
+
+    // SAMPLED 级别每 sample_interval 个事件记录一次并按比例放大，count 为其整数倍时结果精确
+    TEST_ASSERT(stats.events_by_category.at("movement") == count, "Category counted");
+
+    manager.reset_statistics();
+    TEST_ASSERT(manager.get_statistics().events_by_type.empty(), "Reset clears per-type counters");
+    return true;
+}
+
+// 热路径开销：入队 + 分发
+bool test_hot_path_benchmark() {
+    std::cout << "\n=== Hot Path Benchmark (" << level_name() << ") ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    Sink sink;
+    manager.subscribe<MoveEvent>().connect<&Sink::on_move>(sink);
+
+    EventMetadata metadata;
+    metadata.category = "movement";
+    const int frames = 200;
+    const int events_per_frame = 5000;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < events_per_frame; ++i) {
+            manager.enqueue(MoveEvent{i}, metadata);
+        }
+        manager.process_queued_events(0.016f);
+    }
+    const double total_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    std::cout << "Enqueue + dispatch: " << total_ms / frames << " ms/frame, "
+              << total_ms * 1.0e6 / (static_cast<double>(frames) * events_per_frame) << " ns/event" << std::endl;
+    TEST_ASSERT(sink.received == frames * events_per_frame, "All events dispatched");
+    return true;
+}
+
+int main() {
+    std::cout << "Starting Event Instrumentation Tests..." << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_policies();
+    all_passed &= test_counters();
+    all_passed &= test_hot_path_benchmark();
+
+    if (all_passed) {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -335,8 +335,10 @@ void test_event_statistics() {
     
     // 获取统计信息
     auto stats = event_manager.get_statistics();
-    assert(stats.immediate_events_count >= 1);
-    assert(stats.queued_events_count >= 1);
+    if constexpr (EventInstrumentation::counters) {
+        assert(stats.immediate_events_count >= 1);
+        assert(stats.queued_events_count >= 1);
+    }
     
     std::cout << "✓ 事件统计功能测试通过!" << std::endl;
     std::cout << "  即时事件: " << stats.immediate_events_count << std::endl;
@@ -0,0 +1,350 @@
+#include "core/event_manager.h"
+#include "core/worker_pool.h"
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace portal_core;
+
+// 简单的测试宏
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "FAILED: " << message << " at line " << __LINE__ << std::endl; \
+        return false; \
+    } else { \
+        std::cout << "PASSED: " << message << std::endl; \
+    }
+
+// 仅用作访问声明的组件类型
+struct HealthComponent { float value = 100.0f; };
+struct AudioComponent { int clip = 0; };
+
+struct CollisionEvent { int sequence = 0; };
+struct TriggerEvent { int sequence = 0; };
+struct DamageEvent { int sequence = 0; };
+struct UiEvent { int sequence = 0; };
+struct FollowUpEvent { int sequence = 0; };
+
+// 记录并发度与执行线程
+struct ConcurrencyProbe {
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+
+    void enter() {
+        const int now = running.fetch_add(1) + 1;
+        int previous = max_running.load();
+        while (now > previous && !max_running.compare_exchange_weak(previous, now)) {}
+    }
+    void leave() { running.fetch_sub(1); }
+};
+
+struct Handlers {
+    EventManager* manager = nullptr;
+    std::thread::id main_thread;
+
+    ConcurrencyProbe collision_trigger;   // 互不冲突的两种事件
+    ConcurrencyProbe health_writers;      // 都写 HealthComponent 的两种事件
+
+    std::vector<int> collision_order;
+    std::vector<int> trigger_order;
+    std::atomic<int> damage_count{0};
+    std::vector<int> ui_order;
+    std::atomic<bool> ui_off_main{false};
+    std::vector<int> follow_ups;
+
+    void on_collision(const CollisionEvent& event) {
+        collision_trigger.enter();
+        health_writers.enter();
+        if (event.sequence == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        collision_order.push_back(event.sequence);
+        health_writers.leave();
+        collision_trigger.leave();
+        // 工作线程中入队：延后到并行批次结束后执行
+        const auto handle = manager->enqueue(FollowUpEvent{event.sequence});
+        if (handle.is_valid() && std::this_thread::get_id() != main_thread) {
+            follow_ups.push_back(-1);
+        }
+    }
+
+    void on_trigger(const TriggerEvent& event) {
+        collision_trigger.enter();
+        if (event.sequence == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        trigger_order.push_back(event.sequence);
+        collision_trigger.leave();
+    }
+
+    void on_damage(const DamageEvent&) {
+        health_writers.enter();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        damage_count.fetch_add(1);
+        health_writers.leave();
+    }
+
+    void on_ui(const UiEvent& event) {
+        if (std::this_thread::get_id() != main_thread) {
+            ui_off_main = true;
+        }
+        ui_order.push_back(event.sequence);
+    }
+
+    void on_follow_up(const FollowUpEvent& event) { follow_ups.push_back(event.sequence); }
+};
+
+bool test_parallel_dispatch_rules() {
+    std::cout << "\n=== Testing Parallel Dispatch Rules ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    WorkerPool pool(3);
+    manager.set_worker_pool(&pool);
+    manager.set_parallel_dispatch_enabled(true);
+
+    Handlers handlers;
+    handlers.manager = &manager;
+    handlers.main_thread = std::this_thread::get_id();
+
+    manager.subscribe<CollisionEvent>(make_event_handler_declaration<HealthComponent>(EventThreadAffinity::ANY_THREAD))
+        .connect<&Handlers::on_collision>(handlers);
+    manager.subscribe<TriggerEvent>(make_event_handler_declaration<const AudioComponent>(EventThreadAffinity::ANY_THREAD))
+        .connect<&Handlers::on_trigger>(handlers);
+    manager.subscribe<DamageEvent>(make_event_handler_declaration<HealthComponent>(EventThreadAffinity::ANY_THREAD))
+        .connect<&Handlers::on_damage>(handlers);
+    // 未声明的订阅：只在主线程分发
+    manager.subscribe<UiEvent>().connect<&Handlers::on_ui>(handlers);
+    manager.subscribe<FollowUpEvent>().connect<&Handlers::on_follow_up>(handlers);
+
+    for (int i = 0; i < 50; ++i) {
+        manager.enqueue(CollisionEvent{i});
+        manager.enqueue(TriggerEvent{i});
+        manager.enqueue(UiEvent{i});
+    }
+    for (int i = 0; i < 4; ++i) {
+        manager.enqueue(DamageEvent{i});
+    }
+
+    manager.process_queued_events(0.016f);
+
+    const auto& stats = manager.get_statistics();
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(stats.parallel_dispatched_types == 3, "Three any-thread types dispatched in parallel");
+        TEST_ASSERT(stats.parallel_dispatch_batches == 2, "Conflicting Health writers split into two batches");
+    }
+    TEST_ASSERT(handlers.collision_trigger.max_running.load() == 2, "Independent event types overlap");
+    TEST_ASSERT(handlers.health_writers.max_running.load() == 1, "Conflicting event types never overlap");
+    TEST_ASSERT(handlers.damage_count.load() == 4, "All damage events dispatched");
+
+    bool ordered = handlers.collision_order.size() == 50 && handlers.trigger_order.size() == 50;
+    for (int i = 0; ordered && i < 50; ++i) {
+        ordered = handlers.collision_order[i] == i && handlers.trigger_order[i] == i;
+    }
+    TEST_ASSERT(ordered, "Events of one type keep enqueue order");
+    TEST_ASSERT(handlers.ui_order.size() == 50 && !handlers.ui_off_main.load(), "Undeclared handlers stay on main thread");
+
+    // 工作线程中的 enqueue 延后执行，FollowUpEvent 为主线程类型，在并行批次之后同帧分发
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(stats.deferred_operations_count == 50, "Handler enqueues were deferred");
+    }
+    bool follow_ups_ok = handlers.follow_ups.size() == 50;
+    for (int i = 0; follow_ups_ok && i < 50; ++i) {
+        follow_ups_ok = handlers.follow_ups[i] == i;
+    }
+    TEST_ASSERT(follow_ups_ok, "Deferred enqueues applied in order");
+
+    // 关闭后恢复顺序分发
+    manager.set_parallel_dispatch_enabled(false);
+    handlers.collision_order.clear();
+    manager.enqueue(CollisionEvent{7});
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(handlers.collision_order.size() == 1, "Sequential dispatch still works");
+    return true;
+}
+
+// 处理器声明：混合声明时整个类型退回主线程
+struct AffinityRecorder {
+    std::thread::id main_thread;
+    std::atomic<int> off_main{0};
+    void on_a(const TriggerEvent&) { check(); }
+    void on_b(const TriggerEvent&) { check(); }
+    void check() {
+        if (std::this_thread::get_id() != main_thread) {
+            off_main.fetch_add(1);
+        }
+    }
+};
+
+bool test_mixed_affinity() {
+    std::cout << "\n=== Testing Mixed Handler Affinity ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    WorkerPool pool(2);
+    manager.set_worker_pool(&pool);
+    manager.set_parallel_dispatch_enabled(true);
+
+    AffinityRecorder recorder;
+    recorder.main_thread = std::this_thread::get_id();
+    manager.subscribe<TriggerEvent>(make_event_handler_declaration<>(EventThreadAffinity::ANY_THREAD))
+        .connect<&AffinityRecorder::on_a>(recorder);
+    manager.subscribe<TriggerEvent>(make_event_handler_declaration<>(EventThreadAffinity::MAIN_THREAD))
+        .connect<&AffinityRecorder::on_b>(recorder);
+
+    for (int i = 0; i < 10; ++i) {
+        manager.enqueue(TriggerEvent{i});
+    }
+    manager.process_queued_events(0.016f);
+
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(manager.get_statistics().parallel_dispatched_types == 0, "Type with a main-thread handler not parallelised");
+    }
+    TEST_ASSERT(recorder.off_main.load() == 0, "All handlers ran on main thread");
+    return true;
+}
+
+// ANY_THREAD 处理器中创建实体事件、添加组件事件和临时标记
+struct SpawnedEventComponent { using is_event_component = void; int sequence = 0; };
+struct HitComponent { using is_event_component = void; int hits = 0; };
+struct FlashMarker { using is_event_component = void; int sequence = 0; };
+
+struct EntityEventHandlers {
+    EventManager* manager = nullptr;
+    entt::entity target = entt::null;
+    std::atomic<int> non_null_entities{0};
+
+    void on_collision(const CollisionEvent& event) {
+        if (manager->create_entity_event(SpawnedEventComponent{event.sequence}) != entt::null) {
+            non_null_entities.fetch_add(1);
+        }
+        manager->add_component_event(target, HitComponent{event.sequence});
+        manager->add_temporary_marker(target, FlashMarker{event.sequence});
+    }
+    void on_trigger(const TriggerEvent&) {}
+};
+
+bool test_entity_events_from_worker_handlers() {
+    std::cout << "\n=== Testing Entity Events From Any-Thread Handlers ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    WorkerPool pool(2);
+    manager.set_worker_pool(&pool);
+    manager.set_parallel_dispatch_enabled(true);
+
+    EntityEventHandlers handlers;
+    handlers.manager = &manager;
+    handlers.target = registry.create();
+    manager.subscribe<CollisionEvent>(make_event_handler_declaration<HitComponent, FlashMarker>(EventThreadAffinity::ANY_THREAD))
+        .connect<&EntityEventHandlers::on_collision>(handlers);
+    manager.subscribe<TriggerEvent>(make_event_handler_declaration<>(EventThreadAffinity::ANY_THREAD))
+        .connect<&EntityEventHandlers::on_trigger>(handlers);
+
+    for (int i = 0; i < 20; ++i) {
+        manager.enqueue(CollisionEvent{i});
+        manager.enqueue(TriggerEvent{i});
+    }
+    manager.process_queued_events(0.016f);
+
+    TEST_ASSERT(handlers.non_null_entities.load() == 0, "Entity creation inside parallel dispatch returns entt::null");
+    TEST_ASSERT(registry.view<SpawnedEventComponent>().size() == 20, "Deferred entity events created after the parallel batch");
+    TEST_ASSERT(registry.all_of<HitComponent>(handlers.target) && registry.get<HitComponent>(handlers.target).hits == 19,
+                "Deferred component events applied in order");
+    TEST_ASSERT(registry.all_of<FlashMarker>(handlers.target) && registry.get<FlashMarker>(handlers.target).sequence == 19,
+                "Deferred temporary markers applied");
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(manager.get_statistics().deferred_operations_count == 60, "All entity operations were deferred");
+    }
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(!registry.all_of<FlashMarker>(handlers.target), "Deferred temporary markers still expire");
+    return true;
+}
+
+// 碰撞密集帧：大量碰撞/触发事件不再排在无关的 UI 事件之后串行执行
+struct BenchmarkHandlers {
+    std::atomic<uint64_t> sink{0};
+
+    static uint64_t work(int seed) {
+        double value = seed;
+        for (int i = 0; i < 400; ++i) {
+            value = std::sqrt(value * value + i);
+        }
+        return static_cast<uint64_t>(value);
+    }
+    void on_collision(const CollisionEvent& event) { sink.fetch_add(work(event.sequence), std::memory_order_relaxed); }
+    void on_trigger(const TriggerEvent& event) { sink.fetch_add(work(event.sequence), std::memory_order_relaxed); }
+    void on_damage(const DamageEvent& event) { sink.fetch_add(work(event.sequence), std::memory_order_relaxed); }
+    void on_ui(const UiEvent& event) { sink.fetch_add(work(event.sequence), std::memory_order_relaxed); }
+};
+
+double run_benchmark_frame(bool parallel, WorkerPool& pool) {
+    entt::registry registry;
+    EventManager manager(registry);
+    manager.set_worker_pool(&pool);
+    manager.set_parallel_dispatch_enabled(parallel);
+
+    BenchmarkHandlers handlers;
+    manager.subscribe<CollisionEvent>(make_event_handler_declaration<HealthComponent>(EventThreadAffinity::ANY_THREAD))
+        .connect<&BenchmarkHandlers::on_collision>(handlers);
+    manager.subscribe<TriggerEvent>(make_event_handler_declaration<const AudioComponent>(EventThreadAffinity::ANY_THREAD))
+        .connect<&BenchmarkHandlers::on_trigger>(handlers);
+    manager.subscribe<DamageEvent>(make_event_handler_declaration<const HealthComponent>(EventThreadAffinity::ANY_THREAD))
+        .connect<&BenchmarkHandlers::on_damage>(handlers);
+    manager.subscribe<UiEvent>().connect<&BenchmarkHandlers::on_ui>(handlers);
+
+    double total_ms = 0.0;
+    const int frames = 10;
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < 4000; ++i) {
+            manager.enqueue(CollisionEvent{i});
+            manager.enqueue(TriggerEvent{i});
+        }
+        for (int i = 0; i < 500; ++i) {
+            manager.enqueue(DamageEvent{i});
+            manager.enqueue(UiEvent{i});
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        manager.process_queued_events(0.016f);
+        total_ms += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+    return total_ms / frames;
+}
+
+bool test_collision_heavy_benchmark() {
+    std::cout << "\n=== Collision-Heavy Frame Benchmark ===" << std::endl;
+
+    WorkerPool pool;
+    const double sequential_ms = run_benchmark_frame(false, pool);
+    const double parallel_ms = run_benchmark_frame(true, pool);
+
+    std::cout << "Workers: " << pool.get_worker_count() << std::endl;
+    std::cout << "Sequential dispatch: " << sequential_ms << " ms/frame" << std::endl;
+    std::cout << "Parallel dispatch:   " << parallel_ms << " ms/frame" << std::endl;
+    std::cout << "Speedup: " << sequential_ms / parallel_ms << "x" << std::endl;
+
+    TEST_ASSERT(parallel_ms > 0.0 && sequential_ms > 0.0, "Benchmark completed");
+    return true;
+}
+
+int main() {
+    std::cout << "Starting Parallel Event Dispatch Tests..." << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_parallel_dispatch_rules();
+    all_passed &= test_mixed_affinity();
+    all_passed &= test_entity_events_from_worker_handlers();
+    all_passed &= test_collision_heavy_benchmark();
+
+    if (all_passed) {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
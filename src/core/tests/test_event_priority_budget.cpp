@@ -0,0 +1,213 @@
+#include "core/event_manager.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace portal_core;
+
+// 简单的测试宏
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "FAILED: " << message << " at line " << __LINE__ << std::endl; \
+        return false; \
+    } else { \
+        std::cout << "PASSED: " << message << std::endl; \
+    }
+
+struct TeleportEvent { int sequence = 0; };
+struct AudioEvent { int sequence = 0; };
+
+EventMetadata with_priority(EventPriority priority) {
+    EventMetadata metadata;
+    metadata.priority = priority;
+    return metadata;
+}
+
+// 忙等，模拟处理器耗时
+void spin_for(std::chrono::microseconds duration) {
+    const auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {}
+}
+
+struct Recorder {
+    std::vector<int> order;
+    std::chrono::microseconds cost{0};
+
+    void on_teleport(const TeleportEvent& event) { order.push_back(1000 + event.sequence); spin_for(cost); }
+    void on_audio(const AudioEvent& event) { order.push_back(event.sequence); spin_for(cost); }
+};
+
+// 不设预算时按优先级分发，全部处理完
+bool test_priority_order() {
+    std::cout << "\n=== Testing Priority Order ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    Recorder recorder;
+    manager.subscribe<TeleportEvent>().connect<&Recorder::on_teleport>(recorder);
+    manager.subscribe<AudioEvent>().connect<&Recorder::on_audio>(recorder);
+
+    manager.enqueue(AudioEvent{3}, with_priority(EventPriority::LOW));
+    manager.enqueue(AudioEvent{2}, with_priority(EventPriority::NORMAL));
+    manager.enqueue(TeleportEvent{1}, with_priority(EventPriority::HIGH));
+    manager.enqueue(AudioEvent{0}, with_priority(EventPriority::CRITICAL));
+    manager.enqueue(AudioEvent{1}, with_priority(EventPriority::HIGH));
+
+    TEST_ASSERT(manager.get_queued_event_count<AudioEvent>() == 4, "Count spans all priorities");
+    manager.process_queued_events(0.016f);
+
+    const std::vector<int> expected = {0, 1001, 1, 2, 3};
+    TEST_ASSERT(recorder.order == expected, "CRITICAL, HIGH, NORMAL, LOW order; types in first-enqueue order");
+    TEST_ASSERT(manager.get_queued_event_count() == 0, "Everything dispatched without a budget");
+    return true;
+}
+
+// 预算用尽后低优先级事件延后，保持顺序且可取消
+bool test_budget_carry_over() {
+    std::cout << "\n=== Testing Budget Carry-Over ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    Recorder recorder;
+    recorder.cost = std::chrono::microseconds(50);
+    manager.subscribe<TeleportEvent>().connect<&Recorder::on_teleport>(recorder);
+    manager.subscribe<AudioEvent>().connect<&Recorder::on_audio>(recorder);
+    manager.set_queued_event_budget(2000);
+
+    std::vector<QueuedEventHandle> handles;
+    for (int i = 0; i < 200; ++i) {
+        handles.push_back(manager.enqueue(AudioEvent{i}, with_priority(EventPriority::LOW)));
+    }
+    for (int i = 0; i < 20; ++i) {
+        manager.enqueue(TeleportEvent{i}, with_priority(EventPriority::CRITICAL));
+    }
+
+    manager.process_queued_events(0.016f);
+    const size_t teleports = std::count_if(recorder.order.begin(), recorder.order.end(), [](int v) { return v >= 1000; });
+    TEST_ASSERT(teleports == 20, "CRITICAL events dispatched first");
+    const size_t first_frame = recorder.order.size() - teleports;
+    TEST_ASSERT(first_frame > 0 && first_frame < 200, "Low-priority events carried over");
+    TEST_ASSERT(manager.get_queued_event_count<AudioEvent>() == 200 - first_frame, "Carried events still counted");
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(manager.get_statistics().budget_deferred_events_count == 200 - first_frame, "Deferred events reported");
+        TEST_ASSERT(manager.get_statistics().budget_exhausted_frames_count == 1, "Exhausted frame counted");
+    }
+
+    // 延后的事件仍可用原句柄取消
+    TEST_ASSERT(!manager.cancel_queued_event(handles[0]), "Dispatched event cannot be cancelled");
+    TEST_ASSERT(manager.cancel_queued_event(handles[199]), "Carried-over event cancelled by handle");
+
+    for (int frame = 0; frame < 20 && manager.get_queued_event_count() > 0; ++frame) {
+        manager.process_queued_events(0.016f);
+    }
+    std::vector<int> audio;
+    for (int v : recorder.order) {
+        if (v < 1000) {
+            audio.push_back(v);
+        }
+    }
+    bool ordered = audio.size() == 199;
+    for (int i = 0; ordered && i < 199; ++i) {
+        ordered = audio[i] == i;
+    }
+    TEST_ASSERT(ordered, "Carried events dispatched in order across frames");
+    return true;
+}
+
+// 饥饿保护：持续被高优先级事件占满预算时，低优先级事件最终整批分发
+struct StarvingRecorder {
+    int audio = 0;
+    void on_teleport(const TeleportEvent&) { spin_for(std::chrono::microseconds(600)); }
+    void on_audio(const AudioEvent&) { ++audio; }
+};
+
+bool test_starvation_protection() {
+    std::cout << "\n=== Testing Starvation Protection ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    StarvingRecorder recorder;
+    manager.subscribe<TeleportEvent>().connect<&StarvingRecorder::on_teleport>(recorder);
+    manager.subscribe<AudioEvent>().connect<&StarvingRecorder::on_audio>(recorder);
+    manager.set_queued_event_budget(500);
+    manager.set_max_deferral_frames(3);
+
+    for (int i = 0; i < 10; ++i) {
+        manager.enqueue(AudioEvent{i}, with_priority(EventPriority::LOW));
+    }
+    int frames = 0;
+    while (recorder.audio == 0 && frames < 10) {
+        manager.enqueue(TeleportEvent{frames}, with_priority(EventPriority::HIGH));
+        manager.process_queued_events(0.016f);
+        ++frames;
+    }
+    TEST_ASSERT(frames == 4, "Low-priority queue dispatched after max deferral frames");
+    TEST_ASSERT(recorder.audio == 10, "Starving queue dispatched in full");
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(manager.get_statistics().starvation_dispatches_count == 1, "Starvation dispatch counted");
+    }
+    return true;
+}
+
+// 传送帧叠加大量低优先级事件：有预算时单帧耗时受限
+void run_burst(uint32_t budget_us, double& worst_ms, int& frames_to_drain) {
+    entt::registry registry;
+    EventManager manager(registry);
+    Recorder recorder;
+    recorder.cost = std::chrono::microseconds(2);
+    manager.subscribe<TeleportEvent>().connect<&Recorder::on_teleport>(recorder);
+    manager.subscribe<AudioEvent>().connect<&Recorder::on_audio>(recorder);
+    manager.set_queued_event_budget(budget_us);
+
+    for (int i = 0; i < 5000; ++i) {
+        manager.enqueue(AudioEvent{i}, with_priority(EventPriority::LOW));
+    }
+    manager.enqueue(TeleportEvent{0}, with_priority(EventPriority::HIGH));
+
+    worst_ms = 0.0;
+    frames_to_drain = 0;
+    while (manager.get_queued_event_count() > 0 && frames_to_drain < 1000) {
+        auto start = std::chrono::steady_clock::now();
+        manager.process_queued_events(0.016f);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        worst_ms = std::max(worst_ms, ms);
+        ++frames_to_drain;
+    }
+}
+
+bool test_burst_benchmark() {
+    std::cout << "\n=== Teleport Frame Burst Benchmark ===" << std::endl;
+
+    double unbudgeted_worst = 0.0;
+    double budgeted_worst = 0.0;
+    int unbudgeted_frames = 0;
+    int budgeted_frames = 0;
+    run_burst(0, unbudgeted_worst, unbudgeted_frames);
+    run_burst(2000, budgeted_worst, budgeted_frames);
+
+    std::cout << "No budget:   worst frame " << unbudgeted_worst << " ms, drained in " << unbudgeted_frames << " frames" << std::endl;
+    std::cout << "2 ms budget: worst frame " << budgeted_worst << " ms, drained in " << budgeted_frames << " frames" << std::endl;
+
+    TEST_ASSERT(unbudgeted_frames == 1 && budgeted_frames > 1, "Budget spreads the burst over several frames");
+    TEST_ASSERT(budgeted_worst < unbudgeted_worst, "Budget lowers the worst frame time");
+    return true;
+}
+
+int main() {
+    std::cout << "Starting Priority Budget Tests..." << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_priority_order();
+    all_passed &= test_budget_carry_over();
+    all_passed &= test_starvation_protection();
+    all_passed &= test_burst_benchmark();
+
+    if (all_passed) {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
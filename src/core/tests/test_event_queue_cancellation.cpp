@@ -0,0 +1,251 @@
+#include "core/event_typed_queue.h"
+#include "core/event_manager.h"
+#include <iostream>
+#include <vector>
+
+using namespace portal_core;
+
+// 简单的测试宏
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "FAILED: " << message << " at line " << __LINE__ << std::endl; \
+        return false; \
+    } else { \
+        std::cout << "PASSED: " << message << std::endl; \
+    }
+
+// 与 BodyActivationEvent 相同的目标字段布局，避免依赖物理头文件
+struct ActivationEvent {
+    entt::entity entity = entt::null;
+    bool is_active = false;
+    int sequence = 0;
+};
+
+struct HitEvent {
+    entt::entity target = entt::null;
+    float damage = 0.0f;
+};
+
+// 没有目标实体的事件
+struct TickEvent {
+    int value = 0;
+};
+
+struct Recorder {
+    std::vector<ActivationEvent> activations;
+    std::vector<HitEvent> hits;
+    std::vector<TickEvent> ticks;
+
+    void on_activation(const ActivationEvent& event) { activations.push_back(event); }
+    void on_hit(const HitEvent& event) { hits.push_back(event); }
+    void on_tick(const TickEvent& event) { ticks.push_back(event); }
+};
+
+// 按句柄取消
+bool test_cancel_by_handle() {
+    std::cout << "\n=== Testing Cancel By Handle ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    Recorder recorder;
+    manager.subscribe<TickEvent>().connect<&Recorder::on_tick>(recorder);
+
+    manager.enqueue(TickEvent{1});
+    const auto handle = manager.enqueue(TickEvent{2});
+    manager.enqueue(TickEvent{3});
+
+    TEST_ASSERT(handle.is_valid(), "Enqueue returns a valid handle");
+    TEST_ASSERT(manager.get_queued_event_count<TickEvent>() == 3, "Three events pending");
+    TEST_ASSERT(manager.cancel_queued_event(handle), "Cancel pending event");
+    TEST_ASSERT(!manager.cancel_queued_event(handle), "Second cancel fails");
+    TEST_ASSERT(manager.get_queued_event_count() == 2, "Cancelled event no longer counted");
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(recorder.ticks.size() == 2, "Only uncancelled events dispatched");
+    TEST_ASSERT(recorder.ticks[0].value == 1 && recorder.ticks[1].value == 3, "Dispatch keeps enqueue order");
+    TEST_ASSERT(!manager.cancel_queued_event(handle), "Handle invalid after dispatch");
+
+    // 下一帧复用同一位置的事件不能被旧句柄取消
+    manager.enqueue(TickEvent{4});
+    manager.enqueue(TickEvent{5});
+    TEST_ASSERT(!manager.cancel_queued_event(handle), "Stale handle does not cancel a reused slot");
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(recorder.ticks.size() == 4, "Events of the next frame dispatched");
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(manager.get_statistics().cancelled_events_count == 1, "Cancellation counted once");
+    }
+    return true;
+}
+
+// 按条件和按类型取消
+bool test_cancel_by_predicate() {
+    std::cout << "\n=== Testing Cancel By Predicate ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    Recorder recorder;
+    manager.subscribe<TickEvent>().connect<&Recorder::on_tick>(recorder);
+    manager.subscribe<HitEvent>().connect<&Recorder::on_hit>(recorder);
+
+    for (int i = 0; i < 10; ++i) {
+        manager.enqueue(TickEvent{i});
+    }
+    manager.enqueue(HitEvent{entt::null, 5.0f});
+
+    const size_t cancelled = manager.cancel_queued_events_if<TickEvent>([](const TickEvent& event) {
+        return event.value % 2 == 1;
+    });
+    TEST_ASSERT(cancelled == 5, "Predicate cancels odd events");
+    TEST_ASSERT(manager.cancel_queued_events<HitEvent>() == 1, "Cancel all events of one type");
+    TEST_ASSERT(manager.cancel_queued_events<ActivationEvent>() == 0, "Cancelling an unused type is a no-op");
+
+    manager.process_queued_events(0.016f);
+    bool all_even = recorder.ticks.size() == 5;
+    for (const auto& tick : recorder.ticks) {
+        all_even = all_even && tick.value % 2 == 0;
+    }
+    TEST_ASSERT(all_even, "Only even events dispatched");
+    TEST_ASSERT(recorder.hits.empty(), "Cancelled type not dispatched");
+    return true;
+}
+
+// 按目标实体取消：跨事件类型，识别 entity / target 成员
+bool test_cancel_for_entity() {
+    std::cout << "\n=== Testing Cancel For Entity ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    Recorder recorder;
+    manager.subscribe<ActivationEvent>().connect<&Recorder::on_activation>(recorder);
+    manager.subscribe<HitEvent>().connect<&Recorder::on_hit>(recorder);
+    manager.subscribe<TickEvent>().connect<&Recorder::on_tick>(recorder);
+
+    const auto doomed = registry.create();
+    const auto survivor = registry.create();
+
+    manager.enqueue(ActivationEvent{doomed, true, 0});
+    manager.enqueue(ActivationEvent{survivor, true, 1});
+    manager.enqueue(HitEvent{doomed, 10.0f});
+    manager.enqueue(HitEvent{survivor, 20.0f});
+    manager.enqueue(TickEvent{7});
+
+    TEST_ASSERT(manager.cancel_queued_events_for_entity(doomed) == 2, "Events targeting the entity cancelled");
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(recorder.activations.size() == 1 && recorder.activations[0].entity == survivor,
+                "Activation of other entity dispatched");
+    TEST_ASSERT(recorder.hits.size() == 1 && recorder.hits[0].target == survivor,
+                "Hit on other entity dispatched");
+    TEST_ASSERT(recorder.ticks.size() == 1, "Events without a target unaffected");
+    return true;
+}
+
+// 合并：同一帧内同一实体的激活事件只分发最后的状态
+bool test_coalescing() {
+    std::cout << "\n=== Testing Coalescing ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    Recorder recorder;
+    manager.subscribe<ActivationEvent>().connect<&Recorder::on_activation>(recorder);
+    manager.set_event_coalescing<ActivationEvent>(coalesce_by_target_entity<ActivationEvent>);
+
+    const auto a = registry.create();
+    const auto b = registry.create();
+
+    manager.enqueue(ActivationEvent{a, true, 0});
+    manager.enqueue(ActivationEvent{b, true, 1});
+    const auto handle = manager.enqueue(ActivationEvent{a, false, 2});
+    manager.enqueue(ActivationEvent{a, true, 3});
+
+    TEST_ASSERT(manager.get_queued_event_count<ActivationEvent>() == 2, "Duplicates merged before dispatch");
+    if constexpr (EventInstrumentation::counters) {
+        TEST_ASSERT(manager.get_statistics().coalesced_events_count == 2, "Coalesced events counted");
+    }
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(recorder.activations.size() == 2, "One event per entity dispatched");
+    TEST_ASSERT(recorder.activations[0].entity == a && recorder.activations[0].sequence == 3,
+                "Merged event keeps first position and latest state");
+    TEST_ASSERT(recorder.activations[1].entity == b, "Other entity follows");
+    TEST_ASSERT(!manager.cancel_queued_event(handle), "Merged handle expires with the batch");
+
+    // 取消后同键的新事件重新排队
+    recorder.activations.clear();
+    const auto first = manager.enqueue(ActivationEvent{a, true, 4});
+    TEST_ASSERT(manager.cancel_queued_event(first), "Cancel coalesced slot");
+    manager.enqueue(ActivationEvent{a, false, 5});
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(recorder.activations.size() == 1 && recorder.activations[0].sequence == 5,
+                "Event after cancellation is not merged into the cancelled one");
+
+    // 自定义合并函数：累计伤害
+    TypedEventQueue<HitEvent> queue(event_queue_type_index<HitEvent>());
+    queue.set_coalescing(coalesce_by_target_entity<HitEvent>,
+                         [](HitEvent& existing, const HitEvent& incoming) { existing.damage += incoming.damage; });
+    queue.push(HitEvent{a, 1.0f});
+    queue.push(HitEvent{a, 2.5f});
+    queue.push(HitEvent{b, 4.0f});
+    entt::dispatcher dispatcher;
+    dispatcher.sink<HitEvent>().connect<&Recorder::on_hit>(recorder);
+    TEST_ASSERT(queue.dispatch(dispatcher) == 2, "Custom merge dispatches one event per key");
+    TEST_ASSERT(recorder.hits.size() == 2 && recorder.hits[0].damage == 3.5f, "Merge function accumulates");
+    return true;
+}
+
+// 处理器中的取消与重入入队
+struct ReentrantHandler {
+    EventManager* manager = nullptr;
+    QueuedEventHandle victim;
+    std::vector<int> seen;
+
+    void on_tick(const TickEvent& event) {
+        seen.push_back(event.value);
+        if (event.value == 0) {
+            manager->cancel_queued_event(victim);   // 取消本批中尚未轮到的事件
+            manager->enqueue(TickEvent{100});       // 留到下一次处理
+        }
+    }
+};
+
+bool test_cancel_during_dispatch() {
+    std::cout << "\n=== Testing Cancel During Dispatch ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    ReentrantHandler handler;
+    handler.manager = &manager;
+    manager.subscribe<TickEvent>().connect<&ReentrantHandler::on_tick>(handler);
+
+    manager.enqueue(TickEvent{0});
+    handler.victim = manager.enqueue(TickEvent{1});
+    manager.enqueue(TickEvent{2});
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(handler.seen.size() == 2 && handler.seen[0] == 0 && handler.seen[1] == 2,
+                "Handler cancels a later event of the same batch");
+    TEST_ASSERT(manager.get_queued_event_count<TickEvent>() == 1, "Event enqueued by a handler waits for next frame");
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(handler.seen.size() == 3 && handler.seen[2] == 100, "Re-entrant event dispatched next frame");
+    return true;
+}
+
+int main() {
+    std::cout << "Starting Queued Event Cancellation Tests..." << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_cancel_by_handle();
+    all_passed &= test_cancel_by_predicate();
+    all_passed &= test_cancel_for_entity();
+    all_passed &= test_coalescing();
+    all_passed &= test_cancel_during_dispatch();
+
+    if (all_passed) {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,285 @@
+#include "core/event_pool_and_concurrency.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+using namespace portal_core;
+
+// 简单的测试宏
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "FAILED: " << message << " at line " << __LINE__ << std::endl; \
+        return false; \
+    } else { \
+        std::cout << "PASSED: " << message << std::endl; \
+    }
+
+// 带校验字段的事件：写了一半的事件会导致 checksum 不匹配
+struct StressEvent {
+    uint32_t producer = 0;
+    uint32_t sequence = 0;
+    uint64_t checksum = 0;
+
+    StressEvent() = default;
+    StressEvent(uint32_t p, uint32_t s)
+        : producer(p), sequence(s), checksum(make_checksum(p, s)) {}
+
+    static uint64_t make_checksum(uint32_t p, uint32_t s) {
+        return (static_cast<uint64_t>(p) << 32 | s) * 0x9E3779B97F4A7C15ull;
+    }
+    bool valid() const { return checksum == make_checksum(producer, sequence); }
+};
+
+struct StressResult {
+    size_t accepted = 0;         // 生产者认为已入队的数量
+    size_t received = 0;         // 消费者收到的数量
+    size_t duplicates = 0;
+    size_t corrupted = 0;
+    size_t missing = 0;          // 已入队但未收到
+    size_t out_of_order = 0;     // 同一生产者的事件在单个消费者内乱序
+    double milliseconds = 0.0;
+};
+
+/**
+ * 多生产者多消费者压力测试
+ * 生产者交替使用单个入队与批量入队，消费者交替使用单个出队与批量出队，
+ * 最后按 (生产者, 序号) 核对每个被接收的事件恰好送达一次
+ */
+StressResult run_stress(QueueFullPolicy policy, size_t capacity, int producers, int consumers, uint32_t events_per_producer) {
+    LockFreeEventQueue<StressEvent> queue(capacity, policy);
+
+    // accepted_flags[p][s] = 1 表示入队成功；received_counts[p][s] 为收到次数
+    std::vector<std::vector<uint8_t>> accepted_flags(producers, std::vector<uint8_t>(events_per_producer, 0));
+    std::vector<std::vector<std::atomic<uint8_t>>> received_counts(producers);
+    for (auto& counts : received_counts) {
+        counts = std::vector<std::atomic<uint8_t>>(events_per_producer);
+    }
+
+    std::atomic<int> producers_running(producers);
+    std::atomic<size_t> corrupted(0);
+    std::atomic<size_t> out_of_order(0);
+    std::atomic<size_t> received(0);
+    std::atomic<int> threads_ready(0);
+    const int thread_count = producers + consumers;
+    // 所有线程就绪后同时开始，避免生产者在消费者启动前就写满队列
+    auto wait_for_start = [&]() {
+        threads_ready.fetch_add(1);
+        while (threads_ready.load() < thread_count) {
+            std::this_thread::yield();
+        }
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            std::vector<StressEvent> batch;
+            uint32_t s = 0;
+            wait_for_start();
+            while (s < events_per_producer) {
+                if (s % 3 == 0) {
+                    // 批量入队 1~16 个
+                    const uint32_t count = std::min<uint32_t>(1 + s % 16, events_per_producer - s);
+                    batch.clear();
+                    for (uint32_t i = 0; i < count; ++i) {
+                        batch.emplace_back(p, s + i);
+                    }
+                    const size_t accepted = queue.enqueue_batch(batch);
+                    // 批量入队按顺序接收前 accepted 个
+                    for (size_t i = 0; i < accepted; ++i) {
+                        accepted_flags[p][s + i] = 1;
+                    }
+                    if (accepted < count) {
+                        std::this_thread::yield(); // 让出时间片给消费者
+                    }
+                    s += count;
+                } else {
+                    accepted_flags[p][s] = queue.enqueue(StressEvent(p, s)) ? 1 : 0;
+                    if (!accepted_flags[p][s]) {
+                        std::this_thread::yield();
+                    }
+                    ++s;
+                }
+            }
+            producers_running.fetch_sub(1);
+        });
+    }
+
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c]() {
+            std::vector<int64_t> last_sequence(producers, -1);
+            std::vector<StressEvent> batch;
+            wait_for_start();
+            auto consume = [&](const StressEvent& event) {
+                if (!event.valid() || event.producer >= static_cast<uint32_t>(producers) ||
+                    event.sequence >= events_per_producer) {
+                    corrupted.fetch_add(1);
+                    return;
+                }
+                if (static_cast<int64_t>(event.sequence) <= last_sequence[event.producer]) {
+                    out_of_order.fetch_add(1);
+                }
+                last_sequence[event.producer] = event.sequence;
+                received_counts[event.producer][event.sequence].fetch_add(1);
+                received.fetch_add(1);
+            };
+
+            uint64_t iteration = 0;
+            while (true) {
+                // 生产者全部结束后的读取位于 load 之后，空队列即可退出
+                const bool producers_done = producers_running.load() == 0;
+                bool got_any = false;
+                if ((iteration++ + c) % 2 == 0) {
+                    StressEvent event;
+                    if (queue.dequeue(event)) {
+                        consume(event);
+                        got_any = true;
+                    }
+                } else {
+                    if (queue.dequeue_batch(batch, 32) > 0) {
+                        for (const auto& event : batch) {
+                            consume(event);
+                        }
+                        got_any = true;
+                    }
+                }
+                if (!got_any) {
+                    if (producers_done && queue.empty()) {
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    StressResult result;
+    result.milliseconds = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+    result.received = received.load();
+    result.corrupted = corrupted.load();
+    result.out_of_order = out_of_order.load();
+    for (int p = 0; p < producers; ++p) {
+        for (uint32_t s = 0; s < events_per_producer; ++s) {
+            const uint8_t count = received_counts[p][s].load();
+            result.accepted += accepted_flags[p][s];
+            if (count > 1) {
+                result.duplicates += count - 1;
+            }
+            if (accepted_flags[p][s] && count == 0) {
+                result.missing += 1;
+            }
+            if (!accepted_flags[p][s] && count != 0) {
+                result.corrupted += 1; // 被报告为丢弃却被收到
+            }
+        }
+    }
+    return result;
+}
+
+void print_result(const char* name, const StressResult& result) {
+    std::cout << name << ": accepted " << result.accepted << ", received " << result.received
+              << ", duplicates " << result.duplicates << ", missing " << result.missing
+              << ", corrupted " << result.corrupted << ", " << result.milliseconds << " ms" << std::endl;
+}
+
+// 小容量队列上的多生产者多消费者：每个事件恰好送达一次
+bool test_exactly_once(QueueFullPolicy policy, const char* name, bool expect_lossless) {
+    std::cout << "\n=== MPMC Stress (" << name << ") ===" << std::endl;
+
+    const int producers = 6;
+    const int consumers = 4;
+    const uint32_t events_per_producer = 100000;
+    // 容量刻意很小，让生产者频繁遇到队列已满
+    StressResult result = run_stress(policy, 64, producers, consumers, events_per_producer);
+    print_result(name, result);
+
+    TEST_ASSERT(result.corrupted == 0, "No torn or unexpected events");
+    TEST_ASSERT(result.duplicates == 0, "No event delivered twice");
+    TEST_ASSERT(result.missing == 0, "Every accepted event delivered");
+    TEST_ASSERT(result.received == result.accepted, "Received count matches accepted count");
+    TEST_ASSERT(result.out_of_order == 0, "Each consumer sees a producer's events in order");
+    if (expect_lossless) {
+        TEST_ASSERT(result.accepted == static_cast<size_t>(producers) * events_per_producer,
+                    "Policy never drops events");
+    }
+    return true;
+}
+
+// Drop 策略：丢弃数量计入统计
+bool test_drop_statistics() {
+    std::cout << "\n=== Drop Policy Statistics ===" << std::endl;
+
+    LockFreeEventQueue<StressEvent> queue(9, QueueFullPolicy::Drop);
+    std::vector<StressEvent> batch;
+    for (uint32_t i = 0; i < 12; ++i) {
+        batch.emplace_back(0, i);
+    }
+
+    TEST_ASSERT(queue.enqueue_batch(batch) == 8, "Batch enqueue fills remaining capacity");
+    TEST_ASSERT(queue.get_dropped_count() == 4, "Rejected part of the batch counted as dropped");
+    TEST_ASSERT(!queue.enqueue(StressEvent(0, 99)), "Single enqueue fails when full");
+    TEST_ASSERT(queue.get_dropped_count() == 5, "Single drop counted");
+
+    std::vector<StressEvent> out;
+    TEST_ASSERT(queue.dequeue_batch(out, 100) == 8, "Batch dequeue drains the ring");
+    bool ordered = true;
+    for (uint32_t i = 0; i < out.size(); ++i) {
+        ordered = ordered && out[i].sequence == i;
+    }
+    TEST_ASSERT(ordered, "Batch dequeue preserves FIFO order");
+    TEST_ASSERT(queue.empty(), "Queue empty after drain");
+    return true;
+}
+
+// Overflow 策略：溢出部分保持在环形缓冲之后的顺序
+bool test_overflow_order() {
+    std::cout << "\n=== Overflow Policy Ordering ===" << std::endl;
+
+    LockFreeEventQueue<StressEvent> queue(5, QueueFullPolicy::Overflow);
+    for (uint32_t i = 0; i < 10; ++i) {
+        TEST_ASSERT(queue.enqueue(StressEvent(0, i)), "Overflow enqueue never fails");
+    }
+    TEST_ASSERT(queue.size() == 10, "Size includes overflow list");
+    TEST_ASSERT(queue.get_overflow_count() == 6, "Overflowed events counted");
+
+    // 取出一个后环形缓冲有空位，但新事件仍应排在溢出事件之后
+    StressEvent event;
+    TEST_ASSERT(queue.dequeue(event) && event.sequence == 0, "Dequeue oldest event");
+    TEST_ASSERT(queue.enqueue(StressEvent(0, 10)), "Enqueue after partial drain");
+
+    std::vector<StressEvent> out;
+    queue.dequeue_batch(out, 100);
+    bool ordered = out.size() == 10;
+    for (uint32_t i = 0; ordered && i < out.size(); ++i) {
+        ordered = out[i].sequence == i + 1;
+    }
+    TEST_ASSERT(ordered, "Single-threaded order preserved across ring and overflow");
+    TEST_ASSERT(queue.empty(), "Queue empty after drain");
+    return true;
+}
+
+int main() {
+    std::cout << "Starting LockFreeEventQueue MPMC Stress Tests..." << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_drop_statistics();
+    all_passed &= test_overflow_order();
+    all_passed &= test_exactly_once(QueueFullPolicy::Drop, "Drop", false);
+    all_passed &= test_exactly_once(QueueFullPolicy::Spin, "Spin", true);
+    all_passed &= test_exactly_once(QueueFullPolicy::Overflow, "Overflow", true);
+
+    if (all_passed) {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,220 @@
+#include "core/event_manager.h"
+#include "core/event_replay.h"
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace portal_core;
+
+// 简单的测试宏
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "FAILED: " << message << " at line " << __LINE__ << std::endl; \
+        return false; \
+    } else { \
+        std::cout << "PASSED: " << message << std::endl; \
+    }
+
+struct InputEvent { int key = 0; float value = 0.0f; };
+struct TeleportEvent { uint32_t entity = 0; float x = 0.0f, y = 0.0f, z = 0.0f; };
+struct DamageEvent { uint32_t entity = 0; int amount = 0; };     // 只由处理器产生
+struct NoteEvent { std::string text; };                          // 不可录制
+
+const char* LOG_PATH = "test_event_record_replay.pevl";
+
+void register_types(EventRecorder& recorder) {
+    recorder.register_type<InputEvent>("InputEvent");
+    recorder.register_type<TeleportEvent>("TeleportEvent");
+    recorder.register_type<DamageEvent>("DamageEvent");
+}
+
+void register_types(EventReplayer& replayer) {
+    replayer.register_type<InputEvent>("InputEvent");
+    replayer.register_type<TeleportEvent>("TeleportEvent");
+    replayer.register_type<DamageEvent>("DamageEvent");
+}
+
+// 按处理顺序记录 (帧, 事件) 的轨迹，两次运行轨迹相同即为确定性复现
+struct Trace {
+    EventManager* manager = nullptr;
+    uint32_t frame = 0;
+    std::vector<std::string> entries;
+
+    void on_input(const InputEvent& event) {
+        entries.push_back(std::to_string(frame) + " input " + std::to_string(event.key));
+        if (event.key % 3 == 0) {
+            // 处理器派生的事件：回放时由处理器重新产生
+            manager->enqueue(DamageEvent{static_cast<uint32_t>(event.key), event.key * 2});
+        }
+    }
+    void on_teleports(EventSpan<TeleportEvent> events) {
+        entries.push_back(std::to_string(frame) + " teleports " + std::to_string(events.size()));
+    }
+    void on_damage(const DamageEvent& event) {
+        entries.push_back(std::to_string(frame) + " damage " + std::to_string(event.amount));
+    }
+};
+
+void connect(EventManager& manager, Trace& trace) {
+    trace.manager = &manager;
+    manager.subscribe<InputEvent>().connect<&Trace::on_input>(trace);
+    manager.subscribe<EventSpan<TeleportEvent>>().connect<&Trace::on_teleports>(trace);
+    manager.subscribe<DamageEvent>().connect<&Trace::on_damage>(trace);
+}
+
+// 录制一段包含队列、即时、批量与延迟事件的会话
+void run_session(EventManager& manager, Trace& trace, int frames) {
+    for (int frame = 0; frame < frames; ++frame) {
+        trace.frame = static_cast<uint32_t>(frame);
+        manager.enqueue(InputEvent{frame, 0.5f});
+        if (frame % 4 == 0) {
+            manager.publish_immediate(InputEvent{1000 + frame, 1.0f});
+        }
+        if (frame % 5 == 0) {
+            std::vector<TeleportEvent> teleports(3, TeleportEvent{static_cast<uint32_t>(frame), 1.0f, 2.0f, 3.0f});
+            manager.publish_batch(teleports, EventHandlingStrategy::QUEUED);
+        }
+        if (frame % 7 == 0) {
+            EventMetadata delayed;
+            delayed.delay = 0.05f;
+            manager.enqueue(InputEvent{2000 + frame, 0.0f}, delayed);
+        }
+        manager.publish_immediate(NoteEvent{"not recorded"});
+        manager.process_queued_events(0.016f);
+    }
+}
+
+bool test_round_trip() {
+    std::cout << "\n=== Testing Record / Replay Round Trip ===" << std::endl;
+
+    const int frames = 60;
+    Trace recorded;
+    EventRecorder::Statistics recorder_stats;
+    {
+        entt::registry registry;
+        EventManager manager(registry);
+        connect(manager, recorded);
+
+        EventRecorder recorder;
+        register_types(recorder);
+        TEST_ASSERT(recorder.open(LOG_PATH), "Log opened");
+        manager.set_event_recorder(&recorder);
+        run_session(manager, recorded, frames);
+        manager.set_event_recorder(nullptr);
+        recorder.close();
+        recorder_stats = recorder.get_statistics();
+    }
+    TEST_ASSERT(recorder_stats.skipped_unregistered == frames, "Non-trivially-copyable events skipped");
+    TEST_ASSERT(recorder_stats.records_written > static_cast<uint64_t>(frames), "Events and frame markers written");
+
+    Trace replayed;
+    entt::registry registry;
+    EventManager manager(registry);
+    connect(manager, replayed);
+
+    EventReplayer replayer;
+    register_types(replayer);
+    TEST_ASSERT(replayer.open(LOG_PATH), "Log read back");
+    const EventReplayer::Result result = replayer.replay(manager, [&](float delta_time) {
+        manager.process_queued_events(delta_time);
+        ++replayed.frame;
+    });
+
+    TEST_ASSERT(result.frames == static_cast<uint32_t>(frames), "Every frame replayed");
+    TEST_ASSERT(result.skipped_records == 0, "No unknown records");
+    TEST_ASSERT(result.events == recorder_stats.events_written, "All recorded events published");
+    TEST_ASSERT(!recorded.entries.empty() && replayed.entries.size() == recorded.entries.size(),
+                "Same number of handled events");
+    TEST_ASSERT(replayed.entries == recorded.entries, "Handled events identical in order and frame");
+    return true;
+}
+
+bool test_invalid_log() {
+    std::cout << "\n=== Testing Invalid Log ===" << std::endl;
+
+    EventReplayer replayer;
+    TEST_ASSERT(!replayer.open("does_not_exist.pevl"), "Missing file rejected");
+
+    std::FILE* file = std::fopen(LOG_PATH, "wb");
+    std::fputs("not a log", file);
+    std::fclose(file);
+    TEST_ASSERT(!replayer.open(LOG_PATH), "Wrong magic rejected");
+    return true;
+}
+
+// 录制开销与全速回放吞吐
+bool test_throughput_benchmark() {
+    std::cout << "\n=== Record / Replay Throughput Benchmark ===" << std::endl;
+
+    const int frames = 300;
+    const int events_per_frame = 2000;
+    struct Counter {
+        uint64_t count = 0;
+        void on_input(const InputEvent&) { ++count; }
+    };
+
+    auto run = [&](EventRecorder* recorder, Counter& counter) {
+        entt::registry registry;
+        EventManager manager(registry);
+        manager.subscribe<InputEvent>().connect<&Counter::on_input>(counter);
+        manager.set_event_recorder(recorder);
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            for (int i = 0; i < events_per_frame; ++i) {
+                manager.enqueue(InputEvent{i, 0.0f});
+            }
+            manager.process_queued_events(0.016f);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    Counter plain;
+    const double plain_ms = run(nullptr, plain);
+
+    Counter recorded;
+    EventRecorder recorder;
+    register_types(recorder);
+    recorder.open(LOG_PATH);
+    const double recorded_ms = run(&recorder, recorded);
+    recorder.close();
+
+    Counter replayed;
+    entt::registry registry;
+    EventManager manager(registry);
+    manager.subscribe<InputEvent>().connect<&Counter::on_input>(replayed);
+    EventReplayer replayer;
+    register_types(replayer);
+    replayer.open(LOG_PATH);
+    const EventReplayer::Result result = replayer.replay(manager);
+
+    const double total_events = static_cast<double>(frames) * events_per_frame;
+    std::cout << "Live:     " << plain_ms << " ms (" << plain_ms * 1.0e6 / total_events << " ns/event)" << std::endl;
+    std::cout << "Recording: " << recorded_ms << " ms (" << recorded_ms * 1.0e6 / total_events << " ns/event), "
+              << recorder.get_statistics().bytes_written / 1024 << " KB" << std::endl;
+    std::cout << "Replay:   " << result.elapsed_ms << " ms, " << result.frames * 1000.0 / result.elapsed_ms
+              << " frames/s (" << result.elapsed_ms * 1.0e6 / total_events << " ns/event)" << std::endl;
+
+    TEST_ASSERT(recorded.count == plain.count && replayed.count == plain.count, "Replay handled every event");
+    TEST_ASSERT(result.frames == static_cast<uint32_t>(frames), "Replay ran every frame");
+    return true;
+}
+
+int main() {
+    std::cout << "Starting Event Record / Replay Tests..." << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_round_trip();
+    all_passed &= test_invalid_log();
+    all_passed &= test_throughput_benchmark();
+    std::remove(LOG_PATH);
+
+    if (all_passed) {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,341 @@
+#include "core/event_timing_wheel.h"
+#include "core/inline_function.h"
+#include "core/event_manager.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+using namespace portal_core;
+
+// 简单的测试宏
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "FAILED: " << message << " at line " << __LINE__ << std::endl; \
+        return false; \
+    } else { \
+        std::cout << "PASSED: " << message << std::endl; \
+    }
+
+using Task = InlineFunction<void(), 64>;
+
+struct TickEvent {
+    int id = 0;
+    float payload[8] = {};
+};
+
+// 测试到期时间与触发顺序（覆盖多层下放）
+bool test_expiry_across_levels() {
+    std::cout << "\n=== Testing Expiry Across Levels ===" << std::endl;
+
+    TimingWheel<Task> wheel(0.001f);
+    std::vector<std::pair<int, uint64_t>> fired;  // (id, 触发时的 tick)
+
+    // 0 层 / 1 层 / 2 层 / 3 层的延迟
+    const uint64_t delays[] = {3, 1, 200, 300, 70000, 20000000};
+    for (int i = 0; i < 6; ++i) {
+        wheel.schedule_ticks(delays[i], Task([&fired, &wheel, i]() { fired.emplace_back(i, wheel.current_tick()); }));
+    }
+    TEST_ASSERT(wheel.size() == 6, "All tasks pending");
+
+    auto run = [](Task& task) { task(); };
+    wheel.advance_ticks(100000, run);
+    TEST_ASSERT(fired.size() == 5, "Tasks within 100000 ticks fired");
+    bool exact = true;
+    for (const auto& entry : fired) {
+        exact = exact && entry.second == delays[entry.first];
+    }
+    TEST_ASSERT(exact, "Each task fires exactly at its expiry tick");
+    TEST_ASSERT(fired[0].first == 1 && fired[1].first == 0 && fired[2].first == 2 && fired[3].first == 3 && fired[4].first == 4,
+                "Tasks fire in expiry order");
+
+    wheel.advance_ticks(20000000 - 100000, run);
+    TEST_ASSERT(fired.size() == 6 && fired[5].second == 20000000, "Top-level task cascades down and fires on time");
+    TEST_ASSERT(wheel.empty(), "Wheel empty after all tasks fired");
+
+    // 按秒推进：与旧实现相同，延迟 50ms 在每帧 16ms 的第 4 帧触发
+    TimingWheel<Task> seconds_wheel(0.001f);
+    int frame_fired = -1;
+    int frame = 0;
+    seconds_wheel.schedule(0.05f, Task([&]() { frame_fired = frame; }));
+    for (frame = 1; frame <= 5; ++frame) {
+        seconds_wheel.advance(0.016f, run);
+    }
+    TEST_ASSERT(frame_fired == 4, "Seconds-based delay fires on the expected frame");
+
+    return true;
+}
+
+// 测试取消
+bool test_cancellation() {
+    std::cout << "\n=== Testing Cancellation ===" << std::endl;
+
+    TimingWheel<Task> wheel(0.001f);
+    int fired = 0;
+    std::vector<TimerHandle> handles;
+    for (int i = 0; i < 1000; ++i) {
+        handles.push_back(wheel.schedule_ticks(1 + i % 500, Task([&fired]() { ++fired; })));
+    }
+
+    size_t cancelled = 0;
+    for (size_t i = 0; i < handles.size(); i += 2) {
+        cancelled += wheel.cancel(handles[i]) ? 1 : 0;
+    }
+    TEST_ASSERT(cancelled == 500, "Half of the tasks cancelled");
+    TEST_ASSERT(!wheel.cancel(handles[0]), "Cancelling twice fails");
+    TEST_ASSERT(wheel.size() == 500, "Size reflects cancellations");
+
+    wheel.advance_ticks(1000, [](Task& task) { task(); });
+    TEST_ASSERT(fired == 500, "Only non-cancelled tasks fire");
+    TEST_ASSERT(!wheel.is_pending(handles[1]) && !wheel.cancel(handles[1]), "Fired task handle no longer pending");
+
+    // 节点复用后旧句柄失效
+    TimerHandle reused = wheel.schedule_ticks(10, Task([]() {}));
+    TEST_ASSERT(reused.index == handles.back().index || !wheel.is_pending(handles.back()), "Stale handle does not match reused node");
+    TEST_ASSERT(wheel.is_pending(reused) && wheel.cancel(reused), "New handle cancellable");
+
+    return true;
+}
+
+// 测试任务执行期间调度与取消
+bool test_reentrant_schedule() {
+    std::cout << "\n=== Testing Re-entrant Schedule/Cancel ===" << std::endl;
+
+    TimingWheel<Task> wheel(0.001f);
+    std::vector<int> order;
+    TimerHandle victim;
+
+    wheel.schedule_ticks(5, Task([&]() {
+        order.push_back(1);
+        wheel.cancel(victim);  // 取消同一槽内排在后面、尚未执行的任务
+        // 执行期间大量调度，迫使节点数组扩容
+        for (int i = 0; i < 100; ++i) {
+            wheel.schedule_ticks(1, Task([&order]() { order.push_back(2); }));
+        }
+    }));
+    victim = wheel.schedule_ticks(5, Task([&order]() { order.push_back(99); }));
+
+    wheel.advance_ticks(10, [](Task& task) { task(); });
+    TEST_ASSERT(!order.empty() && order[0] == 1, "First task runs");
+    TEST_ASSERT(order.size() == 101, "Tasks scheduled during execution run on later ticks; cancelled task skipped");
+    TEST_ASSERT(wheel.empty(), "Wheel empty");
+
+    return true;
+}
+
+// 测试调度路径不分配内存
+bool test_no_allocation() {
+    std::cout << "\n=== Testing Allocation-free Scheduling ===" << std::endl;
+
+    TimingWheel<Task> wheel(0.001f);
+    wheel.reserve(4096);
+    int sum = 0;
+    TickEvent event;
+    event.id = 3;
+
+    Task probe([&sum, event]() { sum += event.id; });
+    TEST_ASSERT(probe.is_inline(), "Event-capturing executor stored inline");
+
+    // 执行器内联存放，节点在 reserve 范围内复用：调度/取消/到期都不触发堆分配
+    size_t heap_executors = 0;
+    size_t peak_pending = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 4000; ++i) {
+            Task task([&sum, event]() { sum += event.id; });
+            heap_executors += task.is_inline() ? 0 : 1;
+            TimerHandle handle = wheel.schedule_ticks(1 + i % 300, std::move(task));
+            if (i % 4 == 0) {
+                wheel.cancel(handle);
+            }
+            peak_pending = std::max(peak_pending, wheel.size());
+        }
+        wheel.advance_ticks(300, [](Task& task) { task(); });
+    }
+    std::cout << "Heap executors: " << heap_executors << ", peak pending: " << peak_pending << std::endl;
+    TEST_ASSERT(heap_executors == 0, "No executor needed a heap allocation");
+    TEST_ASSERT(peak_pending <= 4096, "Node storage stayed within the reserved capacity");
+    TEST_ASSERT(sum == 10 * 3000 * 3, "All non-cancelled executors ran");
+
+    // 超出容量的可调用对象退回堆分配但仍可执行
+    struct Large { char data[256]; };
+    Large large{};
+    large.data[0] = 7;
+    Task big([large, &sum]() { sum += large.data[0]; });
+    TEST_ASSERT(!big.is_inline(), "Oversized executor falls back to heap");
+    big();
+    TEST_ASSERT(sum == 10 * 3000 * 3 + 7, "Heap executor runs");
+
+    return true;
+}
+
+// EventManager 集成：延迟事件可按句柄取消
+struct DelayedPing {
+    int value = 0;
+};
+
+struct PingCounter {
+    int total = 0;
+    int count = 0;
+    void on_ping(const DelayedPing& ping) { total += ping.value; ++count; }
+};
+
+bool test_event_manager_integration() {
+    std::cout << "\n=== Testing EventManager Delayed Events ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    PingCounter counter;
+    manager.subscribe<DelayedPing>().connect<&PingCounter::on_ping>(counter);
+
+    auto keep = manager.schedule_event(DelayedPing{1}, 0.03f, EventHandlingStrategy::IMMEDIATE);
+    auto drop = manager.schedule_event(DelayedPing{100}, 0.03f, EventHandlingStrategy::QUEUED);
+    manager.schedule_event(DelayedPing{10}, 0.05f, EventHandlingStrategy::QUEUED);
+    TEST_ASSERT(manager.get_scheduled_event_count() == 3, "Three delayed events pending");
+    TEST_ASSERT(manager.cancel_scheduled_event(drop), "Cancel by handle");
+
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(counter.count == 0, "Nothing fires before delay");
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(counter.count == 1 && counter.total == 1, "Immediate delayed event fires after 32ms");
+    TEST_ASSERT(!manager.is_scheduled_event_pending(keep), "Fired handle no longer pending");
+
+    manager.process_queued_events(0.016f);
+    manager.process_queued_events(0.016f);
+    TEST_ASSERT(counter.count == 2 && counter.total == 11, "Queued delayed event dispatched; cancelled one never arrives");
+    TEST_ASSERT(manager.get_scheduled_event_count() == 0, "No pending delayed events");
+
+    return true;
+}
+
+// 延迟入队的事件到期后保留原优先级与分类
+struct PingOrder {
+    std::vector<int> values;
+    void on_ping(const DelayedPing& ping) { values.push_back(ping.value); }
+};
+
+bool test_delayed_enqueue_keeps_metadata() {
+    std::cout << "\n=== Testing Delayed Enqueue Metadata ===" << std::endl;
+
+    entt::registry registry;
+    EventManager manager(registry);
+    PingOrder order;
+    manager.subscribe<DelayedPing>().connect<&PingOrder::on_ping>(order);
+
+    EventMetadata low;
+    low.priority = EventPriority::LOW;
+    low.delay = 0.02f;
+    low.category = "ambient";
+    EventMetadata critical;
+    critical.priority = EventPriority::CRITICAL;
+    critical.delay = 0.02f;
+    critical.category = "combat";
+    manager.enqueue(DelayedPing{1}, low);
+    manager.enqueue(DelayedPing{2}, critical);
+
+    for (int frame = 0; frame < 4; ++frame) {
+        manager.process_queued_events(0.016f);
+    }
+
+    const std::vector<int> expected = {2, 1};
+    TEST_ASSERT(order.values == expected, "Delayed events dispatch in their original priority lanes");
+    if constexpr (EventInstrumentation::counters && EventInstrumentation::sample_interval == 1) {
+        const auto& by_category = manager.get_statistics().events_by_category;
+        auto count_of = [&](const char* category) {
+            auto it = by_category.find(category);
+            return it == by_category.end() ? 0u : it->second;
+        };
+        TEST_ASSERT(count_of("ambient") == 1 && count_of("combat") == 1, "Delayed events keep their category");
+    }
+
+    return true;
+}
+
+// 性能对比：旧实现（遍历 vector + 中间擦除 + std::function）与时间轮
+void benchmark_many_delayed_events() {
+    std::cout << "\n=== Delayed Event Benchmark ===" << std::endl;
+
+    const int EVENT_COUNT = 20000;
+    const int FRAMES = 120;
+    const float DT = 1.0f / 60.0f;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> delay_dist(0.1f, 10.0f);
+    std::vector<float> delays(EVENT_COUNT);
+    for (auto& delay : delays) {
+        delay = delay_dist(rng);
+    }
+
+    // 旧实现
+    struct LegacyDelayed {
+        std::function<void()> executor;
+        float remaining_time;
+        std::string category;
+    };
+    std::vector<LegacyDelayed> legacy;
+    int legacy_fired = 0;
+    auto legacy_start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < EVENT_COUNT; ++i) {
+        TickEvent event;
+        event.id = i;
+        legacy.push_back({[&legacy_fired, event]() { legacy_fired += event.id >= 0; }, delays[i], "scheduled"});
+    }
+    auto legacy_scheduled = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        auto it = legacy.begin();
+        while (it != legacy.end()) {
+            it->remaining_time -= DT;
+            if (it->remaining_time <= 0.0f) {
+                it->executor();
+                it = legacy.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    auto legacy_end = std::chrono::high_resolution_clock::now();
+
+    // 时间轮
+    TimingWheel<Task> wheel(0.001f);
+    int wheel_fired = 0;
+    auto wheel_start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < EVENT_COUNT; ++i) {
+        TickEvent event;
+        event.id = i;
+        wheel.schedule(delays[i], Task([&wheel_fired, event]() { wheel_fired += event.id >= 0; }));
+    }
+    auto wheel_scheduled = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        wheel.advance(DT, [](Task& task) { task(); });
+    }
+    auto wheel_end = std::chrono::high_resolution_clock::now();
+
+    auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    std::cout << "Events: " << EVENT_COUNT << ", frames: " << FRAMES << std::endl;
+    std::cout << "Legacy vector: schedule " << ms(legacy_start, legacy_scheduled) << " ms, per frame "
+              << ms(legacy_scheduled, legacy_end) / FRAMES << " ms (fired " << legacy_fired << ")" << std::endl;
+    std::cout << "Timing wheel:  schedule " << ms(wheel_start, wheel_scheduled) << " ms, per frame "
+              << ms(wheel_scheduled, wheel_end) / FRAMES << " ms (fired " << wheel_fired << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "Starting Timing Wheel Tests..." << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_expiry_across_levels();
+    all_passed &= test_cancellation();
+    all_passed &= test_reentrant_schedule();
+    all_passed &= test_no_allocation();
+    all_passed &= test_event_manager_integration();
+    all_passed &= test_delayed_enqueue_keeps_metadata();
+
+    benchmark_many_delayed_events();
+
+    if (all_passed) {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ Some tests failed!" << std::endl;
+        return 1;
+    }
+}
@@ -2,6 +2,9 @@
 #include <iostream>
 #include <chrono>
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 using namespace portal_core;
 
@@ -124,12 +127,182 @@ void test_complexity_comparison() {
     std::cout << "✅ 如果优化有效，平均时间应该与池大小无关（O(1) 性能）" << std::endl;
 }
 
+// 对照组：每次 acquire/release 都加锁的单一空闲列表（线程缓存引入之前的实现方式）
+class MutexOnlyPool {
+public:
+    explicit MutexOnlyPool(size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            objects_.push_back(std::make_unique<TestComponent>());
+            available_.push_back(objects_.back().get());
+        }
+    }
+    
+    TestComponent* acquire(int value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (available_.empty()) return nullptr;
+        TestComponent* obj = available_.back();
+        available_.pop_back();
+        *obj = TestComponent(value);
+        return obj;
+    }
+    
+    void release(TestComponent* obj) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        *obj = TestComponent();
+        available_.push_back(obj);
+    }
+    
+private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<TestComponent>> objects_;
+    std::vector<TestComponent*> available_;
+};
+
+// 多线程同时 acquire/release 的耗时（毫秒）
+template<typename Work>
+double run_threads(int thread_count, Work work) {
+    std::vector<std::thread> threads;
+    std::atomic<int> ready(0);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t]() {
+            ready.fetch_add(1);
+            while (ready.load() < thread_count) {
+                std::this_thread::yield();
+            }
+            work(t);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 性能测试：多线程竞争同一个池
+void test_multithreaded_contention() {
+    std::cout << "\n=== Multi-threaded Contention Benchmark ===" << std::endl;
+    
+    const int ROUNDS = 20000;
+    const int BURST = 8;  // 每轮借出 8 个再全部归还，模拟一帧内的事件突发
+    
+    for (int thread_count : {1, 2, 4, 8}) {
+        const size_t pool_size = static_cast<size_t>(thread_count) * 256;
+        
+        MutexOnlyPool baseline(pool_size);
+        double baseline_ms = run_threads(thread_count, [&](int t) {
+            TestComponent* held[BURST];
+            for (int round = 0; round < ROUNDS; ++round) {
+                for (int i = 0; i < BURST; ++i) held[i] = baseline.acquire(t + i);
+                for (int i = 0; i < BURST; ++i) baseline.release(held[i]);
+            }
+        });
+        
+        EventPool<TestComponent> pool(0, pool_size);
+        pool.reserve(pool_size);
+        std::atomic<size_t> failures(0);
+        double pool_ms = run_threads(thread_count, [&](int t) {
+            std::vector<EventPool<TestComponent>::unique_obj_ptr> held;
+            held.reserve(BURST);
+            for (int round = 0; round < ROUNDS; ++round) {
+                for (int i = 0; i < BURST; ++i) {
+                    held.push_back(pool.acquire(t + i));
+                    if (!held.back()) failures.fetch_add(1);
+                }
+                held.clear();
+            }
+        });
+        
+        const double operations = static_cast<double>(thread_count) * ROUNDS * BURST;
+        std::cout << "Threads: " << thread_count
+                  << " | mutex pool: " << baseline_ms << " ms (" << baseline_ms * 1e6 / operations << " ns/op)"
+                  << " | thread-cached pool: " << pool_ms << " ms (" << pool_ms * 1e6 / operations << " ns/op)"
+                  << " | speedup: " << baseline_ms / pool_ms << "x" << std::endl;
+        
+        auto stats = pool.get_statistics();
+        if (failures.load() == 0 && stats.active_count == 0 && stats.available_count == pool_size &&
+            stats.reused_count == static_cast<size_t>(operations)) {
+            std::cout << "✅ Statistics consistent after contention" << std::endl;
+        } else {
+            std::cout << "❌ Inconsistent pool state: failures " << failures.load()
+                      << ", active " << stats.active_count << ", available " << stats.available_count
+                      << ", reused " << stats.reused_count << std::endl;
+        }
+    }
+}
+
+// 跨线程归还与全局统计
+void test_cross_thread_release_statistics() {
+    std::cout << "\n=== Cross-thread Release & Global Statistics ===" << std::endl;
+    
+    auto& pool = EventPoolManager::get_instance().get_pool<TestComponent>();
+    
+    // 生产者线程借出，主线程归还
+    std::vector<EventPool<TestComponent>::unique_obj_ptr> objects;
+    std::thread producer([&]() {
+        for (int i = 0; i < 200; ++i) {
+            objects.push_back(pool.acquire(i));
+        }
+    });
+    producer.join();
+    
+    auto during = pool.get_statistics();
+    objects.clear();
+    auto after = pool.get_statistics();
+    auto global = EventPoolManager::get_instance().get_global_statistics();
+    
+    std::cout << "Active while held: " << during.active_count << ", after release: " << after.active_count
+              << ", available: " << after.available_count << ", pools registered: " << global.total_pools << std::endl;
+    
+    if (during.active_count == 200 && after.active_count == 0 && after.available_count == 200 &&
+        global.total_pools >= 1 && global.total_created >= 200) {
+        std::cout << "✅ Objects returned from another thread are accounted for" << std::endl;
+    } else {
+        std::cout << "❌ Cross-thread statistics mismatch" << std::endl;
+    }
+}
+
+// 调试构建中归还前校验指针：外来指针和重复归还都被忽略
+void test_release_validation() {
+    std::cout << "\n=== Release Validation (debug builds) ===" << std::endl;
+    
+#ifdef NDEBUG
+    std::cout << "NDEBUG defined, release validation compiled out" << std::endl;
+#else
+    EventPool<TestComponent> pool(0, 64);
+    auto object = pool.acquire(1);
+    auto deleter = object.get_deleter();
+    TestComponent* raw = object.get();
+    object.reset();
+    
+    const auto before = pool.get_statistics();
+    deleter(raw);            // 重复归还
+    TestComponent foreign;
+    deleter(&foreign);       // 不属于本池的指针
+    const auto after = pool.get_statistics();
+    
+    auto first = pool.acquire(2);
+    auto second = pool.acquire(3);
+    
+    if (after.available_count == before.available_count && after.active_count == before.active_count &&
+        first.get() != second.get() && first.get() != &foreign && second.get() != &foreign) {
+        std::cout << "✅ Double release and foreign pointers are ignored" << std::endl;
+    } else {
+        std::cout << "❌ Invalid release reached the free list" << std::endl;
+    }
+#endif
+}
+
 int main() {
     std::cout << "=== EventPool Performance Benchmark ===" << std::endl;
     
     test_large_pool_shrink_performance();
     test_mass_release_performance();
     test_complexity_comparison();
+    test_multithreaded_contention();
+    test_cross_thread_release_statistics();
+    test_release_validation();
     
     std::cout << "\n=== Performance Test Completed ===" << std::endl;
     return 0;
@@ -0,0 +1,141 @@
+#include "system_test_utils.h"
+#include "core/frame_tracer.h"
+#include "core/portal_core/lib/include/core/portal_trace_hooks.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace portal_core;
+
+class TracedSleepSystem : public ISystem
+{
+public:
+    void update(entt::registry &, float) override
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    const char *get_name() const override { return "TracedSleepSystem"; }
+};
+
+size_t count_occurrences(const std::string &text, const std::string &pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size()))
+    {
+        ++count;
+    }
+    return count;
+}
+
+bool test_disabled_records_nothing()
+{
+    std::cout << "\n=== 關閉時不記錄 ===" << std::endl;
+
+    FrameTracer::set_enabled(false);
+    FrameTracer::clear();
+    {
+        PORTAL_TRACE_SCOPE("ShouldNotAppear");
+    }
+    TEST_ASSERT(FrameTracer::get_event_count() == 0, "關閉追蹤時作用域不寫入事件");
+    return true;
+}
+
+bool test_multithreaded_buffers()
+{
+    std::cout << "\n=== 多線程各自寫入緩衝 ===" << std::endl;
+
+    FrameTracer::set_enabled(true);
+    FrameTracer::clear();
+
+    const int THREADS = 4;
+    const int EVENTS = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([t]()
+                             {
+                                 FrameTracer::set_thread_name("Tracer Test " + std::to_string(t));
+                                 for (int i = 0; i < EVENTS; ++i)
+                                 {
+                                     PORTAL_TRACE_SCOPE_CATEGORY("ThreadWork", "test");
+                                 } });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    TEST_ASSERT(FrameTracer::get_event_count() == THREADS * EVENTS, "所有線程的事件都保留（線程退出後仍可導出）");
+
+    std::string json = FrameTracer::export_chrome_trace();
+    TEST_ASSERT(count_occurrences(json, "\"name\":\"ThreadWork\"") == THREADS * EVENTS, "導出全部完整事件");
+    TEST_ASSERT(json.find("Tracer Test 3") != std::string::npos, "導出線程名元數據");
+
+    FrameTracer::set_enabled(false);
+    return true;
+}
+
+bool test_system_manager_timeline()
+{
+    std::cout << "\n=== SystemManager 幀時間線 ===" << std::endl;
+
+    SystemRegistry::clear();
+    register_test_system<TracedSleepSystem>("TracedA");
+    register_test_system<TracedSleepSystem>("TracedB");
+
+    SystemManager manager;
+    manager.set_worker_thread_count(2);
+    manager.initialize();
+    manager.set_parallel_execution(true);
+
+    // 開啟追蹤時自動為外部庫安裝回調，接入同一個追蹤器
+    FrameTracer::set_enabled(true);
+    FrameTracer::clear();
+
+    entt::registry registry;
+    const int FRAMES = 3;
+    for (int i = 0; i < FRAMES; ++i)
+    {
+        manager.update_systems(registry, 1.0f / 60.0f);
+        Portal::TraceScope hook_scope("ExternalLibScope");
+    }
+    FrameTracer::set_enabled(false);
+    TEST_ASSERT(Portal::trace_callback_slot().load() == nullptr, "關閉追蹤時移除庫回調");
+
+    std::string json = FrameTracer::export_chrome_trace();
+    TEST_ASSERT(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0, "輸出 Chrome trace-event 格式");
+    TEST_ASSERT(count_occurrences(json, "\"name\":\"SystemManager::update_systems\"") == FRAMES, "每幀一個 update_systems 事件");
+    TEST_ASSERT(count_occurrences(json, "\"name\":\"Update\"") == FRAMES, "記錄階段作用域");
+    TEST_ASSERT(count_occurrences(json, "\"name\":\"TracedA\"") == FRAMES &&
+                    count_occurrences(json, "\"name\":\"TracedB\"") == FRAMES,
+                "按註冊名記錄每個系統");
+    TEST_ASSERT(count_occurrences(json, "\"name\":\"ExternalLibScope\"") == FRAMES, "庫回調寫入同一時間線");
+    TEST_ASSERT(json.find("Worker 0") != std::string::npos, "工作線程帶有名稱");
+
+    const std::string path = "test_frame_trace.json";
+    TEST_ASSERT(FrameTracer::write_chrome_trace(path), "寫入文件");
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    TEST_ASSERT(contents.str() == json, "文件內容與導出字符串一致");
+    std::remove(path.c_str());
+
+    manager.cleanup();
+    return true;
+}
+
+int main()
+{
+    std::cout << "=== Frame Tracer Test ===" << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_disabled_records_nothing();
+    all_passed &= test_multithreaded_buffers();
+    all_passed &= test_system_manager_timeline();
+
+    SystemRegistry::reset_and_re_register();
+
+    std::cout << (all_passed ? "\n✅ All tests passed" : "\n❌ Some tests failed") << std::endl;
+    return all_passed ? 0 : 1;
+}
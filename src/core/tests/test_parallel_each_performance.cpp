@@ -0,0 +1,263 @@
+#include "core/parallel_each.h"
+#include "core/components/x_rotation_component.h"
+#include <entt/entt.hpp>
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+#include <cmath>
+#include <memory>
+
+using namespace portal_core;
+
+// 用於多組件 view 的測試組件
+struct BenchVelocity
+{
+    float x = 1.0f, y = 2.0f, z = 3.0f;
+};
+
+struct BenchPosition
+{
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+struct DeferredMarker
+{
+    int value = 0;
+};
+
+// 每個實體的計算負載，模擬旋轉/同步系統的數學運算
+inline void rotation_kernel(XRotationComponent &rotation, float delta_time)
+{
+    for (int i = 0; i < 16; ++i)
+    {
+        rotation.current_rotation += rotation.speed * delta_time;
+        rotation.current_rotation = std::fmod(rotation.current_rotation, 6.2831853f);
+    }
+}
+
+void populate(entt::registry &registry, size_t entity_count)
+{
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        auto entity = registry.create();
+        registry.emplace<XRotationComponent>(entity, 0.5f + static_cast<float>(i % 100) * 0.01f);
+        if (i % 2 == 0)
+        {
+            registry.emplace<BenchPosition>(entity);
+            registry.emplace<BenchVelocity>(entity);
+        }
+    }
+}
+
+bool test_parallel_matches_sequential()
+{
+    std::cout << "\n=== 並行結果與順序結果一致性 ===" << std::endl;
+
+    const size_t ENTITY_COUNT = 50000;
+    const float DELTA_TIME = 0.016f;
+
+    entt::registry sequential_registry;
+    entt::registry parallel_registry;
+    populate(sequential_registry, ENTITY_COUNT);
+    populate(parallel_registry, ENTITY_COUNT);
+
+    WorkerPool pool(4);
+
+    auto sequential_view = sequential_registry.view<XRotationComponent>();
+    for (auto [entity, rotation] : sequential_view.each())
+    {
+        rotation_kernel(rotation, DELTA_TIME);
+    }
+    parallel_each(&pool, parallel_registry.view<XRotationComponent>(), [DELTA_TIME](auto, auto &rotation)
+                  { rotation_kernel(rotation, DELTA_TIME); });
+
+    // 多組件 view（前向迭代器路徑）
+    sequential_registry.view<BenchPosition, const BenchVelocity>().each([](auto &position, const auto &velocity)
+                                                                        { position.x += velocity.x; });
+    parallel_each(&pool, parallel_registry.view<BenchPosition, const BenchVelocity>(), [](auto, auto &position, const auto &velocity)
+                  { position.x += velocity.x; });
+
+    bool matches = true;
+    for (auto entity : sequential_registry.view<XRotationComponent>())
+    {
+        if (sequential_registry.get<XRotationComponent>(entity).current_rotation !=
+            parallel_registry.get<XRotationComponent>(entity).current_rotation)
+        {
+            matches = false;
+            break;
+        }
+    }
+    for (auto entity : sequential_registry.view<BenchPosition>())
+    {
+        if (sequential_registry.get<BenchPosition>(entity).x != parallel_registry.get<BenchPosition>(entity).x)
+        {
+            matches = false;
+            break;
+        }
+    }
+
+    std::cout << (matches ? "✅" : "❌") << " 單組件與多組件 view 的並行結果與順序遍歷一致" << std::endl;
+    return matches;
+}
+
+bool test_deferred_structural_changes()
+{
+    std::cout << "\n=== 延遲結構變更 ===" << std::endl;
+
+    entt::registry registry;
+    populate(registry, 20000);
+
+    WorkerPool pool(4);
+
+    parallel_each_deferred(&pool, registry, registry.view<XRotationComponent>(),
+                           [](DeferredCommands &commands, auto entity, auto &rotation)
+                           {
+                               if (rotation.speed > 1.0f)
+                               {
+                                   commands.emplace_or_replace<DeferredMarker>(entity, 1);
+                               }
+                               else if (rotation.speed < 0.6f)
+                               {
+                                   commands.destroy(entity);
+                               }
+                           });
+
+    size_t expected_markers = 0;
+    size_t wrong_markers = 0;
+    size_t surviving_slow = 0;
+    for (auto [entity, rotation] : registry.view<XRotationComponent>().each())
+    {
+        bool has_marker = registry.all_of<DeferredMarker>(entity);
+        if (rotation.speed > 1.0f)
+        {
+            ++expected_markers;
+            wrong_markers += has_marker ? 0 : 1;
+        }
+        else
+        {
+            wrong_markers += has_marker ? 1 : 0;
+        }
+        surviving_slow += rotation.speed < 0.6f ? 1 : 0;
+    }
+
+    bool passed = wrong_markers == 0 && surviving_slow == 0 && expected_markers > 0 &&
+                  registry.view<DeferredMarker>().size() == expected_markers;
+    std::cout << (passed ? "✅" : "❌") << " 遍歷結束後統一添加 " << expected_markers
+              << " 個組件並銷毀低速實體" << std::endl;
+    return passed;
+}
+
+bool test_task_exceptions()
+{
+    std::cout << "\n=== 任務異常傳播 ===" << std::endl;
+
+    WorkerPool pool(4);
+    std::atomic<int> completed{0};
+    TaskGroup group;
+    for (int i = 0; i < 64; ++i)
+    {
+        pool.submit(group, [i, &completed]()
+                    {
+                        if (i % 16 == 3)
+                        {
+                            throw std::runtime_error("task failed");
+                        }
+                        completed.fetch_add(1, std::memory_order_relaxed); });
+    }
+
+    bool rethrown = false;
+    try
+    {
+        pool.wait(group);
+    }
+    catch (const std::runtime_error &)
+    {
+        rethrown = true;
+    }
+    bool passed = rethrown && group.is_done() && completed.load() == 60;
+    std::cout << (passed ? "✅" : "❌") << " wait 在其餘任務完成後重新拋出任務異常" << std::endl;
+
+    // 異常之後線程池仍可正常使用
+    TaskGroup next_group;
+    std::atomic<int> next_completed{0};
+    for (int i = 0; i < 16; ++i)
+    {
+        pool.submit(next_group, [&next_completed]()
+                    { next_completed.fetch_add(1, std::memory_order_relaxed); });
+    }
+    pool.wait(next_group);
+    bool pool_usable = next_completed.load() == 16;
+    std::cout << (pool_usable ? "✅" : "❌") << " 工作線程未因異常退出" << std::endl;
+
+    // 每一塊都拋出，包括調用線程自己執行的第一塊
+    entt::registry registry;
+    populate(registry, 20000);
+    bool each_rethrown = false;
+    try
+    {
+        parallel_each(&pool, registry.view<XRotationComponent>(), [](auto, auto &)
+                      { throw std::runtime_error("chunk failed"); });
+    }
+    catch (const std::runtime_error &)
+    {
+        each_rethrown = true;
+    }
+    std::cout << (each_rethrown ? "✅" : "❌") << " parallel_each 把回調的異常傳給調用方" << std::endl;
+
+    return passed && pool_usable && each_rethrown;
+}
+
+void benchmark_scaling()
+{
+    std::cout << "\n=== parallel_each 擴展性 (1 → N 線程) ===" << std::endl;
+
+    const size_t ENTITY_COUNT = 100000;
+    const int FRAMES = 50;
+    const float DELTA_TIME = 0.016f;
+
+    entt::registry registry;
+    populate(registry, ENTITY_COUNT);
+    auto view = registry.view<XRotationComponent>();
+
+    auto measure = [&](WorkerPool *pool)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame)
+        {
+            parallel_each(pool, view, [DELTA_TIME](auto, auto &rotation)
+                          { rotation_kernel(rotation, DELTA_TIME); });
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / FRAMES;
+    };
+
+    double single_thread_ms = measure(nullptr);
+    std::cout << "Threads: 1 | " << single_thread_ms << " ms/frame | speedup: 1x" << std::endl;
+
+    size_t hardware_threads = std::max(2u, std::thread::hardware_concurrency());
+    for (size_t threads = 2; threads <= hardware_threads; threads *= 2)
+    {
+        // 調用線程也參與執行，因此工作線程數為 threads - 1
+        WorkerPool pool(threads - 1);
+        double ms = measure(&pool);
+        std::cout << "Threads: " << threads << " | " << ms << " ms/frame | speedup: "
+                  << single_thread_ms / ms << "x" << std::endl;
+    }
+}
+
+int main()
+{
+    std::cout << "=== parallel_each Test & Benchmark ===" << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_parallel_matches_sequential();
+    all_passed &= test_deferred_structural_changes();
+    all_passed &= test_task_exceptions();
+
+    benchmark_scaling();
+
+    std::cout << (all_passed ? "\n✅ All tests passed" : "\n❌ Some tests failed") << std::endl;
+    return all_passed ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <chrono>
+#include <unordered_set>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include "core/physics_world_manager.h"
+#include "core/components/physics_body_component.h"
+#include "core/components/transform_component.h"
+#include "core/systems/physics_system.h"
+
+using namespace portal_core;
+
+#define TEST_ASSERT(condition, message)                          \
+    do                                                           \
+    {                                                            \
+        if (!(condition))                                        \
+        {                                                        \
+            std::cout << "❌ FAILED: " << message << std::endl; \
+            return false;                                        \
+        }                                                        \
+        std::cout << "✅ PASSED: " << message << std::endl;     \
+    } while (0)
+
+std::vector<PhysicsBodyDesc> make_level_chunk(int count)
+{
+    std::vector<PhysicsBodyDesc> descs(count);
+    for (int i = 0; i < count; ++i)
+    {
+        descs[i].body_type = (i % 4 == 0) ? PhysicsBodyType::STATIC : PhysicsBodyType::DYNAMIC;
+        descs[i].shape = PhysicsShapeDesc::box(Vec3(1, 1, 1));
+        descs[i].position = RVec3(static_cast<float>(i % 50) * 2.0f, static_cast<float>(i / 50) * 2.0f, 0.0f);
+        descs[i].user_data = static_cast<uint64_t>(i);
+    }
+    return descs;
+}
+
+bool test_create_and_destroy_bodies()
+{
+    std::cout << "\n=== 批量創建與銷毀物理體 ===" << std::endl;
+
+    auto &physics_manager = PhysicsWorldManager::get_instance();
+    TEST_ASSERT(physics_manager.initialize(), "物理世界初始化");
+
+    const int body_count = 5000;
+    std::vector<PhysicsBodyDesc> descs = make_level_chunk(body_count);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<BodyID> body_ids = physics_manager.create_bodies(descs);
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "批量創建 " << body_count << " 個物理體: " << elapsed_ms << " ms" << std::endl;
+
+    TEST_ASSERT(body_ids.size() == descs.size(), "返回的 BodyID 與描述一一對應");
+    bool all_added = true;
+    std::unordered_set<uint32_t> unique_ids;
+    for (BodyID body_id : body_ids)
+    {
+        all_added &= !body_id.IsInvalid() && physics_manager.has_body(body_id);
+        unique_ids.insert(body_id.GetIndexAndSequenceNumber());
+    }
+    TEST_ASSERT(all_added, "所有物理體都已加入物理世界");
+    TEST_ASSERT(unique_ids.size() == body_ids.size(), "每個物理體的 BodyID 唯一");
+
+    physics_manager.destroy_bodies(body_ids);
+    TEST_ASSERT(physics_manager.get_stats().num_bodies == 0, "批量銷毀後物理世界為空");
+
+    TEST_ASSERT(physics_manager.create_bodies(nullptr, 0).empty(), "空批次不創建物理體");
+    physics_manager.destroy_bodies(std::vector<BodyID>{BodyID()});
+    std::cout << "✅ PASSED: 銷毀無效 BodyID 被忽略" << std::endl;
+
+    physics_manager.cleanup();
+    return true;
+}
+
+bool test_physics_system_batches_pending_bodies()
+{
+    std::cout << "\n=== 物理系統整批處理待創建的物理體 ===" << std::endl;
+
+    entt::registry registry;
+    portal_core::PhysicsSystem physics_system;
+    TEST_ASSERT(physics_system.initialize(registry), "物理系統初始化");
+
+    const int entity_count = 1000;
+    std::vector<entt::entity> entities;
+    for (int i = 0; i < entity_count; ++i)
+    {
+        auto entity = registry.create();
+        TransformComponent transform;
+        transform.position = Vec3(static_cast<float>(i), 0.0f, 0.0f);
+        registry.emplace<TransformComponent>(entity, transform);
+        registry.emplace<PhysicsBodyComponent>(entity, PhysicsBodyType::DYNAMIC, PhysicsShapeDesc::sphere(0.5f));
+        entities.push_back(entity);
+    }
+
+    physics_system.update(registry, 1.0f / 60.0f);
+
+    bool all_created = true;
+    bool all_mapped = true;
+    for (auto entity : entities)
+    {
+        const auto &physics_body = registry.get<PhysicsBodyComponent>(entity);
+        all_created &= physics_body.is_valid();
+        all_mapped &= physics_system.get_entity_by_body_id(physics_body.body_id) == entity;
+    }
+    TEST_ASSERT(all_created, "一次更新為所有實體創建物理體");
+    TEST_ASSERT(all_mapped, "物理體與實體的映射已建立");
+
+    std::vector<JPH::BodyID> removed_ids;
+    for (int i = 0; i < entity_count / 2; ++i)
+    {
+        removed_ids.push_back(registry.get<PhysicsBodyComponent>(entities[i]).body_id);
+        registry.remove<PhysicsBodyComponent>(entities[i]);
+    }
+    physics_system.update(registry, 1.0f / 60.0f);
+
+    bool all_unmapped = true;
+    for (JPH::BodyID body_id : removed_ids)
+    {
+        all_unmapped &= physics_system.get_entity_by_body_id(body_id) == entt::null;
+    }
+    TEST_ASSERT(all_unmapped, "移除組件的實體在下一次更新中整批銷毀");
+    TEST_ASSERT(registry.get<PhysicsBodyComponent>(entities.back()).is_valid(), "其餘物理體保留");
+
+    physics_system.cleanup();
+    return true;
+}
+
+int main()
+{
+    std::cout << "Starting Physics Batch Body Tests..." << std::endl;
+    RegisterDefaultAllocator();
+
+    bool all_passed = true;
+    all_passed &= test_create_and_destroy_bodies();
+    all_passed &= test_physics_system_batches_pending_bodies();
+
+    if (all_passed)
+    {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    }
+    std::cout << "\n❌ Some tests failed!" << std::endl;
+    return 1;
+}
@@ -0,0 +1,316 @@
+#include <iostream>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include "core/frame_arena.h"
+#include "core/components/physics_body_component.h"
+#include "core/components/physics_command_component.h"
+#include "core/systems/physics_command_system.h"
+
+using namespace portal_core;
+
+#define TEST_ASSERT(condition, message)                          \
+    do                                                           \
+    {                                                            \
+        if (!(condition))                                        \
+        {                                                        \
+            std::cout << "❌ FAILED: " << message << std::endl; \
+            return false;                                        \
+        }                                                        \
+        std::cout << "✅ PASSED: " << message << std::endl;     \
+    } while (0)
+
+// 自定義命令需要實體帶有物理體組件才能通過驗證
+entt::entity create_command_entity(entt::registry &registry)
+{
+    auto entity = registry.create();
+    registry.emplace<PhysicsBodyComponent>(entity);
+    registry.emplace<PhysicsCommandComponent>(entity);
+    return entity;
+}
+
+bool test_frame_arena_reuse()
+{
+    std::cout << "\n=== 幀內存重用 ===" << std::endl;
+
+    FrameArena arena(1024);
+    for (int i = 0; i < 100; ++i)
+    {
+        arena.allocate_array<float>(16);
+    }
+    TEST_ASSERT(arena.get_heap_allocations() > 1, "首幀按需申請內存塊");
+
+    const size_t reserved = arena.get_reserved_bytes();
+    arena.reset();
+    for (int i = 0; i < 100; ++i)
+    {
+        void *memory = arena.allocate(64, 16);
+        if (reinterpret_cast<uintptr_t>(memory) % 16 != 0)
+        {
+            std::cout << "❌ FAILED: 分配未按要求對齊" << std::endl;
+            return false;
+        }
+    }
+    TEST_ASSERT(arena.get_heap_allocations() == 0, "重置後重用已有內存塊");
+    TEST_ASSERT(arena.get_reserved_bytes() == reserved, "保留內存不增長");
+
+    arena.reset();
+    {
+        FrameVector<int> values{FrameArenaAllocator<int>(arena)};
+        for (int i = 0; i < 200; ++i)
+        {
+            values.push_back(i);
+        }
+        TEST_ASSERT(values[199] == 199, "FrameVector 可正常增長");
+    }
+    TEST_ASSERT(arena.get_bytes_used() > 0, "FrameVector 從幀內存分配");
+    return true;
+}
+
+bool test_inline_custom_callable()
+{
+    std::cout << "\n=== 自定義命令內聯存儲 ===" << std::endl;
+
+    PhysicsCommandComponent commands;
+    commands.before_physics_commands.reserve(4);
+    commands.allocation_count = 0;
+
+    int counter = 0;
+    commands.add_custom_command([&counter]()
+                                { ++counter; });
+    TEST_ASSERT(commands.allocation_count == 0, "小捕獲的自定義命令不產生堆分配");
+
+    std::array<double, 16> large_capture{};
+    large_capture[3] = 2.0;
+    commands.add_custom_command([&counter, large_capture]()
+                                { counter += static_cast<int>(large_capture[3]); });
+    TEST_ASSERT(commands.allocation_count == 1, "超出內聯容量的捕獲計入分配次數");
+
+    for (const auto &command : commands.before_physics_commands)
+    {
+        command.invoke_custom();
+    }
+    TEST_ASSERT(counter == 3, "兩種存儲方式都能正確調用");
+
+    PhysicsCommand empty(PhysicsCommandType::CUSTOM);
+    TEST_ASSERT(!empty.invoke_custom(), "沒有可調用對象時返回 false");
+    return true;
+}
+
+bool test_priority_order_is_fifo()
+{
+    std::cout << "\n=== 同優先級保持添加順序 ===" << std::endl;
+
+    entt::registry registry;
+    PhysicsCommandSystem system;
+    system.initialize();
+    auto entity = create_command_entity(registry);
+    auto &commands = registry.get<PhysicsCommandComponent>(entity);
+
+    std::vector<std::string> order;
+    auto add = [&](const char *name, PhysicsCommandPriority priority)
+    {
+        PhysicsCommand cmd(PhysicsCommandType::CUSTOM, PhysicsCommandCallable([&order, name]()
+                                                                              { order.push_back(name); }));
+        cmd.priority = priority;
+        commands.add_delayed_command(std::move(cmd), 0.0f);
+    };
+    add("normal-1", PhysicsCommandPriority::NORMAL);
+    add("low", PhysicsCommandPriority::LOW);
+    add("critical", PhysicsCommandPriority::CRITICAL);
+    add("normal-2", PhysicsCommandPriority::NORMAL);
+    add("high", PhysicsCommandPriority::HIGH);
+    add("normal-3", PhysicsCommandPriority::NORMAL);
+
+    system.update(registry, 0.016f);
+
+    const std::vector<std::string> expected = {"critical", "high", "normal-1", "normal-2", "normal-3", "low"};
+    TEST_ASSERT(order == expected, "高優先級在前，同優先級先進先出");
+    TEST_ASSERT(commands.delayed_commands.empty(), "已執行的延遲命令被移除");
+    return true;
+}
+
+bool test_budget_carries_over()
+{
+    std::cout << "\n=== 超出預算的命令保留到下一幀 ===" << std::endl;
+
+    entt::registry registry;
+    PhysicsCommandSystem system;
+    system.initialize();
+    system.set_max_commands_per_frame(1);
+    auto entity = create_command_entity(registry);
+    auto &commands = registry.get<PhysicsCommandComponent>(entity);
+
+    std::vector<int> executed;
+    for (int i = 0; i < 5; ++i)
+    {
+        commands.add_custom_command([&executed, i]()
+                                    { executed.push_back(i); });
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        PhysicsCommand cmd(PhysicsCommandType::CUSTOM, PhysicsCommandCallable([&executed, i]()
+                                                                              { executed.push_back(100 + i); }));
+        commands.add_delayed_command(std::move(cmd), 0.0f);
+    }
+
+    system.update(registry, 0.016f);
+    TEST_ASSERT(system.get_stats().commands_executed_this_frame == 1, "每幀最多執行預算內的命令");
+    TEST_ASSERT(commands.get_total_command_count() == 6, "未執行的命令保留");
+    TEST_ASSERT(commands.delayed_commands.size() == 1, "到期但未執行的延遲命令沒有丟失");
+
+    for (int frame = 0; frame < 6; ++frame)
+    {
+        system.update(registry, 0.016f);
+    }
+    const std::vector<int> expected = {100, 101, 0, 1, 2, 3, 4};
+    TEST_ASSERT(executed == expected, "保留的命令在後續幀按原順序執行");
+    TEST_ASSERT(!commands.has_pending_commands(), "全部命令執行完畢");
+    return true;
+}
+
+bool test_delayed_command_runs_once()
+{
+    std::cout << "\n=== 延遲命令只執行一次（不受 auto_remove 影響） ===" << std::endl;
+
+    entt::registry registry;
+    PhysicsCommandSystem system;
+    system.initialize();
+    auto entity = create_command_entity(registry);
+    auto &commands = registry.get<PhysicsCommandComponent>(entity);
+
+    int delayed_runs = 0;
+    int immediate_runs = 0;
+    PhysicsCommand delayed(PhysicsCommandType::CUSTOM, PhysicsCommandCallable([&delayed_runs]()
+                                                                              { ++delayed_runs; }));
+    delayed.auto_remove = false;
+    commands.add_delayed_command(std::move(delayed), 0.02f);
+    commands.add_custom_command([&immediate_runs]()
+                                { ++immediate_runs; }, PhysicsCommandTiming::IMMEDIATE);
+    commands.immediate_commands.back().auto_remove = false;
+
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        system.update(registry, 0.016f);
+    }
+    TEST_ASSERT(delayed_runs == 1, "到期後執行一次，之後不再重複觸發");
+    TEST_ASSERT(commands.delayed_commands.empty(), "執行過的延遲命令被移除");
+    TEST_ASSERT(immediate_runs == 5 && commands.immediate_commands.size() == 1, "其他階段不自動移除的命令仍每幀執行");
+    return true;
+}
+
+bool test_budget_is_fair_across_entities()
+{
+    std::cout << "\n=== 每幀上限在實體間公平分配 ===" << std::endl;
+
+    entt::registry registry;
+    PhysicsCommandSystem system;
+    system.initialize();
+    system.set_max_commands_per_frame(7);
+
+    const int entity_count = 3;
+    std::vector<int> executed_per_entity(entity_count, 0);
+    for (int e = 0; e < entity_count; ++e)
+    {
+        auto &commands = registry.get<PhysicsCommandComponent>(create_command_entity(registry));
+        for (int i = 0; i < 10; ++i)
+        {
+            commands.add_custom_command([&executed_per_entity, e]()
+                                        { ++executed_per_entity[e]; });
+        }
+    }
+
+    system.update(registry, 0.016f);
+    TEST_ASSERT(system.get_stats().commands_in_stream == 30, "所有實體的命令收集到同一命令流");
+    TEST_ASSERT(executed_per_entity[0] >= 2 && executed_per_entity[1] >= 2 && executed_per_entity[2] >= 2,
+                "每個實體都分到執行配額");
+
+    system.update(registry, 0.016f);
+    system.update(registry, 0.016f);
+    const int most = std::max({executed_per_entity[0], executed_per_entity[1], executed_per_entity[2]});
+    const int least = std::min({executed_per_entity[0], executed_per_entity[1], executed_per_entity[2]});
+    TEST_ASSERT(most - least <= 1, "多幀後各實體執行數相差不超過一個");
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        system.update(registry, 0.016f);
+    }
+    TEST_ASSERT(executed_per_entity[0] == 10 && executed_per_entity[1] == 10 && executed_per_entity[2] == 10,
+                "剩餘命令最終全部執行");
+    return true;
+}
+
+bool test_steady_state_allocations()
+{
+    std::cout << "\n=== 穩定後每幀零分配 ===" << std::endl;
+
+    entt::registry registry;
+    PhysicsCommandSystem system;
+    system.initialize();
+    std::vector<entt::entity> entities;
+    for (int i = 0; i < 32; ++i)
+    {
+        entities.push_back(create_command_entity(registry));
+    }
+
+    uint64_t calls = 0;
+    uint32_t first_frame_allocations = 0;
+    uint32_t steady_allocations = 0;
+    const int frames = 120;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        for (auto entity : entities)
+        {
+            auto &commands = registry.get<PhysicsCommandComponent>(entity);
+            for (int i = 0; i < 8; ++i)
+            {
+                commands.add_custom_command([&calls, i]()
+                                            { calls += static_cast<uint64_t>(i); },
+                                            i % 2 ? PhysicsCommandTiming::IMMEDIATE : PhysicsCommandTiming::BEFORE_PHYSICS_STEP);
+            }
+        }
+        system.update(registry, 0.016f);
+        if (frame == 0)
+        {
+            first_frame_allocations = system.get_stats().allocations_this_frame;
+        }
+        else if (frame >= 2)
+        {
+            steady_allocations += system.get_stats().allocations_this_frame;
+        }
+    }
+
+    std::cout << "首幀分配: " << first_frame_allocations << ", 穩定後分配: " << steady_allocations
+              << ", 幀內存: " << system.get_stats().frame_arena_bytes << " bytes" << std::endl;
+    TEST_ASSERT(first_frame_allocations > 0, "首幀為命令列表分配容量");
+    TEST_ASSERT(steady_allocations == 0, "穩定後命令列表與暫存列表不再分配");
+    TEST_ASSERT(calls == static_cast<uint64_t>(frames) * entities.size() * (1 + 3 + 5 + 7 + 0 + 2 + 4 + 6),
+                "所有命令都已執行");
+    return true;
+}
+
+int main()
+{
+    std::cout << "Starting Physics Command Storage Tests..." << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_frame_arena_reuse();
+    all_passed &= test_inline_custom_callable();
+    all_passed &= test_priority_order_is_fifo();
+    all_passed &= test_budget_carries_over();
+    all_passed &= test_delayed_command_runs_once();
+    all_passed &= test_budget_is_fair_across_entities();
+    all_passed &= test_steady_state_allocations();
+
+    if (all_passed)
+    {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    }
+    std::cout << "\n❌ Some tests failed!" << std::endl;
+    return 1;
+}
@@ -5,6 +5,7 @@
 #include "core/components/physics_body_component.h"
 #include <entt/entt.hpp>
 #include <iostream>
+#include <unordered_map>
 #include <chrono>
 #include <thread>
 
@@ -39,6 +40,7 @@ public:
         all_passed &= test_lazy_loading();
         all_passed &= test_water_surface_detection();
         all_passed &= test_ground_detection();
+        all_passed &= test_batched_queries_across_entities();
 
         // 清理
         cleanup_systems();
@@ -66,6 +68,8 @@ private:
         bool water_surface_detected = false;
         bool ground_detected = false;
         bool plane_intersection_detected = false;
+        std::unordered_map<entt::entity, int> raycast_results_by_requester;
+        std::unordered_map<entt::entity, int> overlap_results_by_requester;
     } results_;
 
     // 事件处理成员函数
@@ -101,6 +105,7 @@ private:
 
     void handle_raycast_result(const RaycastResultEvent& event) {
         results_.raycast_result_events++;
+        results_.raycast_results_by_requester[event.requester]++;
         std::cout << "🎯 Raycast result received (hit: " << (event.hit ? "Yes" : "No") << ")" << std::endl;
         
         if (event.hit && event.hit_distance < 1.0f) {  // 检测到地面
@@ -111,6 +116,7 @@ private:
 
     void handle_overlap_result(const OverlapQueryResultEvent& event) {
         results_.overlap_result_events++;
+        results_.overlap_results_by_requester[event.requester]++;
         std::cout << "🔍 Overlap result received (objects found: " << event.overlapping_entities.size() << ")" << std::endl;
         
         if (!event.overlapping_entities.empty()) {
@@ -394,6 +400,42 @@ private:
         return passed;
     }
 
+    bool test_batched_queries_across_entities() {
+        std::cout << "\n🧪 Testing batched queries across entities..." << std::endl;
+
+        // 多个实体的查询合并成每帧一次批量，结果按批量槽位分发回各自的实体
+        std::vector<entt::entity> ray_entities;
+        for (int i = 0; i < 4; ++i) {
+            auto entity = registry_.create();
+            PhysicsQueryFactory::create_raycast_query(registry_, entity, JPH::Vec3(80.0f + i, 10, 0), JPH::Vec3(0, -1, 0), 20.0f);
+            PhysicsQueryFactory::create_raycast_query(registry_, entity, JPH::Vec3(80.0f + i, 10, 1), JPH::Vec3(0, -1, 0), 20.0f);
+            ray_entities.push_back(entity);
+        }
+
+        // 胶囊体重叠查询不受支持：跳过查询但仍返回空结果
+        auto overlap_entity = registry_.create();
+        auto& overlap_comp = registry_.emplace<PhysicsEventQueryComponent>(overlap_entity);
+        PhysicsQueryComponent::OverlapQuery capsule;
+        capsule.shape = PhysicsQueryComponent::OverlapQuery::CAPSULE;
+        capsule.center = JPH::Vec3(80, 0, 0);
+        capsule.size = JPH::Vec3(1, 2, 1);
+        overlap_comp.overlap_queries.push_back(capsule);
+        overlap_comp.add_sphere_overlap(JPH::Vec3(80, 0, 0), 1.0f);
+        registry_.emplace<PendingQueryTag>(overlap_entity);
+
+        simulate_physics_frames(1);
+
+        bool passed = true;
+        for (auto entity : ray_entities) {
+            passed &= results_.raycast_results_by_requester[entity] == 2;
+        }
+        passed &= results_.overlap_results_by_requester[overlap_entity] == 2;
+        passed &= registry_.get<PhysicsEventQueryComponent>(overlap_entity).overlap_queries[0].overlapping_entities.empty();
+        std::cout << (passed ? "✅" : "❌") << " Batched queries test: every requester received one result per query" << std::endl;
+
+        return passed;
+    }
+
     entt::entity create_test_entity(const JPH::Vec3& position, PhysicsBodyType body_type) {
         auto entity = registry_.create();
         
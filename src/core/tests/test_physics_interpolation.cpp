@@ -0,0 +1,202 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include "core/physics_world_manager.h"
+#include "core/components/physics_body_component.h"
+#include "core/components/physics_command_component.h"
+#include "core/components/physics_sync_component.h"
+#include "core/components/transform_component.h"
+#include "core/systems/physics_system.h"
+#include "core/systems/physics_command_system.h"
+
+using namespace portal_core;
+
+#define TEST_ASSERT(condition, message)                          \
+    do                                                           \
+    {                                                            \
+        if (!(condition))                                        \
+        {                                                        \
+            std::cout << "❌ FAILED: " << message << std::endl; \
+            return false;                                        \
+        }                                                        \
+        std::cout << "✅ PASSED: " << message << std::endl;     \
+    } while (0)
+
+bool nearly_equal(const Vec3 &a, const Vec3 &b)
+{
+    return (a - b).Length() < 1.0e-4f;
+}
+
+bool test_pose_double_buffer()
+{
+    std::cout << "\n=== 姿態雙緩衝與插值 ===" << std::endl;
+
+    PhysicsSyncComponent sync;
+    sync.push_physics_pose(Vec3(1, 0, 0), Quat::sIdentity());
+    TEST_ASSERT(sync.has_pose_history, "記錄第一個姿態");
+    TEST_ASSERT(nearly_equal(sync.get_interpolated_position(0.5f), Vec3(1, 0, 0)), "第一個姿態不從原點插值");
+
+    sync.push_physics_pose(Vec3(3, 0, 0), Quat::sRotation(Vec3(0, 1, 0), 1.0f));
+    TEST_ASSERT(nearly_equal(sync.previous_position, Vec3(1, 0, 0)), "當前姿態成為上一姿態");
+    TEST_ASSERT(nearly_equal(sync.get_interpolated_position(0.0f), Vec3(1, 0, 0)), "alpha = 0 為上一物理步");
+    TEST_ASSERT(nearly_equal(sync.get_interpolated_position(1.0f), Vec3(3, 0, 0)), "alpha = 1 為當前物理步");
+    TEST_ASSERT(nearly_equal(sync.get_interpolated_position(0.25f), Vec3(1.5f, 0, 0)), "位置線性插值");
+    TEST_ASSERT(sync.get_interpolated_rotation(0.5f).IsClose(Quat::sRotation(Vec3(0, 1, 0), 0.5f), 1.0e-5f), "旋轉球面插值");
+
+    sync.reset_pose_history();
+    sync.push_physics_pose(Vec3(10, 0, 0), Quat::sIdentity());
+    TEST_ASSERT(nearly_equal(sync.get_interpolated_position(0.5f), Vec3(10, 0, 0)), "重置後不跨越傳送前後插值");
+    return true;
+}
+
+bool test_interpolation_system_uses_frame_alpha()
+{
+    std::cout << "\n=== 插值系統使用幀插值係數 ===" << std::endl;
+
+    entt::registry registry;
+    auto entity = registry.create();
+    registry.emplace<TransformComponent>(entity);
+    auto &sync = registry.emplace<PhysicsSyncComponent>(entity);
+    sync.enable_interpolation = true;
+    sync.push_physics_pose(Vec3(0, 10, 0), Quat::sIdentity());
+    sync.push_physics_pose(Vec3(0, 8, 0), Quat::sIdentity());
+
+    auto other = registry.create();
+    registry.emplace<TransformComponent>(other).position = Vec3(5, 5, 5);
+    registry.emplace<PhysicsSyncComponent>(other).push_physics_pose(Vec3(0, 0, 0), Quat::sIdentity());
+
+    PhysicsInterpolationSystem system;
+    system.update(registry, 1.0f / 144.0f);
+    TEST_ASSERT(system.get_last_interpolated_bodies() == 0, "沒有幀時間信息時不插值");
+
+    FrameTiming timing;
+    timing.interpolation_alpha = 0.25f;
+    system.set_frame_timing(&timing);
+    system.update(registry, 1.0f / 144.0f);
+    TEST_ASSERT(system.get_last_interpolated_bodies() == 1, "只處理啟用插值的實體");
+    TEST_ASSERT(nearly_equal(registry.get<TransformComponent>(entity).position, Vec3(0, 9.5f, 0)), "Transform 寫入混合後的姿態");
+    TEST_ASSERT(nearly_equal(registry.get<TransformComponent>(other).position, Vec3(5, 5, 5)), "未啟用插值的實體不受影響");
+
+    timing.interpolation_alpha = 0.75f;
+    system.update(registry, 1.0f / 144.0f);
+    TEST_ASSERT(nearly_equal(registry.get<TransformComponent>(entity).position, Vec3(0, 8.5f, 0)), "沒有新物理步的幀繼續向當前姿態推進");
+    return true;
+}
+
+bool test_physics_system_direct_update()
+{
+    std::cout << "\n=== 直接更新時使用物理世界的累積器 ===" << std::endl;
+
+    entt::registry registry;
+    portal_core::PhysicsSystem physics_system;
+    TEST_ASSERT(physics_system.initialize(registry), "物理系統初始化");
+    auto &physics_manager = PhysicsWorldManager::get_instance();
+    physics_manager.set_fixed_timestep(1.0f / 30.0f);
+
+    auto entity = registry.create();
+    registry.emplace<TransformComponent>(entity).position = Vec3(0, 10, 0);
+    registry.emplace<PhysicsBodyComponent>(entity, PhysicsBodyType::DYNAMIC, PhysicsShapeDesc::sphere(0.5f));
+    registry.emplace<PhysicsSyncComponent>(entity).enable_interpolation = true;
+
+    // 144 Hz 渲染，30 Hz 物理
+    bool all_blended = true;
+    bool alpha_in_range = true;
+    uint32_t frames_without_step = 0;
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        physics_system.update(registry, 1.0f / 144.0f);
+        if (physics_manager.get_last_update_steps() == 0)
+        {
+            ++frames_without_step;
+        }
+
+        const auto &stats = physics_system.get_stats();
+        alpha_in_range &= stats.interpolation_alpha >= 0.0f && stats.interpolation_alpha < 1.0f;
+        const auto &sync = registry.get<PhysicsSyncComponent>(entity);
+        if (sync.has_pose_history)
+        {
+            all_blended &= stats.num_interpolated_bodies == 1 &&
+                           nearly_equal(registry.get<TransformComponent>(entity).position,
+                                        sync.get_interpolated_position(stats.interpolation_alpha));
+        }
+    }
+    TEST_ASSERT(frames_without_step > 0, "多數渲染幀沒有物理步");
+    TEST_ASSERT(alpha_in_range, "插值係數位於 [0, 1)");
+    TEST_ASSERT(registry.get<PhysicsSyncComponent>(entity).has_pose_history, "物理步後記錄了姿態");
+    TEST_ASSERT(all_blended, "每幀 Transform 都是兩個物理步姿態的混合");
+
+    physics_manager.set_fixed_timestep(1.0f / 60.0f);
+    physics_system.cleanup();
+    return true;
+}
+
+bool test_teleport_command_resets_history()
+{
+    std::cout << "\n=== 傳送命令後不跨越兩地插值 ===" << std::endl;
+
+    entt::registry registry;
+    portal_core::PhysicsSystem physics_system;
+    TEST_ASSERT(physics_system.initialize(registry), "物理系統初始化");
+    PhysicsCommandSystem command_system;
+    TEST_ASSERT(command_system.initialize(), "命令系統初始化");
+    auto &physics_manager = PhysicsWorldManager::get_instance();
+    physics_manager.set_fixed_timestep(1.0f / 30.0f);
+
+    auto entity = registry.create();
+    registry.emplace<TransformComponent>(entity).position = Vec3(0, 10, 0);
+    registry.emplace<PhysicsBodyComponent>(entity, PhysicsBodyType::DYNAMIC, PhysicsShapeDesc::sphere(0.5f));
+    registry.emplace<PhysicsSyncComponent>(entity).enable_interpolation = true;
+    registry.emplace<PhysicsCommandComponent>(entity);
+
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        physics_system.update(registry, 1.0f / 144.0f);
+    }
+    TEST_ASSERT(registry.get<PhysicsSyncComponent>(entity).has_pose_history, "傳送前已有姿態歷史");
+
+    const Vec3 destination(100, 10, 0);
+    registry.get<PhysicsCommandComponent>(entity).teleport(destination, Quat::sIdentity(), PhysicsCommandTiming::IMMEDIATE);
+    command_system.update(registry, 1.0f / 144.0f);
+    TEST_ASSERT(!registry.get<PhysicsSyncComponent>(entity).has_pose_history, "傳送命令清除姿態歷史");
+
+    // 直到下一個物理步，Transform 都停在目的地附近，而不是從舊位置混合過來
+    bool stayed_at_destination = true;
+    bool stepped = false;
+    for (int frame = 0; frame < 20 && !stepped; ++frame)
+    {
+        physics_system.update(registry, 1.0f / 144.0f);
+        stepped = physics_manager.get_last_update_steps() > 0;
+        stayed_at_destination &= registry.get<TransformComponent>(entity).position.GetX() > destination.GetX() - 0.01f;
+    }
+    const auto &sync = registry.get<PhysicsSyncComponent>(entity);
+    TEST_ASSERT(stepped, "傳送後發生了物理步");
+    TEST_ASSERT(stayed_at_destination, "傳送後的插值姿態不混合傳送前的位置");
+    TEST_ASSERT(nearly_equal(sync.previous_position, sync.current_position), "傳送後第一個物理步以新位置作為上一姿態");
+
+    physics_manager.set_fixed_timestep(1.0f / 60.0f);
+    command_system.cleanup();
+    physics_system.cleanup();
+    return true;
+}
+
+int main()
+{
+    std::cout << "Starting Physics Interpolation Tests..." << std::endl;
+    RegisterDefaultAllocator();
+
+    bool all_passed = true;
+    all_passed &= test_pose_double_buffer();
+    all_passed &= test_interpolation_system_uses_frame_alpha();
+    all_passed &= test_physics_system_direct_update();
+    all_passed &= test_teleport_command_resets_history();
+
+    if (all_passed)
+    {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    }
+    std::cout << "\n❌ Some tests failed!" << std::endl;
+    return 1;
+}
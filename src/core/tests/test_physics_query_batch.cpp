@@ -0,0 +1,149 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include "core/physics_world_manager.h"
+
+using namespace portal_core;
+
+#define TEST_ASSERT(condition, message)                          \
+    do                                                           \
+    {                                                            \
+        if (!(condition))                                        \
+        {                                                        \
+            std::cout << "❌ FAILED: " << message << std::endl; \
+            return false;                                        \
+        }                                                        \
+        std::cout << "✅ PASSED: " << message << std::endl;     \
+    } while (0)
+
+// 地面頂面位於 y = 0，向下的射線命中，向上的射線落空
+std::vector<PhysicsWorldManager::RaycastQuery> make_sensor_rays(int count)
+{
+    std::vector<PhysicsWorldManager::RaycastQuery> rays(count);
+    for (int i = 0; i < count; ++i)
+    {
+        rays[i].origin = RVec3(static_cast<float>(i % 40) - 20.0f, 5.0f + static_cast<float>(i % 7), static_cast<float>(i / 40) - 20.0f);
+        rays[i].direction = (i % 3 == 0) ? Vec3(0, 1, 0) : Vec3(0, -1, 0);
+        rays[i].max_distance = 100.0f;
+    }
+    return rays;
+}
+
+bool test_raycast_batch_matches_single()
+{
+    std::cout << "\n=== 批量射線與逐條查詢結果一致 ===" << std::endl;
+
+    auto &physics_manager = PhysicsWorldManager::get_instance();
+    TEST_ASSERT(physics_manager.initialize(), "物理世界初始化");
+
+    PhysicsBodyDesc ground;
+    ground.body_type = PhysicsBodyType::STATIC;
+    ground.shape = PhysicsShapeDesc::box(Vec3(100, 2, 100));
+    ground.position = RVec3(0, -1, 0);
+    BodyID ground_id = physics_manager.create_body(ground);
+    TEST_ASSERT(!ground_id.IsInvalid(), "創建地面");
+
+    const int ray_count = 2000;
+    std::vector<PhysicsWorldManager::RaycastQuery> rays = make_sensor_rays(ray_count);
+    PhysicsWorldManager::RaycastBatchResults results;
+
+    auto start = std::chrono::steady_clock::now();
+    physics_manager.raycast_batch(rays, results);
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "批量執行 " << ray_count << " 條射線: " << elapsed_ms << " ms" << std::endl;
+
+    TEST_ASSERT(results.size() == rays.size(), "每條射線一個結果");
+    bool all_match = true;
+    int hits = 0;
+    for (int i = 0; i < ray_count; ++i)
+    {
+        auto single = physics_manager.raycast(rays[i].origin, rays[i].direction, rays[i].max_distance);
+        all_match &= (results.hit[i] != 0) == single.hit;
+        if (single.hit)
+        {
+            all_match &= results.body_ids[i] == single.body_id && results.distances[i] == single.distance;
+            ++hits;
+        }
+    }
+    TEST_ASSERT(all_match, "命中、物理體與距離與單條查詢相同");
+    TEST_ASSERT(hits > 0 && hits < ray_count, "向下的射線命中，向上的射線落空");
+
+    const float *distances = results.distances.data();
+    physics_manager.raycast_batch(rays, results);
+    TEST_ASSERT(results.distances.data() == distances, "重用結果緩衝區時不重新分配");
+
+    physics_manager.raycast_batch(nullptr, 0, results);
+    TEST_ASSERT(results.size() == 0, "空批次清空結果");
+
+    physics_manager.destroy_body(ground_id);
+    physics_manager.cleanup();
+    return true;
+}
+
+bool test_overlap_batch_matches_single()
+{
+    std::cout << "\n=== 批量重疊查詢與逐個查詢結果一致 ===" << std::endl;
+
+    auto &physics_manager = PhysicsWorldManager::get_instance();
+    TEST_ASSERT(physics_manager.initialize(), "物理世界初始化");
+
+    PhysicsBodyDesc crate;
+    crate.body_type = PhysicsBodyType::STATIC;
+    crate.shape = PhysicsShapeDesc::box(Vec3(1, 1, 1));
+    std::vector<PhysicsBodyDesc> crates;
+    for (int i = 0; i < 20; ++i)
+    {
+        crate.position = RVec3(static_cast<float>(i) * 3.0f, 0.0f, 0.0f);
+        crates.push_back(crate);
+    }
+    std::vector<BodyID> crate_ids = physics_manager.create_bodies(crates);
+
+    std::vector<PhysicsWorldManager::OverlapQuery> queries;
+    for (int i = 0; i < 500; ++i)
+    {
+        RVec3 center(static_cast<float>(i % 60), 0.0f, 0.0f);
+        queries.push_back(i % 2 ? PhysicsWorldManager::OverlapQuery::sphere(center, 1.0f)
+                                : PhysicsWorldManager::OverlapQuery::box(center, Vec3(0.5f, 0.5f, 0.5f)));
+    }
+
+    PhysicsWorldManager::OverlapBatchResults results;
+    physics_manager.overlap_batch(queries, results);
+    TEST_ASSERT(results.size() == queries.size(), "每個查詢一組結果");
+
+    bool all_match = true;
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        const auto &query = queries[i];
+        std::vector<BodyID> single = query.type == PhysicsWorldManager::OverlapQuery::Type::SPHERE
+                                         ? physics_manager.overlap_sphere(query.center, query.half_extents.GetX())
+                                         : physics_manager.overlap_box(query.center, query.half_extents, query.rotation);
+        std::vector<BodyID> batched(results.body_ids.begin() + results.first[i],
+                                    results.body_ids.begin() + results.first[i] + results.count[i]);
+        all_match &= single == batched;
+    }
+    TEST_ASSERT(all_match, "每個查詢的重疊物理體與單個查詢相同且保持順序");
+    TEST_ASSERT(results.first.back() + results.count.back() == results.body_ids.size(), "結果區間覆蓋全部命中");
+
+    physics_manager.destroy_bodies(crate_ids);
+    physics_manager.cleanup();
+    return true;
+}
+
+int main()
+{
+    std::cout << "Starting Physics Query Batch Tests..." << std::endl;
+    RegisterDefaultAllocator();
+
+    bool all_passed = true;
+    all_passed &= test_raycast_batch_matches_single();
+    all_passed &= test_overlap_batch_matches_single();
+
+    if (all_passed)
+    {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    }
+    std::cout << "\n❌ Some tests failed!" << std::endl;
+    return 1;
+}
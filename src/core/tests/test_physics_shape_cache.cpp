@@ -0,0 +1,203 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include "core/physics_world_manager.h"
+
+using namespace portal_core;
+
+#define TEST_ASSERT(condition, message)                          \
+    do                                                           \
+    {                                                            \
+        if (!(condition))                                        \
+        {                                                        \
+            std::cout << "❌ FAILED: " << message << std::endl; \
+            return false;                                        \
+        }                                                        \
+        std::cout << "✅ PASSED: " << message << std::endl;     \
+    } while (0)
+
+PhysicsShapeDesc make_hull(float scale)
+{
+    PhysicsShapeDesc desc;
+    desc.type = PhysicsShapeType::CONVEX_HULL;
+    desc.vertices = {Vec3(0, 0, 0), Vec3(scale, 0, 0), Vec3(0, scale, 0), Vec3(0, 0, scale)};
+    return desc;
+}
+
+// 模擬 create_body 的查找流程
+RefConst<Shape> get_shape(PhysicsShapeCache &cache, const PhysicsShapeDesc &desc)
+{
+    RefConst<Shape> shape = cache.find(desc);
+    if (!shape)
+    {
+        shape = new BoxShape(desc.size * 0.5f);
+        cache.insert(desc, shape);
+    }
+    return shape;
+}
+
+bool test_identical_shapes_are_shared()
+{
+    std::cout << "\n=== 相同描述共享形狀 ===" << std::endl;
+
+    PhysicsShapeCache cache;
+    RefConst<Shape> first = get_shape(cache, PhysicsShapeDesc::box(Vec3(1, 2, 3)));
+    RefConst<Shape> second = get_shape(cache, PhysicsShapeDesc::box(Vec3(1, 2, 3)));
+    RefConst<Shape> other = get_shape(cache, PhysicsShapeDesc::box(Vec3(1, 2, 4)));
+
+    TEST_ASSERT(first.GetPtr() == second.GetPtr(), "相同尺寸的盒子共享同一個形狀");
+    TEST_ASSERT(first.GetPtr() != other.GetPtr(), "不同尺寸的盒子各自創建");
+    TEST_ASSERT(cache.get_stats().cached_shapes == 2, "緩存兩個不同形狀");
+    TEST_ASSERT(cache.get_stats().hits_this_frame == 1 && cache.get_stats().misses_this_frame == 2, "命中與未命中計數");
+    TEST_ASSERT(cache.get_stats().bytes_saved_this_frame > 0, "命中時記錄節省的內存");
+    return true;
+}
+
+bool test_content_keys()
+{
+    std::cout << "\n=== 按內容比較頂點與索引 ===" << std::endl;
+
+    TEST_ASSERT(PhysicsShapeCache::is_same_shape(make_hull(1.0f), make_hull(1.0f)), "頂點相同的凸包相同");
+    TEST_ASSERT(!PhysicsShapeCache::is_same_shape(make_hull(1.0f), make_hull(2.0f)), "頂點不同的凸包不同");
+    TEST_ASSERT(PhysicsShapeCache::hash_shape_desc(make_hull(1.0f)) == PhysicsShapeCache::hash_shape_desc(make_hull(1.0f)),
+                "相同內容哈希一致");
+
+    PhysicsShapeDesc mesh_a = make_hull(1.0f);
+    mesh_a.type = PhysicsShapeType::MESH;
+    mesh_a.indices = {0, 1, 2, 0, 2, 3};
+    PhysicsShapeDesc mesh_b = mesh_a;
+    mesh_b.indices = {0, 2, 1, 0, 2, 3};
+    TEST_ASSERT(!PhysicsShapeCache::is_same_shape(mesh_a, mesh_b), "索引不同的網格不同");
+
+    // 只比較該類型使用的字段
+    PhysicsShapeDesc sphere_a = PhysicsShapeDesc::sphere(0.5f);
+    PhysicsShapeDesc sphere_b = PhysicsShapeDesc::sphere(0.5f);
+    sphere_b.height = 7.0f;
+    TEST_ASSERT(PhysicsShapeCache::is_same_shape(sphere_a, sphere_b), "球體忽略無關的高度字段");
+    TEST_ASSERT(!PhysicsShapeCache::is_same_shape(PhysicsShapeDesc::capsule(0.5f, 1.0f), PhysicsShapeDesc::capsule(0.5f, 2.0f)),
+                "膠囊比較高度");
+    return true;
+}
+
+bool test_refcount_eviction()
+{
+    std::cout << "\n=== 引用計數淘汰 ===" << std::endl;
+
+    PhysicsShapeCache cache;
+    cache.set_eviction_delay(3);
+
+    std::vector<RefConst<Shape>> bodies;
+    for (int i = 0; i < 4; ++i)
+    {
+        bodies.push_back(get_shape(cache, PhysicsShapeDesc::box(Vec3(1, 1, 1))));
+    }
+    RefConst<Shape> unused = get_shape(cache, PhysicsShapeDesc::box(Vec3(5, 5, 5)));
+    unused = nullptr;
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        cache.end_frame();
+    }
+    TEST_ASSERT(cache.get_stats().cached_shapes == 1, "閒置足夠幀數的形狀被淘汰");
+    TEST_ASSERT(cache.get_stats().total_evicted == 1, "淘汰計數");
+
+    bodies.pop_back();
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        cache.end_frame();
+    }
+    TEST_ASSERT(cache.get_stats().cached_shapes == 1, "仍被物理體引用的形狀保留");
+
+    bodies.clear();
+    cache.end_frame();
+    cache.end_frame();
+    get_shape(cache, PhysicsShapeDesc::box(Vec3(1, 1, 1)));
+    TEST_ASSERT(cache.get_stats().total_hits == 4, "閒置未到期時重新使用會命中並重置計時");
+
+    TEST_ASSERT(cache.evict_unused() == 1, "evict_unused 立即淘汰未引用的形狀");
+    TEST_ASSERT(cache.get_stats().cached_shapes == 0 && cache.get_stats().cached_bytes == 0, "緩存內存歸零");
+    return true;
+}
+
+bool test_frame_statistics()
+{
+    std::cout << "\n=== 每幀統計 ===" << std::endl;
+
+    PhysicsShapeCache cache;
+    for (int i = 0; i < 10; ++i)
+    {
+        get_shape(cache, PhysicsShapeDesc::box(Vec3(1, 1, 1)));
+    }
+    cache.end_frame();
+
+    const PhysicsShapeCache::Stats &stats = cache.get_stats();
+    TEST_ASSERT(stats.last_frame_hits == 9 && stats.last_frame_misses == 1, "上一幀命中統計");
+    TEST_ASSERT(stats.get_last_frame_hit_rate() > 0.89f && stats.get_last_frame_hit_rate() < 0.91f, "上一幀命中率");
+    TEST_ASSERT(stats.hits_this_frame == 0 && stats.bytes_saved_this_frame == 0, "新的一幀從零開始");
+    TEST_ASSERT(stats.last_frame_bytes_saved == 9 * stats.cached_bytes, "節省的內存等於命中次數乘形狀大小");
+
+    cache.set_enabled(false);
+    TEST_ASSERT(!cache.find(PhysicsShapeDesc::box(Vec3(1, 1, 1))), "關閉緩存後不再返回共享形狀");
+    TEST_ASSERT(stats.cached_shapes == 0, "關閉緩存時清空");
+    return true;
+}
+
+bool test_crate_wave()
+{
+    std::cout << "\n=== 生成一波相同的箱子 ===" << std::endl;
+
+    auto &physics_manager = PhysicsWorldManager::get_instance();
+    TEST_ASSERT(physics_manager.initialize(), "物理世界初始化");
+
+    PhysicsBodyDesc crate;
+    crate.shape = PhysicsShapeDesc::box(Vec3(1, 1, 1));
+
+    const int crate_count = 10000;
+    std::vector<BodyID> bodies;
+    bodies.reserve(crate_count);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < crate_count; ++i)
+    {
+        crate.position = RVec3(static_cast<float>(i % 100) * 2.0f, 10.0f + static_cast<float>(i / 100) * 2.0f, 0.0f);
+        bodies.push_back(physics_manager.create_body(crate));
+    }
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const PhysicsShapeCache::Stats &stats = physics_manager.get_shape_cache().get_stats();
+    std::cout << "創建 " << crate_count << " 個箱子: " << elapsed_ms << " ms, 命中率 "
+              << stats.get_total_hit_rate() * 100.0f << "%, 節省 " << stats.total_bytes_saved / 1024 << " KB" << std::endl;
+    TEST_ASSERT(stats.cached_shapes == 1, "一萬個相同的箱子只創建一個形狀");
+    TEST_ASSERT(stats.total_hits == crate_count - 1, "其餘全部命中緩存");
+
+    for (BodyID body_id : bodies)
+    {
+        physics_manager.destroy_body(body_id);
+    }
+    physics_manager.get_shape_cache().evict_unused();
+    TEST_ASSERT(physics_manager.get_shape_cache().get_stats().cached_shapes == 0, "物理體銷毀後形狀可被淘汰");
+
+    physics_manager.cleanup();
+    return true;
+}
+
+int main()
+{
+    std::cout << "Starting Physics Shape Cache Tests..." << std::endl;
+    RegisterDefaultAllocator();
+
+    bool all_passed = true;
+    all_passed &= test_identical_shapes_are_shared();
+    all_passed &= test_content_keys();
+    all_passed &= test_refcount_eviction();
+    all_passed &= test_frame_statistics();
+    all_passed &= test_crate_wave();
+
+    if (all_passed)
+    {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    }
+    std::cout << "\n❌ Some tests failed!" << std::endl;
+    return 1;
+}
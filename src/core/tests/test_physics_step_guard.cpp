@@ -0,0 +1,201 @@
+#include <iostream>
+
+#include "core/physics_world_manager.h"
+#include "core/system_manager.h"
+#include "core/systems/physics_system.h"
+
+using namespace portal_core;
+
+#define TEST_ASSERT(condition, message)                          \
+    do                                                           \
+    {                                                            \
+        if (!(condition))                                        \
+        {                                                        \
+            std::cout << "❌ FAILED: " << message << std::endl; \
+            return false;                                        \
+        }                                                        \
+        std::cout << "✅ PASSED: " << message << std::endl;     \
+    } while (0)
+
+const float FIXED_STEP = 1.0f / 60.0f;
+
+bool test_defaults()
+{
+    std::cout << "\n=== 默認設定 ===" << std::endl;
+
+    auto &physics_manager = PhysicsWorldManager::get_instance();
+    SystemManager system_manager;
+    TEST_ASSERT(physics_manager.get_max_steps_per_frame() == system_manager.get_max_fixed_steps_per_frame(),
+                "每幀步數上限與 SystemManager 一致");
+    TEST_ASSERT(physics_manager.get_max_merged_steps() == 1, "默認不合併固定步");
+    TEST_ASSERT(!physics_manager.is_adaptive_collision_steps(), "默認關閉自適應碰撞子步");
+    return true;
+}
+
+// 每個測試使用默認設定的物理世界
+PhysicsWorldManager &reset_world()
+{
+    auto &physics_manager = PhysicsWorldManager::get_instance();
+    physics_manager.cleanup();
+    physics_manager.initialize();
+    physics_manager.set_fixed_timestep(FIXED_STEP);
+    physics_manager.set_max_steps_per_frame(4);
+    physics_manager.set_max_merged_steps(2);
+    physics_manager.set_step_time_budget(0.0f);
+    physics_manager.set_adaptive_collision_steps(true);
+    physics_manager.set_collision_steps_range(1, 4);
+    return physics_manager;
+}
+
+bool test_normal_frames()
+{
+    std::cout << "\n=== 正常幀不合併不丟步 ===" << std::endl;
+
+    auto &physics_manager = reset_world();
+    physics_manager.update(FIXED_STEP * 1.5f);
+    const auto &stats = physics_manager.get_step_stats();
+    TEST_ASSERT(stats.steps == 1 && stats.merged_steps == 0 && stats.dropped_steps == 0, "一個固定步");
+    TEST_ASSERT(stats.time_scale == 1.0f, "時間不減慢");
+    TEST_ASSERT(stats.collision_steps == 1, "固定步長使用一個碰撞子步");
+
+    physics_manager.update(FIXED_STEP * 0.25f);
+    TEST_ASSERT(stats.steps == 0, "累積不足一步時不步進");
+    TEST_ASSERT(physics_manager.get_interpolation_alpha() > 0.7f && physics_manager.get_interpolation_alpha() < 0.8f,
+                "剩餘時間保留在累積器中");
+    return true;
+}
+
+bool test_backlog_is_merged()
+{
+    std::cout << "\n=== 少量積壓合併成較長的步 ===" << std::endl;
+
+    auto &physics_manager = reset_world();
+    physics_manager.update(FIXED_STEP * 6.5f);
+    const auto &stats = physics_manager.get_step_stats();
+    TEST_ASSERT(stats.steps == 3, "六個固定步合併為三步");
+    TEST_ASSERT(stats.merged_steps == 3 && stats.dropped_steps == 0, "合併三個固定步，不丟步");
+    TEST_ASSERT(stats.collision_steps == 2, "雙倍步長使用兩個碰撞子步");
+    TEST_ASSERT(stats.time_scale == 1.0f, "合併不影響遊戲時間");
+    return true;
+}
+
+bool test_hitch_is_capped()
+{
+    std::cout << "\n=== 長時間卡頓後限制步數並丟棄積壓 ===" << std::endl;
+
+    auto &physics_manager = reset_world();
+    physics_manager.update(0.51f);
+    const auto &stats = physics_manager.get_step_stats();
+    std::cout << "步數: " << stats.steps << ", 合併: " << stats.merged_steps << ", 丟棄: " << stats.dropped_steps
+              << ", 時間比例: " << stats.time_scale << std::endl;
+    TEST_ASSERT(stats.steps == 4, "步數不超過每幀上限");
+    TEST_ASSERT(stats.merged_steps == 4 && stats.dropped_steps == 22, "合併後仍超出的固定步被丟棄");
+    TEST_ASSERT(stats.time_scale < 0.3f, "遊戲時間相對變慢");
+    TEST_ASSERT(physics_manager.get_interpolation_alpha() < 1.0f, "丟棄積壓後累積器不足一步");
+
+    physics_manager.update(FIXED_STEP);
+    TEST_ASSERT(stats.steps == 1 && stats.dropped_steps == 0, "下一幀恢復正常");
+    TEST_ASSERT(stats.total_dropped_steps == 22 && stats.total_merged_steps == 4, "累計統計");
+
+    physics_manager.set_max_merged_steps(1);
+    physics_manager.update(FIXED_STEP * 6.0f);
+    TEST_ASSERT(stats.steps == 4 && stats.merged_steps == 0 && stats.dropped_steps == 2, "禁止合併時直接丟步");
+    return true;
+}
+
+bool test_collision_step_selection()
+{
+    std::cout << "\n=== 碰撞子步數選擇 ===" << std::endl;
+
+    auto &physics_manager = reset_world();
+    physics_manager.set_adaptive_collision_steps(false);
+    physics_manager.set_collision_steps(3);
+    physics_manager.update(FIXED_STEP * 1.5f);
+    TEST_ASSERT(physics_manager.get_step_stats().collision_steps == 3, "關閉自適應時使用設定值");
+
+    physics_manager.set_adaptive_collision_steps(true);
+    physics_manager.set_collision_steps_range(2, 4);
+    physics_manager.step(FIXED_STEP);
+    TEST_ASSERT(physics_manager.get_step_stats().collision_steps == 2, "不少於最小子步數");
+    physics_manager.step(FIXED_STEP * 10.0f);
+    TEST_ASSERT(physics_manager.get_step_stats().collision_steps == 4, "不超過最大子步數");
+    TEST_ASSERT(physics_manager.get_step_stats().collision_step_cost > 0.0f, "記錄每個子步的耗時");
+
+    // 極小的預算：每幀只能負擔一步和最少的子步
+    physics_manager.set_collision_steps_range(1, 4);
+    physics_manager.set_step_time_budget(1.0e-12f);
+    physics_manager.update(FIXED_STEP * 3.0f);
+    const auto &stats = physics_manager.get_step_stats();
+    TEST_ASSERT(stats.steps == 1, "耗時預算限制每幀步數");
+    TEST_ASSERT(stats.collision_steps == 1, "耗時預算限制碰撞子步數");
+    TEST_ASSERT(stats.merged_steps == 1 && stats.dropped_steps == 1, "超出預算的積壓先合併再丟棄");
+
+    physics_manager.cleanup();
+    return true;
+}
+
+bool test_pipeline_driven_steps()
+{
+    std::cout << "\n=== 由固定步時鐘驅動時同樣受耗時預算限制 ===" << std::endl;
+
+    auto &physics_manager = reset_world();
+    entt::registry registry;
+    portal_core::PhysicsSystem physics_system;
+    TEST_ASSERT(physics_system.initialize(registry), "物理系統初始化");
+
+    FrameTiming timing;
+    timing.fixed_timestep = FIXED_STEP;
+    physics_system.set_frame_timing(&timing);
+    auto run_fixed_steps = [&](uint32_t count)
+    {
+        timing.fixed_step_count = count;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            timing.fixed_step_index = i;
+            physics_system.update(registry, FIXED_STEP);
+        }
+    };
+
+    run_fixed_steps(3);
+    const auto &stats = physics_system.get_stats();
+    TEST_ASSERT(stats.physics_steps == 3 && stats.dropped_physics_steps == 0, "無預算時執行時鐘給出的全部固定步");
+    TEST_ASSERT(physics_manager.get_step_stats().collision_step_cost > 0.0f, "記錄每個子步的耗時");
+
+    physics_manager.set_step_time_budget(1.0e-12f);
+    run_fixed_steps(4);
+    TEST_ASSERT(stats.physics_steps == 1 && stats.dropped_physics_steps == 3, "耗時預算限制固定步驅動時的步數");
+    TEST_ASSERT(stats.collision_steps == 1, "耗時預算限制碰撞子步數");
+    TEST_ASSERT(physics_manager.get_step_stats().time_scale == 0.25f, "丟步後遊戲時間相對變慢");
+
+    physics_manager.set_step_time_budget(0.0f);
+    timing.dropped_fixed_steps = 2;
+    run_fixed_steps(2);
+    TEST_ASSERT(stats.physics_steps == 2 && stats.dropped_physics_steps == 2, "統計包含固定步時鐘丟棄的步");
+
+    physics_system.set_frame_timing(nullptr);
+    physics_system.cleanup();
+    physics_manager.cleanup();
+    return true;
+}
+
+int main()
+{
+    std::cout << "Starting Physics Step Guard Tests..." << std::endl;
+    RegisterDefaultAllocator();
+
+    bool all_passed = true;
+    all_passed &= test_defaults();
+    all_passed &= test_normal_frames();
+    all_passed &= test_backlog_is_merged();
+    all_passed &= test_hitch_is_capped();
+    all_passed &= test_collision_step_selection();
+    all_passed &= test_pipeline_driven_steps();
+
+    if (all_passed)
+    {
+        std::cout << "\n🎉 All tests passed!" << std::endl;
+        return 0;
+    }
+    std::cout << "\n❌ Some tests failed!" << std::endl;
+    return 1;
+}
@@ -0,0 +1,135 @@
+#include "system_test_utils.h"
+#include <iostream>
+#include <algorithm>
+
+using namespace portal_core;
+
+struct AccessPosition
+{
+    float x = 0.0f;
+};
+
+struct AccessVelocity
+{
+    float x = 0.0f;
+};
+
+struct AccessHealth
+{
+    int value = 0;
+};
+
+// 通過模板參數聲明組件訪問的測試系統
+template <typename... Components>
+class AccessTestSystem : public ISystem
+{
+public:
+    void update(entt::registry &, float) override {}
+    const char *get_name() const override { return "AccessTestSystem"; }
+    ComponentAccess get_component_access() const override
+    {
+        return make_component_access<Components...>();
+    }
+};
+
+// 未聲明組件訪問的系統
+class UndeclaredSystem : public ISystem
+{
+public:
+    void update(entt::registry &, float) override {}
+    const char *get_name() const override { return "UndeclaredSystem"; }
+};
+
+size_t layer_of(const SystemManager &manager, const std::string &name)
+{
+    const auto &layers = manager.get_parallel_layers();
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        if (std::find(layers[i].begin(), layers[i].end(), name) != layers[i].end())
+        {
+            return i;
+        }
+    }
+    return static_cast<size_t>(-1);
+}
+
+bool test_component_access_conflicts()
+{
+    std::cout << "\n=== 組件訪問衝突判定 ===" << std::endl;
+
+    auto read_position = make_component_access<const AccessPosition>();
+    auto write_position = make_component_access<AccessPosition>();
+    auto write_velocity = make_component_access<AccessVelocity, const AccessPosition>();
+    auto exclusive = make_component_access<entt::registry>();
+    auto undeclared = ComponentAccess{};
+
+    TEST_ASSERT(!read_position.conflicts_with(read_position), "讀-讀 不衝突");
+    TEST_ASSERT(read_position.conflicts_with(write_position), "讀-寫 衝突");
+    TEST_ASSERT(write_position.conflicts_with(write_position), "寫-寫 衝突");
+    TEST_ASSERT(!write_velocity.conflicts_with(read_position), "不同組件寫入不衝突");
+    TEST_ASSERT(exclusive.conflicts_with(read_position), "獨占註冊表與任何訪問衝突");
+    TEST_ASSERT(!undeclared.conflicts_with(write_position), "未聲明的系統不參與推導");
+    return true;
+}
+
+bool test_layers_from_hazards()
+{
+    std::cout << "\n=== 根據數據衝突構建執行層 ===" << std::endl;
+
+    SystemRegistry::clear();
+    register_test_system<AccessTestSystem<AccessPosition, const AccessVelocity>>("Movement", 10);
+    register_test_system<AccessTestSystem<const AccessPosition>>("PositionReaderA", 20);
+    register_test_system<AccessTestSystem<const AccessPosition>>("PositionReaderB", 21);
+    register_test_system<AccessTestSystem<AccessHealth>>("Health", 5);
+    register_test_system<AccessTestSystem<AccessVelocity>>("VelocityWriter", 30);
+    register_test_system<UndeclaredSystem>("Legacy", 0);
+
+    SystemManager manager;
+    manager.initialize();
+
+    TEST_ASSERT(layer_of(manager, "Movement") == 0, "寫 Position 的系統在第一層");
+    TEST_ASSERT(layer_of(manager, "Health") == 0, "無衝突的系統與其並行");
+    TEST_ASSERT(layer_of(manager, "Legacy") == 0, "未聲明的系統保持原有行為");
+    TEST_ASSERT(layer_of(manager, "PositionReaderA") == 1, "讀 Position 的系統排在寫入之後");
+    TEST_ASSERT(layer_of(manager, "PositionReaderB") == 1, "兩個只讀系統可以並行");
+    TEST_ASSERT(layer_of(manager, "VelocityWriter") == 1, "寫 Velocity 的系統排在讀取之後，並與只讀 Position 的系統並行");
+
+    manager.cleanup();
+    return true;
+}
+
+bool test_explicit_dependency_wins_over_priority()
+{
+    std::cout << "\n=== 名稱依賴優先於優先級 ===" << std::endl;
+
+    SystemRegistry::clear();
+    // Writer 優先級較低，但依賴 Reader，因此必須在 Reader 之後
+    register_test_system<AccessTestSystem<AccessPosition>>("Writer", 1, {"Reader"});
+    register_test_system<AccessTestSystem<const AccessPosition>>("Reader", 50);
+    register_test_system<UndeclaredSystem>("A", 10, {}, {"B"});
+    register_test_system<UndeclaredSystem>("B", 20);
+
+    SystemManager manager;
+    manager.initialize();
+
+    TEST_ASSERT(layer_of(manager, "Reader") < layer_of(manager, "Writer"), "依賴關係不被衝突推導反轉");
+    TEST_ASSERT(layer_of(manager, "A") < layer_of(manager, "B"), "衝突列表中的系統不會並行");
+
+    manager.cleanup();
+    return true;
+}
+
+int main()
+{
+    std::cout << "=== System Access Scheduling Test ===" << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_component_access_conflicts();
+    all_passed &= test_layers_from_hazards();
+    all_passed &= test_explicit_dependency_wins_over_priority();
+
+    SystemRegistry::reset_and_re_register();
+
+    std::cout << (all_passed ? "\n✅ All tests passed" : "\n❌ Some tests failed") << std::endl;
+    return all_passed ? 0 : 1;
+}
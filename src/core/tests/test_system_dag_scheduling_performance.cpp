@@ -0,0 +1,230 @@
+#include "system_test_utils.h"
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <map>
+#include <atomic>
+#include <algorithm>
+
+using namespace portal_core;
+
+using Clock = std::chrono::steady_clock;
+
+// 記錄每個系統的開始/結束時間
+static std::mutex g_timeline_mutex;
+static std::map<std::string, std::pair<Clock::time_point, Clock::time_point>> g_timeline;
+
+// 固定耗時的系統（用 sleep 模擬，結果不受核心數影響）
+template <int Milliseconds>
+class TimedSystem : public ISystem
+{
+public:
+    explicit TimedSystem(std::string name) : name_(std::move(name)) {}
+
+    void update(entt::registry &, float) override
+    {
+        auto start = Clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(Milliseconds));
+        std::lock_guard<std::mutex> lock(g_timeline_mutex);
+        g_timeline[name_] = {start, Clock::now()};
+    }
+    const char *get_name() const override { return "TimedSystem"; }
+
+private:
+    std::string name_;
+};
+
+template <int Milliseconds>
+void register_timed_system(const std::string &name, const std::vector<std::string> &dependencies = {})
+{
+    SystemRegistry::register_system(
+        name, [name]() -> std::unique_ptr<ISystem>
+        { return std::make_unique<TimedSystem<Milliseconds>>(name); },
+        dependencies, {}, 0);
+}
+
+/**
+ * 不平衡的層：
+ *   層 0: Slow (8ms)   Fast (1ms)
+ *   層 1: BranchA (4ms, 依賴 Fast)   BranchB (4ms, 依賴 Fast)
+ *   層 2: Tail (2ms, 依賴 BranchA)
+ * 按層屏障執行需要 8 + 4 + 2 = 14ms；按依賴圖執行時 Fast 之後的分支與 Slow 重疊，約 8ms
+ */
+void register_unbalanced_systems()
+{
+    SystemRegistry::clear();
+    register_timed_system<8>("Slow");
+    register_timed_system<1>("Fast");
+    register_timed_system<4>("BranchA", {"Fast"});
+    register_timed_system<4>("BranchB", {"Fast"});
+    register_timed_system<2>("Tail", {"BranchA"});
+}
+
+double measure_frame_ms(ParallelSchedulingMode mode, int frames)
+{
+    register_unbalanced_systems();
+
+    SystemManager manager;
+    manager.set_worker_thread_count(3);
+    manager.initialize();
+    manager.set_parallel_execution(true);
+    manager.set_scheduling_mode(mode);
+
+    entt::registry registry;
+    manager.update_systems(registry, 1.0f / 60.0f); // 預熱
+
+    auto start = Clock::now();
+    for (int i = 0; i < frames; ++i)
+    {
+        manager.update_systems(registry, 1.0f / 60.0f);
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / frames;
+
+    manager.cleanup();
+    return ms;
+}
+
+bool test_dependencies_respected()
+{
+    std::cout << "\n=== 依賴圖調度遵守依賴順序 ===" << std::endl;
+
+    register_unbalanced_systems();
+    SystemManager manager;
+    manager.set_worker_thread_count(3);
+    manager.initialize();
+    manager.set_parallel_execution(true);
+
+    entt::registry registry;
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        g_timeline.clear();
+        manager.update_systems(registry, 1.0f / 60.0f);
+
+        TEST_ASSERT(g_timeline.size() == 5, "每幀所有系統都執行一次");
+        TEST_ASSERT(g_timeline["Fast"].second <= g_timeline["BranchA"].first &&
+                        g_timeline["Fast"].second <= g_timeline["BranchB"].first &&
+                        g_timeline["BranchA"].second <= g_timeline["Tail"].first,
+                    "後繼系統在前驅完成後才開始");
+    }
+
+    // 不必等待同層的 Slow
+    TEST_ASSERT(g_timeline["BranchA"].first < g_timeline["Slow"].second, "後繼系統不等待同層的慢系統");
+
+    const auto *frame = manager.get_profiler().get_last_frame();
+    TEST_ASSERT(frame && frame->critical_path_ms >= 7.5f && frame->critical_path_ms < 12.0f,
+                "關鍵路徑取依賴圖上的最長路徑（Slow 8ms，而不是逐層累加的 14ms）");
+
+    manager.cleanup();
+    return true;
+}
+
+/**
+ * 入口按關鍵路徑優先級依次開始：
+ *   ChainN 後面跟著 N-1 個依賴它的系統，鏈越長優先級越高
+ * 工作線程全部被佔住時，只有調用線程在執行，入口的開始順序即為領取順序
+ */
+bool test_roots_start_in_priority_order()
+{
+    std::cout << "\n=== 入口任務按優先級開始 ===" << std::endl;
+
+    SystemRegistry::clear();
+    const int CHAINS = 5;
+    for (int length = 1; length <= CHAINS; ++length)
+    {
+        const std::string root = "Chain" + std::to_string(length);
+        register_timed_system<0>(root);
+        std::string previous = root;
+        for (int i = 1; i < length; ++i)
+        {
+            const std::string next = root + "_" + std::to_string(i);
+            register_timed_system<0>(next, {previous});
+            previous = next;
+        }
+    }
+
+    SystemManager manager;
+    manager.set_worker_thread_count(2);
+    manager.initialize();
+    manager.set_parallel_execution(true);
+    WorkerPool *pool = manager.get_worker_pool();
+
+    // 佔住全部工作線程，一段時間後自動釋放
+    std::atomic<bool> release{false};
+    std::atomic<int> blocked{0};
+    TaskGroup blocker_group;
+    for (size_t i = 0; i < pool->get_worker_count(); ++i)
+    {
+        pool->submit(blocker_group, [&]()
+                     {
+                         blocked.fetch_add(1);
+                         while (!release.load())
+                         {
+                             std::this_thread::yield();
+                         } });
+    }
+    while (blocked.load() < static_cast<int>(pool->get_worker_count()))
+    {
+        std::this_thread::yield();
+    }
+    std::thread releaser([&release]()
+                         {
+                             std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                             release.store(true); });
+
+    entt::registry registry;
+    g_timeline.clear();
+    manager.update_systems(registry, 1.0f / 60.0f);
+
+    releaser.join();
+    pool->wait(blocker_group);
+
+    std::vector<std::pair<Clock::time_point, int>> root_starts;
+    for (int length = 1; length <= CHAINS; ++length)
+    {
+        root_starts.emplace_back(g_timeline["Chain" + std::to_string(length)].first, length);
+    }
+    std::sort(root_starts.begin(), root_starts.end());
+
+    bool descending = true;
+    for (int i = 0; i < CHAINS; ++i)
+    {
+        descending &= root_starts[i].second == CHAINS - i;
+    }
+    TEST_ASSERT(g_timeline.size() == CHAINS * (CHAINS + 1) / 2, "所有系統都執行一次");
+    TEST_ASSERT(descending, "入口按關鍵路徑長度從長到短開始");
+
+    manager.cleanup();
+    return true;
+}
+
+bool benchmark_unbalanced_layer()
+{
+    std::cout << "\n=== 不平衡層基準：層屏障 vs 依賴圖 ===" << std::endl;
+
+    const int FRAMES = 30;
+    double barrier_ms = measure_frame_ms(ParallelSchedulingMode::LayerBarrier, FRAMES);
+    double graph_ms = measure_frame_ms(ParallelSchedulingMode::DependencyGraph, FRAMES);
+
+    std::cout << "Layer barrier:    " << barrier_ms << " ms/frame" << std::endl;
+    std::cout << "Dependency graph: " << graph_ms << " ms/frame" << std::endl;
+    std::cout << "Speedup: " << barrier_ms / graph_ms << "x" << std::endl;
+
+    TEST_ASSERT(graph_ms < barrier_ms * 0.85, "依賴圖調度明顯快於層屏障");
+    return true;
+}
+
+int main()
+{
+    std::cout << "=== System DAG Scheduling Test & Benchmark ===" << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_dependencies_respected();
+    all_passed &= test_roots_start_in_priority_order();
+    all_passed &= benchmark_unbalanced_layer();
+
+    SystemRegistry::reset_and_re_register();
+
+    std::cout << (all_passed ? "\n✅ All tests passed" : "\n❌ Some tests failed") << std::endl;
+    return all_passed ? 0 : 1;
+}
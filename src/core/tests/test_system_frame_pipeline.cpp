@@ -0,0 +1,112 @@
+#include "system_test_utils.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+using namespace portal_core;
+
+// 記錄執行順序的全局日誌
+static std::vector<std::string> g_execution_log;
+static std::vector<float> g_fixed_deltas;
+
+template <SystemPhase Phase>
+class PhaseRecorderSystem : public ISystem
+{
+public:
+    void update(entt::registry &, float delta_time) override
+    {
+        g_execution_log.push_back(get_phase_name(Phase));
+        if (Phase == SystemPhase::FixedUpdate)
+        {
+            g_fixed_deltas.push_back(delta_time);
+        }
+    }
+    const char *get_name() const override { return get_phase_name(Phase); }
+    SystemPhase get_phase() const override { return Phase; }
+};
+
+void register_pipeline_systems()
+{
+    SystemRegistry::clear();
+    // 故意打亂註冊順序，執行順序應只由階段決定
+    register_test_system<PhaseRecorderSystem<SystemPhase::RenderExtract>>("Extract", 0);
+    register_test_system<PhaseRecorderSystem<SystemPhase::Update>>("Logic", 0);
+    register_test_system<PhaseRecorderSystem<SystemPhase::FixedUpdate>>("Physics", 0);
+    register_test_system<PhaseRecorderSystem<SystemPhase::PostUpdate>>("Post", 0, {"Logic"});
+    register_test_system<PhaseRecorderSystem<SystemPhase::PreUpdate>>("Input", 0);
+}
+
+bool test_phase_order_and_substeps()
+{
+    std::cout << "\n=== 階段順序與固定步進 ===" << std::endl;
+
+    register_pipeline_systems();
+    SystemManager manager;
+    manager.set_fixed_timestep(1.0f / 60.0f);
+    manager.initialize();
+
+    entt::registry registry;
+    g_execution_log.clear();
+    g_fixed_deltas.clear();
+
+    // 1/30 秒的一幀應執行兩次固定步
+    manager.update_systems(registry, 1.0f / 30.0f + 0.001f);
+
+    std::vector<std::string> expected = {"PreUpdate", "FixedUpdate", "FixedUpdate", "Update", "PostUpdate", "RenderExtract"};
+    TEST_ASSERT(g_execution_log == expected, "階段按 PreUpdate → FixedUpdate×2 → Update → PostUpdate → RenderExtract 執行");
+    TEST_ASSERT(g_fixed_deltas.size() == 2 && std::fabs(g_fixed_deltas[0] - 1.0f / 60.0f) < 1e-6f, "FixedUpdate 使用固定步長");
+    TEST_ASSERT(manager.get_frame_timing().fixed_step_count == 2, "幀時間信息記錄固定步數");
+
+    float alpha = manager.get_frame_timing().interpolation_alpha;
+    TEST_ASSERT(alpha > 0.0f && alpha < 1.0f, "插值係數在 (0, 1) 範圍內");
+
+    // 很短的一幀可能不執行固定步
+    g_execution_log.clear();
+    manager.update_systems(registry, 0.001f);
+    TEST_ASSERT(std::count(g_execution_log.begin(), g_execution_log.end(), "FixedUpdate") == 0, "累積時間不足時跳過 FixedUpdate");
+    TEST_ASSERT(std::count(g_execution_log.begin(), g_execution_log.end(), "Update") == 1, "其他階段每幀仍執行一次");
+
+    manager.cleanup();
+    return true;
+}
+
+bool test_spike_is_clamped()
+{
+    std::cout << "\n=== 幀率尖峰時限制固定步數 ===" << std::endl;
+
+    register_pipeline_systems();
+    SystemManager manager;
+    manager.set_fixed_timestep(1.0f / 60.0f);
+    manager.set_max_fixed_steps_per_frame(4);
+    manager.initialize();
+
+    entt::registry registry;
+    g_fixed_deltas.clear();
+
+    // 一秒的卡頓不應觸發 60 次物理步進
+    manager.update_systems(registry, 1.0f);
+    TEST_ASSERT(g_fixed_deltas.size() == 4, "固定步數被限制為每幀上限");
+    TEST_ASSERT(manager.get_frame_timing().dropped_fixed_steps >= 55, "記錄被丟棄的固定步數");
+
+    // 下一幀不應繼續追趕積壓的時間
+    g_fixed_deltas.clear();
+    manager.update_systems(registry, 1.0f / 60.0f);
+    TEST_ASSERT(g_fixed_deltas.size() <= 2, "積壓時間被丟棄，不會形成死亡螺旋");
+
+    manager.cleanup();
+    return true;
+}
+
+int main()
+{
+    std::cout << "=== System Frame Pipeline Test ===" << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_phase_order_and_substeps();
+    all_passed &= test_spike_is_clamped();
+
+    SystemRegistry::reset_and_re_register();
+
+    std::cout << (all_passed ? "\n✅ All tests passed" : "\n❌ Some tests failed") << std::endl;
+    return all_passed ? 0 : 1;
+}
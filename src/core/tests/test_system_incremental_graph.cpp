@@ -0,0 +1,236 @@
+#include "system_test_utils.h"
+#include <iostream>
+#include <chrono>
+#include <map>
+
+using namespace portal_core;
+
+struct GraphPosition
+{
+    float x = 0.0f;
+};
+
+struct GraphVelocity
+{
+    float x = 0.0f;
+};
+
+template <typename... Components>
+class GraphTestSystem : public ISystem
+{
+public:
+    void update(entt::registry &, float) override {}
+    const char *get_name() const override { return "GraphTestSystem"; }
+    ComponentAccess get_component_access() const override
+    {
+        return make_component_access<Components...>();
+    }
+};
+
+// 訪問模式在運行時指定的系統（基準測試用）
+class ConfigurableAccessSystem : public ISystem
+{
+public:
+    explicit ConfigurableAccessSystem(ComponentAccess access) : access_(std::move(access)) {}
+    void update(entt::registry &, float) override {}
+    const char *get_name() const override { return "ConfigurableAccessSystem"; }
+    ComponentAccess get_component_access() const override { return access_; }
+
+private:
+    ComponentAccess access_;
+};
+
+// 每個系統所在的層（跨階段拼接後的下標）
+std::map<std::string, size_t> layer_map(const SystemManager &manager)
+{
+    std::map<std::string, size_t> result;
+    const auto &layers = manager.get_parallel_layers();
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        for (const std::string &name : layers[i])
+        {
+            result[name] = i;
+        }
+    }
+    return result;
+}
+
+bool test_incremental_matches_full_rebuild()
+{
+    std::cout << "\n=== 增量添加與全量重建結果一致 ===" << std::endl;
+
+    SystemRegistry::clear();
+    register_test_system<GraphTestSystem<GraphPosition>>("Move", 0);
+    register_test_system<GraphTestSystem<const GraphPosition>>("Render", 1, {"Move"});
+    register_test_system<GraphTestSystem<GraphVelocity>>("Accelerate", 0);
+
+    SystemManager manager;
+    manager.initialize();
+
+    // 熱加載：依賴 Render，並且與 Accelerate 存在寫衝突
+    manager.add_system("Audio", std::make_unique<GraphTestSystem<const GraphPosition>>(), {"Render"}, {}, 2);
+    manager.add_system("Drag", std::make_unique<GraphTestSystem<GraphVelocity>>(), {}, {}, 1);
+    manager.add_system("Input", std::make_unique<GraphTestSystem<>>(), {}, {}, -1);
+
+    auto incremental = layer_map(manager);
+    TEST_ASSERT(incremental.size() == 6, "手動添加的系統進入調度");
+    TEST_ASSERT(incremental["Move"] < incremental["Render"] && incremental["Render"] < incremental["Audio"], "顯式依賴鏈保持順序");
+    TEST_ASSERT(incremental["Accelerate"] != incremental["Drag"], "寫衝突的系統不在同一層");
+
+    manager.rebuild_task_graph();
+    TEST_ASSERT(layer_map(manager) == incremental, "增量結果與全量重建的分層相同");
+
+    manager.cleanup();
+    return true;
+}
+
+bool test_remove_relayers_successors()
+{
+    std::cout << "\n=== 移除系統後重新分層 ===" << std::endl;
+
+    SystemRegistry::clear();
+    register_test_system<GraphTestSystem<>>("A", 0);
+    register_test_system<GraphTestSystem<>>("B", 0, {"A"});
+    register_test_system<GraphTestSystem<>>("C", 0, {"B"});
+    register_test_system<GraphTestSystem<>>("D", 0, {"C"});
+
+    SystemManager manager;
+    manager.initialize();
+    TEST_ASSERT(manager.get_parallel_layers().size() == 4, "鏈式依賴共四層");
+
+    manager.remove_system("B");
+    auto layers = layer_map(manager);
+    TEST_ASSERT(layers.size() == 3 && layers["C"] == 0 && layers["D"] == 1, "後繼系統的層次隨之前移");
+    TEST_ASSERT(manager.get_system("B") == nullptr, "系統實例被移除");
+
+    entt::registry registry;
+    manager.update_systems(registry, 1.0f / 60.0f);
+    TEST_ASSERT(manager.get_profiler().get_last_frame()->layers.size() == 2, "調度表同步更新");
+
+    manager.cleanup();
+    return true;
+}
+
+bool test_batch_out_of_order_dependencies()
+{
+    std::cout << "\n=== 批量添加（依賴後到） ===" << std::endl;
+
+    SystemRegistry::clear();
+    register_test_system<GraphTestSystem<>>("Base", 0);
+
+    SystemManager manager;
+    manager.initialize();
+
+    {
+        SystemManager::SystemBatch batch(manager);
+        manager.add_system("Consumer", std::make_unique<GraphTestSystem<>>(), {"Producer"});
+        manager.add_system("Producer", std::make_unique<GraphTestSystem<>>(), {"Base"});
+        manager.remove_system("Base");
+        // 提交前層次列表不變
+        TEST_ASSERT(manager.get_parallel_layers().size() == 1, "批量操作期間不更新層次列表");
+    }
+
+    auto layers = layer_map(manager);
+    TEST_ASSERT(layers.size() == 2, "提交後包含新增系統且移除了 Base");
+    TEST_ASSERT(layers["Producer"] == 0 && layers["Consumer"] == 1, "先添加的依賴方在被依賴方加入後正確排序");
+
+    manager.cleanup();
+    return true;
+}
+
+bool test_cycle_falls_back_to_full_rebuild()
+{
+    std::cout << "\n=== 循環依賴退回全量構建 ===" << std::endl;
+
+    SystemRegistry::clear();
+    register_test_system<GraphTestSystem<>>("First", 0, {"Second"});
+
+    SystemManager manager;
+    manager.initialize();
+    // Second 依賴 First，而 First 已依賴 Second
+    manager.add_system("Second", std::make_unique<GraphTestSystem<>>(), {"First"});
+
+    TEST_ASSERT(layer_map(manager).empty(), "循環中的系統不被調度（與全量構建一致）");
+    manager.remove_system("Second");
+    TEST_ASSERT(layer_map(manager).size() == 1, "打破循環後恢復調度");
+
+    manager.cleanup();
+    return true;
+}
+
+ComponentAccess random_access(size_t seed)
+{
+    // 32 種組件類型中隨機讀 2 個、寫 1 個
+    ComponentAccess access;
+    access.declared = true;
+    access.writes.push_back({static_cast<entt::id_type>(seed * 7 % 32 + 1), "bench"});
+    access.reads.push_back({static_cast<entt::id_type>(seed * 13 % 32 + 1), "bench"});
+    access.reads.push_back({static_cast<entt::id_type>(seed * 29 % 32 + 1), "bench"});
+    return access;
+}
+
+void benchmark_hot_reload_cost()
+{
+    std::cout << "\n=== 熱加載耗時隨系統數量的變化 ===" << std::endl;
+
+    for (size_t system_count : {50, 100, 200, 400})
+    {
+        SystemRegistry::clear();
+        SystemManager manager;
+        manager.initialize();
+
+        double full_ms = 0.0;
+        double incremental_us = 0.0;
+        const int RELOADS = 50;
+        {
+            ScopedSilence silence;
+            {
+                SystemManager::SystemBatch batch(manager);
+                for (size_t i = 0; i < system_count; ++i)
+                {
+                    std::vector<std::string> dependencies;
+                    if (i >= 4 && i % 3 == 0)
+                    {
+                        dependencies.push_back("Bench" + std::to_string(i / 2));
+                    }
+                    manager.add_system("Bench" + std::to_string(i),
+                                       std::make_unique<ConfigurableAccessSystem>(random_access(i)), dependencies);
+                }
+            }
+
+            auto start = std::chrono::high_resolution_clock::now();
+            manager.rebuild_task_graph();
+            full_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+            start = std::chrono::high_resolution_clock::now();
+            for (int reload = 0; reload < RELOADS; ++reload)
+            {
+                manager.add_system("HotReloaded", std::make_unique<ConfigurableAccessSystem>(random_access(reload)),
+                                   {"Bench" + std::to_string(reload % system_count)});
+            }
+            incremental_us = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / RELOADS;
+        }
+
+        std::cout << "Systems: " << system_count << " | full rebuild: " << full_ms
+                  << " ms | incremental hot reload: " << incremental_us << " us" << std::endl;
+        manager.cleanup();
+    }
+}
+
+int main()
+{
+    std::cout << "=== System Incremental Task Graph Test ===" << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_incremental_matches_full_rebuild();
+    all_passed &= test_remove_relayers_successors();
+    all_passed &= test_batch_out_of_order_dependencies();
+    all_passed &= test_cycle_falls_back_to_full_rebuild();
+
+    benchmark_hot_reload_cost();
+
+    SystemRegistry::reset_and_re_register();
+
+    std::cout << (all_passed ? "\n✅ All tests passed" : "\n❌ Some tests failed") << std::endl;
+    return all_passed ? 0 : 1;
+}
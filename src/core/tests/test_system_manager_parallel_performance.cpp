@@ -0,0 +1,174 @@
+#include "core/system_manager.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <future>
+#include <cmath>
+#include <atomic>
+
+using namespace portal_core;
+
+// 模擬系統負載：固定次數的浮點運算
+class BenchmarkSystem : public ISystem
+{
+public:
+    explicit BenchmarkSystem(int work_iterations) : work_iterations_(work_iterations) {}
+
+    void update(entt::registry &registry, float delta_time) override
+    {
+        (void)registry;
+        float value = delta_time;
+        for (int i = 0; i < work_iterations_; ++i)
+        {
+            value = std::sqrt(value * value + 1.0f);
+        }
+        sink_.store(value, std::memory_order_relaxed);
+        update_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const char *get_name() const override { return "BenchmarkSystem"; }
+
+    static std::atomic<int> update_count_;
+
+private:
+    int work_iterations_;
+    std::atomic<float> sink_{0.0f};
+};
+
+std::atomic<int> BenchmarkSystem::update_count_{0};
+
+// 註冊 system_count 個系統，分成 layer_count 層（每層依賴上一層的第一個系統）
+void register_benchmark_systems(size_t system_count, size_t layer_count, int work_iterations)
+{
+    SystemRegistry::clear();
+
+    size_t per_layer = system_count / layer_count;
+    for (size_t i = 0; i < system_count; ++i)
+    {
+        size_t layer = i / per_layer;
+        std::vector<std::string> dependencies;
+        if (layer > 0)
+        {
+            dependencies.push_back("BenchSystem_" + std::to_string((layer - 1) * per_layer));
+        }
+
+        SystemRegistry::register_system(
+            "BenchSystem_" + std::to_string(i),
+            [work_iterations]() -> std::unique_ptr<ISystem>
+            { return std::make_unique<BenchmarkSystem>(work_iterations); },
+            dependencies, {}, static_cast<int>(i));
+    }
+}
+
+// 舊實現的基準：每幀每個系統一次 std::async
+void update_with_async(SystemManager &manager, entt::registry &registry, float delta_time)
+{
+    for (const auto &layer : manager.get_parallel_layers())
+    {
+        std::vector<std::future<void>> futures;
+        for (const std::string &system_name : layer)
+        {
+            ISystem *system = manager.get_system(system_name);
+            futures.emplace_back(std::async(std::launch::async, [system, &registry, delta_time]()
+                                            { system->update(registry, delta_time); }));
+        }
+        for (auto &future : futures)
+        {
+            future.wait();
+        }
+    }
+}
+
+template <typename UpdateFunc>
+double measure_frames(int frames, UpdateFunc &&update)
+{
+    // 預熱
+    for (int i = 0; i < 10; ++i)
+    {
+        update();
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < frames; ++i)
+    {
+        update();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / frames;
+}
+
+bool test_parallel_scaling(size_t system_count, int work_iterations)
+{
+    const size_t LAYER_COUNT = 4;
+    const int FRAMES = 200;
+    const float DELTA_TIME = 0.016f;
+
+    register_benchmark_systems(system_count, LAYER_COUNT, work_iterations);
+
+    SystemManager manager;
+    manager.initialize();
+
+    entt::registry registry;
+
+    double sequential_us = measure_frames(FRAMES, [&]()
+                                          { manager.update_systems(registry, DELTA_TIME); });
+
+    double async_us = measure_frames(FRAMES, [&]()
+                                     { update_with_async(manager, registry, DELTA_TIME); });
+
+    manager.set_parallel_execution(true);
+    BenchmarkSystem::update_count_.store(0);
+    double pool_us = measure_frames(FRAMES, [&]()
+                                    { manager.update_systems(registry, DELTA_TIME); });
+
+    bool all_updated = BenchmarkSystem::update_count_.load() == static_cast<int>(system_count) * (FRAMES + 10);
+
+    std::cout << "Systems: " << system_count
+              << " | work: " << work_iterations
+              << " | sequential: " << sequential_us << " μs/frame"
+              << " | std::async: " << async_us << " μs/frame"
+              << " | worker pool: " << pool_us << " μs/frame"
+              << " | speedup vs async: " << (pool_us > 0.0 ? async_us / pool_us : 0.0) << "x"
+              << std::endl;
+
+    manager.cleanup();
+
+    if (!all_updated)
+    {
+        std::cout << "❌ 部分系統未被執行" << std::endl;
+    }
+    return all_updated;
+}
+
+int main()
+{
+    std::cout << "=== SystemManager Parallel Execution Benchmark ===" << std::endl;
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    bool all_passed = true;
+    const std::vector<size_t> system_counts = {8, 16, 32, 64};
+
+    std::cout << "\n--- Light systems (調度開銷主導) ---" << std::endl;
+    for (size_t count : system_counts)
+    {
+        all_passed &= test_parallel_scaling(count, 200);
+    }
+
+    std::cout << "\n--- Heavy systems (計算主導) ---" << std::endl;
+    for (size_t count : system_counts)
+    {
+        all_passed &= test_parallel_scaling(count, 20000);
+    }
+
+    SystemRegistry::reset_and_re_register();
+
+    if (all_passed)
+    {
+        std::cout << "\n✅ 所有系統在每幀均被執行，常駐線程池應明顯低於 std::async 的每幀開銷" << std::endl;
+        return 0;
+    }
+
+    std::cout << "\n❌ Benchmark failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,157 @@
+#include "system_test_utils.h"
+#include "core/parallel_each.h"
+#include <iostream>
+#include <atomic>
+#include <thread>
+
+using namespace portal_core;
+
+struct ProfiledComponent
+{
+    float value = 0.0f;
+};
+
+// 遍歷組件的系統，實體數應由 parallel_each 自動計入
+class ProfiledIterateSystem : public ISystem
+{
+public:
+    void update(entt::registry &registry, float) override
+    {
+        parallel_each(get_worker_pool(), registry.view<ProfiledComponent>(), [](auto, auto &component)
+                      { component.value += 1.0f; });
+    }
+    const char *get_name() const override { return "ProfiledIterateSystem"; }
+};
+
+// 明顯更慢的系統
+class ProfiledSlowSystem : public ISystem
+{
+public:
+    void update(entt::registry &, float) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    const char *get_name() const override { return "ProfiledSlowSystem"; }
+};
+
+bool test_system_timing_and_entities(bool parallel)
+{
+    std::cout << "\n=== 系統耗時與實體統計 (" << (parallel ? "並行" : "順序") << ") ===" << std::endl;
+
+    SystemRegistry::clear();
+    register_test_system<ProfiledIterateSystem>("Iterate");
+    register_test_system<ProfiledSlowSystem>("Slow");
+
+    SystemManager manager;
+    manager.initialize();
+    manager.set_parallel_execution(parallel);
+
+    entt::registry registry;
+    for (int i = 0; i < 5000; ++i)
+    {
+        registry.emplace<ProfiledComponent>(registry.create());
+    }
+
+    const int FRAMES = 10;
+    for (int i = 0; i < FRAMES; ++i)
+    {
+        manager.update_systems(registry, 1.0f / 60.0f);
+    }
+
+    const SystemProfiler &profiler = manager.get_profiler();
+    auto stats = profiler.get_system_stats();
+
+    TEST_ASSERT(stats.size() == 2, "每個系統都有統計數據");
+    TEST_ASSERT(stats[0].name == "Slow", "按平均耗時排序，最慢的系統排在最前");
+    TEST_ASSERT(stats[0].avg_ms >= 1.5f, "記錄了慢系統的耗時");
+    TEST_ASSERT(stats[1].last_entities == 5000, "parallel_each 自動計入處理的實體數");
+
+    TEST_ASSERT(profiler.get_frame_history().size() == FRAMES, "幀歷史寫入環形緩衝");
+    const auto *frame = profiler.get_last_frame();
+    TEST_ASSERT(frame && frame->layers.size() == 1, "記錄了每層的耗時");
+    TEST_ASSERT(frame->critical_path_ms >= stats[0].last_ms - 0.001f, "關鍵路徑不小於層內最慢系統");
+    TEST_ASSERT(frame->frame_ms >= frame->critical_path_ms, "幀耗時不小於關鍵路徑");
+
+    manager.cleanup();
+    return true;
+}
+
+bool test_ring_buffer_wraps()
+{
+    std::cout << "\n=== 環形緩衝覆蓋 ===" << std::endl;
+
+    RingBuffer<int, 4> ring;
+    for (int i = 0; i < 10; ++i)
+    {
+        ring.push(i);
+    }
+
+    TEST_ASSERT(ring.size() == 4, "容量固定");
+    TEST_ASSERT(ring[0] == 6 && ring.back() == 9, "保留最近的數據並按時間順序訪問");
+    return true;
+}
+
+bool test_help_time_is_separate()
+{
+    std::cout << "\n=== 幫助執行其他任務的時間單獨統計 ===" << std::endl;
+
+    WorkerPool pool(1);
+
+    // 佔住唯一的工作線程，保證後續任務都由等待中的調用線程執行
+    std::atomic<bool> release_worker{false};
+    std::atomic<bool> worker_blocked{false};
+    TaskGroup blocker_group;
+    pool.submit(blocker_group, [&]()
+                {
+                    worker_blocked.store(true);
+                    while (!release_worker.load())
+                    {
+                        std::this_thread::yield();
+                    } });
+    while (!worker_blocked.load())
+    {
+        std::this_thread::yield();
+    }
+
+    // 隊尾的其他系統任務先被取出，隨後才是自己的任務
+    TaskGroup own_group;
+    TaskGroup foreign_group;
+    pool.submit(own_group, []()
+                { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+    pool.submit(foreign_group, []()
+                { std::this_thread::sleep_for(std::chrono::milliseconds(3)); });
+
+    const uint64_t help_before = WorkerPool::get_thread_help_time_ns();
+    pool.wait(own_group);
+    const float help_ms = static_cast<float>(WorkerPool::get_thread_help_time_ns() - help_before) / 1.0e6f;
+
+    release_worker.store(true);
+    pool.wait(blocker_group);
+
+    TEST_ASSERT(foreign_group.is_done(), "等待時替其他任務組執行了任務");
+    TEST_ASSERT(help_ms >= 2.5f, "其他任務組的耗時計入幫助時間");
+
+    const uint64_t own_before = WorkerPool::get_thread_help_time_ns();
+    TaskGroup own_only;
+    pool.submit(own_only, []()
+                { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+    pool.wait(own_only);
+    TEST_ASSERT(WorkerPool::get_thread_help_time_ns() == own_before, "執行自己任務組的任務不計入幫助時間");
+    return true;
+}
+
+int main()
+{
+    std::cout << "=== System Profiler Test ===" << std::endl;
+
+    bool all_passed = true;
+    all_passed &= test_ring_buffer_wraps();
+    all_passed &= test_system_timing_and_entities(false);
+    all_passed &= test_system_timing_and_entities(true);
+    all_passed &= test_help_time_is_separate();
+
+    SystemRegistry::reset_and_re_register();
+
+    std::cout << (all_passed ? "\n✅ All tests passed" : "\n❌ Some tests failed") << std::endl;
+    return all_passed ? 0 : 1;
+}
@@ -0,0 +1,381 @@
+#pragma once
+
+#include "frame_tracer.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace portal_core
+{
+
+  /**
+   * 任務組
+   * 追蹤一批提交到 WorkerPool 的任務，配合 WorkerPool::wait 使用。
+   * 任務拋出的第一個異常保存在組內，由 wait 在全部任務結束後重新拋出
+   */
+  class TaskGroup
+  {
+  public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    /**
+     * 組內所有任務是否已完成
+     */
+    bool is_done() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+  private:
+    friend class WorkerPool;
+    std::atomic<uint32_t> pending_{0};
+    std::mutex exception_mutex_;
+    std::exception_ptr exception_;
+
+    void capture_exception(std::exception_ptr exception)
+    {
+      std::lock_guard<std::mutex> lock(exception_mutex_);
+      if (!exception_)
+      {
+        exception_ = std::move(exception);
+      }
+    }
+
+    void rethrow_if_failed()
+    {
+      std::exception_ptr exception;
+      {
+        std::lock_guard<std::mutex> lock(exception_mutex_);
+        exception = std::exchange(exception_, nullptr);
+      }
+      if (exception)
+      {
+        std::rethrow_exception(exception);
+      }
+    }
+  };
+
+  /**
+   * 常駐工作線程池（work-stealing）
+   *
+   * 線程在構造時創建、析構時回收，每幀派發任務不再產生線程創建/銷毀開銷。
+   * 每個工作線程擁有自己的任務隊列：自己從隊尾取（LIFO，緩存友好），
+   * 空閒時從其他線程的隊首竊取（FIFO）。調用 wait() 的線程也會參與執行任務，
+   * 因此在工作線程內部提交並等待子任務不會死鎖。
+   */
+  class WorkerPool
+  {
+  public:
+    using Task = std::function<void()>;
+
+    /**
+     * @param worker_count 工作線程數，0 表示硬件線程數 - 1（調用線程會在 wait 中補位）
+     */
+    explicit WorkerPool(size_t worker_count = 0)
+    {
+      if (worker_count == 0)
+      {
+        unsigned hardware_threads = std::thread::hardware_concurrency();
+        worker_count = hardware_threads > 1 ? hardware_threads - 1 : 1;
+      }
+
+      queues_.reserve(worker_count);
+      for (size_t i = 0; i < worker_count; ++i)
+      {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+      }
+
+      workers_.reserve(worker_count);
+      for (size_t i = 0; i < worker_count; ++i)
+      {
+        workers_.emplace_back([this, i]()
+                              { worker_loop(i); });
+      }
+    }
+
+    ~WorkerPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_.store(true, std::memory_order_seq_cst);
+      }
+      sleep_cv_.notify_all();
+
+      for (auto &worker : workers_)
+      {
+        worker.join();
+      }
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /**
+     * 提交任務到指定任務組
+     * 從工作線程內部提交時放入該線程自己的隊列，否則輪詢分配
+     */
+    void submit(TaskGroup &group, Task task)
+    {
+      group.pending_.fetch_add(1, std::memory_order_relaxed);
+
+      size_t queue_index = (current_pool_ == this)
+                               ? current_worker_index_
+                               : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+      {
+        std::lock_guard<std::mutex> lock(queues_[queue_index]->mutex);
+        queues_[queue_index]->tasks.push_back(QueuedTask{std::move(task), &group});
+      }
+
+      queued_tasks_.fetch_add(1, std::memory_order_seq_cst);
+      wake_one_worker();
+    }
+
+    /**
+     * 等待任務組完成
+     * 等待期間調用線程會竊取並執行任務，而不是空轉；執行其他任務組的任務
+     * 所花的時間計入當前線程的幫助時間（get_thread_help_time_ns）。
+     * 組內有任務拋出異常時，在所有任務結束後重新拋出第一個異常
+     */
+    void wait(TaskGroup &group)
+    {
+      size_t start_index = (current_pool_ == this) ? current_worker_index_ : 0;
+
+      while (!group.is_done())
+      {
+        QueuedTask task;
+        if (try_acquire(start_index, task))
+        {
+          if (task.group == &group)
+          {
+            run(task);
+          }
+          else
+          {
+            // 任務內部嵌套的幫助時間已包含在本次耗時中，不重複累加
+            const uint64_t help_before = help_time_ns_;
+            auto start = std::chrono::steady_clock::now();
+            run(task);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            help_time_ns_ = help_before + static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+          }
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+
+      group.rethrow_if_failed();
+    }
+
+    /**
+     * 在當前線程執行 func 後等待任務組
+     * func 拋出異常時仍先等組內任務結束再傳播（它們可能引用調用方棧上的數據），
+     * 此時組內任務的異常被丟棄
+     */
+    template <typename Func>
+    void run_and_wait(TaskGroup &group, Func &&func)
+    {
+      try
+      {
+        func();
+      }
+      catch (...)
+      {
+        try
+        {
+          wait(group);
+        }
+        catch (...)
+        {
+        }
+        throw;
+      }
+      wait(group);
+    }
+
+    size_t get_worker_count() const { return workers_.size(); }
+
+    /**
+     * 當前線程是否為本池的工作線程
+     */
+    bool is_worker_thread() const { return current_pool_ == this; }
+
+    /**
+     * 工作線程累計執行任務的時間（納秒），用於計算空閒率
+     */
+    uint64_t get_busy_time_ns() const { return busy_time_ns_.load(std::memory_order_relaxed); }
+
+    /**
+     * 累計從其他線程隊列竊取的任務數
+     */
+    uint64_t get_stolen_task_count() const { return stolen_tasks_.load(std::memory_order_relaxed); }
+
+    /**
+     * 當前線程在 wait 中替其他任務組執行任務的累計時間（納秒）
+     * 用於從調用方的耗時中扣除不屬於它的工作
+     */
+    static uint64_t get_thread_help_time_ns() { return help_time_ns_; }
+
+  private:
+    struct QueuedTask
+    {
+      Task task;
+      TaskGroup *group = nullptr;
+    };
+
+    struct WorkerQueue
+    {
+      std::mutex mutex;
+      std::deque<QueuedTask> tasks;
+    };
+
+    // 進入睡眠前的自旋次數，避免層與層之間的短暫空檔觸發睡眠/喚醒
+    static constexpr int SPIN_BEFORE_SLEEP = 64;
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<size_t> queued_tasks_{0};
+    std::atomic<size_t> sleeping_workers_{0};
+    std::atomic<bool> stopping_{false};
+
+    // 性能統計
+    std::atomic<uint64_t> busy_time_ns_{0};
+    std::atomic<uint64_t> stolen_tasks_{0};
+
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+
+    inline static thread_local WorkerPool *current_pool_ = nullptr;
+    inline static thread_local size_t current_worker_index_ = 0;
+    inline static thread_local uint64_t help_time_ns_ = 0;
+
+    void worker_loop(size_t index)
+    {
+      current_pool_ = this;
+      current_worker_index_ = index;
+      FrameTracer::set_thread_name("Worker " + std::to_string(index));
+
+      while (true)
+      {
+        QueuedTask task;
+        bool found = try_acquire(index, task);
+
+        for (int spin = 0; !found && spin < SPIN_BEFORE_SLEEP; ++spin)
+        {
+          std::this_thread::yield();
+          found = try_acquire(index, task);
+        }
+
+        if (found)
+        {
+          auto start = std::chrono::steady_clock::now();
+          run(task);
+          auto elapsed = std::chrono::steady_clock::now() - start;
+          busy_time_ns_.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                                  std::memory_order_relaxed);
+          continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleeping_workers_.fetch_add(1, std::memory_order_seq_cst);
+        sleep_cv_.wait(lock, [this]()
+                       { return stopping_.load(std::memory_order_seq_cst) ||
+                                queued_tasks_.load(std::memory_order_seq_cst) > 0; });
+        sleeping_workers_.fetch_sub(1, std::memory_order_seq_cst);
+
+        if (stopping_.load() && queued_tasks_.load() == 0)
+        {
+          return;
+        }
+      }
+    }
+
+    /**
+     * 先從自己的隊尾取任務，再依次從其他隊列的隊首竊取
+     */
+    bool try_acquire(size_t start_index, QueuedTask &out)
+    {
+      if (queued_tasks_.load(std::memory_order_acquire) == 0)
+      {
+        return false;
+      }
+
+      const size_t queue_count = queues_.size();
+      for (size_t offset = 0; offset < queue_count; ++offset)
+      {
+        WorkerQueue &queue = *queues_[(start_index + offset) % queue_count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+          continue;
+        }
+
+        if (offset == 0)
+        {
+          out = std::move(queue.tasks.back());
+          queue.tasks.pop_back();
+        }
+        else
+        {
+          out = std::move(queue.tasks.front());
+          queue.tasks.pop_front();
+          stolen_tasks_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        queued_tasks_.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+      }
+      return false;
+    }
+
+    /**
+     * 執行任務；異常交給任務組保存，無論成功與否都計為完成，
+     * 否則等待方會永遠等下去，工作線程也會因異常逃逸而 terminate
+     */
+    void run(QueuedTask &task)
+    {
+      struct CompletionGuard
+      {
+        TaskGroup *group;
+        ~CompletionGuard() { group->pending_.fetch_sub(1, std::memory_order_acq_rel); }
+      } completion{task.group};
+
+      try
+      {
+        task.task();
+      }
+      catch (...)
+      {
+        task.group->capture_exception(std::current_exception());
+      }
+    }
+
+    void wake_one_worker()
+    {
+      if (sleeping_workers_.load(std::memory_order_seq_cst) == 0)
+      {
+        return;
+      }
+
+      // 持鎖後再通知，確保不會錯過正在進入睡眠的線程
+      {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+      }
+      sleep_cv_.notify_one();
+    }
+  };
+
+} // namespace portal_core